@@ -0,0 +1,94 @@
+#include "analysis/parallel_simulator.h"
+#include "memory/physical_memory.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace memsim;
+
+namespace {
+
+constexpr size_t BLOCK_SIZE = 64;
+constexpr size_t MEMORY_SIZE = 1 << 20;
+
+std::vector<TraceRecord> makeTrace(size_t accesses, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<Address> hot_dist(0, 65535);
+    std::uniform_int_distribution<Address> any_dist(0, MEMORY_SIZE - 1);
+    std::uniform_int_distribution<int> pct(0, 99);
+
+    std::vector<TraceRecord> trace;
+    trace.reserve(accesses);
+    for (size_t i = 0; i < accesses; i++) {
+        int p = pct(rng);
+        Address addr = (p < 80) ? hot_dist(rng) : any_dist(rng);
+        trace.push_back({addr, p % 10 == 0});
+    }
+    return trace;
+}
+
+} // namespace
+
+int main() {
+    auto trace = makeTrace(1000000, 11);
+
+    std::vector<SweepConfig> configs;
+    for (auto policy : {CachePolicy::LRU, CachePolicy::TREE_PLRU, CachePolicy::DRRIP, CachePolicy::LFU}) {
+        for (size_t sets : {64, 256}) {
+            configs.push_back({{{sets, 8, BLOCK_SIZE, policy}, {1024, 16, BLOCK_SIZE, CachePolicy::LRU}},
+                               InclusionPolicy::NINE});
+        }
+    }
+
+    std::cout << "=== Parallel Sweep Benchmark ===\n";
+    std::cout << configs.size() << " two-level configurations, " << trace.size() << " accesses, "
+              << std::thread::hardware_concurrency() << " hardware threads\n\n";
+
+    // Baseline: one configuration after another
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint64_t> sequential_memory_accesses;
+    for (const auto& config : configs) {
+        PhysicalMemory memory(MEMORY_SIZE);
+        CacheHierarchy cache(&memory, config.levels, config.inclusion);
+        for (const auto& record : trace) {
+            if (record.is_write) {
+                cache.write(record.address, 0);
+            } else {
+                cache.read(record.address);
+            }
+        }
+        sequential_memory_accesses.push_back(cache.getStats().memory_accesses);
+    }
+    double sequential = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // One shared pass, one thread per configuration
+    start = std::chrono::steady_clock::now();
+    ParallelCacheSimulator simulator(MEMORY_SIZE);
+    for (const auto& config : configs) {
+        simulator.addConfig(config);
+    }
+    simulator.run(trace);
+    double parallel = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < configs.size(); i++) {
+        if (simulator.getResults()[i].stats.memory_accesses != sequential_memory_accesses[i]) {
+            mismatches++;
+        }
+    }
+
+    double total = static_cast<double>(trace.size()) * configs.size();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  sequential: " << std::setw(8) << sequential << " s  ("
+              << std::setprecision(0) << total / sequential << " config-accesses/s)\n";
+    std::cout << std::setprecision(3);
+    std::cout << "  parallel:   " << std::setw(8) << parallel << " s  ("
+              << std::setprecision(0) << total / parallel << " config-accesses/s)\n";
+    std::cout << "  speedup: " << std::setprecision(2) << sequential / parallel << "x, "
+              << mismatches << " mismatches\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+#include "analysis/stack_distance.h"
+#include "cache/cache_level.h"
+#include "memory/physical_memory.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace memsim;
+
+namespace {
+
+constexpr size_t BLOCK_SIZE = 64;
+constexpr size_t NUM_BLOCKS = 16384;
+constexpr size_t MEMORY_SIZE = NUM_BLOCKS * BLOCK_SIZE;
+constexpr size_t MAX_SETS = 512;                  // Sets 1, 2, ..., 512
+constexpr size_t WAYS[] = {1, 2, 4, 8, 16};       // x 5 associativities = 50 configs
+
+/**
+ * @brief Mixed workload: a looping array scan plus skewed random reads
+ */
+std::vector<Address> makeTrace(size_t accesses, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<size_t> hot_dist(0, 1023);
+    std::uniform_int_distribution<size_t> any_dist(0, NUM_BLOCKS - 1);
+    std::uniform_int_distribution<int> pct(0, 99);
+
+    std::vector<Address> trace;
+    trace.reserve(accesses);
+    size_t scan = 0;
+    for (size_t i = 0; i < accesses; i++) {
+        int p = pct(rng);
+        size_t block;
+        if (p < 40) {
+            block = scan++ % 4096;
+        } else if (p < 90) {
+            block = hot_dist(rng);
+        } else {
+            block = any_dist(rng);
+        }
+        trace.push_back(block * BLOCK_SIZE);
+    }
+    return trace;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    PhysicalMemory memory(MEMORY_SIZE);
+    auto trace = makeTrace(500000, 7);
+    size_t configs = 0;
+    for (size_t sets = 1; sets <= MAX_SETS; sets *= 2) {
+        configs += sizeof(WAYS) / sizeof(WAYS[0]);
+    }
+
+    std::cout << "=== Stack Distance Benchmark ===\n";
+    std::cout << configs << " LRU configurations, " << trace.size() << " reads, "
+              << BLOCK_SIZE << "B blocks\n\n";
+
+    // One pass for every configuration
+    auto start = std::chrono::steady_clock::now();
+    StackDistanceAnalyzer analyzer(BLOCK_SIZE, MAX_SETS);
+    for (Address addr : trace) {
+        analyzer.access(addr);
+    }
+    double single_pass = secondsSince(start);
+
+    // One replay per configuration
+    start = std::chrono::steady_clock::now();
+    size_t mismatches = 0;
+    for (size_t sets = 1; sets <= MAX_SETS; sets *= 2) {
+        for (size_t ways : WAYS) {
+            CacheLevel cache(1, sets, ways, BLOCK_SIZE, CachePolicy::LRU, &memory);
+            for (Address addr : trace) {
+                cache.read(addr);
+            }
+            if (cache.getStats().misses != analyzer.getMisses(sets, ways)) {
+                mismatches++;
+            }
+        }
+    }
+    double replays = secondsSince(start);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  single pass (stack distance): " << std::setw(9) << single_pass << " s\n";
+    std::cout << "  per-config replay:            " << std::setw(9) << replays << " s\n";
+    std::cout << "  speedup: " << std::setprecision(1) << replays / single_pass << "x, "
+              << mismatches << " miss-count mismatches\n\n";
+
+    std::cout << analyzer.getReport(16);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include "memory/physical_memory.h"
+#include "virtual_memory/swap_device.h"
+#include "virtual_memory/virtual_memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace memsim;
+
+namespace {
+
+constexpr size_t PAGE_SIZE = 4096;
+constexpr size_t VIRTUAL_PAGES = 2048;
+constexpr size_t PHYSICAL_FRAMES = 128;
+constexpr size_t READAHEAD_PAGES = 32;
+constexpr size_t FAULT_AROUND_PAGES = 16;
+const char* SWAP_PATH = "/tmp/memsim_swap_bench.swap";
+
+struct Workload {
+    std::string name;
+    std::vector<uint64_t> pages;   // Page of each read, in order
+    bool readahead;                // Readahead, else fault-around
+};
+
+struct BenchResult {
+    double seconds;
+    uint64_t faults;
+    double wait_ms;
+    size_t mismatches;
+};
+
+// Every page is written once first, so each read of the workload faults it back from swap
+BenchResult run(const Workload& workload, size_t threads, uint64_t delay_us) {
+    PhysicalMemory memory(PHYSICAL_FRAMES * PAGE_SIZE);
+    VirtualMemory vm(&memory, VIRTUAL_PAGES, PHYSICAL_FRAMES, PAGE_SIZE, PageReplacementPolicy::LRU);
+    auto swap = std::make_unique<SwapDevice>();
+    if (!swap->open(SWAP_PATH, PAGE_SIZE).success) {
+        std::cerr << "Cannot open " << SWAP_PATH << "\n";
+        std::exit(1);
+    }
+    SwapDevice* device = swap.get();
+    vm.setSwapDevice(std::move(swap));
+
+    // Fill swap quickly: no delay and batched writes
+    vm.setSwapAsync(8, SwapDevice::DEFAULT_BATCH_SIZE);
+    for (uint64_t page = 0; page < VIRTUAL_PAGES; page++) {
+        vm.write(page * PAGE_SIZE, static_cast<uint8_t>(page * 7 + 1));
+    }
+    vm.setSwapAsync(threads, SwapDevice::DEFAULT_BATCH_SIZE);   // Finishes the writes first
+    device->setDeviceDelay(delay_us);
+    if (workload.readahead) {
+        vm.setReadahead(READAHEAD_PAGES);
+    } else {
+        vm.setFaultAround(FAULT_AROUND_PAGES);
+    }
+
+    uint64_t faults_before = vm.getStats().page_faults;
+    uint64_t wait_before = device->getStats().wait_ns;
+    BenchResult result{0.0, 0, 0.0, 0};
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t page : workload.pages) {
+        auto value = vm.read(page * PAGE_SIZE);
+        if (!value.success || value.value != static_cast<uint8_t>(page * 7 + 1)) {
+            result.mismatches++;
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.faults = vm.getStats().page_faults - faults_before;
+    result.wait_ms = static_cast<double>(device->getStats().wait_ns - wait_before) / 1e6;
+    return result;
+}
+
+void printRow(const std::string& name, const BenchResult& r, size_t accesses) {
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  " << std::left << std::setw(10) << name << std::right
+              << std::setw(8) << r.seconds << " s  "
+              << std::setprecision(0) << std::setw(8) << accesses / r.seconds << " accesses/s  "
+              << std::setw(6) << r.faults << " faults  "
+              << std::setprecision(1) << std::setw(8) << r.wait_ms << " ms blocked\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t delay_us = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100;
+
+    Workload sequential{"sequential scan, readahead " + std::to_string(READAHEAD_PAGES), {}, true};
+    for (uint64_t page = 0; page < VIRTUAL_PAGES; page++) {
+        sequential.pages.push_back(page);
+    }
+
+    // Random blocks, each touched in a shuffled order: locality fault-around can use
+    Workload blocks{"random blocks, fault-around " + std::to_string(FAULT_AROUND_PAGES), {}, false};
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<uint64_t> block_dist(0, VIRTUAL_PAGES / FAULT_AROUND_PAGES - 1);
+    for (size_t i = 0; i < 256; i++) {
+        uint64_t first = block_dist(rng) * FAULT_AROUND_PAGES;
+        std::vector<uint64_t> pages;
+        for (uint64_t page = first; page < first + FAULT_AROUND_PAGES; page++) {
+            pages.push_back(page);
+        }
+        std::shuffle(pages.begin(), pages.end(), rng);
+        blocks.pages.insert(blocks.pages.end(), pages.begin(), pages.end());
+    }
+
+    std::cout << "=== Swap I/O Benchmark ===\n";
+    std::cout << VIRTUAL_PAGES << " pages swapped out, " << PHYSICAL_FRAMES << " frames, "
+              << delay_us << " us per transfer\n";
+
+    size_t mismatches = 0;
+    for (const Workload& workload : {sequential, blocks}) {
+        std::cout << "\n" << workload.name << " (" << workload.pages.size() << " reads)\n";
+        BenchResult sync = run(workload, 0, delay_us);
+        printRow("sync", sync, workload.pages.size());
+        mismatches += sync.mismatches;
+        for (size_t threads : {4, 16}) {
+            BenchResult async = run(workload, threads, delay_us);
+            printRow("async x" + std::to_string(threads), async, workload.pages.size());
+            std::cout << "    speedup: " << std::setprecision(2) << sync.seconds / async.seconds << "x\n";
+            mismatches += async.mismatches;
+        }
+    }
+    std::remove(SWAP_PATH);
+    std::cout << "\n" << mismatches << " mismatches\n";
+    return mismatches == 0 ? 0 : 1;
+}
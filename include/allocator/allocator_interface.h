@@ -88,6 +88,13 @@ public:
      * @return Result containing the address on success, or error message on failure
      */
     virtual Result<Address> getBlockAddress(BlockId block_id) const = 0;
+
+    /**
+     * @brief Find the allocated block containing an address
+     * @param address Any address within the block
+     * @return Result containing the block ID, or error if the address is not allocated
+     */
+    virtual Result<BlockId> findBlockId(Address address) const = 0;
 };
 
 } // namespace memsim
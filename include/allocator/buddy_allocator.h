@@ -73,6 +73,7 @@ public:
     double getUtilization() const override;
     AllocatorType getType() const override { return AllocatorType::BUDDY; }
     Result<Address> getBlockAddress(BlockId block_id) const override;
+    Result<BlockId> findBlockId(Address address) const override;
 
 private:
     PhysicalMemory* physical_memory_;
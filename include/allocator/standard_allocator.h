@@ -47,6 +47,7 @@ public:
     double getUtilization() const override;
     AllocatorType getType() const override { return strategy_; }
     Result<Address> getBlockAddress(BlockId block_id) const override;
+    Result<BlockId> findBlockId(Address address) const override;
 
 private:
     PhysicalMemory* physical_memory_;  // Pointer to physical memory
@@ -0,0 +1,62 @@
+#ifndef MEMSIM_ANALYSIS_FENWICK_TREE_H
+#define MEMSIM_ANALYSIS_FENWICK_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Binary indexed (Fenwick) tree of counts over positions 1..size()
+ *
+ * Point updates and prefix sums are O(log n). Positions can be appended
+ * at the end in O(log n), so the tree can be indexed by a growing
+ * timestamp.
+ */
+class FenwickTree {
+public:
+    FenwickTree() : tree_(1, 0) {}
+
+    /**
+     * @brief Number of positions
+     */
+    size_t size() const { return tree_.size() - 1; }
+
+    /**
+     * @brief Append a new last position holding value
+     */
+    void append(uint32_t value);
+
+    /**
+     * @brief Add delta to the value at a position (1-based)
+     */
+    void add(size_t position, int32_t delta);
+
+    /**
+     * @brief Sum of the values at positions 1..position (0 gives 0)
+     */
+    uint64_t prefixSum(size_t position) const;
+
+    /**
+     * @brief Sum of the values at positions first..last (empty if first > last)
+     */
+    uint64_t rangeSum(size_t first, size_t last) const;
+
+    /**
+     * @brief Replace the contents with n positions all holding value, in O(n)
+     */
+    void reset(size_t n, uint32_t value);
+
+private:
+    std::vector<uint32_t> tree_;   // tree_[i] covers (i - lowbit(i), i]; tree_[0] unused
+
+    /**
+     * @brief Lowest set bit of i (the span of node i)
+     */
+    static size_t lowbit(size_t i);
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_ANALYSIS_FENWICK_TREE_H
@@ -0,0 +1,132 @@
+#ifndef MEMSIM_ANALYSIS_PARALLEL_SIMULATOR_H
+#define MEMSIM_ANALYSIS_PARALLEL_SIMULATOR_H
+
+#include "common/types.h"
+#include "common/result.h"
+#include "analysis/trace_reader.h"
+#include "cache/cache_hierarchy.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief One cache configuration simulated by ParallelCacheSimulator
+ */
+struct SweepConfig {
+    std::vector<CacheLevelConfig> levels;   // L1 first
+    InclusionPolicy inclusion;
+    size_t sampling_ratio = 1;              // Simulate one set in sampling_ratio (1 = exact)
+    SetSamplingMode sampling_mode = SetSamplingMode::HASH;
+};
+
+/**
+ * @brief Result of simulating one configuration over a trace
+ */
+struct SweepResult {
+    SweepConfig config;
+    HierarchyStats stats;        // Covers only the simulated sets when sampling
+    SamplingStats sampling;      // Extrapolated estimates (exact values when not sampling)
+    uint64_t errors;     // Accesses outside the simulated memory
+    double seconds;      // Wall time of this configuration's thread
+};
+
+/**
+ * @brief Simulates many cache configurations over one trace in a single pass
+ *
+ * The trace is decoded once, by the calling thread, into the slots of a
+ * TraceChunkRing. Every configuration runs on its own thread with its own
+ * CacheHierarchy and PhysicalMemory and consumes the chunks in place, so
+ * decoding is shared and the configurations proceed in parallel (bounded
+ * by the slowest one, which may lag the producer by the ring capacity).
+ *
+ * Trace writes are simulated as writes of 0. A configuration with a
+ * sampling ratio above 1 simulates only that fraction of its sets (see
+ * CacheHierarchy::setSetSampling), which gives quick estimates with
+ * confidence intervals; ratio 1 gives exact results.
+ */
+class ParallelCacheSimulator {
+public:
+    /**
+     * @brief Construct a simulator
+     *
+     * @param memory_size Size of each configuration's physical memory in bytes
+     * @param chunk_records Records per trace chunk
+     * @param ring_chunks Chunks buffered between the decoder and the simulators
+     */
+    explicit ParallelCacheSimulator(size_t memory_size,
+                                    size_t chunk_records = DEFAULT_CHUNK_RECORDS,
+                                    size_t ring_chunks = DEFAULT_RING_CHUNKS);
+
+    /**
+     * @brief Add a configuration to simulate
+     *
+     * @throws std::invalid_argument if the configuration is invalid
+     */
+    void addConfig(const SweepConfig& config);
+
+    /**
+     * @brief Number of configurations added
+     */
+    size_t getNumConfigs() const { return configs_.size(); }
+
+    /**
+     * @brief Simulate every configuration over a trace file
+     * @return Result indicating success or a trace error
+     */
+    Result<void> run(TraceReader& reader);
+
+    /**
+     * @brief Simulate every configuration over an in-memory trace
+     */
+    Result<void> run(const std::vector<TraceRecord>& trace);
+
+    /**
+     * @brief Results of the last run, in the order the configurations were added
+     */
+    const std::vector<SweepResult>& getResults() const { return results_; }
+
+    /**
+     * @brief Number of trace records in the last run
+     */
+    uint64_t getRecords() const { return records_; }
+
+    /**
+     * @brief Formatted table of the last run's results
+     *
+     * Includes each configuration's AMAT under the default latencies
+     * (CacheHierarchy::defaultLatencies), so geometries compare in cycles.
+     */
+    std::string getReport() const;
+
+    static constexpr size_t DEFAULT_CHUNK_RECORDS = 4096;
+    static constexpr size_t DEFAULT_RING_CHUNKS = 64;
+
+private:
+    size_t memory_size_;
+    size_t chunk_records_;
+    size_t ring_chunks_;
+    std::vector<SweepConfig> configs_;
+    std::vector<SweepResult> results_;
+    uint64_t records_;
+    double seconds_;     // Wall time of the last run
+
+    /**
+     * @brief Run the configurations, pulling chunks from a decoder
+     *
+     * @param next_chunk Fills a chunk (at most chunk_records_ records) and
+     *                   returns its size, 0 at the end, or an error
+     */
+    Result<void> runWith(const std::function<Result<size_t>(std::vector<TraceRecord>&)>& next_chunk);
+};
+
+/**
+ * @brief Short description of a sweep configuration, e.g. "64x8x64 LRU / 512x16x64 LRU"
+ */
+std::string sweepConfigToString(const SweepConfig& config);
+
+} // namespace memsim
+
+#endif // MEMSIM_ANALYSIS_PARALLEL_SIMULATOR_H
@@ -0,0 +1,157 @@
+#ifndef MEMSIM_ANALYSIS_STACK_DISTANCE_H
+#define MEMSIM_ANALYSIS_STACK_DISTANCE_H
+
+#include "common/types.h"
+#include "analysis/fenwick_tree.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Miss count of one LRU cache configuration
+ */
+struct MissRatioPoint {
+    size_t num_sets;
+    size_t associativity;
+    size_t capacity_bytes;
+    uint64_t misses;
+    double miss_ratio;        // Percentage of accesses
+};
+
+/**
+ * @brief Single-pass LRU stack-distance (Mattson) analysis
+ *
+ * For an LRU cache the blocks of each set form a stack ordered by recency,
+ * and an access hits in an A-way cache exactly when fewer than A distinct
+ * blocks of its set were referenced since the block's previous access
+ * (its stack distance). Recording a histogram of stack distances therefore
+ * yields the misses of every associativity at once.
+ *
+ * Set mapping changes the stacks, so one model is kept per number of sets
+ * (1, 2, 4, ..., max_sets), all fed by the same pass. In each model, every
+ * set keeps a Fenwick tree over its access timestamps holding a 1 at the
+ * latest access of each block; the stack distance is the range sum between
+ * the block's previous access and now, so each access costs
+ * O(log accesses) per model. A single hash lookup per access finds the
+ * block's previous timestamps in all models. Timestamps are periodically
+ * renumbered, which keeps memory proportional to the number of distinct
+ * blocks.
+ */
+class StackDistanceAnalyzer {
+public:
+    /**
+     * @brief Construct an analyzer
+     *
+     * @param block_size Cache block size in bytes (power of 2)
+     * @param max_sets Largest number of sets to model (power of 2; 1 = fully associative only)
+     */
+    StackDistanceAnalyzer(size_t block_size, size_t max_sets = 1);
+
+    /**
+     * @brief Feed one access of the stream
+     */
+    void access(Address address);
+
+    /**
+     * @brief Number of accesses seen
+     */
+    uint64_t getAccesses() const { return accesses_; }
+
+    /**
+     * @brief Number of first references (misses in a cache of any size)
+     */
+    uint64_t getColdMisses() const;
+
+    /**
+     * @brief Get the stack-distance histogram of a set count
+     *
+     * @param num_sets A modelled number of sets
+     * @return histogram[d] = reuses at stack distance d (0 = most recently used)
+     */
+    const std::vector<uint64_t>& getDistanceHistogram(size_t num_sets = 1) const;
+
+    /**
+     * @brief Misses of an LRU cache with the given geometry
+     *
+     * @param num_sets A modelled number of sets
+     * @param associativity Ways per set
+     */
+    uint64_t getMisses(size_t num_sets, size_t associativity) const;
+
+    /**
+     * @brief Miss ratio (percentage) of an LRU cache with the given geometry
+     */
+    double getMissRatio(size_t num_sets, size_t associativity) const;
+
+    /**
+     * @brief Miss-ratio curve of a set count for associativities 1..max_associativity
+     */
+    std::vector<MissRatioPoint> getMissRatioCurve(size_t num_sets, size_t max_associativity) const;
+
+    /**
+     * @brief Check whether a number of sets is modelled
+     */
+    bool isModelled(size_t num_sets) const;
+
+    /**
+     * @brief Get block size in bytes
+     */
+    size_t getBlockSize() const { return block_size_; }
+
+    /**
+     * @brief Get the largest modelled number of sets
+     */
+    size_t getMaxSets() const { return models_.back().num_sets; }
+
+    /**
+     * @brief Formatted miss-ratio table for every set count (associativity doubling up to max)
+     */
+    std::string getReport(size_t max_associativity) const;
+
+    static constexpr size_t COMPACT_SLACK = 4096;   // Extra timestamps tolerated before renumbering
+
+private:
+    /**
+     * @brief LRU stacks of every set for one set count
+     */
+    struct SetCountModel {
+        size_t num_sets;
+        std::vector<FenwickTree> set_trees;   // One per set, indexed by set-local time
+        std::vector<uint64_t> histogram;      // Stack distance counts
+        size_t timestamps;                    // Positions across all set trees
+    };
+
+    size_t block_size_;
+    size_t offset_bits_;
+    uint64_t accesses_;
+    std::vector<SetCountModel> models_;   // models_[k] has 2^k sets
+
+    // Distinct blocks, numbered in order of first reference
+    std::unordered_map<Address, size_t> block_ids_;
+    std::vector<Address> blocks_;
+    std::vector<uint64_t> last_access_;   // [id * models + k]: set-local time in model k (0 = never)
+
+    /**
+     * @brief Record one access to block id in model k
+     */
+    void accessModel(size_t k, size_t id, Address block);
+
+    /**
+     * @brief Renumber model k's timestamps to 1..n per set (n = blocks in the set)
+     */
+    void compact(size_t k);
+
+    /**
+     * @brief Find the model of a set count (throws if not modelled)
+     */
+    const SetCountModel& getModel(size_t num_sets) const;
+
+    static bool isPowerOfTwo(size_t value);
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_ANALYSIS_STACK_DISTANCE_H
@@ -0,0 +1,70 @@
+#ifndef MEMSIM_ANALYSIS_TRACE_READER_H
+#define MEMSIM_ANALYSIS_TRACE_READER_H
+
+#include "common/types.h"
+#include "common/result.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief One memory access of a trace
+ */
+struct TraceRecord {
+    Address address;
+    bool is_write;
+    uint32_t core = 0;   // Issuing core (multi-core traces)
+};
+
+/**
+ * @brief Reads memory access traces from a text file
+ *
+ * One access per line: "R <address>" or "W <address>" (case-insensitive),
+ * or just "<address>" for a read, optionally followed by the issuing core
+ * ID (default 0). Addresses are decimal or 0x-prefixed hex.
+ * Blank lines and lines starting with '#' are skipped.
+ */
+class TraceReader {
+public:
+    TraceReader() : line_number_(0) {}
+
+    /**
+     * @brief Open a trace file
+     * @return Result indicating success or error
+     */
+    Result<void> open(const std::string& path);
+
+    /**
+     * @brief Read the next chunk of records
+     *
+     * @param records Output: replaced with up to max_records records
+     * @param max_records Maximum number of records to read
+     * @return Number of records read (0 at end of trace), or error on a malformed line
+     */
+    Result<size_t> read(std::vector<TraceRecord>& records, size_t max_records);
+
+    /**
+     * @brief Number of lines consumed so far
+     */
+    uint64_t getLineNumber() const { return line_number_; }
+
+    /**
+     * @brief Parse one trace line
+     *
+     * @param line Line text
+     * @param record Output record
+     * @return true if the line held a record, false if it is blank or a comment; error if malformed
+     */
+    static Result<bool> parseLine(const std::string& line, TraceRecord& record);
+
+private:
+    std::ifstream file_;
+    uint64_t line_number_;
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_ANALYSIS_TRACE_READER_H
@@ -0,0 +1,89 @@
+#ifndef MEMSIM_ANALYSIS_TRACE_RING_H
+#define MEMSIM_ANALYSIS_TRACE_RING_H
+
+#include "analysis/trace_reader.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Lock-free single-producer, multi-consumer broadcast ring of trace chunks
+ *
+ * The producer decodes each chunk directly into a ring slot and publishes
+ * it; every consumer reads every chunk in order, in place, and releases it
+ * when done. A slot is reused only after all consumers have released it.
+ *
+ * Synchronization is one atomic head counter written by the producer and
+ * one atomic cursor per consumer (each on its own cache line), so chunks
+ * pass between threads without locks or copies. Waiting sides yield the
+ * processor while spinning.
+ */
+class TraceChunkRing {
+public:
+    /**
+     * @brief Construct a ring
+     *
+     * @param capacity Number of chunk slots (at least 1)
+     * @param num_consumers Number of consumer threads (at least 1)
+     */
+    TraceChunkRing(size_t capacity, size_t num_consumers);
+
+    TraceChunkRing(const TraceChunkRing&) = delete;
+    TraceChunkRing& operator=(const TraceChunkRing&) = delete;
+
+    /**
+     * @brief Producer: wait for a free slot and return it for filling
+     */
+    std::vector<TraceRecord>& acquireWrite();
+
+    /**
+     * @brief Producer: publish the slot returned by acquireWrite()
+     */
+    void commitWrite();
+
+    /**
+     * @brief Producer: signal that no more chunks will be published
+     */
+    void close();
+
+    /**
+     * @brief Consumer: wait for the next chunk
+     *
+     * @param consumer Consumer index in [0, num_consumers)
+     * @return The chunk, or nullptr once the ring is closed and drained
+     */
+    const std::vector<TraceRecord>* acquireRead(size_t consumer);
+
+    /**
+     * @brief Consumer: release the chunk returned by acquireRead()
+     */
+    void releaseRead(size_t consumer);
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cursor {
+        std::atomic<uint64_t> position{0};   // Chunks this consumer has released
+    };
+
+    std::vector<std::vector<TraceRecord>> slots_;
+    std::unique_ptr<Cursor[]> cursors_;
+    size_t num_consumers_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_;   // Chunks published
+    std::atomic<bool> closed_;
+    uint64_t slowest_;   // Producer-only cache of the minimum consumer cursor
+
+    /**
+     * @brief Minimum release position over all consumers
+     */
+    uint64_t minCursor() const;
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_ANALYSIS_TRACE_RING_H
@@ -3,44 +3,192 @@
 
 #include "common/types.h"
 #include "common/result.h"
+#include "common/bit_utils.h"
 #include "cache/cache_level.h"
+#include "cache/prefetcher.h"
 #include "memory/physical_memory.h"
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace memsim {
 
+/**
+ * @brief Configuration of one cache level
+ */
+struct CacheLevelConfig {
+    size_t sets;
+    size_t associativity;
+    size_t block_size;
+    CachePolicy policy;
+};
+
+/**
+ * @brief Access latencies of a cache hierarchy, in cycles
+ *
+ * A read pays the hit latency of every level it probes, down to the one
+ * that holds the block, plus the memory latency if every level misses.
+ */
+struct LatencyConfig {
+    std::vector<uint64_t> hit_cycles;   // hit_cycles[i] = level i + 1
+    uint64_t victim_cycles;             // Victim/miss cache lookup after an L1 miss
+    uint64_t memory_cycles;             // Main memory access
+
+    LatencyConfig() : victim_cycles(0), memory_cycles(0) {}
+};
+
+/**
+ * @brief Power-of-two histogram of access latencies
+ *
+ * Bucket b counts latencies in [2^b, 2^(b+1)); bucket 0 also counts
+ * zero-cycle accesses and the last bucket everything above it.
+ */
+struct LatencyHistogram {
+    static constexpr size_t NUM_BUCKETS = 32;
+
+    std::array<uint64_t, NUM_BUCKETS> buckets;
+    uint64_t count;
+    uint64_t total_cycles;
+    uint64_t max_cycles;
+
+    LatencyHistogram() : buckets{}, count(0), total_cycles(0), max_cycles(0) {}
+
+    void record(uint64_t cycles) {
+        size_t bucket = cycles == 0 ? 0 : floorLog2(cycles);
+        buckets[bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1]++;
+        count++;
+        total_cycles += cycles;
+        if (cycles > max_cycles) max_cycles = cycles;
+    }
+
+    double getAverage() const {
+        if (count == 0) return 0.0;
+        return static_cast<double>(total_cycles) / count;
+    }
+};
+
+/**
+ * @brief Simulated cycles spent on reads and writes
+ */
+struct LatencyStats {
+    LatencyHistogram reads;
+    LatencyHistogram writes;
+
+    /**
+     * @brief Average memory access time over reads and writes, in cycles
+     */
+    double getAMAT() const {
+        uint64_t count = reads.count + writes.count;
+        if (count == 0) return 0.0;
+        return static_cast<double>(reads.total_cycles + writes.total_cycles) / count;
+    }
+
+    /**
+     * @brief Format AMAT, per-type averages and the non-empty histogram buckets
+     */
+    std::string toString() const;
+};
+
 /**
  * @brief Combined statistics for the entire cache hierarchy
+ *
+ * level_stats[i] holds the statistics of level i + 1. l1_stats and
+ * l2_stats mirror the first two levels for two-level callers (l2_stats
+ * is zero in a single-level hierarchy).
  */
 struct HierarchyStats {
+    std::vector<CacheStats> level_stats;
     CacheStats l1_stats;
     CacheStats l2_stats;
+    CacheStats victim_stats;       // Victim/miss cache lookups on L1 read misses (zero if none)
     uint64_t total_accesses;
-    uint64_t memory_accesses;  // Number of times we went to main memory
+    uint64_t memory_accesses;      // Number of times we went to main memory
+    uint64_t back_invalidations;   // Upper-level lines invalidated to keep inclusion
+    LatencyStats latency;          // Cycles of the simulated reads and writes
 
     HierarchyStats()
-        : total_accesses(0), memory_accesses(0) {}
+        : total_accesses(0), memory_accesses(0), back_invalidations(0) {}
 
     double getOverallHitRatio() const {
         if (total_accesses == 0) return 0.0;
-        uint64_t total_hits = l1_stats.hits + l2_stats.hits;
+        uint64_t total_hits = 0;
+        for (const auto& level : level_stats) {
+            total_hits += level.hits;
+        }
+        total_hits += victim_stats.hits;
         return (static_cast<double>(total_hits) / total_accesses) * 100.0;
     }
 };
 
 /**
- * @brief Manages a two-level cache hierarchy (L1 + L2)
+ * @brief Miss ratio of one level extrapolated from a set-sampled simulation
+ */
+struct SampledEstimate {
+    double miss_ratio;    // Estimated miss ratio (percentage)
+    double margin;        // Half-width of the 95% confidence interval (percentage points, < 0 if unknown)
+    uint64_t accesses;    // Accesses extrapolated to the full request stream
+    uint64_t misses;      // Misses extrapolated to the full request stream
+
+    SampledEstimate() : miss_ratio(0.0), margin(-1.0), accesses(0), misses(0) {}
+};
+
+/**
+ * @brief Set-sampling configuration and estimates of a hierarchy
+ *
+ * In exact mode (ratio 1) every estimate is the measured value with a
+ * margin of 0.
+ */
+struct SamplingStats {
+    size_t ratio;                          // One in ratio sets is simulated (1 = exact)
+    SetSamplingMode mode;
+    int sampling_level;                    // Level whose sets are the set groups, 1 = L1 (0 if none)
+    size_t first_index_bit;                // Lowest address bit of the set-index bits every level shares
+    size_t sampled_sets;                   // Simulated set groups
+    size_t total_sets;                     // Set groups: values of the shared set-index bits
+    uint64_t requests;                     // Reads and writes issued to the hierarchy
+    uint64_t simulated_requests;           // Requests that mapped to a simulated set
+    std::vector<SampledEstimate> levels;   // levels[i] = level i + 1
+    SampledEstimate memory;                // Requests that missed every level and went to memory
+
+    SamplingStats()
+        : ratio(1), mode(SetSamplingMode::HASH), sampling_level(1), first_index_bit(0), sampled_sets(0),
+          total_sets(0), requests(0), simulated_requests(0) {}
+};
+
+/**
+ * @brief Manages an N-level cache hierarchy (L1, L2, ..., LLC)
  *
  * Access flow:
  * 1. Check L1 cache
- * 2. On L1 miss, check L2 cache
- * 3. On L2 miss, access main memory
+ * 2. On a miss, check the next level down, stopping at the first hit
+ * 3. If every level misses, access main memory
+ * 4. Fill the block into the upper levels according to the inclusion policy
+ *
+ * The inclusion policy decides which levels a block is filled into and
+ * what a lower-level eviction does to the levels above (see
+ * InclusionPolicy). All levels use write-through policy. Each access
+ * probes a level's set once: the probe taken on a miss is reused for the
+ * fill, and writes update only the levels that already hold the block,
+ * writing memory once.
  *
- * Both L1 and L2 use write-through policy.
+ * Prefetchers, a victim or miss cache between L1 and L2, set sampling and
+ * the latency model are optional and configured through their setters.
  */
 class CacheHierarchy {
 public:
+    /**
+     * @brief Construct a cache hierarchy from per-level configurations
+     *
+     * @param memory Pointer to physical memory
+     * @param levels Level configurations, L1 first (at least one)
+     * @param inclusion Inclusion policy between levels
+     */
+    CacheHierarchy(PhysicalMemory* memory, const std::vector<CacheLevelConfig>& levels,
+                   InclusionPolicy inclusion = InclusionPolicy::NINE);
+
     /**
      * @brief Construct cache hierarchy with L1 and L2
      *
@@ -65,7 +213,7 @@ public:
     /**
      * @brief Read data through cache hierarchy
      *
-     * Checks L1, then L2, then memory on misses.
+     * Checks each level in turn, then memory if all levels miss.
      *
      * @param address Physical address to read
      * @return Result containing data byte, or error
@@ -103,15 +251,40 @@ public:
      */
     void dump() const;
 
+    /**
+     * @brief Get the inclusion policy between levels
+     */
+    InclusionPolicy getInclusionPolicy() const { return inclusion_; }
+
+    /**
+     * @brief Get the number of cache levels
+     */
+    size_t getNumLevels() const { return levels_.size(); }
+
+    /**
+     * @brief Get a cache level (for direct testing)
+     *
+     * @param level Level number, 1 = L1
+     * @return The cache level, or nullptr if the hierarchy has no such level
+     */
+    CacheLevel* getLevel(int level);
+
     /**
      * @brief Get L1 cache (for direct testing)
      */
-    CacheLevel* getL1() { return l1_cache_.get(); }
+    CacheLevel* getL1() { return getLevel(1); }
 
     /**
      * @brief Get L2 cache (for direct testing)
      */
-    CacheLevel* getL2() { return l2_cache_.get(); }
+    CacheLevel* getL2() { return getLevel(2); }
+
+    /**
+     * @brief Check if address is in a cache level
+     *
+     * @param level Level number, 1 = L1 (false if there is no such level)
+     */
+    bool containsInLevel(int level, Address address) const;
 
     /**
      * @brief Check if address is in L1 cache
@@ -123,13 +296,344 @@ public:
      */
     bool containsInL2(Address address) const;
 
+    /**
+     * @brief Attach a prefetcher to a cache level, replacing any existing one
+     *
+     * The prefetcher is trained on the level's demand reads. Its requests
+     * fill the level `latency` hierarchy reads after they are issued; a
+     * demand miss on a block whose prefetch is still in flight counts as a
+     * late prefetch. Prefetch fills are not counted as memory accesses.
+     *
+     * @param level Level number, 1 = L1
+     * @param prefetcher Prefetcher to attach (nullptr detaches)
+     * @param latency Reads between issuing a prefetch and its fill (0 = immediate)
+     * @return Result indicating success or error
+     */
+    Result<void> setPrefetcher(int level, std::unique_ptr<IPrefetcher> prefetcher,
+                               uint64_t latency = 0);
+
+    /**
+     * @brief Get the prefetcher attached to a level (nullptr if none)
+     */
+    const IPrefetcher* getPrefetcher(int level) const;
+
+    /**
+     * @brief Attach a fully-associative victim or miss cache between L1 and L2
+     *
+     * The buffer is looked up on every L1 read miss. A victim cache
+     * receives the lines L1 evicts, and a hit swaps the line back into L1,
+     * so it never holds a block L1 has; under EXCLUSIVE it is part of the
+     * victim chain and its own victims move on to L2. A miss cache receives
+     * a copy of every block fetched on an L1 miss, and a hit reloads L1 and
+     * keeps the copy; it is not available under EXCLUSIVE. Under INCLUSIVE
+     * a lower-level eviction also back-invalidates the buffer.
+     *
+     * The buffer uses L1's block size and LRU replacement. Replacing it
+     * discards its contents and statistics.
+     *
+     * @param entries Number of lines (0 removes the buffer)
+     * @param mode Victim cache or miss cache
+     * @return Result indicating success or error
+     */
+    Result<void> setVictimCache(size_t entries, VictimCacheMode mode = VictimCacheMode::VICTIM);
+
+    /**
+     * @brief Get the victim/miss cache (nullptr if none is attached)
+     */
+    const CacheLevel* getVictimCache() const { return victim_.get(); }
+
+    /**
+     * @brief Get the mode of the attached victim/miss cache
+     */
+    VictimCacheMode getVictimCacheMode() const { return victim_mode_; }
+
+    /**
+     * @brief Check if address is in the victim/miss cache (false if none)
+     */
+    bool containsInVictimCache(Address address) const;
+
+    /**
+     * @brief Enable or disable 3C miss classification on every level
+     *
+     * See CacheLevel::setMissClassification.
+     */
+    void setMissClassification(bool enable);
+
+    /**
+     * @brief Simulate only a fraction of the sets and extrapolate the rest
+     *
+     * Requests are grouped by the set-index bits every level shares (above
+     * the largest block offset, below the smallest index end); with equal
+     * block sizes the groups are the sets of the level with the fewest
+     * sets. Only one group in ratio is simulated and the others go straight
+     * to memory. Each group is made of whole sets of every level, so
+     * per-level miss ratios are estimated without bias, and each sampled
+     * group is one cluster of a ratio estimator, which gives the 95%
+     * confidence interval. Prefetchers and the victim cache only observe
+     * the sampled stream. Levels with no index bits in common cannot be
+     * sampled.
+     *
+     * The caches are flushed, since writes to skipped groups bypass them,
+     * and the sampling counters restart; level statistics keep counting but
+     * from then on only cover the simulated sets.
+     *
+     * @param ratio Simulate one set group in ratio (1 returns to exact simulation)
+     * @param mode Pick every ratio-th set, or sets by a hash of their index
+     * @return Result indicating success or error
+     */
+    Result<void> setSetSampling(size_t ratio, SetSamplingMode mode = SetSamplingMode::HASH);
+
+    /**
+     * @brief Get the set-sampling ratio (1 = exact simulation)
+     */
+    size_t getSamplingRatio() const { return sampling_ratio_; }
+
+    /**
+     * @brief Get the sampling configuration and extrapolated statistics
+     */
+    SamplingStats getSamplingStats() const;
+
+    /**
+     * @brief Set the latencies charged to each access
+     *
+     * Every simulated access is charged cycles as described at
+     * LatencyConfig, accumulated per access type into AMAT and a latency
+     * histogram. A write pays the levels probed down to the first one
+     * holding the block, or memory if none does (no write-allocate); the
+     * write-through traffic itself is assumed to drain through a write
+     * buffer. A new hierarchy uses defaultLatencies().
+     *
+     * @param latencies One hit latency per level, victim cache and memory latencies
+     * @return Result indicating success or error
+     */
+    Result<void> setLatencies(const LatencyConfig& latencies);
+
+    /**
+     * @brief Get the latencies charged to each access
+     */
+    const LatencyConfig& getLatencies() const { return latencies_; }
+
+    /**
+     * @brief Get the cycles charged to the last read or write (0 if set sampling skipped it)
+     */
+    uint64_t getLastAccessCycles() const { return last_access_cycles_; }
+
+    /**
+     * @brief Default latencies of a hierarchy with the given number of levels
+     */
+    static LatencyConfig defaultLatencies(size_t num_levels);
+
+    static constexpr uint64_t DEFAULT_L1_CYCLES = 4;
+    static constexpr uint64_t DEFAULT_LEVEL_CYCLES_FACTOR = 3;   // Each level is this much slower than the one above
+    static constexpr uint64_t DEFAULT_VICTIM_CYCLES = 1;
+    static constexpr uint64_t DEFAULT_MEMORY_CYCLES = 200;
+
 private:
+    /**
+     * @brief Prefetcher attached to one level plus its outstanding requests
+     */
+    struct PrefetchSlot {
+        struct InFlight {
+            Address block_address;
+            uint64_t ready_time;
+        };
+
+        std::unique_ptr<IPrefetcher> prefetcher;
+        uint64_t latency;
+        std::deque<InFlight> in_flight;   // Ordered by ready_time
+        uint64_t issued;
+        uint64_t late;
+
+        PrefetchSlot() : latency(0), issued(0), late(0) {}
+    };
+
+    /**
+     * @brief Access and miss counters of one level within one sampled set group
+     */
+    struct SampleCounts {
+        uint64_t accesses;
+        uint64_t misses;
+    };
+
+    static constexpr size_t NOT_SAMPLED = SIZE_MAX;
+
     PhysicalMemory* memory_;
-    std::unique_ptr<CacheLevel> l1_cache_;
-    std::unique_ptr<CacheLevel> l2_cache_;
+    std::vector<std::unique_ptr<CacheLevel>> levels_;  // levels_[0] = L1
+    std::vector<PrefetchSlot> prefetch_slots_;         // One per level
+    std::unique_ptr<CacheLevel> victim_;               // Optional buffer between L1 and L2
+    VictimCacheMode victim_mode_;
+    InclusionPolicy inclusion_;
     uint64_t memory_access_count_;
+    uint64_t back_invalidation_count_;
+
+    uint64_t read_clock_;              // Hierarchy reads, the prefetch latency time base
+    std::vector<Address> candidates_;  // Scratch buffer for prefetch candidates
+    std::vector<CacheProbe> probes_;   // Scratch buffer: one probe per level visited by a read
+
+    uint64_t request_count_;                     // Reads and writes, sampled or not
+    size_t sampling_ratio_;                      // 1 = exact simulation
+    SetSamplingMode sampling_mode_;
+    int sampling_level_;                         // Level whose sets are the set groups (0 if none)
+    size_t sample_shift_;                        // Lowest shared set-index bit
+    size_t sample_groups_;                       // Values of the shared set-index bits
+    size_t sampled_sets_;                        // Simulated set groups
+    std::vector<size_t> sample_cluster_;         // Set group -> cluster index, NOT_SAMPLED if skipped
+    std::vector<SampleCounts> cluster_counts_;   // [cluster * (levels + 1) + level]; last slot: requests/memory accesses
+    std::vector<SampleCounts> sample_before_;    // Scratch: counters before the current sampled access
+
+    LatencyConfig latencies_;
+    LatencyStats latency_stats_;
+    uint64_t last_access_cycles_;
+
+    /**
+     * @brief Read through the caches (the whole hierarchy or one sampled set group)
+     */
+    Result<uint8_t> simulateRead(Address address);
+
+    /**
+     * @brief Write through the caches (the whole hierarchy or one sampled set group)
+     */
+    Result<void> simulateWrite(Address address, uint8_t data);
+
+    /**
+     * @brief Cycles of an access served by a level (levels_.size() = memory)
+     *
+     * @param hit_level Level index that held the block (0 for a victim/miss cache hit)
+     * @param victim_probed Whether the victim/miss cache was looked up after an L1 miss
+     */
+    uint64_t accessCycles(size_t hit_level, bool victim_probed) const;
+
+    /**
+     * @brief Charge an access's cycles to the latency statistics
+     */
+    void recordLatency(bool is_write, uint64_t cycles);
+
+    /**
+     * @brief Get the cluster of an address under set sampling (NOT_SAMPLED if skipped)
+     */
+    size_t sampleCluster(Address address) const;
+
+    /**
+     * @brief Snapshot the counters that a sampled access is about to change
+     */
+    void beginSample();
+
+    /**
+     * @brief Add the counter changes of the current access to its cluster
+     */
+    void endSample(size_t cluster);
+
+    /**
+     * @brief Ratio estimate and 95% margin of one counter slot across the clusters
+     *
+     * @param slot Slot within each cluster (a level index, or levels_.size() for memory)
+     * @param scale Requests per simulated request, used to extrapolate the counts
+     */
+    SampledEstimate estimateSlot(size_t slot, double scale) const;
+
+    /**
+     * @brief Hash a set index for HASH sampling
+     */
+    static uint64_t hashSetIndex(size_t set);
+
+    /**
+     * @brief Fill a block into a level, handling its victim per the inclusion policy
+     *
+     * @param level Level index (0 = L1)
+     * @param address Any address within the block
+     * @param prefetched Whether this is a prefetch fill
+     */
+    void install(size_t level, Address address, bool prefetched);
+
+    /**
+     * @brief Fill a block into a level using a probe taken on this access
+     *
+     * @param probe The level's probe of the address, updated to the filled line
+     */
+    void install(size_t level, CacheProbe& probe, Address address, bool prefetched = false);
+
+    /**
+     * @brief Invalidate a lower-level victim from every level above it
+     *
+     * @param level Level index the block was evicted from
+     * @param block_address Block-aligned address of the evicted line
+     */
+    void backInvalidate(size_t level, Address block_address);
+
+    /**
+     * @brief Install a completed prefetch into a level
+     */
+    void installPrefetch(size_t level, Address block_address);
+
+    /**
+     * @brief Install prefetches whose latency has elapsed
+     */
+    void completePrefetches(size_t level);
+
+    /**
+     * @brief Account a demand miss against an in-flight prefetch of the same block
+     */
+    void checkLatePrefetch(PrefetchSlot& slot, Address block_address);
+
+    /**
+     * @brief Train a level's prefetcher on a demand read and issue its requests
+     *
+     * @param level Level index (0 = L1)
+     * @param hit Whether the read hit in the level
+     * @param prefetch_hit Whether the hit was the first use of a prefetched line
+     */
+    void trainPrefetcher(size_t level, Address address, bool hit, bool prefetch_hit);
+
+    /**
+     * @brief Check that a level number names an existing level
+     */
+    bool isValidLevel(int level) const;
 };
 
+/**
+ * @brief Helper function to convert VictimCacheMode to string
+ */
+inline std::string victimCacheModeToString(VictimCacheMode mode) {
+    switch (mode) {
+        case VictimCacheMode::VICTIM: return "Victim Cache";
+        case VictimCacheMode::MISS: return "Miss Cache";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief Helper function to convert SetSamplingMode to string
+ */
+inline std::string setSamplingModeToString(SetSamplingMode mode) {
+    switch (mode) {
+        case SetSamplingMode::STRIDE: return "Stride";
+        case SetSamplingMode::HASH: return "Hash";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief Describe the set groups a sampling configuration picks from
+ */
+inline std::string samplingGroupName(const SamplingStats& sampling) {
+    if (sampling.sampling_level > 0) {
+        return "L" + std::to_string(sampling.sampling_level) + " sets";
+    }
+    return "set groups (address bits from " + std::to_string(sampling.first_index_bit) + ")";
+}
+
+/**
+ * @brief Helper function to convert InclusionPolicy to string
+ */
+inline std::string inclusionPolicyToString(InclusionPolicy policy) {
+    switch (policy) {
+        case InclusionPolicy::NINE: return "Non-Inclusive Non-Exclusive";
+        case InclusionPolicy::INCLUSIVE: return "Inclusive";
+        case InclusionPolicy::EXCLUSIVE: return "Exclusive";
+        default: return "Unknown";
+    }
+}
+
 } // namespace memsim
 
 #endif // MEMSIM_CACHE_CACHE_HIERARCHY_H
@@ -4,9 +4,13 @@
 #include "common/types.h"
 #include "common/result.h"
 #include "cache/cache_line.h"
+#include "cache/frequency_buckets.h"
+#include "cache/miss_classifier.h"
+#include "cache/prefetcher.h"
 #include "memory/physical_memory.h"
 #include <vector>
 #include <string>
+#include <memory>
 #include <cstdint>
 
 namespace memsim {
@@ -18,8 +22,16 @@ struct CacheStats {
     uint64_t hits;
     uint64_t misses;
     uint64_t accesses;
+    PrefetchStats prefetch;    // Prefetch fills are not counted as accesses
 
-    CacheStats() : hits(0), misses(0), accesses(0) {}
+    // 3C breakdown of misses (only counted while miss classification is enabled)
+    uint64_t compulsory_misses;
+    uint64_t capacity_misses;
+    uint64_t conflict_misses;
+
+    CacheStats()
+        : hits(0), misses(0), accesses(0),
+          compulsory_misses(0), capacity_misses(0), conflict_misses(0) {}
 
     double getHitRatio() const {
         if (accesses == 0) return 0.0;
@@ -33,10 +45,41 @@ struct CacheStats {
 };
 
 /**
- * @brief Represents a single level of cache (L1 or L2)
+ * @brief Handle returned by a single set scan (CacheLevel::probe/peek)
+ *
+ * On a hit, way is the matching line. On a miss, way is the first invalid
+ * way seen during the scan (NO_WAY if the set was full), so a following
+ * fill() does not need to scan the set again.
+ */
+struct CacheProbe {
+    bool hit;
+    bool prefetch_hit;     // Hit was the first demand use of a prefetched line
+    size_t set_index;
+    size_t way;
+    Address tag;
+    size_t offset;
+
+    static constexpr size_t NO_WAY = SIZE_MAX;
+
+    CacheProbe()
+        : hit(false), prefetch_hit(false), set_index(0), way(NO_WAY), tag(0), offset(0) {}
+};
+
+/**
+ * @brief A line displaced by CacheLevel::fill()
+ */
+struct CacheEviction {
+    bool valid;               // Whether a valid line was evicted
+    Address block_address;    // Block-aligned address of the evicted line
+
+    CacheEviction() : valid(false), block_address(0) {}
+};
+
+/**
+ * @brief Represents a single level of a cache hierarchy
  *
- * Supports direct-mapped and N-way set-associative caches
- * with FIFO, LRU, and LFU replacement policies.
+ * Supports direct-mapped and N-way set-associative caches with the
+ * replacement policies of CachePolicy.
  *
  * Address breakdown:
  * | Tag | Set Index | Block Offset |
@@ -46,12 +89,14 @@ public:
     /**
      * @brief Construct a cache level
      *
-     * @param level Cache level (1 for L1, 2 for L2)
+     * @param level Cache level (1 for L1, 2 for L2, ...)
      * @param num_sets Number of sets in the cache
      * @param associativity Number of lines per set (1 = direct-mapped)
      * @param block_size Size of each cache line in bytes
-     * @param policy Replacement policy (FIFO, LRU, LFU)
+     * @param policy Replacement policy (FIFO, LRU, LFU variants, PLRU, RRIP variants)
      * @param memory Pointer to physical memory (for fetching on miss)
+     * @throws std::invalid_argument if a parameter is invalid, or DRRIP has
+     *         fewer than DRRIP_MIN_SETS sets (no follower sets)
      */
     CacheLevel(int level,
                size_t num_sets,
@@ -91,6 +136,113 @@ public:
      */
     bool contains(Address address) const;
 
+    /**
+     * @brief Look up an address for a demand read, without allocating on a miss
+     *
+     * Scans the set once, counts the access as a hit or miss and updates
+     * replacement state on a hit. The cache is unchanged on a miss so the
+     * caller decides whether and where the block is filled.
+     *
+     * @param address Physical address to look up
+     * @return Probe handle for readData()/writeData() on a hit or fill() on a miss
+     */
+    CacheProbe probe(Address address);
+
+    /**
+     * @brief Look up an address for a write under no-write-allocate
+     *
+     * Like probe(), but a miss is not counted (the write goes to memory only).
+     */
+    CacheProbe probeForWrite(Address address);
+
+    /**
+     * @brief Scan for an address without updating stats or replacement state
+     */
+    CacheProbe peek(Address address) const;
+
+    /**
+     * @brief Get the byte addressed by a hit probe
+     */
+    uint8_t readData(const CacheProbe& probe) const;
+
+    /**
+     * @brief Store a byte in the line of a hit probe (cache only, no memory write)
+     */
+    void writeData(const CacheProbe& probe, uint8_t data);
+
+    /**
+     * @brief Install the block of a missed probe without counting an access
+     *
+     * Uses the invalid way found by the probe, or a victim chosen by the
+     * replacement policy, and loads the block from memory. On return the
+     * probe refers to the new line (hit = true). Does nothing for a hit probe.
+     *
+     * @param probe Probe from probe()/peek() of the same address
+     * @param address Any address within the block to install
+     * @param prefetched Mark the new line as prefetched (see prefetch())
+     * @return The valid line that was displaced, if any
+     */
+    CacheEviction fill(CacheProbe& probe, Address address, bool prefetched = false);
+
+    /**
+     * @brief Install a block without counting an access (scans the set first)
+     *
+     * Does nothing if the block is already cached.
+     *
+     * @param address Any address within the block to install
+     * @param prefetched Mark the new line as prefetched (see prefetch())
+     * @return The valid line that was displaced, if any
+     */
+    CacheEviction fill(Address address, bool prefetched = false);
+
+    /**
+     * @brief Invalidate the line of a hit probe
+     */
+    void invalidate(const CacheProbe& probe);
+
+    /**
+     * @brief Invalidate the line holding an address, if present
+     *
+     * @param address Any address within the block
+     * @return true if a line was invalidated
+     */
+    bool invalidate(Address address);
+
+    /**
+     * @brief Install a block ahead of demand (prefetch fill)
+     *
+     * Does nothing if the block is already cached. Otherwise a victim is
+     * replaced as for a miss and the new line is marked as prefetched, so a
+     * later demand hit counts as useful and an eviction before any use
+     * counts as polluting. Hit/miss/access counters are not changed.
+     *
+     * @param address Any address within the block to install
+     * @return true if the block was installed, false if already present
+     */
+    bool prefetch(Address address);
+
+    /**
+     * @brief Get the block size in bytes
+     */
+    size_t getBlockSize() const { return block_size_; }
+
+    /**
+     * @brief Get the number of sets
+     */
+    size_t getNumSets() const { return num_sets_; }
+
+    /**
+     * @brief Get the set an address maps to
+     */
+    size_t getSetIndex(Address address) const {
+        return static_cast<size_t>((address >> offset_bits_) & ((1ULL << index_bits_) - 1));
+    }
+
+    /**
+     * @brief Get number of ways per set
+     */
+    size_t getAssociativity() const { return associativity_; }
+
     /**
      * @brief Invalidate all cache lines
      */
@@ -116,6 +268,49 @@ public:
      */
     std::string getConfigString() const;
 
+    /**
+     * @brief Get the DRRIP policy selector counter
+     *
+     * Values above PSEL_MAX / 2 make follower sets use BRRIP insertion.
+     */
+    uint32_t getPsel() const { return psel_; }
+
+    /**
+     * @brief Set how often LFU access counts are halved
+     *
+     * @param accesses Number of accesses between agings (0 disables aging)
+     */
+    void setLfuAgingInterval(uint64_t accesses) { lfu_aging_interval_ = accesses; }
+
+    /**
+     * @brief Get the LFU aging interval in accesses (0 = disabled)
+     */
+    uint64_t getLfuAgingInterval() const { return lfu_aging_interval_; }
+
+    /**
+     * @brief Enable or disable 3C classification of misses
+     *
+     * While enabled, every counted miss is classified as compulsory,
+     * capacity or conflict (see MissClassifier). Enabling starts from an
+     * empty history and zeroes the 3C counters, so it should happen before
+     * the workload runs. flush() empties the shadow cache but keeps the
+     * record of blocks already referenced.
+     */
+    void setMissClassification(bool enable);
+
+    /**
+     * @brief Check whether misses are being classified
+     */
+    bool isMissClassificationEnabled() const { return classifier_ != nullptr; }
+
+    static constexpr uint64_t LFU_AGING_LINES_FACTOR = 16;  // Default interval = 16 x total lines
+
+    static constexpr uint8_t RRPV_MAX = 3;          // 2-bit RRPV ("distant" re-reference)
+    static constexpr uint32_t PSEL_MAX = 1023;      // 10-bit saturating counter
+    static constexpr size_t DRRIP_MAX_LEADER_SETS = 32;  // Leader sets per dueling policy
+    static constexpr size_t DRRIP_MIN_SETS = 4;     // Two leaders and at least two followers
+    static constexpr uint32_t BRRIP_LONG_INTERVAL = 32;  // BRRIP inserts at RRPV_MAX-1 once per 32 fills
+
 private:
     int level_;                    // Cache level (1 or 2)
     size_t num_sets_;              // Number of sets
@@ -126,9 +321,28 @@ private:
 
     // Cache storage: sets[set_index][way] = CacheLine
     std::vector<std::vector<CacheLine>> sets_;
+    std::vector<size_t> valid_lines_;  // Valid lines per set (fill skips the invalid-way scan when full)
+
+    // Pseudo-LRU state, one word per set (TREE_PLRU / BIT_PLRU only)
+    // Tree-PLRU: bit n is internal node n of a heap-ordered tree (root = 1),
+    //            0 = victim is in the left subtree, 1 = right subtree
+    // Bit-PLRU:  bit w is the MRU bit of way w
+    std::vector<uint64_t> plru_bits_;
+
+    // RRIP state
+    uint32_t psel_;                // DRRIP policy selector (set dueling)
+    uint64_t brrip_fill_count_;    // Drives BRRIP's infrequent long-interval insertion
+    size_t dueling_stride_;        // DRRIP leader sets: set % stride == 0 (SRRIP), == stride / 2 (BRRIP)
+
+    // LFU state (LFU / LFU_DA only)
+    std::vector<FrequencyBuckets> lfu_buckets_;  // Per-set frequency ordering
+    std::vector<uint64_t> lfu_age_;              // LFU-DA: per-set cache age L
+    uint64_t lfu_aging_interval_;                // LFU: accesses between halvings (0 = off)
+    uint64_t lfu_accesses_since_aging_;
 
     // Statistics
     CacheStats stats_;
+    std::unique_ptr<MissClassifier> classifier_;  // 3C tracker (nullptr = off)
     uint64_t global_time_;         // For LRU timestamps
 
     // Address parsing bit counts
@@ -141,21 +355,75 @@ private:
     void parseAddress(Address address, Address& tag, size_t& set_index, size_t& offset) const;
 
     /**
-     * @brief Find line in set matching tag
+     * @brief Rebuild the block-aligned address of a line from its tag and set
+     */
+    Address makeBlockAddress(Address tag, size_t set_index) const;
+
+    /**
+     * @brief Count an access and update replacement state for a probe
      *
-     * @return Pointer to line if found, nullptr otherwise
+     * @param count_miss Whether a miss is counted (false for write probes)
+     */
+    void recordProbe(CacheProbe& probe, bool count_miss);
+
+    /**
+     * @brief Classify a counted miss and bump its 3C counter
      */
-    CacheLine* findLine(size_t set_index, Address tag);
+    void classifyMiss(Address block_address);
 
     /**
      * @brief Select victim line for replacement
      *
-     * Uses the configured replacement policy (FIFO, LRU, LFU).
+     * Prefers an invalid line, otherwise uses the configured replacement
+     * policy (FIFO, LRU, LFU, PLRU, RRIP).
      *
      * @return Index of victim line in the set
      */
     size_t selectVictim(size_t set_index);
 
+    /**
+     * @brief Select a victim among the lines of a full set by replacement policy
+     */
+    size_t selectPolicyVictim(size_t set_index);
+
+    /**
+     * @brief Update per-set replacement state after a hit or fill
+     *
+     * Only the pseudo-LRU policies keep per-set state; the timestamp
+     * based policies are updated through CacheLine::recordAccess().
+     *
+     * @param set_index Set that was accessed
+     * @param way_index Way within the set that was accessed
+     */
+    void updateReplacementState(size_t set_index, size_t way_index);
+
+    /**
+     * @brief Initialize replacement state for a freshly loaded line
+     *
+     * RRIP policies pick the insertion RRPV here (DRRIP followers by
+     * PSEL); other policies treat the fill like an access. Fills also
+     * come from prefetches and victim installs, so PSEL is trained on
+     * demand misses in recordProbe() instead.
+     */
+    void updateInsertionState(size_t set_index, size_t way_index);
+
+    /**
+     * @brief Get a set's DRRIP role
+     *
+     * @return 0 for an SRRIP leader, 1 for a BRRIP leader, 2 for a follower
+     */
+    int duelingRole(size_t set_index) const;
+
+    /**
+     * @brief Check if the configured policy is one of the RRIP variants
+     */
+    bool isRripPolicy() const;
+
+    /**
+     * @brief Count an access towards periodic LFU aging, halving all counts when due
+     */
+    void tickLfuAging();
+
     /**
      * @brief Load block from memory into cache
      *
@@ -177,6 +445,24 @@ private:
     static bool isPowerOfTwo(size_t value);
 };
 
+/**
+ * @brief Helper function to convert CachePolicy to string
+ */
+inline std::string cachePolicyToString(CachePolicy policy) {
+    switch (policy) {
+        case CachePolicy::FIFO: return "FIFO";
+        case CachePolicy::LRU: return "LRU";
+        case CachePolicy::LFU: return "LFU";
+        case CachePolicy::LFU_DA: return "LFU-DA";
+        case CachePolicy::TREE_PLRU: return "Tree-PLRU";
+        case CachePolicy::BIT_PLRU: return "Bit-PLRU";
+        case CachePolicy::SRRIP: return "SRRIP";
+        case CachePolicy::BRRIP: return "BRRIP";
+        case CachePolicy::DRRIP: return "DRRIP";
+        default: return "Unknown";
+    }
+}
+
 } // namespace memsim
 
 #endif // MEMSIM_CACHE_CACHE_LEVEL_H
@@ -11,7 +11,7 @@ namespace memsim {
  * @brief Represents a single line in a cache
  *
  * A cache line stores a block of data from memory along with metadata
- * for replacement policies (FIFO, LRU, LFU).
+ * for replacement policies (FIFO, LRU, LFU, RRIP).
  */
 struct CacheLine {
     bool valid;              // Valid bit (is this line occupied?)
@@ -22,6 +22,8 @@ struct CacheLine {
     uint64_t insertion_order;  // For FIFO (lower = older)
     uint64_t last_access_time; // For LRU (lower = older)
     uint64_t access_count;     // For LFU (lower = less frequently used)
+    uint8_t rrpv;              // For RRIP (re-reference prediction value, higher = sooner evicted)
+    bool prefetched;           // Filled by a prefetch and not yet used by a demand access
 
     /**
      * @brief Construct an invalid cache line
@@ -32,7 +34,9 @@ struct CacheLine {
           data(block_size, 0),
           insertion_order(0),
           last_access_time(0),
-          access_count(0) {}
+          access_count(0),
+          rrpv(0),
+          prefetched(false) {}
 
     /**
      * @brief Reset the cache line to invalid state
@@ -43,6 +47,8 @@ struct CacheLine {
         insertion_order = 0;
         last_access_time = 0;
         access_count = 0;
+        rrpv = 0;
+        prefetched = false;
     }
 
     /**
@@ -0,0 +1,138 @@
+#ifndef MEMSIM_CACHE_FREQUENCY_BUCKETS_H
+#define MEMSIM_CACHE_FREQUENCY_BUCKETS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Frequency-bucket ordering of the ways of one cache set (for LFU)
+ *
+ * Ways are grouped into buckets of equal key (access frequency, or the
+ * dynamic-aging priority for LFU-DA). Buckets form a doubly-linked list in
+ * ascending key order and each bucket keeps its ways in a doubly-linked
+ * list ordered by insertion, so:
+ * - the victim (lowest key, least recently promoted) is found in O(1)
+ * - incrementing a key by one moves the way to the neighbour bucket in O(1)
+ *
+ * All links are indices into fixed pools sized by the number of ways, so
+ * no allocation happens after construction.
+ */
+class FrequencyBuckets {
+public:
+    /**
+     * @brief Construct an empty bucket list for a set
+     * @param num_ways Number of ways in the set
+     */
+    explicit FrequencyBuckets(size_t num_ways);
+
+    /**
+     * @brief Add a way with the given key (way must not be present)
+     */
+    void insert(size_t way, uint64_t key);
+
+    /**
+     * @brief Remove a way (no-op if not present)
+     */
+    void remove(size_t way);
+
+    /**
+     * @brief Increase a way's key by one
+     */
+    void increment(size_t way);
+
+    /**
+     * @brief Raise a way's key to new_key (new_key >= current key)
+     *
+     * Walks forward over the buckets between the old and new key.
+     */
+    void promote(size_t way, uint64_t new_key);
+
+    /**
+     * @brief Halve every key, merging buckets that collapse together
+     *
+     * O(num_ways); used for periodic LFU aging.
+     */
+    void age();
+
+    /**
+     * @brief Get the way with the lowest key (oldest among ties)
+     * @return Way index (list must not be empty)
+     */
+    size_t victim() const;
+
+    /**
+     * @brief Get the key of a present way
+     */
+    uint64_t getKey(size_t way) const;
+
+    /**
+     * @brief Check if a way is present
+     */
+    bool contains(size_t way) const;
+
+    /**
+     * @brief Check if no ways are present
+     */
+    bool empty() const { return head_ == NIL; }
+
+    /**
+     * @brief Remove all ways
+     */
+    void clear();
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Bucket {
+        uint64_t key;
+        uint32_t first_way;    // Oldest way in this bucket
+        uint32_t last_way;     // Newest way in this bucket
+        uint32_t prev;         // Bucket with next-lower key
+        uint32_t next;         // Bucket with next-higher key
+    };
+
+    struct Node {
+        uint32_t bucket;       // Owning bucket, NIL if not present
+        uint32_t prev;         // Older way in the same bucket
+        uint32_t next;         // Newer way in the same bucket
+    };
+
+    std::vector<Bucket> buckets_;          // Bucket pool (at most one per way)
+    std::vector<uint32_t> free_buckets_;   // Unused bucket indices
+    std::vector<Node> nodes_;              // One node per way
+    uint32_t head_;                        // Lowest-key bucket
+
+    /**
+     * @brief Unlink a way from its bucket, releasing the bucket if it empties
+     * @return Bucket to resume a forward search from (key <= old key), or NIL
+     */
+    uint32_t detach(uint32_t way);
+
+    /**
+     * @brief Link a way into the bucket for key, searching forward from start
+     * @param start Bucket with key <= key to start from, or NIL for the head
+     */
+    void attach(uint32_t way, uint64_t key, uint32_t start);
+
+    /**
+     * @brief Append a way at the tail of a bucket
+     */
+    void appendToBucket(uint32_t bucket, uint32_t way);
+
+    /**
+     * @brief Take a bucket from the pool and link it after prev (NIL = at head)
+     */
+    uint32_t createBucketAfter(uint32_t prev, uint64_t key);
+
+    /**
+     * @brief Unlink an empty bucket and return it to the pool
+     */
+    void releaseBucket(uint32_t bucket);
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_CACHE_FREQUENCY_BUCKETS_H
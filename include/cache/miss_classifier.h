@@ -0,0 +1,119 @@
+#ifndef MEMSIM_CACHE_MISS_CLASSIFIER_H
+#define MEMSIM_CACHE_MISS_CLASSIFIER_H
+
+#include "common/types.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief The "3C" cause of a cache miss
+ */
+enum class MissType {
+    COMPULSORY,   // First reference to the block
+    CAPACITY,     // A fully-associative LRU cache of equal size would also miss
+    CONFLICT      // Only the set mapping caused the miss
+};
+
+/**
+ * @brief Classifies the misses of one cache level into compulsory, capacity
+ *        and conflict misses
+ *
+ * Keeps two structures alongside the real cache, both fed with the same
+ * demand accesses:
+ * - a set of every block ever referenced (open addressing, one word per
+ *   block), which identifies compulsory misses
+ * - a fully-associative LRU shadow cache with as many lines as the real
+ *   cache; a miss it shares is a capacity miss, any other miss a conflict
+ *   miss
+ *
+ * The shadow's LRU list is index-linked over a fixed pool, so every access
+ * is O(1) expected.
+ */
+class MissClassifier {
+public:
+    /**
+     * @brief Construct a classifier for a cache of the given size
+     * @param capacity_lines Total lines in the real cache (sets x ways)
+     */
+    explicit MissClassifier(size_t capacity_lines);
+
+    /**
+     * @brief Record a demand hit in the real cache
+     * @param block Block-aligned address
+     */
+    void recordHit(Address block);
+
+    /**
+     * @brief Record and classify a demand miss in the real cache
+     * @param block Block-aligned address
+     */
+    MissType recordMiss(Address block);
+
+    /**
+     * @brief Empty the shadow cache (the set of seen blocks is kept)
+     */
+    void flush();
+
+    /**
+     * @brief Number of distinct blocks referenced so far
+     */
+    size_t getSeenBlocks() const { return seen_count_; }
+
+private:
+    static constexpr size_t NIL = SIZE_MAX;
+    static constexpr size_t INITIAL_SEEN_SLOTS = 1024;   // Power of two
+
+    // Shadow fully-associative LRU cache
+    size_t capacity_;
+    std::vector<Address> shadow_block_;
+    std::vector<size_t> shadow_prev_;      // Towards MRU
+    std::vector<size_t> shadow_next_;      // Towards LRU
+    size_t shadow_mru_;
+    size_t shadow_lru_;
+    size_t shadow_size_;
+    std::unordered_map<Address, size_t> shadow_index_;  // block -> pool slot
+
+    // Seen blocks: open addressing with linear probing, 0 = empty slot,
+    // entries stored as block + 1 so block 0 is representable
+    std::vector<Address> seen_;
+    size_t seen_count_;
+
+    /**
+     * @brief Access the shadow cache, moving or inserting the block at MRU
+     * @return true if the block was present
+     */
+    bool accessShadow(Address block);
+
+    void unlinkShadow(size_t slot);
+    void pushShadowMru(size_t slot);
+
+    /**
+     * @brief Add a block to the seen set
+     * @return true if the block had not been seen before
+     */
+    bool markSeen(Address block);
+
+    void growSeen();
+    size_t seenSlot(Address key) const;
+};
+
+/**
+ * @brief Helper function to convert MissType to string
+ */
+inline std::string missTypeToString(MissType type) {
+    switch (type) {
+        case MissType::COMPULSORY: return "Compulsory";
+        case MissType::CAPACITY: return "Capacity";
+        case MissType::CONFLICT: return "Conflict";
+        default: return "Unknown";
+    }
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_CACHE_MISS_CLASSIFIER_H
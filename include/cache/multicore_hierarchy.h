@@ -0,0 +1,313 @@
+#ifndef MEMSIM_CACHE_MULTICORE_HIERARCHY_H
+#define MEMSIM_CACHE_MULTICORE_HIERARCHY_H
+
+#include "common/types.h"
+#include "common/result.h"
+#include "cache/cache_hierarchy.h"
+#include "cache/cache_level.h"
+#include "memory/physical_memory.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Coherence state of one core's copy of a block
+ */
+enum class CoherenceState {
+    INVALID,
+    SHARED,      // Clean, possibly held by other cores
+    EXCLUSIVE,   // Clean, held by this core only
+    OWNED,       // Dirty, shared; this core answers requests for it (MOESI only)
+    MODIFIED     // Dirty, held by this core only
+};
+
+/**
+ * @brief Coherence traffic of a multi-core hierarchy
+ */
+struct CoherenceStats {
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t invalidations;          // L1 copies invalidated by another core's write
+    uint64_t interventions;          // Misses served from another core's L1
+    uint64_t upgrades;               // Writes to a shared copy that had to gain ownership
+    uint64_t writebacks;             // Dirty lines written back (evicted, flushed, or downgraded under MESI)
+    uint64_t coherence_misses;       // Misses on a block this core lost to another core's write
+    uint64_t false_sharing_misses;   // Coherence misses on bytes no other core wrote since
+    uint64_t memory_accesses;        // Reads served by main memory
+
+    CoherenceStats()
+        : reads(0), writes(0), invalidations(0), interventions(0), upgrades(0),
+          writebacks(0), coherence_misses(0), false_sharing_misses(0), memory_accesses(0) {}
+};
+
+/**
+ * @brief Bytes of one line written by one core
+ */
+struct LineWriter {
+    size_t core;
+    size_t first_byte;       // Lowest offset written
+    size_t last_byte;        // Highest offset written
+    size_t bytes_written;    // Distinct bytes written
+};
+
+/**
+ * @brief A line that suffered coherence traffic its cores did not need
+ */
+struct FalseSharingLine {
+    Address block_address;
+    uint64_t false_sharing_misses;
+    uint64_t coherence_misses;
+    uint64_t invalidations;
+    bool disjoint_writes;              // No byte of the line was written by two cores
+    std::vector<LineWriter> writers;   // Ordered by core
+};
+
+/**
+ * @brief Private per-core L1 caches kept coherent over a shared L2
+ *
+ * Each core has its own L1 CacheLevel; all cores share one L2 (the last
+ * level cache). A directory beside the L2 records, for every block held
+ * by some L1, which cores share it and which one owns it, so requests
+ * are forwarded to the owner or invalidate the sharers directly instead
+ * of being broadcast.
+ *
+ * Protocol (MESI, or MOESI when selected):
+ * - A read miss is served by the owning core if there is one (an
+ *   intervention; under MESI a Modified owner writes back and drops to
+ *   Shared, under MOESI it becomes Owned), otherwise by the L2 or memory.
+ *   The reader gets Exclusive if no other core holds the block, else Shared.
+ * - A write needs the only copy: a hit on Shared or Owned upgrades and
+ *   invalidates the other copies, a miss fetches the block and invalidates
+ *   every other copy (read-for-ownership). The writer ends in Modified.
+ * - Evicting a Modified or Owned line writes it back.
+ *
+ * The data itself stays write-through, as in CacheHierarchy: memory and
+ * the L2 copy are updated on every write, so states and counters follow
+ * the protocol while any copy can be reloaded from memory.
+ *
+ * A miss on a block whose copy this core lost to another core's write is
+ * a coherence miss. It is counted as false sharing when none of the bytes
+ * the core now accesses were written by another core since then.
+ *
+ * With false-sharing detection enabled, every line additionally keeps
+ * the bytes each core has written to it and its own invalidation and
+ * coherence-miss counts, so the lines worth padding can be ranked.
+ */
+class MultiCoreHierarchy {
+public:
+    static constexpr size_t MAX_CORES = 64;
+
+    /**
+     * @brief Construct a multi-core hierarchy
+     *
+     * @param memory Pointer to physical memory
+     * @param num_cores Number of cores, each with a private L1 (1 to MAX_CORES)
+     * @param l1 Configuration of every private L1
+     * @param l2 Configuration of the shared L2
+     * @param protocol MESI or MOESI
+     * @throws std::invalid_argument if the configuration is invalid
+     */
+    MultiCoreHierarchy(PhysicalMemory* memory, size_t num_cores,
+                       const CacheLevelConfig& l1, const CacheLevelConfig& l2,
+                       CoherenceProtocol protocol = CoherenceProtocol::MESI);
+
+    ~MultiCoreHierarchy() = default;
+
+    /**
+     * @brief Read a byte on behalf of a core
+     *
+     * @param core Core index (0-based)
+     * @param address Physical address to read
+     * @return Result containing data byte, or error
+     */
+    Result<uint8_t> read(size_t core, Address address);
+
+    /**
+     * @brief Write a byte on behalf of a core
+     *
+     * @param core Core index (0-based)
+     * @param address Physical address to write
+     * @param data Data byte to write
+     * @return Result indicating success or error
+     */
+    Result<void> write(size_t core, Address address, uint8_t data);
+
+    /**
+     * @brief Write back dirty lines and invalidate every cache
+     */
+    void flush();
+
+    /**
+     * @brief Get the coherence state of a core's copy of an address
+     */
+    CoherenceState getState(size_t core, Address address) const;
+
+    /**
+     * @brief Get the coherence counters
+     */
+    const CoherenceStats& getStats() const { return stats_; }
+
+    /**
+     * @brief Get formatted statistics string (per-core L1, shared L2, coherence)
+     */
+    std::string getStatsString() const;
+
+    /**
+     * @brief Enable or disable per-line false-sharing detection
+     *
+     * Enabling starts from empty line profiles, so it should happen
+     * before the workload runs. Costs a byte mask per core for every
+     * line written while enabled.
+     */
+    void setFalseSharingDetection(bool enable);
+
+    /**
+     * @brief Check if per-line false-sharing detection is enabled
+     */
+    bool isFalseSharingDetectionEnabled() const { return detect_false_sharing_; }
+
+    /**
+     * @brief Get the most falsely shared lines (requires detection enabled)
+     *
+     * A line qualifies if it had a false-sharing miss, or if two or more
+     * cores wrote disjoint bytes of it and it was invalidated. Lines are
+     * ranked by false-sharing misses, then invalidations.
+     *
+     * @param top_n Maximum number of lines to return
+     */
+    std::vector<FalseSharingLine> getFalseSharingLines(size_t top_n) const;
+
+    /**
+     * @brief Get the number of cores
+     */
+    size_t getNumCores() const { return l1s_.size(); }
+
+    /**
+     * @brief Get the coherence protocol
+     */
+    CoherenceProtocol getProtocol() const { return protocol_; }
+
+    /**
+     * @brief Get a core's private L1 (nullptr if there is no such core)
+     */
+    const CacheLevel* getL1(size_t core) const;
+
+    /**
+     * @brief Get the shared L2
+     */
+    const CacheLevel* getL2() const { return l2_.get(); }
+
+private:
+    /**
+     * @brief Directory entry of one block
+     *
+     * Kept while any L1 holds the block or any core has lost it to a write.
+     */
+    struct DirectoryEntry {
+        uint64_t sharers;                  // Bit per core holding a valid copy
+        int owner;                         // Core holding the block in E, O or M, -1 if none
+        CoherenceState owner_state;
+        uint64_t invalidated;              // Bit per core whose copy another core's write invalidated
+        std::vector<uint64_t> lost_writes; // Per invalidated core: bytes written by others since
+
+        DirectoryEntry() : sharers(0), owner(-1), owner_state(CoherenceState::INVALID), invalidated(0) {}
+    };
+
+    /**
+     * @brief Sharing history of one line (false-sharing detection)
+     */
+    struct LineProfile {
+        uint64_t invalidations;
+        uint64_t coherence_misses;
+        uint64_t false_sharing_misses;
+        std::vector<uint64_t> write_masks;   // Per core: bytes written, mask_words_ words each
+
+        LineProfile() : invalidations(0), coherence_misses(0), false_sharing_misses(0) {}
+    };
+
+    PhysicalMemory* memory_;
+    CoherenceProtocol protocol_;
+    std::vector<std::unique_ptr<CacheLevel>> l1s_;   // One per core
+    std::unique_ptr<CacheLevel> l2_;                  // Shared
+    std::unordered_map<Address, DirectoryEntry> directory_;  // Keyed by L1 block address
+    size_t block_size_;                               // L1 block size
+    size_t mask_words_;                               // 64-bit words per byte mask of a block
+    CoherenceStats stats_;
+    bool detect_false_sharing_;
+    std::unordered_map<Address, LineProfile> line_profiles_;  // Keyed by L1 block address
+
+    /**
+     * @brief Get the profile of a line, creating it on first use
+     */
+    LineProfile& profileLine(Address block_address);
+
+    /**
+     * @brief Handle an L1 miss: account it, fetch the block and fill the core's L1
+     *
+     * @param for_write Read-for-ownership (invalidates every other copy)
+     */
+    Result<void> handleMiss(size_t core, CacheProbe& probe, Address address, bool for_write);
+
+    /**
+     * @brief Invalidate every copy of a block except the given core's
+     */
+    void invalidateOthers(DirectoryEntry& entry, Address block_address, size_t core);
+
+    /**
+     * @brief Account a coherence miss and classify it as true or false sharing
+     */
+    void classifyMiss(DirectoryEntry& entry, Address block_address, size_t core, size_t offset);
+
+    /**
+     * @brief Mark a byte as written in the masks of the cores that lost the block
+     */
+    void recordLostWrite(DirectoryEntry& entry, size_t writer, size_t offset);
+
+    /**
+     * @brief Update the directory for a line a core's L1 evicted
+     */
+    void handleEviction(size_t core, Address block_address);
+
+    /**
+     * @brief Drop a directory entry that no longer records anything
+     */
+    void releaseEntry(Address block_address);
+
+    /**
+     * @brief Whether a state holds data newer than memory
+     */
+    static bool isDirty(CoherenceState state);
+};
+
+/**
+ * @brief Helper function to convert CoherenceState to its one-letter name
+ */
+inline std::string coherenceStateToString(CoherenceState state) {
+    switch (state) {
+        case CoherenceState::INVALID: return "I";
+        case CoherenceState::SHARED: return "S";
+        case CoherenceState::EXCLUSIVE: return "E";
+        case CoherenceState::OWNED: return "O";
+        case CoherenceState::MODIFIED: return "M";
+        default: return "?";
+    }
+}
+
+/**
+ * @brief Helper function to convert CoherenceProtocol to string
+ */
+inline std::string coherenceProtocolToString(CoherenceProtocol protocol) {
+    switch (protocol) {
+        case CoherenceProtocol::MESI: return "MESI";
+        case CoherenceProtocol::MOESI: return "MOESI";
+        default: return "Unknown";
+    }
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_CACHE_MULTICORE_HIERARCHY_H
@@ -0,0 +1,186 @@
+#ifndef MEMSIM_CACHE_PREFETCHER_H
+#define MEMSIM_CACHE_PREFETCHER_H
+
+#include "common/types.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Prefetch effectiveness counters for one cache level
+ */
+struct PrefetchStats {
+    uint64_t issued;     // Prefetch requests sent for blocks not already cached
+    uint64_t useful;     // Prefetched lines later hit by a demand access
+    uint64_t late;       // Demand misses on blocks whose prefetch was still in flight
+    uint64_t polluting;  // Prefetched lines evicted before any demand use
+
+    PrefetchStats() : issued(0), useful(0), late(0), polluting(0) {}
+
+    double getAccuracy() const {
+        if (issued == 0) return 0.0;
+        return (static_cast<double>(useful) / issued) * 100.0;
+    }
+};
+
+/**
+ * @brief A demand access as seen by a prefetcher
+ */
+struct PrefetchTrigger {
+    Address block_address;  // Block-aligned address of the demand access
+    bool hit;               // Whether the access hit in the cache level
+    bool prefetch_hit;      // Whether it was the first hit on a prefetched line
+};
+
+/**
+ * @brief Interface for hardware prefetcher models
+ *
+ * A prefetcher observes the demand accesses of one cache level and
+ * proposes block addresses to bring into that level ahead of use.
+ * Accesses carry no program counter, so per-stream training is keyed by
+ * address region rather than by instruction.
+ */
+class IPrefetcher {
+public:
+    virtual ~IPrefetcher() = default;
+
+    /**
+     * @brief Observe a demand access and propose prefetches
+     * @param trigger The demand access
+     * @param candidates Output: block-aligned addresses to prefetch (appended)
+     */
+    virtual void onAccess(const PrefetchTrigger& trigger, std::vector<Address>& candidates) = 0;
+
+    /**
+     * @brief Forget all training state
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Get the type of this prefetcher
+     */
+    virtual PrefetcherType getType() const = 0;
+
+    /**
+     * @brief Get a short description (type and parameters)
+     */
+    virtual std::string getConfigString() const = 0;
+};
+
+/**
+ * @brief Tagged next-line prefetcher
+ *
+ * On a miss, or on the first demand hit to a prefetched line, prefetches
+ * the next `degree` sequential blocks.
+ */
+class NextLinePrefetcher : public IPrefetcher {
+public:
+    NextLinePrefetcher(size_t block_size, size_t degree);
+
+    void onAccess(const PrefetchTrigger& trigger, std::vector<Address>& candidates) override;
+    void reset() override {}
+    PrefetcherType getType() const override { return PrefetcherType::NEXT_LINE; }
+    std::string getConfigString() const override;
+
+private:
+    size_t block_size_;
+    size_t degree_;
+};
+
+/**
+ * @brief Stride prefetcher with a per-stream reference prediction table
+ *
+ * Streams are identified by address region (REGION_BLOCKS blocks). Each
+ * table entry remembers the last block and stride seen in its region with
+ * a 2-bit confidence counter; once the same stride repeats, the next
+ * `degree` blocks along the stride are prefetched.
+ */
+class StridePrefetcher : public IPrefetcher {
+public:
+    StridePrefetcher(size_t block_size, size_t degree);
+
+    void onAccess(const PrefetchTrigger& trigger, std::vector<Address>& candidates) override;
+    void reset() override;
+    PrefetcherType getType() const override { return PrefetcherType::STRIDE; }
+    std::string getConfigString() const override;
+
+    static constexpr size_t TABLE_SIZE = 64;        // Direct-mapped entries
+    static constexpr size_t REGION_BLOCKS = 64;     // Blocks per tracked region
+    static constexpr uint8_t CONFIDENCE_MAX = 3;
+    static constexpr uint8_t CONFIDENCE_THRESHOLD = 2;
+
+private:
+    struct Entry {
+        bool valid;
+        Address region;
+        Address last_block;
+        int64_t stride;        // In bytes
+        uint8_t confidence;
+    };
+
+    size_t block_size_;
+    size_t degree_;
+    std::vector<Entry> table_;
+};
+
+/**
+ * @brief Sequential stream buffers
+ *
+ * Tracks up to NUM_STREAMS ascending streams. A miss outside every stream
+ * allocates the least recently used stream buffer and fills it with the
+ * next `depth` blocks; demand accesses inside a buffer's window advance it,
+ * keeping `depth` blocks prefetched ahead of the stream.
+ */
+class StreamBufferPrefetcher : public IPrefetcher {
+public:
+    StreamBufferPrefetcher(size_t block_size, size_t depth);
+
+    void onAccess(const PrefetchTrigger& trigger, std::vector<Address>& candidates) override;
+    void reset() override;
+    PrefetcherType getType() const override { return PrefetcherType::STREAM_BUFFER; }
+    std::string getConfigString() const override;
+
+    static constexpr size_t NUM_STREAMS = 4;
+
+private:
+    struct Stream {
+        bool valid;
+        Address head;            // Oldest block still covered by the buffer
+        Address next_prefetch;   // Next block to prefetch for this stream
+        uint64_t last_use;       // For LRU stream replacement
+    };
+
+    size_t block_size_;
+    size_t depth_;
+    std::vector<Stream> streams_;
+    uint64_t time_;
+};
+
+/**
+ * @brief Create a prefetcher of the given type
+ *
+ * @param type Prefetcher type (NONE returns nullptr)
+ * @param block_size Block size of the cache level it is attached to
+ * @param degree Blocks per trigger (next-line, stride) or buffer depth (stream)
+ */
+std::unique_ptr<IPrefetcher> createPrefetcher(PrefetcherType type, size_t block_size, size_t degree);
+
+/**
+ * @brief Helper function to convert PrefetcherType to string
+ */
+inline std::string prefetcherTypeToString(PrefetcherType type) {
+    switch (type) {
+        case PrefetcherType::NONE: return "None";
+        case PrefetcherType::NEXT_LINE: return "Next-Line";
+        case PrefetcherType::STRIDE: return "Stride";
+        case PrefetcherType::STREAM_BUFFER: return "Stream Buffer";
+        default: return "Unknown";
+    }
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_CACHE_PREFETCHER_H
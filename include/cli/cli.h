@@ -88,10 +88,82 @@ private:
 
     /**
      * @brief Parse CachePolicy from string
-     * @param policy_str Policy string (fifo, lru, lfu)
+     * @param policy_str Policy string (fifo, lru, lfu, lfu_da, tree_plru, bit_plru, srrip, brrip, drrip)
      * @return CachePolicy or error
      */
     Result<CachePolicy> parseCachePolicy(const std::string& policy_str);
+
+    /**
+     * @brief Parse InclusionPolicy from string
+     * @param policy_str Policy string (nine, inclusive, exclusive)
+     * @return InclusionPolicy or error
+     */
+    Result<InclusionPolicy> parseInclusionPolicy(const std::string& policy_str);
+
+    /**
+     * @brief Parse a cache level name ("l1", "l2", ...)
+     * @param level_str Level string
+     * @return Level number (1 = L1) or error
+     */
+    Result<int> parseCacheLevel(const std::string& level_str);
+
+    /**
+     * @brief Parse PrefetcherType from string
+     * @param type_str Type string (none, next_line, stride, stream)
+     * @return PrefetcherType or error
+     */
+    Result<PrefetcherType> parsePrefetcherType(const std::string& type_str);
+
+    /**
+     * @brief Parse VictimCacheMode from string
+     * @param mode_str Mode string (victim, miss)
+     * @return VictimCacheMode or error
+     */
+    Result<VictimCacheMode> parseVictimCacheMode(const std::string& mode_str);
+
+    /**
+     * @brief Parse set sampling mode from string
+     * @param mode_str Mode string ("hash", "stride")
+     * @return SetSamplingMode or error
+     */
+    Result<SetSamplingMode> parseSetSamplingMode(const std::string& mode_str);
+
+    /**
+     * @brief Parse a sweep configuration ("<sets>x<assoc>x<block>:<policy>", levels joined by '/')
+     *
+     * An optional "@<ratio>" suffix hash-samples one set in ratio.
+     *
+     * @param config_str Configuration string
+     * @return SweepConfig (non-inclusive non-exclusive) or error
+     */
+    Result<SweepConfig> parseSweepConfig(const std::string& config_str);
+
+    /**
+     * @brief Parse coherence protocol from string
+     * @param protocol_str Protocol string ("mesi", "moesi")
+     * @return CoherenceProtocol or error
+     */
+    Result<CoherenceProtocol> parseCoherenceProtocol(const std::string& protocol_str);
+
+    /**
+     * @brief Parse TLB replacement policy from string
+     * @param policy_str Policy string ("lru", "fifo", "random")
+     * @return TLBPolicy or error
+     */
+    Result<TLBPolicy> parseTLBPolicy(const std::string& policy_str);
+
+    /**
+     * @brief Parse huge page size from string
+     * @param size_str Size string ("2m", "1g")
+     * @return PageSize or error
+     */
+    Result<PageSize> parsePageSize(const std::string& size_str);
+
+    static constexpr size_t DEFAULT_PREFETCH_DEGREE = 2;
+    static constexpr size_t DEFAULT_MRC_MAX_SETS = 64;
+    static constexpr size_t DEFAULT_MRC_MAX_ASSOC = 16;
+    static constexpr size_t DEFAULT_FALSE_SHARING_LINES = 10;
+    static constexpr size_t DEFAULT_PAGE_TABLE_LEVELS = 2;
 };
 
 } // namespace memsim
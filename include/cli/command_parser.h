@@ -18,17 +18,38 @@ enum class CommandType {
     DUMP_MEMORY,        // dump memory
     STATS,              // stats
     INIT_CACHE,         // init cache <l1_sets> <l1_assoc> <l1_block> <l1_policy> <l2_sets> <l2_assoc> <l2_block> <l2_policy>
+    INIT_CACHE_LEVEL,   // init cache level <n> <sets> <assoc> <block> <policy>
     CACHE_READ,         // cache read <address>
     CACHE_WRITE,        // cache write <address> <value>
     CACHE_STATS,        // cache stats
     CACHE_DUMP,         // cache dump
     CACHE_FLUSH,        // cache flush
-    INIT_VM,            // init vm <num_virtual_pages> <num_physical_frames> <page_size> <policy>
+    CACHE_INCLUSION,    // cache inclusion <inclusive|exclusive|nine>
+    CACHE_PREFETCH,     // cache prefetch <l1|l2|...> <type> [degree] [latency]
+    CACHE_VICTIM,       // cache victim <entries> [victim|miss]
+    CACHE_CLASSIFY,     // cache classify <on|off>
+    CACHE_SAMPLE,       // cache sample <ratio> [hash|stride]
+    CACHE_LATENCY,      // cache latency <l1_cycles> [l2_cycles ...] <memory_cycles>
+    INIT_VM,            // init vm <num_virtual_pages> <num_physical_frames> <page_size> <policy> [levels]
     VM_READ,            // vm read <virtual_address>
     VM_WRITE,           // vm write <virtual_address> <value>
     VM_TRANSLATE,       // vm translate <virtual_address>
     VM_STATS,           // vm stats
     VM_DUMP,            // vm dump
+    VM_LATENCY,         // vm latency <page_load_cycles> [writeback_cycles]
+    VM_SWAP,            // vm swap <file|off> | vm swap async <threads> [batch] | vm swap sync | vm swap delay <us>
+    VM_REPLAY,          // vm replay <trace_file> [lookahead]
+    VM_PREFETCH,        // vm prefetch <readahead|faultaround> <pages>
+    VM_TLB,             // vm tlb <dtlb_sets> <dtlb_assoc> <stlb_sets> <stlb_assoc> [policy] [walk_cycles] | vm tlb off
+    VM_WALK,            // vm walk <pwc_entries> [cache|memory]
+    VM_THP,             // vm thp <off|2m|1g>
+    VM_PROMOTE,         // vm promote <virtual_address> <2m|1g>
+    VM_DEMOTE,          // vm demote <virtual_address>
+    VM_CLOCK,           // vm clock <spread|window> <value>
+    ANALYZE_MRC,        // analyze mrc <trace_file> <block_size> [max_sets] [max_assoc]
+    ANALYZE_SWEEP,      // analyze sweep <trace_file> <memory_size> <config> [config...]
+    ANALYZE_COHERENCE,  // analyze coherence <trace_file> <memory_size> <cores> <l1>/<l2> [mesi|moesi] [top_n]
+    ANALYZE_VM,         // analyze vm <trace_file> <virtual_pages> <physical_frames> <page_size>
     HELP,               // help
     EXIT,               // exit
     UNKNOWN             // Unrecognized command
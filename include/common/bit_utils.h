@@ -0,0 +1,46 @@
+#ifndef MEMSIM_COMMON_BIT_UTILS_H
+#define MEMSIM_COMMON_BIT_UTILS_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace memsim {
+
+/**
+ * @brief Index of the lowest set bit in a 64-bit word
+ *
+ * @param value Word to scan (must be non-zero)
+ * @return Bit index in [0, 63]
+ */
+inline unsigned countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+/**
+ * @brief Index of the highest set bit in a 64-bit word (floor of log2)
+ *
+ * @param value Word to scan (must be non-zero)
+ * @return Bit index in [0, 63]
+ */
+inline unsigned floorLog2(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_COMMON_BIT_UTILS_H
@@ -21,16 +21,86 @@ enum class AllocatorType {
 
 // Cache replacement policies
 enum class CachePolicy {
-    FIFO,  // First-In-First-Out
-    LRU,   // Least Recently Used
-    LFU    // Least Frequently Used
+    FIFO,       // First-In-First-Out
+    LRU,        // Least Recently Used
+    LFU,        // Least Frequently Used: per-set frequency buckets make victim selection
+                // O(1), and every aging interval halves all access counts so lines that
+                // were hot long ago can eventually be evicted
+    LFU_DA,     // LFU with dynamic aging: lines are ordered by frequency plus a per-set
+                // age that is raised to the priority of each evicted line
+    TREE_PLRU,  // Tree pseudo-LRU: a binary decision tree in one 64-bit word per set
+                // (at most 64 ways, power-of-two associativity)
+    BIT_PLRU,   // Bit pseudo-LRU: one MRU bit per way in one 64-bit word per set (at most 64 ways)
+    SRRIP,      // Static re-reference interval prediction (2-bit prediction value per line)
+    BRRIP,      // Bimodal re-reference interval prediction
+    DRRIP       // Dynamic RRIP: demand misses in SRRIP and BRRIP leader sets (one in
+                // eight, up to CacheLevel::DRRIP_MAX_LEADER_SETS each) train a saturating
+                // PSEL counter that picks the insertion policy of the follower sets
+};
+
+// Hardware prefetchers
+enum class PrefetcherType {
+    NONE,           // No prefetching
+    NEXT_LINE,      // Tagged next-line (sequential) prefetcher
+    STRIDE,         // Per-stream stride detector
+    STREAM_BUFFER   // Sequential stream buffers
+};
+
+// Cache hierarchy inclusion policies
+enum class InclusionPolicy {
+    NINE,       // Non-inclusive non-exclusive: a read fills every level above the one
+                // that served it, and evictions are independent per level
+    INCLUSIVE,  // As NINE, but a line evicted from a lower level is also invalidated in
+                // every level above it (back-invalidation), so lower levels hold a superset
+    EXCLUSIVE   // A block lives in at most one level: lower-level hits move it to L1 and
+                // each level's victim moves one level down (the last level's is dropped);
+                // all levels must share one block size
+};
+
+// Small fully-associative buffer between L1 and L2
+enum class VictimCacheMode {
+    VICTIM,     // Holds lines evicted from L1; a hit swaps the line back into L1
+    MISS        // Holds lines fetched on L1 misses; a hit reloads L1 from it
+};
+
+// How a sampled cache simulation picks the sets it simulates
+enum class SetSamplingMode {
+    STRIDE,     // Every n-th set (set index divisible by the sampling ratio)
+    HASH        // Sets whose hashed index is divisible by the sampling ratio
+};
+
+// Cache coherence protocols between private L1s
+enum class CoherenceProtocol {
+    MESI,       // Modified, Exclusive, Shared, Invalid
+    MOESI       // MESI plus Owned: dirty lines are shared without a write-back
+};
+
+// TLB replacement policies
+enum class TLBPolicy {
+    LRU,        // Least Recently Used
+    FIFO,       // First-In-First-Out
+    RANDOM      // Pseudo-random way (deterministic xorshift sequence)
+};
+
+// Sizes of a page mapping (x86-64 sizes, i.e. 4 KB base pages and 9-bit table levels)
+enum class PageSize {
+    BASE,       // One leaf page table entry
+    HUGE_2M,    // One entry a level above the leaves, covering a whole leaf node
+    HUGE_1G     // One entry two levels above the leaves
 };
 
 // Page replacement policies
 enum class PageReplacementPolicy {
-    FIFO,   // First-In-First-Out
-    LRU,    // Least Recently Used
-    CLOCK   // Clock algorithm (second chance)
+    FIFO,               // First-In-First-Out
+    LRU,                // Least Recently Used
+    CLOCK,              // Clock algorithm (second chance)
+    CLOCK_PRO,          // CLOCK-Pro: hot/cold pages with test periods
+    WSCLOCK,            // WSClock: clock over the working set, cleaning dirty pages early
+    TWO_HANDED_CLOCK,   // Front hand clears reference bits, back hand evicts
+    ARC,                // Adaptive Replacement Cache: recency and frequency lists with ghosts
+    TWO_Q,              // 2Q: FIFO probation queue in front of an LRU main queue
+    LIRS,               // Low Inter-reference Recency Set
+    OPTIMAL             // Belady's OPT: evict the page used furthest in the future (needs the trace)
 };
 
 } // namespace memsim
@@ -7,6 +7,10 @@
 #include "allocator/buddy_allocator.h"
 #include "virtual_memory/virtual_memory.h"
 #include "cache/cache_hierarchy.h"
+#include "cache/multicore_hierarchy.h"
+#include "analysis/stack_distance.h"
+#include "analysis/parallel_simulator.h"
+#include "analysis/trace_reader.h"
 #include "common/types.h"
 #include "common/result.h"
 #include <memory>
@@ -109,12 +113,14 @@ public:
      * @param num_physical_frames Number of physical frames
      * @param page_size Size of each page in bytes
      * @param policy Page replacement policy
+     * @param page_table_levels Levels of the radix page table (2 to 5)
      * @return Result indicating success or failure
      */
     Result<void> initVirtualMemory(size_t num_virtual_pages,
                                     size_t num_physical_frames,
                                     size_t page_size,
-                                    PageReplacementPolicy policy);
+                                    PageReplacementPolicy policy,
+                                    size_t page_table_levels = 2);
 
     /**
      * @brief Read from virtual address
@@ -138,6 +144,125 @@ public:
      */
     Result<Address> vmTranslate(Address virtual_addr);
 
+    /**
+     * @brief Put a two-level TLB in front of the page table, replacing any existing one
+     * @param dtlb First-level data TLB
+     * @param stlb Second-level unified TLB
+     * @param walk_cycles Page table walk latency
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMTLB(const TLBConfig& dtlb, const TLBConfig& stlb, uint64_t walk_cycles);
+
+    /**
+     * @brief Remove the TLB: every translation walks the page table
+     * @return Result indicating success or failure
+     */
+    Result<void> disableVMTLB();
+
+    /**
+     * @brief Configure page-walk accounting
+     *
+     * Walk references follow the cache hierarchy across rebuilds of it.
+     *
+     * @param pwc_entries Page-walk cache entries per non-leaf level (0 removes it)
+     * @param through_cache Send walk references through the cache hierarchy
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMPageWalk(size_t pwc_entries, bool through_cache);
+
+    /**
+     * @brief Let page faults map huge pages up to a size
+     * @param max_size Largest page size (BASE disables huge pages)
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMHugePages(PageSize max_size);
+
+    /**
+     * @brief Collapse the region around a virtual address into a huge page
+     * @param virtual_addr Address inside the region
+     * @param size Huge page size
+     * @return Result indicating success or failure
+     */
+    Result<void> vmPromote(Address virtual_addr, PageSize size);
+
+    /**
+     * @brief Split the huge page mapping a virtual address
+     * @param virtual_addr Address inside the huge page
+     * @return Result indicating success or failure
+     */
+    Result<void> vmDemote(Address virtual_addr);
+
+    /**
+     * @brief Set how far the front hand of the two-handed clock runs ahead
+     * @param frames Frames between the hands
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMClockHandSpread(size_t frames);
+
+    /**
+     * @brief Set the WSClock working-set window
+     * @param accesses Accesses after which an unused page leaves the working set
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMWorkingSetWindow(uint64_t accesses);
+
+    /**
+     * @brief Read ahead of sequential page faults
+     * @param max_pages Largest readahead window in pages (0 disables)
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMReadahead(size_t max_pages);
+
+    /**
+     * @brief Map the aligned block of pages around every unexplained fault
+     * @param pages Block size in pages (power of two; 0 or 1 disables)
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMFaultAround(size_t pages);
+
+    /**
+     * @brief Charge page faults a simulated disk latency
+     * @param page_load_cycles Cycles to load a page on a fault
+     * @param writeback_cycles Cycles to write back a dirty victim page
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMDiskLatency(uint64_t page_load_cycles, uint64_t writeback_cycles);
+
+    /**
+     * @brief Back evicted pages with a swap file
+     * @param path File to create (truncated if it exists), or "off" to detach
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMSwapFile(const std::string& path);
+
+    /**
+     * @brief Move swap pages on worker threads
+     * @param num_threads Worker threads (0 makes swap I/O synchronous)
+     * @param batch_size Dirty victims written back together
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMSwapAsync(size_t num_threads, size_t batch_size);
+
+    /**
+     * @brief Make every swap transfer take at least this long, like a slow device
+     * @param microseconds Added to each transfer (0 for none)
+     * @return Result indicating success or failure
+     */
+    Result<void> setVMSwapDelay(uint64_t microseconds);
+
+    /**
+     * @brief Replay a trace of virtual addresses through the virtual memory
+     *
+     * Writes store the low byte of their address. With an asynchronous
+     * swap device, the page of the access lookahead records ahead is
+     * prefetched from swap so its read overlaps with the replay.
+     *
+     * @param trace_path Trace file (R/W lines)
+     * @param lookahead Records between a prefetch and its access (0 disables)
+     * @return Result indicating success or failure
+     */
+    Result<void> replayVMTrace(const std::string& trace_path, size_t lookahead);
+
     /**
      * @brief Print virtual memory statistics
      */
@@ -169,6 +294,35 @@ public:
     Result<void> initCache(size_t l1_sets, size_t l1_assoc, size_t l1_block_size, CachePolicy l1_policy,
                            size_t l2_sets, size_t l2_assoc, size_t l2_block_size, CachePolicy l2_policy);
 
+    /**
+     * @brief Configure one level of the cache hierarchy and rebuild it
+     *
+     * Levels are numbered from 1 (L1). An existing level is replaced; a new
+     * level may only be added directly below the current last level.
+     * Rebuilding clears cache contents, statistics and the victim cache;
+     * prefetchers and latencies of the existing levels are kept.
+     *
+     * @param level Level number (1 .. current depth + 1)
+     * @param sets Number of sets
+     * @param assoc Associativity
+     * @param block_size Block size in bytes
+     * @param policy Replacement policy
+     * @return Result indicating success or failure
+     */
+    Result<void> initCacheLevel(size_t level, size_t sets, size_t assoc, size_t block_size,
+                                CachePolicy policy);
+
+    /**
+     * @brief Set the inclusion policy between cache levels and rebuild the hierarchy
+     *
+     * Rebuilding clears cache contents, statistics and the victim cache;
+     * prefetchers and latencies are kept.
+     *
+     * @param policy Inclusion policy (NINE, INCLUSIVE, EXCLUSIVE)
+     * @return Result indicating success or failure
+     */
+    Result<void> setCacheInclusion(InclusionPolicy policy);
+
     /**
      * @brief Read from cache
      * @param address Physical address to read from
@@ -184,6 +338,51 @@ public:
      */
     Result<void> cacheWrite(Address address, uint8_t data);
 
+    /**
+     * @brief Attach a hardware prefetcher to a cache level
+     * @param level Cache level (1 = L1)
+     * @param type Prefetcher type (NONE detaches)
+     * @param degree Blocks per trigger, or stream buffer depth
+     * @param latency Reads before an issued prefetch fills the cache
+     * @return Result indicating success or failure
+     */
+    Result<void> setCachePrefetcher(int level, PrefetcherType type, size_t degree, uint64_t latency);
+
+    /**
+     * @brief Add a fully-associative victim or miss cache between L1 and L2
+     * @param entries Number of lines (0 removes the buffer)
+     * @param mode Victim cache or miss cache
+     * @return Result indicating success or failure
+     */
+    Result<void> setCacheVictim(size_t entries, VictimCacheMode mode);
+
+    /**
+     * @brief Enable or disable 3C (compulsory/capacity/conflict) miss classification
+     * @param enable Whether to classify misses on every cache level
+     * @return Result indicating success or failure
+     */
+    Result<void> setCacheMissClassification(bool enable);
+
+    /**
+     * @brief Simulate only a fraction of the cache sets and extrapolate statistics
+     * @param ratio Simulate one set in ratio (1 = exact simulation)
+     * @param mode How the simulated sets are picked
+     * @return Result indicating success or failure
+     */
+    Result<void> setCacheSampling(size_t ratio, SetSamplingMode mode);
+
+    /**
+     * @brief Set the cycles charged to cache hits per level and to memory accesses
+     *
+     * The victim/miss cache latency is kept. Rebuilding the hierarchy
+     * restores the default latencies.
+     *
+     * @param hit_cycles Hit latency of each level, L1 first (one per level)
+     * @param memory_cycles Main memory latency
+     * @return Result indicating success or failure
+     */
+    Result<void> setCacheLatency(const std::vector<uint64_t>& hit_cycles, uint64_t memory_cycles);
+
     /**
      * @brief Print cache statistics
      */
@@ -199,18 +398,114 @@ public:
      */
     void flushCache();
 
+    /**
+     * @brief Print LRU miss-ratio curves of a trace file for many cache geometries
+     *
+     * Runs a single-pass stack-distance analysis (StackDistanceAnalyzer)
+     * over the trace. Independent of the simulated memory and caches.
+     *
+     * @param trace_path Trace file (see TraceReader for the format)
+     * @param block_size Block size in bytes
+     * @param max_sets Largest number of sets (1, 2, 4, ... up to this are reported)
+     * @param max_assoc Largest associativity reported
+     * @return Result indicating success or failure
+     */
+    Result<void> analyzeStackDistance(const std::string& trace_path, size_t block_size,
+                                      size_t max_sets, size_t max_assoc);
+
+    /**
+     * @brief Simulate several cache hierarchies over one pass of a trace file
+     *
+     * Each configuration runs on its own thread with a private memory of
+     * memory_size bytes (ParallelCacheSimulator). Independent of the
+     * simulated memory and caches.
+     *
+     * @param trace_path Trace file (see TraceReader for the format)
+     * @param memory_size Physical memory size for every configuration
+     * @param configs Configurations to simulate
+     * @return Result indicating success or failure
+     */
+    Result<void> analyzeCacheSweep(const std::string& trace_path, size_t memory_size,
+                                   const std::vector<SweepConfig>& configs);
+
+    /**
+     * @brief Replay a core-tagged trace through private L1s kept coherent over a shared L2
+     *
+     * Runs a MultiCoreHierarchy with a private memory of memory_size bytes.
+     * Independent of the simulated memory and caches, except that the
+     * falsely shared lines reported are mapped to the blocks of the current
+     * allocator (if one is set), since trace addresses are physical.
+     *
+     * @param trace_path Trace file (see TraceReader; the core ID follows each address)
+     * @param memory_size Physical memory size in bytes
+     * @param num_cores Number of cores
+     * @param l1 Configuration of every private L1
+     * @param l2 Configuration of the shared L2
+     * @param protocol MESI or MOESI
+     * @param top_n Number of falsely shared lines to report
+     * @return Result indicating success or failure
+     */
+    Result<void> analyzeCoherence(const std::string& trace_path, size_t memory_size, size_t num_cores,
+                                  const CacheLevelConfig& l1, const CacheLevelConfig& l2,
+                                  CoherenceProtocol protocol, size_t top_n);
+
+    /**
+     * @brief Replay a trace of virtual addresses under every page replacement policy
+     *
+     * The whole trace is read first, so OPT can be given the future
+     * accesses; each policy then runs on a fresh VirtualMemory over a
+     * private memory of num_physical_frames frames, and its faults are
+     * reported against OPT's minimum. Independent of the simulated memory.
+     *
+     * @param trace_path Trace file (see TraceReader; addresses are virtual)
+     * @param num_virtual_pages Number of virtual pages
+     * @param num_physical_frames Number of physical frames
+     * @param page_size Page size in bytes
+     * @return Result indicating success or failure
+     */
+    Result<void> analyzePageReplacement(const std::string& trace_path, size_t num_virtual_pages,
+                                        size_t num_physical_frames, size_t page_size);
+
     /**
      * @brief Check if cache is initialized
      * @return true if cache is initialized
      */
     bool isCacheInitialized() const { return cache_ != nullptr; }
 
+    static constexpr size_t TRACE_CHUNK_RECORDS = 4096;   // Records decoded per trace read
+
 private:
     std::unique_ptr<PhysicalMemory> physical_memory_;
     std::unique_ptr<IAllocator> allocator_;
     std::unique_ptr<VirtualMemory> virtual_memory_;
     std::unique_ptr<CacheHierarchy> cache_;
+    std::vector<CacheLevelConfig> cache_levels_;   // Configuration of the current hierarchy
+
+    // Prefetcher attached to a cache level, re-attached when the hierarchy is rebuilt
+    struct PrefetcherSetting {
+        PrefetcherType type;
+        size_t degree;
+        uint64_t latency;
+    };
+    std::vector<PrefetcherSetting> cache_prefetchers_;   // [level - 1]; NONE if no prefetcher
+    InclusionPolicy cache_inclusion_;
+    bool walks_through_cache_;                     // VM page walks read through cache_
     AllocatorType current_allocator_type_;
+
+    /**
+     * @brief Build the cache hierarchy from a level list and print its layout
+     */
+    Result<void> buildCache(const std::vector<CacheLevelConfig>& levels, InclusionPolicy inclusion);
+
+    /**
+     * @brief Rebuild the cache hierarchy, keeping the prefetchers and latencies of its levels
+     */
+    Result<void> rebuildCache(const std::vector<CacheLevelConfig>& levels, InclusionPolicy inclusion);
+
+    /**
+     * @brief Print the most falsely shared lines, with the allocator blocks their writers touched
+     */
+    void printFalseSharing(const MultiCoreHierarchy& hierarchy, size_t top_n) const;
 };
 
 } // namespace memsim
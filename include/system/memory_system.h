@@ -22,7 +22,10 @@ enum class AccessLevel {
     L1_CACHE,       // Data found in L1 cache
     L2_CACHE,       // Data found in L2 cache (L1 miss)
     MEMORY,         // Data found in memory (L1 and L2 miss)
-    PAGE_FAULT      // Page fault occurred (VM miss)
+    PAGE_FAULT,     // Page fault occurred (VM miss)
+    DTLB_HIT,       // Translation found in the dTLB
+    STLB_HIT,       // Translation found in the STLB (dTLB miss)
+    PAGE_WALK       // Translation walked the page table (TLB miss, page resident)
 };
 
 /**
@@ -35,11 +38,13 @@ struct AccessResult {
     Address physical_address;   // Physical address accessed
     Address virtual_address;    // Virtual address (if using VM)
     bool used_virtual_memory;   // Whether VM translation occurred
+    AccessLevel translation;    // Where the translation was found: DTLB_HIT, STLB_HIT, PAGE_WALK or PAGE_FAULT (if VM used)
+    uint64_t cycles;            // Simulated cycles, including translation and any page fault
 
     AccessResult()
         : success(false), value(0), level(AccessLevel::MEMORY),
           physical_address(0), virtual_address(0),
-          used_virtual_memory(false) {}
+          used_virtual_memory(false), translation(AccessLevel::PAGE_WALK), cycles(0) {}
 };
 
 /**
@@ -55,13 +60,22 @@ struct SessionStats {
     uint64_t memory_accesses;
     uint64_t page_faults;
 
+    // Per-level translation counts (VM enabled)
+    uint64_t dtlb_hits;
+    uint64_t stlb_hits;
+    uint64_t page_walks;
+
     // Running totals
     uint64_t total_reads;
     uint64_t total_writes;
 
+    // Simulated cycles of the successful accesses, per access type
+    LatencyStats latency;
+
     SessionStats()
         : total_accesses(0), l1_hits(0), l2_hits(0),
           memory_accesses(0), page_faults(0),
+          dtlb_hits(0), stlb_hits(0), page_walks(0),
           total_reads(0), total_writes(0) {}
 
     double getL1HitRate() const {
@@ -83,6 +97,10 @@ struct SessionStats {
         if (total_accesses == 0) return 0.0;
         return (static_cast<double>(page_faults) / total_accesses) * 100.0;
     }
+
+    double getAMAT() const {
+        return latency.getAMAT();
+    }
 };
 
 /**
@@ -93,6 +111,12 @@ struct SessionStats {
  * - Virtual memory can optionally translate addresses
  * - Detailed logging shows exactly where each access is served from
  * - Session statistics track hits/misses at each level
+ * - Virtual addresses are translated through a dTLB and STLB in front of
+ *   the page table; each access records where its translation was found
+ * - Every access is charged simulated cycles: the cache hierarchy's
+ *   latencies (memory latency alone without caches) plus the TLB and page
+ *   walk latency and the disk latency of any page fault, giving the
+ *   session AMAT and latency histograms
  */
 class MemorySystem {
 public:
@@ -200,6 +224,32 @@ public:
     void configureVM(size_t num_virtual_pages, size_t num_physical_frames,
                      size_t page_size, PageReplacementPolicy policy);
 
+    /**
+     * @brief Configure the TLB in front of the page table (kept across reconfiguration)
+     *
+     * @param dtlb First-level data TLB
+     * @param stlb Second-level unified TLB
+     * @param walk_cycles Page table walk latency
+     * @throws std::invalid_argument if a TLB geometry is invalid
+     */
+    void configureTLB(const TLBConfig& dtlb, const TLBConfig& stlb, uint64_t walk_cycles);
+
+    /**
+     * @brief Set the L1, L2 and memory latencies (kept across reconfiguration)
+     *
+     * @param latencies Two hit latencies, victim cache and memory latencies
+     * @return Result indicating success or error
+     */
+    Result<void> setLatencies(const LatencyConfig& latencies);
+
+    /**
+     * @brief Set the disk latencies charged to page faults (kept across reconfiguration)
+     *
+     * @param page_load_cycles Cycles to load a page on a fault
+     * @param writeback_cycles Cycles to write back a dirty victim page
+     */
+    void setDiskLatency(uint64_t page_load_cycles, uint64_t writeback_cycles);
+
 private:
     // Core components
     std::unique_ptr<PhysicalMemory> memory_;
@@ -219,14 +269,8 @@ private:
     static constexpr size_t MAX_HISTORY_SIZE = 1000;
 
     // Cache configuration (for lazy initialization)
-    struct CacheConfig {
-        size_t sets;
-        size_t associativity;
-        size_t block_size;
-        CachePolicy policy;
-    };
-    CacheConfig l1_config_;
-    CacheConfig l2_config_;
+    CacheLevelConfig l1_config_;
+    CacheLevelConfig l2_config_;
 
     // VM configuration
     struct VMConfig {
@@ -237,6 +281,16 @@ private:
     };
     VMConfig vm_config_;
 
+    // TLB configuration
+    TLBConfig dtlb_config_;
+    TLBConfig stlb_config_;
+    uint64_t walk_cycles_;
+
+    // Latency configuration (applied to every cache and VM instance)
+    LatencyConfig latencies_;
+    uint64_t page_load_cycles_;
+    uint64_t writeback_cycles_;
+
     /**
      * @brief Initialize cache with current configuration
      */
@@ -247,6 +301,13 @@ private:
      */
     void initializeVM();
 
+    /**
+     * @brief Classify a translation from the VM statistics before and after it
+     *        and count it in the session statistics
+     */
+    AccessLevel recordTranslation(const VirtualMemoryStats& before,
+                                    const VirtualMemoryStats& after);
+
     /**
      * @brief Record an access in history
      */
@@ -267,6 +328,9 @@ inline std::string accessLevelToString(AccessLevel level) {
         case AccessLevel::L2_CACHE: return "L2 Cache";
         case AccessLevel::MEMORY: return "Memory";
         case AccessLevel::PAGE_FAULT: return "Page Fault";
+        case AccessLevel::DTLB_HIT: return "dTLB Hit";
+        case AccessLevel::STLB_HIT: return "STLB Hit";
+        case AccessLevel::PAGE_WALK: return "Page Walk";
         default: return "Unknown";
     }
 }
@@ -280,6 +344,9 @@ inline std::string getAccessLevelColor(AccessLevel level) {
         case AccessLevel::L2_CACHE: return "\033[33m";    // Yellow
         case AccessLevel::MEMORY: return "\033[31m";      // Red
         case AccessLevel::PAGE_FAULT: return "\033[35m";  // Magenta
+        case AccessLevel::DTLB_HIT: return "\033[32m";    // Green
+        case AccessLevel::STLB_HIT: return "\033[33m";    // Yellow
+        case AccessLevel::PAGE_WALK: return "\033[31m";   // Red
         default: return "\033[0m";
     }
 }
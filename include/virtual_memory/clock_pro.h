@@ -0,0 +1,141 @@
+#ifndef MEMSIM_VIRTUAL_MEMORY_CLOCK_PRO_H
+#define MEMSIM_VIRTUAL_MEMORY_CLOCK_PRO_H
+
+#include "virtual_memory/page_table_entry.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace memsim {
+
+/**
+ * @brief CLOCK-Pro page replacement state (Jiang, Chen and Zhang, 2005)
+ *
+ * Resident pages are hot or cold; a cold page is in its test period
+ * from the time it is loaded until the hot hand passes it. All pages,
+ * plus the metadata of recently evicted cold pages still in their test
+ * period (non-resident test pages), sit on one circular list, newest
+ * behind the hot hand. Three hands sweep it:
+ * - The cold hand finds victims: a referenced cold page turns hot, an
+ *   unreferenced one is evicted and kept as a non-resident test page.
+ * - The hot hand keeps hot pages within their share of the frames: a
+ *   referenced hot page loses its bit, an unreferenced one turns cold.
+ * - The test hand ends test periods, dropping non-resident test pages.
+ *
+ * A fault on a non-resident test page means its reuse distance beat the
+ * hot pages', so it enters hot and the cold target (the frames cold
+ * pages may hold, starting at 1) grows; a test period ending without a
+ * reuse shrinks it. Reference bits are read from and cleared in the
+ * resident pages' PageTableEntry.
+ */
+class ClockPro {
+public:
+    /**
+     * @brief Construct empty CLOCK-Pro state
+     *
+     * @param capacity Resident pages (frames) the policy manages, also the
+     *                 limit on non-resident test pages (at least 2)
+     * @throws std::invalid_argument if capacity < 2
+     */
+    explicit ClockPro(size_t capacity);
+
+    ~ClockPro() = default;
+
+    /**
+     * @brief Add a page that was just loaded
+     *
+     * Clears its reference bit: the access that loaded it is not a reuse.
+     *
+     * @param page_number First page of the mapping
+     * @param pte Its page table entry (must stay valid while resident)
+     * @param prefetched Mapped ahead of use: a test page enters cold, as no reuse happened
+     * @return true if the page was a non-resident test page and enters hot
+     */
+    bool insert(uint64_t page_number, PageTableEntry* pte, bool prefetched = false);
+
+    /**
+     * @brief Run the cold hand until it evicts a page
+     *
+     * If the page is in its test period it stays on the list as a
+     * non-resident test page, which remove() leaves in place.
+     *
+     * @param page_number Output: page to evict
+     * @return false if no page is resident
+     */
+    bool selectVictim(uint64_t& page_number);
+
+    /**
+     * @brief Forget a resident page (no-op for non-resident test pages)
+     */
+    void remove(uint64_t page_number);
+
+    /**
+     * @brief Drop all pages and metadata
+     */
+    void clear();
+
+    size_t getHotPages() const { return hot_; }
+    size_t getColdPages() const { return cold_; }
+    size_t getTestPages() const { return test_; }
+    size_t getColdTarget() const { return cold_target_; }
+
+private:
+    enum class Status {
+        HOT,
+        COLD,        // Resident cold page
+        TEST         // Non-resident cold page in its test period
+    };
+
+    struct Node {
+        uint64_t page_number;
+        Status status;
+        bool in_test;           // Resident cold page still in its test period
+        PageTableEntry* pte;    // Resident pages only
+    };
+
+    using Iterator = std::list<Node>::iterator;
+
+    size_t capacity_;
+    size_t cold_target_;        // Frames the cold pages may hold
+    size_t hot_;
+    size_t cold_;
+    size_t test_;
+    std::list<Node> ring_;      // Circular: the end wraps to the beginning
+    std::unordered_map<uint64_t, Iterator> index_;
+    Iterator hand_hot_;
+    Iterator hand_cold_;
+    Iterator hand_test_;
+
+    /**
+     * @brief Next node of the circular list
+     */
+    Iterator next(Iterator it) {
+        ++it;
+        return it == ring_.end() ? ring_.begin() : it;
+    }
+
+    /**
+     * @brief Unlink a node, moving any hand on it to the next node
+     */
+    void erase(Iterator it);
+
+    /**
+     * @brief Move the hot hand one step (may demote a hot page to cold)
+     */
+    void runHandHot();
+
+    /**
+     * @brief Move the test hand one step (may drop a non-resident test page)
+     */
+    void runHandTest();
+
+    /**
+     * @brief Run the hot and test hands until hot and test pages fit their budgets
+     */
+    void balance();
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_VIRTUAL_MEMORY_CLOCK_PRO_H
@@ -0,0 +1,95 @@
+#ifndef MEMSIM_VIRTUAL_MEMORY_FREE_FRAME_BITMAP_H
+#define MEMSIM_VIRTUAL_MEMORY_FREE_FRAME_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Two-level bitmap of free physical frames
+ *
+ * Each 64-bit word holds one bit per frame, set while the frame is
+ * free; a summary word holds one bit per frame word, set while that word
+ * has a free frame. A cursor stays on the lowest non-zero summary word,
+ * so finding the lowest free frame takes one count of trailing zeros
+ * there and one in the frame word it names: O(1). The cursor moves back
+ * when a lower word gets a free frame and forward, past summary words
+ * with none, when its own word fills up.
+ *
+ * Runs aligned to their length (huge pages) are found by folding each
+ * word with free frames onto itself, so a run within a word costs
+ * O(log run length) per candidate word.
+ */
+class FreeFrameBitmap {
+public:
+    static constexpr size_t WORD_BITS = 64;
+
+    /**
+     * @brief Construct a bitmap with every frame free
+     *
+     * @param num_frames Number of physical frames
+     */
+    explicit FreeFrameBitmap(size_t num_frames);
+
+    ~FreeFrameBitmap() = default;
+
+    /**
+     * @brief Find the lowest free frame
+     *
+     * @param frame Output: frame number
+     * @return false if every frame is allocated
+     */
+    bool findFree(size_t& frame) const;
+
+    /**
+     * @brief Find the lowest free run of frames aligned to its length
+     *
+     * @param count Frames in the run (power of 2)
+     * @param first Output: first frame of the run
+     * @return false if no such run is free
+     */
+    bool findFreeRun(size_t count, size_t& first) const;
+
+    /**
+     * @brief Mark frames as allocated
+     */
+    void allocate(size_t first, size_t count = 1);
+
+    /**
+     * @brief Mark frames as free
+     */
+    void release(size_t first, size_t count = 1);
+
+    /**
+     * @brief Mark every frame free
+     */
+    void reset();
+
+    /**
+     * @brief Check if a frame is free
+     */
+    bool isFree(size_t frame) const {
+        return (words_[frame / WORD_BITS] >> (frame % WORD_BITS)) & 1;
+    }
+
+    size_t getFreeFrames() const { return free_frames_; }
+    size_t getNumFrames() const { return num_frames_; }
+
+private:
+    size_t num_frames_;
+    size_t free_frames_;
+    std::vector<uint64_t> words_;     // Bit per frame, set while free
+    std::vector<uint64_t> summary_;   // Bit per frame word, set while it has a free frame
+    size_t first_summary_;            // Lowest non-zero summary word (summary_.size() if none)
+
+    /**
+     * @brief Set or clear a word's summary bit from its contents
+     */
+    void updateSummary(size_t word);
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_VIRTUAL_MEMORY_FREE_FRAME_BITMAP_H
@@ -0,0 +1,350 @@
+#ifndef MEMSIM_VIRTUAL_MEMORY_PAGE_REPLACER_H
+#define MEMSIM_VIRTUAL_MEMORY_PAGE_REPLACER_H
+
+#include "common/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Interface for page replacement policies that keep their own page lists
+ *
+ * VirtualMemory reports every event of its resident mappings (keyed by
+ * the first page they cover) and asks for a victim when no frame is
+ * free. The sequence of one fault is onFault(), then selectVictim() and
+ * onEvict() if memory is full, then insert(). Mappings replaced without
+ * an eviction (promotion, demotion) go through remove() and insert(), and
+ * pages mapped ahead of use (readahead, fault-around) through
+ * insertPrefetched(), without an onFault().
+ * Each mapping counts as one page, whatever its size.
+ */
+class IPageReplacer {
+public:
+    virtual ~IPageReplacer() = default;
+
+    /**
+     * @brief A resident page was accessed
+     */
+    virtual void onAccess(uint64_t page_number) = 0;
+
+    /**
+     * @brief A fault on a page begins (before any eviction it causes)
+     */
+    virtual void onFault(uint64_t page_number) = 0;
+
+    /**
+     * @brief Choose the resident page to evict
+     *
+     * @param page_number Output: victim page
+     * @return false if no page is resident
+     */
+    virtual bool selectVictim(uint64_t& page_number) = 0;
+
+    /**
+     * @brief A resident page was evicted (history may be kept)
+     */
+    virtual void onEvict(uint64_t page_number) = 0;
+
+    /**
+     * @brief A page became resident
+     */
+    virtual void insert(uint64_t page_number) = 0;
+
+    /**
+     * @brief A page was mapped ahead of use
+     *
+     * Enters it as a page seen once: history kept from an earlier eviction
+     * is dropped rather than counted as a reuse.
+     */
+    virtual void insertPrefetched(uint64_t page_number) = 0;
+
+    /**
+     * @brief Forget a resident page without keeping history
+     */
+    virtual void remove(uint64_t page_number) = 0;
+
+    /**
+     * @brief Forget every page and all history
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Get the policy this replacer implements
+     */
+    virtual PageReplacementPolicy getPolicy() const = 0;
+
+    /**
+     * @brief Get a one-line summary of the policy's lists
+     */
+    virtual std::string getStateString() const = 0;
+};
+
+/**
+ * @brief Adaptive Replacement Cache (Megiddo and Modha, 2003)
+ *
+ * T1 holds pages seen once recently and T2 pages seen at least twice;
+ * B1 and B2 remember the pages evicted from each. A fault on a page in
+ * B1 grows the target size p of T1, one in B2 shrinks it, and the victim
+ * comes from T1 while it is larger than p, so the split between recency
+ * and frequency adapts to the workload and a scan only flushes T1.
+ */
+class ArcReplacer : public IPageReplacer {
+public:
+    /**
+     * @param capacity Resident pages (frames) the policy manages
+     */
+    explicit ArcReplacer(size_t capacity);
+
+    void onAccess(uint64_t page_number) override;
+    void onFault(uint64_t page_number) override;
+    bool selectVictim(uint64_t& page_number) override;
+    void onEvict(uint64_t page_number) override;
+    void insert(uint64_t page_number) override;
+    void insertPrefetched(uint64_t page_number) override;
+    void remove(uint64_t page_number) override;
+    void reset() override;
+    PageReplacementPolicy getPolicy() const override { return PageReplacementPolicy::ARC; }
+    std::string getStateString() const override;
+
+    /**
+     * @brief Get the adaptive target size of T1
+     */
+    size_t getTarget() const { return target_; }
+
+    /**
+     * @brief Get the sizes of T1, T2, B1 and B2 (list index 0-3)
+     */
+    size_t getListSize(size_t list) const { return lists_[list].size(); }
+
+private:
+    enum List { T1, T2, B1, B2, NUM_LISTS };
+
+    struct Entry {
+        List list;
+        std::list<uint64_t>::iterator position;
+    };
+
+    size_t capacity_;
+    size_t target_;                                   // p: target size of T1
+    std::list<uint64_t> lists_[NUM_LISTS];            // Front = most recent
+    std::unordered_map<uint64_t, Entry> entries_;
+    uint64_t pending_;                                // Page of the fault in progress
+    bool pending_in_b2_;                              // The pending page was a B2 ghost
+
+    /**
+     * @brief Move a page to the front of a list, adding it if untracked
+     */
+    void moveTo(uint64_t page_number, List list);
+
+    /**
+     * @brief Drop a page from whichever list holds it
+     */
+    void erase(uint64_t page_number);
+
+    /**
+     * @brief Drop the oldest ghosts until B1 and B2 fit the directory
+     */
+    void trimGhosts();
+};
+
+/**
+ * @brief 2Q (Johnson and Shasha, 1994)
+ *
+ * A page faulted in for the first time enters A1in, a FIFO of about a
+ * quarter of the frames; evicted from there, it is remembered in A1out.
+ * A fault on a page in A1out shows reuse, so the page goes to Am, an LRU
+ * queue holding the rest. Pages touched once (a scan) never reach Am.
+ */
+class TwoQueueReplacer : public IPageReplacer {
+public:
+    /**
+     * @param capacity Resident pages (frames) the policy manages
+     */
+    explicit TwoQueueReplacer(size_t capacity);
+
+    void onAccess(uint64_t page_number) override;
+    void onFault(uint64_t page_number) override { (void)page_number; }
+    bool selectVictim(uint64_t& page_number) override;
+    void onEvict(uint64_t page_number) override;
+    void insert(uint64_t page_number) override;
+    void insertPrefetched(uint64_t page_number) override;
+    void remove(uint64_t page_number) override;
+    void reset() override;
+    PageReplacementPolicy getPolicy() const override { return PageReplacementPolicy::TWO_Q; }
+    std::string getStateString() const override;
+
+    /**
+     * @brief Get the sizes of A1in, Am and A1out (list index 0-2)
+     */
+    size_t getListSize(size_t list) const { return lists_[list].size(); }
+
+private:
+    enum List { A1_IN, AM, A1_OUT, NUM_LISTS };
+
+    struct Entry {
+        List list;
+        std::list<uint64_t>::iterator position;
+    };
+
+    size_t in_limit_;                                 // Kin: A1in size before it yields victims
+    size_t out_limit_;                                // Kout: A1out ghosts kept
+    std::list<uint64_t> lists_[NUM_LISTS];            // Front = most recent
+    std::unordered_map<uint64_t, Entry> entries_;
+
+    void moveTo(uint64_t page_number, List list);
+    void erase(uint64_t page_number);
+};
+
+/**
+ * @brief Low Inter-reference Recency Set (Jiang and Zhang, 2002)
+ *
+ * Pages whose last two accesses were close (low inter-reference recency)
+ * are LIR and hold all frames but a few; the rest are HIR. Resident HIR
+ * pages wait in queue Q and are the only victims. Stack S orders pages
+ * by recency, with an LIR page at the bottom: an HIR page accessed
+ * while still in S has reused sooner than the oldest LIR page, so the
+ * two swap status. S also keeps evicted HIR pages (at most capacity of
+ * them) so a quick return is recognized.
+ */
+class LirsReplacer : public IPageReplacer {
+public:
+    /**
+     * @param capacity Resident pages (frames) the policy manages (at least 2)
+     * @throws std::invalid_argument if capacity < 2
+     */
+    explicit LirsReplacer(size_t capacity);
+
+    void onAccess(uint64_t page_number) override;
+    void onFault(uint64_t page_number) override { (void)page_number; }
+    bool selectVictim(uint64_t& page_number) override;
+    void onEvict(uint64_t page_number) override;
+    void insert(uint64_t page_number) override;
+    void insertPrefetched(uint64_t page_number) override;
+    void remove(uint64_t page_number) override;
+    void reset() override;
+    PageReplacementPolicy getPolicy() const override { return PageReplacementPolicy::LIRS; }
+    std::string getStateString() const override;
+
+    size_t getLirPages() const { return lir_count_; }
+    size_t getResidentHirPages() const { return queue_.size(); }
+    size_t getNonResidentPages() const { return ghosts_.size(); }
+
+private:
+    enum class Status {
+        LIR,
+        HIR,           // Resident HIR page (in Q)
+        NON_RESIDENT   // Evicted HIR page still in S
+    };
+
+    using Iterator = std::list<uint64_t>::iterator;
+
+    struct Entry {
+        Status status;
+        bool in_stack;
+        Iterator stack_position;
+        Iterator queue_position;   // Q for resident HIR pages, ghosts_ for non-resident ones
+    };
+
+    size_t capacity_;
+    size_t lir_limit_;                                // Frames for LIR pages
+    size_t lir_count_;
+    std::list<uint64_t> stack_;                       // S: front = top (most recent)
+    std::list<uint64_t> queue_;                       // Q: front = next victim
+    std::list<uint64_t> ghosts_;                      // Non-resident pages in S, oldest first
+    std::unordered_map<uint64_t, Entry> entries_;
+
+    /**
+     * @brief Push a page on top of S
+     */
+    void pushStack(uint64_t page_number, Entry& entry);
+
+    /**
+     * @brief Turn the bottom LIR page of S into a resident HIR page
+     */
+    void demoteBottom();
+
+    /**
+     * @brief Pop HIR pages off the bottom of S until an LIR page is there
+     */
+    void prune();
+
+    /**
+     * @brief Drop a page's entry and every list position it holds
+     */
+    void forget(uint64_t page_number);
+};
+
+/**
+ * @brief Belady's optimal replacement (OPT), given the future accesses
+ *
+ * The whole access sequence is scanned up front into each page's sorted
+ * list of positions; a victim is the resident page whose next position
+ * after the current one is furthest away (or that is never used again),
+ * which gives the minimum number of faults for the sequence. Every
+ * onAccess() and onFault() moves one position along the sequence; pages
+ * are looked up by the key the caller reports, so it is exact for base
+ * pages. Without a sequence every page counts as never used again, and
+ * reset() keeps the sequence and the position in it.
+ */
+class OptimalReplacer : public IPageReplacer {
+public:
+    static constexpr uint64_t NEVER = UINT64_MAX;   // Next use of a page not accessed again
+
+    OptimalReplacer() : length_(0), position_(0) {}
+
+    /**
+     * @brief Set the future access sequence and restart at its beginning
+     *
+     * @param pages Page number of every access, in order
+     */
+    void setFuture(const std::vector<uint64_t>& pages);
+
+    /**
+     * @brief Position of a page's next access at or after a position
+     */
+    uint64_t nextUse(uint64_t page_number, uint64_t from) const;
+
+    void onAccess(uint64_t page_number) override;
+    void onFault(uint64_t page_number) override { (void)page_number; position_++; }
+    bool selectVictim(uint64_t& page_number) override;
+    void onEvict(uint64_t page_number) override { remove(page_number); }
+    void insert(uint64_t page_number) override;
+    void insertPrefetched(uint64_t page_number) override { insert(page_number); }
+    void remove(uint64_t page_number) override;
+    void reset() override;
+    PageReplacementPolicy getPolicy() const override { return PageReplacementPolicy::OPTIMAL; }
+    std::string getStateString() const override;
+
+    /**
+     * @brief Get the position of the next access in the future sequence
+     */
+    uint64_t getPosition() const { return position_; }
+
+private:
+    std::unordered_map<uint64_t, std::vector<uint64_t>> uses_;   // Page -> positions, ascending
+    uint64_t length_;                                            // Accesses in the sequence
+    uint64_t position_;
+    std::set<std::pair<uint64_t, uint64_t>> by_next_use_;        // (next use, page) of resident pages
+    std::unordered_map<uint64_t, uint64_t> next_use_;            // Resident page -> its next use
+};
+
+/**
+ * @brief Create the replacer of a policy that keeps its own page lists
+ *
+ * @param policy Page replacement policy
+ * @param capacity Resident pages (frames) the policy manages
+ * @return The replacer, or nullptr for policies VirtualMemory handles itself
+ */
+std::unique_ptr<IPageReplacer> createPageReplacer(PageReplacementPolicy policy, size_t capacity);
+
+} // namespace memsim
+
+#endif // MEMSIM_VIRTUAL_MEMORY_PAGE_REPLACER_H
@@ -10,17 +10,24 @@ namespace memsim {
  * @brief Entry in a page table
  *
  * Each page table entry maps a virtual page number to a physical frame number
- * and stores metadata for page replacement policies.
+ * and stores metadata for page replacement policies. Resident entries can
+ * be threaded on an intrusive LRU list owned by VirtualMemory.
  */
 struct PageTableEntry {
     bool valid;              // Is this page currently in physical memory?
     Address frame_number;    // Physical frame number (if valid)
     bool dirty;              // Has this page been modified?
     bool referenced;         // Has this page been accessed? (for Clock algorithm)
+    PageSize size;           // Base page, or huge page covering several base pages
+    bool prefetched;         // Mapped ahead of use (readahead, fault-around), not accessed since
 
     // Metadata for page replacement policies
     uint64_t load_time;      // When was this page loaded? (for FIFO)
     uint64_t last_access;    // When was this page last accessed? (for LRU)
+    uint64_t virtual_page;   // First virtual page mapped (set while valid)
+    uint64_t fifo_stamp;     // Stamp of its live FIFO queue entry (0: none)
+    PageTableEntry* lru_prev;   // More recently used neighbour (LRU list)
+    PageTableEntry* lru_next;   // Less recently used neighbour (LRU list)
 
     /**
      * @brief Construct an invalid page table entry
@@ -30,8 +37,14 @@ struct PageTableEntry {
           frame_number(0),
           dirty(false),
           referenced(false),
+          size(PageSize::BASE),
+          prefetched(false),
           load_time(0),
-          last_access(0) {}
+          last_access(0),
+          virtual_page(0),
+          fifo_stamp(0),
+          lru_prev(nullptr),
+          lru_next(nullptr) {}
 
     /**
      * @brief Reset entry to invalid state
@@ -41,8 +54,14 @@ struct PageTableEntry {
         frame_number = 0;
         dirty = false;
         referenced = false;
+        size = PageSize::BASE;
+        prefetched = false;
         load_time = 0;
         last_access = 0;
+        virtual_page = 0;
+        fifo_stamp = 0;
+        lru_prev = nullptr;
+        lru_next = nullptr;
     }
 
     /**
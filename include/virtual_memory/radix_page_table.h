@@ -0,0 +1,209 @@
+#ifndef MEMSIM_VIRTUAL_MEMORY_RADIX_PAGE_TABLE_H
+#define MEMSIM_VIRTUAL_MEMORY_RADIX_PAGE_TABLE_H
+
+#include "common/types.h"
+#include "virtual_memory/page_table_entry.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Sparse multi-level radix page table
+ *
+ * The virtual page number is split into one index per level, level 0
+ * (the root) taking the most significant bits. Interior nodes hold
+ * pointers to the nodes below and leaf nodes hold the PageTableEntry
+ * array; only the root exists up front and every other node is
+ * allocated the first time a page below it is inserted, so memory grows
+ * with the pages touched rather than with the virtual address space.
+ *
+ * Bits are spread evenly over the levels; when they do not divide, the
+ * lower levels get one more bit each. Nodes are kept once built, as in
+ * an OS that keeps page-table pages, until collapse() or clear().
+ *
+ * An entry above the leaf level can itself map a huge page covering all
+ * pages below it (as a 2 MB or 1 GB x86-64 mapping does). Such an entry
+ * and a next-level node are never present at the same index.
+ *
+ * Every node also has a byte offset in a notional page-table region
+ * (PTE_BYTES per entry, nodes laid out in allocation order), so a walk
+ * can be replayed as memory references.
+ */
+class RadixPageTable {
+public:
+    static constexpr size_t MIN_LEVELS = 2;
+    static constexpr size_t MAX_LEVELS = 5;
+    static constexpr size_t PTE_BYTES = 8;   // Size of one entry in the page-table region
+
+    /**
+     * @brief Construct an empty page table (root node only)
+     *
+     * @param page_number_bits Bits of the virtual page number
+     * @param levels Number of levels (MIN_LEVELS to MAX_LEVELS)
+     * @throws std::invalid_argument if levels is out of range or the page number has over 64 bits
+     */
+    RadixPageTable(size_t page_number_bits, size_t levels);
+
+    ~RadixPageTable() = default;
+
+    /**
+     * @brief Find the entry mapping a page without allocating
+     * @return The valid huge entry covering the page, else its leaf entry,
+     *         or nullptr if no leaf node covers the page yet
+     */
+    PageTableEntry* find(uint64_t page_number);
+    const PageTableEntry* find(uint64_t page_number) const;
+
+    /**
+     * @brief Get a page's entry at a level, allocating the missing nodes above it
+     *
+     * An entry above the leaf level maps a huge page; the caller must
+     * collapse() any node below it first.
+     *
+     * @param page_number Virtual page number
+     * @param level Level of the entry (default: leaf level)
+     */
+    PageTableEntry& insert(uint64_t page_number);
+    PageTableEntry& insert(uint64_t page_number, size_t level);
+
+    /**
+     * @brief Free the node (and everything under it) below a page's entry at a level
+     *
+     * @param page_number Virtual page number
+     * @param level Level of the entry whose subtree is dropped (not the leaf level)
+     */
+    void collapse(uint64_t page_number, size_t level);
+
+    /**
+     * @brief Replay the walk of a page as page-table region offsets
+     *
+     * One entry is read per level from the root down; the walk stops
+     * after a huge-page entry or the first entry whose next-level node
+     * does not exist.
+     *
+     * @param page_number Virtual page number
+     * @param entry_offsets Output: replaced with the byte offsets of the entries read
+     * @return Number of entries read (1 to levels)
+     */
+    size_t walk(uint64_t page_number, std::vector<uint64_t>& entry_offsets) const;
+
+    /**
+     * @brief Bits of the page number that select the entry read at a level
+     *
+     * Pages with equal prefixes at a level share the path down to it, so
+     * the prefix is the tag of a page-walk cache for that level.
+     */
+    uint64_t prefix(uint64_t page_number, size_t level) const {
+        return page_number >> shifts_[level];
+    }
+
+    /**
+     * @brief Visit every valid entry in ascending page order
+     *
+     * A huge-page entry is visited once, with the first page it covers.
+     */
+    void forEachValid(const std::function<void(uint64_t, PageTableEntry&)>& visit);
+    void forEachValid(const std::function<void(uint64_t, const PageTableEntry&)>& visit) const;
+
+    /**
+     * @brief Find the first valid page at or after a page number
+     *
+     * A huge-page entry counts as the first page it covers.
+     *
+     * @param from Page number to start from
+     * @param page_number Output: the valid page found
+     * @return true if one exists
+     */
+    bool nextValid(uint64_t from, uint64_t& page_number) const;
+
+    /**
+     * @brief Drop every node except an empty root
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of levels
+     */
+    size_t getLevels() const { return bits_.size(); }
+
+    /**
+     * @brief Get the index bits of a level (0 = root)
+     */
+    size_t getLevelBits(size_t level) const { return bits_[level]; }
+
+    /**
+     * @brief Get the number of base pages an entry at a level covers
+     */
+    uint64_t getPagesPerEntry(size_t level) const { return 1ULL << shifts_[level]; }
+
+    /**
+     * @brief Get the number of allocated nodes, root included
+     */
+    size_t getNumNodes() const { return num_nodes_; }
+
+    /**
+     * @brief Get the bytes of page-table region the allocated nodes occupy
+     *
+     * Offsets of collapsed nodes are not reused, so walks of new nodes
+     * land on new addresses.
+     */
+    uint64_t getTableBytes() const { return table_bytes_; }
+
+private:
+    struct Node {
+        uint64_t offset;                               // Byte offset in the page-table region
+        std::vector<std::unique_ptr<Node>> children;   // Interior levels: one per index
+        std::vector<PageTableEntry> entries;           // Leaf level: one per index; interior:
+                                                       // huge-page entries, sized on first use
+    };
+
+    std::vector<size_t> bits_;     // Index bits per level, root first
+    std::vector<size_t> shifts_;   // Page number shift of each level's index
+    std::unique_ptr<Node> root_;
+    size_t num_nodes_;
+    uint64_t table_bytes_;         // Bytes of the live nodes
+    uint64_t next_offset_;         // Region offset of the next node allocated
+
+    /**
+     * @brief Index of a page's entry within a node of a level
+     */
+    size_t indexAt(uint64_t page_number, size_t level) const {
+        return static_cast<size_t>((page_number >> shifts_[level]) & ((1ULL << bits_[level]) - 1));
+    }
+
+    /**
+     * @brief Allocate a node for a level, assigning its region offset
+     */
+    std::unique_ptr<Node> makeNode(size_t level);
+
+    /**
+     * @brief Account the nodes of a subtree being freed
+     */
+    void releaseNode(const Node& node, size_t level);
+
+    /**
+     * @brief Whether an interior node holds a valid huge-page entry at an index
+     */
+    static bool hasHugeEntry(const Node& node, size_t index) {
+        return !node.entries.empty() && node.entries[index].valid;
+    }
+
+    /**
+     * @brief Depth-first visit of the valid entries below a node
+     */
+    void visitNode(Node& node, size_t level, uint64_t base,
+                   const std::function<void(uint64_t, PageTableEntry&)>& visit);
+
+    /**
+     * @brief Depth-first search for the first valid page >= from below a node
+     */
+    bool searchNode(const Node& node, size_t level, uint64_t base, uint64_t from,
+                    uint64_t& page_number) const;
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_VIRTUAL_MEMORY_RADIX_PAGE_TABLE_H
@@ -0,0 +1,253 @@
+#ifndef MEMSIM_VIRTUAL_MEMORY_SWAP_DEVICE_H
+#define MEMSIM_VIRTUAL_MEMORY_SWAP_DEVICE_H
+
+#include "common/result.h"
+#include "virtual_memory/swap_io_engine.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief I/O counters of a swap device
+ */
+struct SwapStats {
+    uint64_t reads;            // Pages read back from their slots
+    uint64_t writes;           // Pages written to their slots
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t peak_slots;       // Most slots in use at once
+    uint64_t errors;           // Failed reads and writes
+    uint64_t completed;        // Transfers finished (latency samples)
+    uint64_t total_latency_ns; // Submission to completion, summed over completed transfers
+    uint64_t max_latency_ns;
+    uint64_t wait_ns;          // Time the caller blocked on transfers
+    uint64_t batches;          // Write batches submitted (async)
+    uint64_t max_queue_depth;  // Most transfers queued or running at once (async)
+    uint64_t total_queue_depth;   // Queue depth after each submission, summed (async)
+    uint64_t submissions;      // Batches and prefetches submitted (async)
+    uint64_t buffer_hits;      // Reads served from a write still queued or in flight (async)
+    uint64_t prefetches;       // Reads started ahead of their fault (async)
+    uint64_t prefetch_hits;    // Reads that found their prefetch issued (async)
+
+    SwapStats()
+        : reads(0), writes(0), bytes_read(0), bytes_written(0), peak_slots(0), errors(0),
+          completed(0), total_latency_ns(0), max_latency_ns(0), wait_ns(0), batches(0),
+          max_queue_depth(0), total_queue_depth(0), submissions(0), buffer_hits(0),
+          prefetches(0), prefetch_hits(0) {}
+
+    double getAverageLatencyUs() const {
+        if (completed == 0) return 0.0;
+        return static_cast<double>(total_latency_ns) / completed / 1000.0;
+    }
+
+    double getAverageQueueDepth() const {
+        if (submissions == 0) return 0.0;
+        return static_cast<double>(total_queue_depth) / submissions;
+    }
+};
+
+/**
+ * @brief Swap space for evicted pages, backed by a local file
+ *
+ * The file is an array of page-sized slots. A page gets a slot the first
+ * time it is written out and keeps it, so a page that is evicted again
+ * overwrites its own slot; released slots are reused before the file
+ * grows. Pages are moved with pread/pwrite at slot * page_size.
+ *
+ * By default every transfer blocks the caller. In async mode a
+ * SwapIoEngine moves pages on worker threads:
+ * - Writes are copied into requests and submitted a batch at a time, so
+ *   eviction never waits for the disk. A later write of the same page
+ *   replaces its queued copy, or waits for its in-flight one, so writes
+ *   to a slot land in order.
+ * - A read of a page whose write has not completed is served from that
+ *   write's copy; any other read blocks, unless prefetch() issued it
+ *   earlier and it has already overlapped with the caller's work.
+ */
+class SwapDevice {
+public:
+    static constexpr size_t DEFAULT_BATCH_SIZE = 16;
+    static constexpr size_t MAX_PREFETCHES = 256;   // Prefetched pages waiting to be read
+
+    SwapDevice() : fd_(-1), page_size_(0), next_slot_(0), delay_(0), batch_size_(DEFAULT_BATCH_SIZE) {}
+
+    ~SwapDevice();
+
+    SwapDevice(const SwapDevice&) = delete;
+    SwapDevice& operator=(const SwapDevice&) = delete;
+
+    /**
+     * @brief Create (or truncate) a swap file
+     *
+     * @param path File to hold the slots
+     * @param page_size Bytes per slot
+     * @return Result indicating success or error
+     */
+    Result<void> open(const std::string& path, size_t page_size);
+
+    /**
+     * @brief Close the file, dropping every slot (the file is kept)
+     */
+    void close();
+
+    /**
+     * @brief Check if a swap file is open
+     */
+    bool isOpen() const { return fd_ >= 0; }
+
+    /**
+     * @brief Move pages on worker threads, or back on the caller
+     *
+     * Switching finishes every outstanding transfer first.
+     *
+     * @param num_threads Worker threads (0 makes every transfer synchronous)
+     * @param batch_size Writes gathered before they are submitted together
+     * @return Result indicating success or error
+     */
+    Result<void> setAsync(size_t num_threads, size_t batch_size = DEFAULT_BATCH_SIZE);
+
+    /**
+     * @brief Check if transfers run on worker threads
+     */
+    bool isAsync() const { return engine_ != nullptr; }
+
+    size_t getNumThreads() const { return engine_ ? engine_->getNumThreads() : 0; }
+    size_t getBatchSize() const { return batch_size_; }
+
+    /**
+     * @brief Make every transfer take at least this long, like a disk or network device
+     *
+     * A cached swap file answers in well under a microsecond, less than a
+     * thread handoff costs; the delay models a device whose reads block, on
+     * which transfers overlapped by the async engine save time.
+     *
+     * @param microseconds Added to each transfer (0 for none)
+     */
+    void setDeviceDelay(uint64_t microseconds);
+
+    uint64_t getDeviceDelay() const { return static_cast<uint64_t>(delay_.count()); }
+
+    /**
+     * @brief Write a page to its slot, allocating one if it has none
+     *
+     * In async mode the page is queued and the result only reports slot
+     * allocation; transfer failures show in the stats' errors.
+     *
+     * @param page_number Virtual page
+     * @param data page_size bytes
+     * @return Result indicating success or error
+     */
+    Result<void> writePage(uint64_t page_number, const uint8_t* data);
+
+    /**
+     * @brief Read a page back from its slot
+     *
+     * @param page_number Virtual page
+     * @param data Output: page_size bytes
+     * @return true if the page had a slot, false if it was never written; error on I/O failure
+     */
+    Result<bool> readPage(uint64_t page_number, uint8_t* data);
+
+    /**
+     * @brief Start reading a page ahead of its use (async mode only)
+     *
+     * @return true if a read was issued; false if the page has no slot, is
+     *         already buffered or issued, or MAX_PREFETCHES unfinished reads wait
+     */
+    bool prefetch(uint64_t page_number);
+
+    /**
+     * @brief Submit the queued writes and wait for every transfer to finish
+     */
+    void sync();
+
+    /**
+     * @brief Check if a page has a slot
+     */
+    bool hasSlot(uint64_t page_number) const { return slots_.count(page_number) > 0; }
+
+    /**
+     * @brief Free a page's slot (its contents are discarded)
+     */
+    void release(uint64_t page_number);
+
+    /**
+     * @brief Free every slot and shrink the file to nothing
+     */
+    void releaseAll();
+
+    const SwapStats& getStats() const { return stats_; }
+    const std::string& getPath() const { return path_; }
+    size_t getPageSize() const { return page_size_; }
+    size_t getSlotsInUse() const { return slots_.size(); }
+
+    /**
+     * @brief Get the number of slots the file holds (in use or free)
+     */
+    uint64_t getFileSlots() const { return next_slot_; }
+
+    /**
+     * @brief Get the number of transfers queued or running (async mode)
+     */
+    size_t getQueueDepth() const { return engine_ ? engine_->getInFlight() : 0; }
+
+private:
+    using Request = std::shared_ptr<SwapRequest>;
+
+    int fd_;
+    std::string path_;
+    size_t page_size_;
+    std::unordered_map<uint64_t, uint64_t> slots_;   // Virtual page -> slot
+    std::vector<uint64_t> free_slots_;               // Released slots, reused last first
+    uint64_t next_slot_;                             // First slot past the end of the file
+    std::chrono::microseconds delay_;                // Added to every transfer
+    SwapStats stats_;
+
+    // Async mode
+    std::unique_ptr<SwapIoEngine> engine_;
+    size_t batch_size_;
+    std::vector<Request> batch_;                      // Writes not yet submitted
+    std::unordered_map<uint64_t, Request> writes_;    // Latest unfinished write per page
+    std::unordered_map<uint64_t, Request> prefetched_;   // Issued reads not yet consumed
+    std::vector<Request> completed_;                  // Scratch for reap()
+
+    /**
+     * @brief Get a page's slot, allocating one if it has none
+     */
+    uint64_t allocateSlot(uint64_t page_number);
+
+    /**
+     * @brief Submit the writes gathered in batch_
+     */
+    void submitBatch();
+
+    /**
+     * @brief Account a submission's queue depth
+     */
+    void recordDepth(size_t depth);
+
+    /**
+     * @brief Account a finished transfer's latency
+     */
+    void recordLatency(uint64_t latency_ns);
+
+    /**
+     * @brief Retire finished transfers: account them and drop completed writes
+     */
+    void reap();
+
+    /**
+     * @brief Block on a submitted request, accounting the wait
+     */
+    void waitFor(const Request& request);
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_VIRTUAL_MEMORY_SWAP_DEVICE_H
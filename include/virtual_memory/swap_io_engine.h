@@ -0,0 +1,136 @@
+#ifndef MEMSIM_VIRTUAL_MEMORY_SWAP_IO_ENGINE_H
+#define MEMSIM_VIRTUAL_MEMORY_SWAP_IO_ENGINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief One page transfer between memory and a swap slot
+ *
+ * Owned jointly by the submitter and the engine. Once submitted, only
+ * the engine writes it until done is set; the submitter may read data
+ * meanwhile (the engine only reads it for a write).
+ */
+struct SwapRequest {
+    bool is_write;
+    uint64_t page_number;
+    uint64_t slot;
+    std::vector<uint8_t> data;   // Page contents: source of a write, destination of a read
+    bool submitted;              // Handed to the engine
+    bool done;                   // Guarded by the engine's lock
+    int error;                   // 0, or the errno of a failed transfer
+    uint64_t latency_ns;         // Submission to completion
+    std::chrono::steady_clock::time_point submitted_at;
+
+    SwapRequest(bool write, uint64_t page, uint64_t slot_index, size_t page_size)
+        : is_write(write), page_number(page), slot(slot_index), data(page_size, 0),
+          submitted(false), done(false), error(0), latency_ns(0) {}
+};
+
+/**
+ * @brief Asynchronous swap I/O on a pool of worker threads
+ *
+ * Requests are queued in batches under one lock and picked up by the
+ * workers, which transfer each page with pread/pwrite on the shared file
+ * descriptor, so independent transfers overlap with each other and with
+ * the submitting thread. Completed requests are collected by the
+ * submitter; ordering between requests for the same slot is left to it.
+ */
+class SwapIoEngine {
+public:
+    /**
+     * @brief Start the worker threads
+     *
+     * @param fd Open swap file
+     * @param num_threads Worker threads (at least 1)
+     * @throws std::invalid_argument if num_threads is 0
+     */
+    SwapIoEngine(int fd, size_t num_threads);
+
+    /**
+     * @brief Finish the queued requests and stop the workers
+     */
+    ~SwapIoEngine();
+
+    SwapIoEngine(const SwapIoEngine&) = delete;
+    SwapIoEngine& operator=(const SwapIoEngine&) = delete;
+
+    /**
+     * @brief Queue a batch of requests
+     *
+     * @return Requests queued or running after the batch was added
+     */
+    size_t submit(const std::vector<std::shared_ptr<SwapRequest>>& batch);
+
+    /**
+     * @brief Block until a submitted request is done
+     */
+    void wait(const std::shared_ptr<SwapRequest>& request);
+
+    /**
+     * @brief Block until every submitted request is done
+     */
+    void drain();
+
+    /**
+     * @brief Check if a submitted request is done, without blocking
+     */
+    bool isDone(const std::shared_ptr<SwapRequest>& request) const;
+
+    /**
+     * @brief Move the requests completed since the last call into completed
+     */
+    void collect(std::vector<std::shared_ptr<SwapRequest>>& completed);
+
+    /**
+     * @brief Get the number of requests queued or running
+     */
+    size_t getInFlight() const;
+
+    size_t getNumThreads() const { return workers_.size(); }
+
+    /**
+     * @brief Make every later transfer take at least delay, as on a slow device
+     */
+    void setDelay(std::chrono::microseconds delay);
+
+    /**
+     * @brief Transfer a whole page, retrying short and interrupted transfers
+     *
+     * @param delay Time the transfer holds the calling thread, on top of the I/O
+     * @return 0, or the errno of the failure (EIO for a read past the end)
+     */
+    static int transfer(int fd, bool is_write, uint8_t* data, size_t size, uint64_t offset,
+                        std::chrono::microseconds delay = std::chrono::microseconds(0));
+
+private:
+    int fd_;
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<SwapRequest>> queue_;
+    std::vector<std::shared_ptr<SwapRequest>> completed_;
+    size_t in_flight_;                     // Queued plus running
+    size_t waiters_;                       // Threads blocked in wait() or drain()
+    std::chrono::microseconds delay_;      // Added to every transfer
+    bool stopping_;
+    mutable std::mutex mutex_;
+    std::condition_variable work_ready_;   // Workers: queue_ not empty or stopping_
+    std::condition_variable work_done_;    // Waiters: a request completed
+
+    /**
+     * @brief Worker thread body
+     */
+    void run();
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_VIRTUAL_MEMORY_SWAP_IO_ENGINE_H
@@ -0,0 +1,262 @@
+#ifndef MEMSIM_VIRTUAL_MEMORY_TLB_H
+#define MEMSIM_VIRTUAL_MEMORY_TLB_H
+
+#include "common/types.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace memsim {
+
+/**
+ * @brief Configuration of one TLB level
+ */
+struct TLBConfig {
+    size_t sets;              // Number of sets (power of 2)
+    size_t associativity;     // Entries per set
+    TLBPolicy policy;
+    uint64_t hit_cycles;      // Lookup latency, charged to every translation that reaches this level
+};
+
+/**
+ * @brief Statistics of one TLB level
+ */
+struct TLBStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t accesses;
+    uint64_t evictions;       // Valid entries replaced by a fill
+    uint64_t invalidations;   // Entries removed by a shootdown
+
+    TLBStats() : hits(0), misses(0), accesses(0), evictions(0), invalidations(0) {}
+
+    double getHitRatio() const {
+        if (accesses == 0) return 0.0;
+        return (static_cast<double>(hits) / accesses) * 100.0;
+    }
+
+    double getMissRatio() const {
+        if (accesses == 0) return 0.0;
+        return (static_cast<double>(misses) / accesses) * 100.0;
+    }
+};
+
+/**
+ * @brief One set-associative level of translation lookaside buffer
+ *
+ * Caches virtual page number -> physical frame number mappings. The set
+ * is selected by the low bits of the page number.
+ */
+class TLB {
+public:
+    /**
+     * @brief Construct a TLB level
+     *
+     * @param name Name used in reports (e.g. "dTLB")
+     * @param config Geometry, replacement policy and latency
+     * @throws std::invalid_argument if the geometry is invalid
+     */
+    TLB(const std::string& name, const TLBConfig& config);
+
+    ~TLB() = default;
+
+    /**
+     * @brief Look up a page, counting a hit or miss
+     *
+     * @param page_number Virtual page number
+     * @param frame_number Output: frame number on a hit
+     * @return true on a hit
+     */
+    bool lookup(uint64_t page_number, Address& frame_number);
+
+    /**
+     * @brief Insert a mapping, replacing a victim if the set is full
+     *
+     * An existing entry for the page is updated in place.
+     */
+    void insert(uint64_t page_number, Address frame_number);
+
+    /**
+     * @brief Remove a page's entry (shootdown)
+     * @return true if the TLB held the page
+     */
+    bool invalidate(uint64_t page_number);
+
+    /**
+     * @brief Invalidate every entry
+     */
+    void flush();
+
+    /**
+     * @brief Check if the TLB holds a page (no statistics or replacement updates)
+     */
+    bool contains(uint64_t page_number) const;
+
+    /**
+     * @brief Get the configuration
+     */
+    const TLBConfig& getConfig() const { return config_; }
+
+    /**
+     * @brief Get the number of entries (sets x associativity)
+     */
+    size_t getNumEntries() const { return entries_.size(); }
+
+    /**
+     * @brief Get statistics
+     */
+    const TLBStats& getStats() const { return stats_; }
+
+    /**
+     * @brief Get formatted statistics string
+     */
+    std::string getStatsString() const;
+
+    /**
+     * @brief Get configuration string
+     */
+    std::string getConfigString() const;
+
+private:
+    struct Entry {
+        bool valid;
+        uint64_t page_number;
+        Address frame_number;
+        uint64_t last_used;   // For LRU
+        uint64_t inserted;    // For FIFO
+
+        Entry() : valid(false), page_number(0), frame_number(0), last_used(0), inserted(0) {}
+    };
+
+    std::string name_;
+    TLBConfig config_;
+    std::vector<Entry> entries_;   // Set-major: set s occupies [s * associativity, (s + 1) * associativity)
+    uint64_t clock_;               // Lookups and inserts, the LRU/FIFO time base
+    uint64_t random_state_;        // xorshift state for RANDOM
+    TLBStats stats_;
+
+    /**
+     * @brief Index of the page's entry, or entries_.size() if absent
+     */
+    size_t find(uint64_t page_number) const;
+
+    /**
+     * @brief Pick the entry to replace within a set (an invalid one if any)
+     */
+    size_t selectVictim(size_t set);
+};
+
+/**
+ * @brief Where a translation was found
+ */
+enum class TLBOutcome {
+    DTLB_HIT,   // First-level data TLB
+    STLB_HIT,   // Second-level unified TLB (the dTLB is refilled)
+    MISS        // Page table walk needed
+};
+
+/**
+ * @brief Two-level TLB: a first-level dTLB backed by a unified STLB
+ *
+ * A lookup probes the dTLB, then the STLB; an STLB hit refills the
+ * dTLB. After a miss the page table walk fills both levels, which are
+ * non-inclusive (each replaces its own victims). Translations pay the
+ * dTLB latency, plus the STLB latency on a dTLB miss, plus the walk
+ * latency on an STLB miss.
+ *
+ * A page leaving memory must be shot down from both levels.
+ */
+class TLBHierarchy {
+public:
+    static constexpr uint64_t DEFAULT_DTLB_CYCLES = 0;   // Overlapped with the L1 cache lookup
+    static constexpr uint64_t DEFAULT_STLB_CYCLES = 7;
+    static constexpr uint64_t DEFAULT_WALK_CYCLES = 30;
+
+    /**
+     * @brief Construct a two-level TLB
+     *
+     * @param dtlb First-level data TLB configuration
+     * @param stlb Second-level unified TLB configuration
+     * @param walk_cycles Page table walk latency (the miss latency)
+     * @throws std::invalid_argument if a level's geometry is invalid
+     */
+    TLBHierarchy(const TLBConfig& dtlb, const TLBConfig& stlb,
+                 uint64_t walk_cycles = DEFAULT_WALK_CYCLES);
+
+    ~TLBHierarchy() = default;
+
+    /**
+     * @brief Look up a page in the dTLB, then the STLB
+     *
+     * @param page_number Virtual page number
+     * @param frame_number Output: frame number unless the outcome is MISS
+     */
+    TLBOutcome lookup(uint64_t page_number, Address& frame_number);
+
+    /**
+     * @brief Fill both levels with a mapping produced by a page table walk
+     */
+    void fill(uint64_t page_number, Address frame_number);
+
+    /**
+     * @brief Invalidate a page in both levels (its mapping changed or it was evicted)
+     */
+    void shootdown(uint64_t page_number);
+
+    /**
+     * @brief Invalidate every entry of both levels
+     */
+    void flush();
+
+    /**
+     * @brief Cycles a translation with the given outcome costs
+     */
+    uint64_t getCycles(TLBOutcome outcome) const;
+
+    /**
+     * @brief Get the first-level data TLB
+     */
+    const TLB& getDTLB() const { return dtlb_; }
+
+    /**
+     * @brief Get the second-level unified TLB
+     */
+    const TLB& getSTLB() const { return stlb_; }
+
+    /**
+     * @brief Get the page table walk latency
+     */
+    uint64_t getWalkCycles() const { return walk_cycles_; }
+
+    /**
+     * @brief Number of shootdowns requested
+     */
+    uint64_t getShootdowns() const { return shootdowns_; }
+
+    /**
+     * @brief Get formatted statistics string for both levels
+     */
+    std::string getStatsString() const;
+
+private:
+    TLB dtlb_;
+    TLB stlb_;
+    uint64_t walk_cycles_;
+    uint64_t shootdowns_;
+};
+
+/**
+ * @brief Helper function to convert TLBPolicy to string
+ */
+inline std::string tlbPolicyToString(TLBPolicy policy) {
+    switch (policy) {
+        case TLBPolicy::LRU: return "LRU";
+        case TLBPolicy::FIFO: return "FIFO";
+        case TLBPolicy::RANDOM: return "Random";
+        default: return "Unknown";
+    }
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_VIRTUAL_MEMORY_TLB_H
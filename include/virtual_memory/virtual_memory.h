@@ -3,15 +3,39 @@
 
 #include "common/types.h"
 #include "common/result.h"
+#include "virtual_memory/clock_pro.h"
+#include "virtual_memory/free_frame_bitmap.h"
+#include "virtual_memory/page_replacer.h"
 #include "virtual_memory/page_table_entry.h"
+#include "virtual_memory/radix_page_table.h"
+#include "virtual_memory/swap_device.h"
+#include "virtual_memory/tlb.h"
 #include "memory/physical_memory.h"
+#include <array>
+#include <memory>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <string>
 #include <cstdint>
 
 namespace memsim {
 
+class CacheHierarchy;
+
+static constexpr size_t NUM_PAGE_SIZES = 3;   // Entries of PageSize
+
+/**
+ * @brief Virtual memory counters of one page size
+ */
+struct PageSizeStats {
+    uint64_t faults;       // Faults that mapped a page of this size
+    uint64_t tlb_hits;     // TLB hits on mappings of this size
+    uint64_t tlb_misses;   // TLB misses resolved to a mapping of this size
+    uint64_t mappings;     // Pages of this size currently resident
+
+    PageSizeStats() : faults(0), tlb_hits(0), tlb_misses(0), mappings(0) {}
+};
+
 /**
  * @brief Statistics for virtual memory system
  */
@@ -19,8 +43,39 @@ struct VirtualMemoryStats {
     uint64_t page_faults;
     uint64_t page_hits;
     uint64_t total_accesses;
-
-    VirtualMemoryStats() : page_faults(0), page_hits(0), total_accesses(0) {}
+    uint64_t page_writebacks;   // Dirty pages written to disk on eviction
+    uint64_t clean_evictions;   // Evicted mappings that were clean, so skipped the writeback
+    uint64_t disk_cycles;       // Simulated cycles spent loading and writing back pages
+    uint64_t dtlb_hits;         // Translations found in the dTLB (TLB attached)
+    uint64_t stlb_hits;         // Translations found in the STLB after a dTLB miss
+    uint64_t page_walks;        // Translations that missed both TLB levels
+    uint64_t translation_cycles;   // Simulated cycles spent in TLB lookups and page walks
+    uint64_t walk_references;   // Page-table entries read by walks
+    uint64_t pwc_hits;          // Walks that skipped upper levels through the page-walk cache
+    uint64_t pwc_misses;        // Walks that started at the root (page-walk cache attached)
+    uint64_t walk_cycles;       // Cycles of walk references served by the cache hierarchy
+    std::array<PageSizeStats, NUM_PAGE_SIZES> by_size;   // Indexed by PageSize
+    uint64_t promotions;        // Regions collapsed into a huge page
+    uint64_t demotions;         // Huge pages split into smaller pages
+    uint64_t huge_fallbacks;    // Huge-page faults mapped smaller for lack of aligned free frames
+    uint64_t clock_scans;       // Mappings the Clock, two-handed Clock and WSClock hands passed
+    uint64_t page_cleanings;    // Dirty pages WSClock wrote back ahead of their eviction
+    uint64_t free_frames;       // Physical frames currently free
+    uint64_t min_free_frames;   // Fewest frames free at any point (low watermark)
+    uint64_t readahead_windows;   // Readahead windows issued for sequential streams
+    uint64_t readahead_pages;   // Pages mapped by readahead
+    uint64_t fault_around_pages;   // Neighbours mapped by fault-around
+    uint64_t prefetch_hits;     // Prefetched pages accessed before their eviction
+    uint64_t prefetch_wasted;   // Prefetched pages evicted without an access
+
+    VirtualMemoryStats()
+        : page_faults(0), page_hits(0), total_accesses(0), page_writebacks(0), clean_evictions(0),
+          disk_cycles(0),
+          dtlb_hits(0), stlb_hits(0), page_walks(0), translation_cycles(0),
+          walk_references(0), pwc_hits(0), pwc_misses(0), walk_cycles(0),
+          promotions(0), demotions(0), huge_fallbacks(0), clock_scans(0), page_cleanings(0),
+          free_frames(0), min_free_frames(0), readahead_windows(0), readahead_pages(0),
+          fault_around_pages(0), prefetch_hits(0), prefetch_wasted(0) {}
 
     double getPageFaultRate() const {
         if (total_accesses == 0) return 0.0;
@@ -37,8 +92,12 @@ struct VirtualMemoryStats {
  * @brief Virtual memory system with paging and page replacement
  *
  * Provides address translation from virtual addresses to physical addresses
- * using a page table. Implements page replacement policies (FIFO, LRU, Clock)
- * when physical memory is full.
+ * using a sparse multi-level radix page table (RadixPageTable), with an
+ * optional TLB and page-walk cache in front of it. Implements page
+ * replacement policies (FIFO, LRU, the clocks, CLOCK-Pro, ARC, 2Q, LIRS
+ * and Belady's OPT) when physical memory is full. Faults can map huge
+ * pages or prefetch neighbouring pages, and evicted dirty pages can be
+ * kept on a swap device.
  *
  * Virtual Address format:
  * | Page Number | Page Offset |
@@ -51,17 +110,24 @@ public:
     /**
      * @brief Construct virtual memory system
      *
+     * Clock evicts the first mapping whose reference bit it finds clear;
+     * CLOCK-Pro (ClockPro) keeps hot and cold mappings and remembers
+     * recently evicted cold pages, adapting the cold share to reuse. ARC,
+     * 2Q, LIRS and OPT keep their own page lists in an IPageReplacer.
+     *
      * @param memory Pointer to physical memory
      * @param num_virtual_pages Total number of virtual pages
      * @param num_physical_frames Number of physical frames available
      * @param page_size Size of each page in bytes (must be power of 2)
      * @param policy Page replacement policy
+     * @param page_table_levels Levels of the radix page table (2 to 5)
      */
     VirtualMemory(PhysicalMemory* memory,
                   size_t num_virtual_pages,
                   size_t num_physical_frames,
                   size_t page_size,
-                  PageReplacementPolicy policy);
+                  PageReplacementPolicy policy,
+                  size_t page_table_levels = 2);
 
     ~VirtualMemory() = default;
 
@@ -97,11 +163,194 @@ public:
      */
     Result<void> write(Address virtual_addr, uint8_t data);
 
+    /**
+     * @brief Translate a resident page without side effects
+     *
+     * Does not count an access, consult the TLB or update replacement state.
+     *
+     * @param virtual_addr Virtual address to translate
+     * @return Result containing physical address, or error if the page is not resident
+     */
+    Result<Address> peek(Address virtual_addr) const;
+
+    /**
+     * @brief Get the size of the page mapping a resident address
+     *
+     * @param virtual_addr Virtual address
+     * @return Result containing the page size, or error if the page is not resident
+     */
+    Result<PageSize> getPageSize(Address virtual_addr) const;
+
+    /**
+     * @brief Set the largest page size faults may map (transparent huge pages)
+     *
+     * Huge pages are entries one (2M) or two (1G) levels above the leaves
+     * (2 MB and 1 GB with 4 KB pages and 9-bit levels). One occupies an
+     * aligned run of frames, is loaded, written back and evicted whole and
+     * takes one TLB entry. A fault maps the largest enabled size whose
+     * region is unmapped, falling back when no aligned run is free.
+     *
+     * @param max_size Largest size to map on a fault; BASE disables huge pages
+     * @return Result indicating success, or error if the page table or memory cannot hold that size
+     */
+    Result<void> setTransparentHugePages(PageSize max_size);
+
+    /**
+     * @brief Get the largest page size faults may map
+     */
+    PageSize getTransparentHugePages() const { return thp_size_; }
+
+    /**
+     * @brief Collapse the aligned region around an address into one huge page
+     *
+     * Resident pages of the region are copied into an aligned frame run,
+     * the rest are loaded from disk. The run evicting the fewest other
+     * pages is chosen, and whatever else holds its frames is evicted.
+     *
+     * @param virtual_addr Address inside the region
+     * @param size Huge page size
+     * @return Result indicating success or error
+     */
+    Result<void> promote(Address virtual_addr, PageSize size);
+
+    /**
+     * @brief Split the huge page mapping an address into pages of the next smaller size
+     *
+     * The pages keep their frames and data; nothing is loaded or written.
+     *
+     * @param virtual_addr Address inside the huge page
+     * @return Result indicating success, or error if no huge page maps the address
+     */
+    Result<void> demote(Address virtual_addr);
+
+    /**
+     * @brief Get the number of base pages a page of some size covers
+     */
+    uint64_t getPagesPerMapping(PageSize size) const {
+        return page_table_.getPagesPerEntry(mappingLevel(size));
+    }
+
+    /**
+     * @brief Get the size of a base page in bytes
+     */
+    size_t getBasePageSize() const { return page_size_; }
+
     /**
      * @brief Flush all pages (mark all as invalid)
      */
     void flush();
 
+    /**
+     * @brief Attach a TLB in front of the page table, replacing any existing one
+     *
+     * A hit skips the walk; a miss walks the table (faulting if the page is
+     * not resident) and fills the TLB. Evictions shoot their mapping down,
+     * and flush() flushes it.
+     *
+     * @param tlb TLB to attach (nullptr detaches)
+     */
+    void setTLB(std::unique_ptr<TLBHierarchy> tlb);
+
+    /**
+     * @brief Get the attached TLB (nullptr if none)
+     */
+    const TLBHierarchy* getTLB() const { return tlb_.get(); }
+
+    /**
+     * @brief Attach a page-walk cache, replacing any existing one
+     *
+     * Every page-table consult is replayed as one entry read per level
+     * (VirtualMemoryStats::walk_references). The cache keeps the entries
+     * recently read at each non-leaf level, so a walk starts below the
+     * deepest level it hits.
+     *
+     * @param entries_per_level Fully associative LRU entries per non-leaf level (0 removes it)
+     */
+    void setPageWalkCache(size_t entries_per_level);
+
+    /**
+     * @brief Get the page-walk cache entries per non-leaf level (0 if none)
+     */
+    size_t getPageWalkCacheEntries() const {
+        return walk_cache_levels_.empty() ? 0 : walk_cache_levels_[0]->getNumEntries();
+    }
+
+    /**
+     * @brief Send page-walk references through a cache hierarchy
+     *
+     * The page table is placed in physical memory after the last frame
+     * (wrapping within the rest of memory, or all of it when the frames
+     * fill it). The walk's cycles then replace the TLB's fixed page-walk
+     * latency. The hierarchy must outlive this object or be detached.
+     *
+     * @param cache Cache hierarchy over the same physical memory (nullptr detaches)
+     */
+    void setPageWalkMemory(CacheHierarchy* cache);
+
+    /**
+     * @brief Check if page-walk references go through a cache hierarchy
+     */
+    bool isPageWalkThroughCache() const { return walk_memory_ != nullptr; }
+
+    /**
+     * @brief Set how far the front hand of the two-handed clock runs ahead
+     *
+     * The front hand clears reference bits; the back hand evicts a mapping
+     * still clear when it arrives.
+     *
+     * @param frames Frames between the hands (below the number of frames)
+     * @return Result indicating success, or error if the spread is too large
+     */
+    Result<void> setClockHandSpread(size_t frames);
+
+    /**
+     * @brief Get the frames between the hands of the two-handed clock
+     */
+    size_t getClockHandSpread() const { return hand_spread_; }
+
+    /**
+     * @brief Set the WSClock working-set window
+     *
+     * WSClock evicts a clean mapping unused for longer than the window;
+     * old dirty mappings it passes are written back so a later sweep can
+     * take them.
+     *
+     * @param accesses Accesses since its last use after which a mapping leaves the working set
+     */
+    void setWorkingSetWindow(uint64_t accesses) { working_set_window_ = accesses; }
+
+    /**
+     * @brief Get the WSClock working-set window (in accesses)
+     */
+    uint64_t getWorkingSetWindow() const { return working_set_window_; }
+
+    /**
+     * @brief Give the OPT policy the accesses still to come
+     *
+     * Must list every access this object will translate from now on, in
+     * order, for the fault count to be the minimum. Addresses outside the
+     * virtual address space are skipped, as translate() rejects them.
+     *
+     * @param virtual_addrs Virtual address of every future access
+     * @return Result indicating success, or error if the policy is not OPT
+     */
+    Result<void> setOptimalTrace(const std::vector<Address>& virtual_addrs);
+
+    /**
+     * @brief Get the replacer of ARC, 2Q, LIRS or OPT (nullptr under other policies)
+     */
+    const IPageReplacer* getPageReplacer() const { return replacer_.get(); }
+
+    /**
+     * @brief Get the CLOCK-Pro state (nullptr under other policies)
+     */
+    const ClockPro* getClockPro() const { return clock_pro_.get(); }
+
+    /**
+     * @brief Get the radix page table
+     */
+    const RadixPageTable& getPageTable() const { return page_table_; }
+
     /**
      * @brief Get virtual memory statistics
      */
@@ -112,6 +361,127 @@ public:
      */
     std::string getStatsString() const;
 
+    /**
+     * @brief Set the simulated disk latencies charged to page faults
+     *
+     * Every fault pays the page load and every dirty page it evicts the
+     * writeback, summed in VirtualMemoryStats::disk_cycles (zero by default).
+     *
+     * @param page_load_cycles Cycles to load a page from disk on a fault
+     * @param writeback_cycles Cycles to write a dirty victim page back to disk
+     */
+    void setDiskLatency(uint64_t page_load_cycles, uint64_t writeback_cycles) {
+        page_load_cycles_ = page_load_cycles;
+        writeback_cycles_ = writeback_cycles;
+    }
+
+    /**
+     * @brief Get the cycles charged to load a page from disk
+     */
+    uint64_t getPageLoadCycles() const { return page_load_cycles_; }
+
+    /**
+     * @brief Get the cycles charged to write a dirty page back to disk
+     */
+    uint64_t getWritebackCycles() const { return writeback_cycles_; }
+
+    /**
+     * @brief Attach a swap device, replacing any existing one
+     *
+     * Dirty victims are written to their slots and a fault on a page with
+     * a slot reads it back; clean pages are dropped without a write.
+     * Without a device a fault fills the frame with a pattern derived from
+     * the address and a writeback is only counted. Pages written to a
+     * previous device are lost, as are dirty pages evicted while none was
+     * attached.
+     *
+     * @param swap Open device with this page size (nullptr detaches)
+     * @return Result indicating success, or error if the device does not fit
+     */
+    Result<void> setSwapDevice(std::unique_ptr<SwapDevice> swap);
+
+    /**
+     * @brief Get the attached swap device (nullptr if none)
+     */
+    const SwapDevice* getSwapDevice() const { return swap_.get(); }
+
+    /**
+     * @brief Move swap pages on worker threads (see SwapDevice::setAsync)
+     *
+     * Victims are written back in batches. A fault issues its read together
+     * with those of the pages readahead or fault-around will map after it.
+     *
+     * @param num_threads Worker threads (0 makes swap I/O synchronous)
+     * @param batch_size Dirty victims written back together
+     * @return Result indicating success, or error if no swap device is attached
+     */
+    Result<void> setSwapAsync(size_t num_threads, size_t batch_size);
+
+    /**
+     * @brief Make every swap transfer take at least this long (see SwapDevice::setDeviceDelay)
+     *
+     * @param microseconds Added to each transfer (0 for none)
+     * @return Result indicating success, or error if no swap device is attached
+     */
+    Result<void> setSwapDelay(uint64_t microseconds);
+
+    /**
+     * @brief Start reading a non-resident page from swap ahead of its fault
+     *
+     * Lets the read overlap with the accesses before the fault; only
+     * issued with an asynchronous swap device.
+     *
+     * @param virtual_addr Address inside the page
+     * @return true if a read was issued
+     */
+    bool prefetchSwap(Address virtual_addr);
+
+    static constexpr size_t READAHEAD_STREAMS = 8;         // Sequential streams tracked at once
+    static constexpr size_t READAHEAD_INITIAL_WINDOW = 4;   // Pages read when a stream is detected
+
+    /**
+     * @brief Enable or disable sequential readahead
+     *
+     * Up to READAHEAD_STREAMS streams are tracked. A fault on the page after
+     * a stream's last fault or window maps a window of the following pages,
+     * starting at READAHEAD_INITIAL_WINDOW and doubling; the first access to
+     * a window's middle page maps the next one. Windows are capped by a
+     * limit that rises with every prefetched page used and falls with every
+     * one evicted unused. Prefetched pages enter the replacement policy
+     * where an unused one is evicted first (LRU tail, FIFO front, seen once
+     * elsewhere), and stop rather than evict a page of the current fault or
+     * window (the clocks prefetch into free frames only).
+     *
+     * @param max_pages Largest readahead window in pages (0 disables)
+     */
+    void setReadahead(size_t max_pages);
+
+    /**
+     * @brief Get the largest readahead window in pages (0 if disabled)
+     */
+    size_t getReadahead() const { return readahead_max_; }
+
+    /**
+     * @brief Get the current cap on readahead windows (adapts to hits and waste)
+     */
+    size_t getReadaheadLimit() const { return readahead_limit_; }
+
+    /**
+     * @brief Map the rest of the aligned block around every unexplained fault
+     *
+     * Applies to faults no readahead stream explains; the pages are entered
+     * like readahead pages.
+     *
+     * @param pages Block size in pages (power of two; 0 or 1 disables)
+     * @return Result indicating success, or error if not a power of two
+     */
+    Result<void> setFaultAround(size_t pages);
+
+    /**
+     * @brief Get the fault-around block size in pages (0 if disabled)
+     */
+    size_t getFaultAround() const { return fault_around_; }
+
     /**
      * @brief Dump page table contents
      */
@@ -129,20 +499,75 @@ private:
     size_t page_size_;
     PageReplacementPolicy policy_;
 
-    // Page table: virtual page number -> PageTableEntry
-    std::vector<PageTableEntry> page_table_;
-
-    // Frame tracking: which frames are currently free?
-    std::vector<bool> frame_allocated_;  // true if frame is in use
+    static constexpr size_t TLB_SIZE_TAG_SHIFT = 62;   // TLB keys of huge pages carry their size here
 
-    // Page replacement data structures
-    std::queue<size_t> fifo_queue_;      // For FIFO: queue of page numbers
-    size_t clock_hand_;                   // For Clock: current position
+    // Page table: virtual page number -> PageTableEntry
+    RadixPageTable page_table_;
+    std::vector<uint64_t> walk_offsets_;   // Scratch: entry offsets of the current walk
+
+    // Frame table: frame -> entry of the mapping holding it (nullptr if free).
+    // The clocks sweep it, so a victim search scales with the resident set.
+    // Free frames are found with trailing-zero counts in a two-level bitmap.
+    std::vector<PageTableEntry*> frame_table_;
+    FreeFrameBitmap free_frames_;
+
+    // Page replacement data structures. LRU threads an intrusive list through
+    // the entries, most recent first, so hits and victims are O(1). A FIFO
+    // entry is live while its stamp matches the mapping's: eviction, merging
+    // and requeueing leave the old entry stale, and victim searches skip it.
+    struct FifoEntry {
+        uint64_t page;    // First page of the mapping
+        uint64_t stamp;   // Matches PageTableEntry::fifo_stamp while live
+    };
+    std::deque<FifoEntry> fifo_queue_;   // For FIFO: front = next victim
+    uint64_t fifo_stamp_;                 // For FIFO: last stamp handed out
+    size_t clock_hand_;                   // For the clocks: frame under the (back) hand
+    size_t front_hand_;                   // For Two-Handed Clock: frame under the front hand
+    size_t hand_spread_;                  // For Two-Handed Clock: frames between the hands
+    uint64_t working_set_window_;         // For WSClock: accesses a mapping stays in the working set
+    PageTableEntry* lru_head_;            // For LRU: most recently used resident mapping
+    PageTableEntry* lru_tail_;            // For LRU: least recently used resident mapping
+    std::unique_ptr<ClockPro> clock_pro_; // For CLOCK-Pro
+    std::unique_ptr<IPageReplacer> replacer_;   // For ARC, 2Q, LIRS and OPT
 
     // Statistics and time tracking
     VirtualMemoryStats stats_;
     uint64_t global_time_;
 
+    // Disk latency model
+    uint64_t page_load_cycles_;
+    uint64_t writeback_cycles_;
+
+    // Optional swap device, with a page of staging space for its I/O
+    std::unique_ptr<SwapDevice> swap_;
+    std::vector<uint8_t> swap_buffer_;
+
+    // Prefetching: sequential readahead streams and fault-around
+    struct ReadaheadStream {
+        uint64_t next_page;   // Page after the last fault or window (NO_PAGE if unused)
+        uint64_t marker;      // Prefetched page whose first access reads the next window
+        size_t window;        // Pages in the last window (0: one fault seen so far)
+        uint64_t last_use;    // For replacing the least recently used stream
+    };
+    enum class PrefetchOutcome { MAPPED, RESIDENT, STOPPED };
+    static constexpr uint64_t NO_PAGE = UINT64_MAX;
+    size_t readahead_max_;
+    size_t readahead_limit_;              // Adaptive cap on readahead windows
+    size_t fault_around_;
+    std::vector<ReadaheadStream> streams_;
+
+    // Optional TLB in front of page_table_
+    std::unique_ptr<TLBHierarchy> tlb_;
+
+    // Largest page size a fault may map
+    PageSize thp_size_;
+
+    // Optional page-walk cache (one per non-leaf level) and walk memory path
+    std::vector<std::unique_ptr<TLB>> walk_cache_levels_;
+    CacheHierarchy* walk_memory_;
+    Address walk_table_base_;             // Physical address of the page-table region
+    Address walk_table_span_;             // Bytes the region may use before wrapping
+
     // Address parsing
     size_t offset_bits_;                  // Number of bits for page offset
     size_t page_number_bits_;             // Number of bits for page number
@@ -157,18 +582,173 @@ private:
      */
     Address constructPhysicalAddress(Address frame_number, size_t offset) const;
 
+    /**
+     * @brief Replay the page-table walk of a page
+     *
+     * Consults the page-walk cache, counts the entries read and sends
+     * them through the walk memory path if one is set.
+     */
+    void walkPageTable(size_t page_number);
+
+    /**
+     * @brief Page-table level of the entries mapping pages of a size
+     */
+    size_t mappingLevel(PageSize size) const {
+        return page_table_.getLevels() - 1 - sizeIndex(size);
+    }
+
+    /**
+     * @brief Check that the page table and memory can hold pages of a huge size
+     */
+    Result<void> checkPageSize(PageSize size) const;
+
+    /**
+     * @brief TLB key of a page mapped with a given size
+     *
+     * Base pages use their page number; huge pages their huge page number
+     * tagged with the size, so the sizes never alias.
+     */
+    uint64_t tlbKey(uint64_t page_number, PageSize size) const;
+
+    /**
+     * @brief Find the key under which the TLB holds a page, without side effects
+     *
+     * @param page_number Virtual page number
+     * @param size Output: size of the cached mapping (BASE if none is cached)
+     * @return Key to look up
+     */
+    uint64_t probeTLBKey(uint64_t page_number, PageSize& size) const;
+
+    /**
+     * @brief Shoot a mapping down from the TLB, free its frames and invalidate it
+     *
+     * @param first_page First page the mapping covers
+     * @param pte Mapping entry
+     */
+    void removeMapping(uint64_t first_page, PageTableEntry& pte);
+
+    /**
+     * @brief Record an access to a resident mapping (reference bit, LRU order)
+     */
+    void recordAccess(PageTableEntry& pte);
+
+    /**
+     * @brief Readahead or fault-around after a base-page fault
+     */
+    void prefetchAfterFault(uint64_t page_number);
+
+    /**
+     * @brief Map a stream's next window and move its marker and next page past it
+     *
+     * @param protect_first First page that may not be evicted (the window's end is the last)
+     */
+    void readAhead(ReadaheadStream& stream, uint64_t protect_first);
+
+    /**
+     * @brief Issue the swap reads of a fault and of the pages it will prefetch
+     *
+     * Called before the fault is handled with an asynchronous swap device,
+     * so the reads run on the engine together instead of one after another.
+     */
+    void startFaultReads(uint64_t page_number);
+
+    /**
+     * @brief Issue swap reads for the non-resident pages from first to last (async only)
+     */
+    void startSwapReads(uint64_t first, uint64_t last);
+
+    /**
+     * @brief Map a page ahead of use, evicting if no frame is free
+     *
+     * @param protect_first First page of a range that may not be evicted
+     * @param protect_last Last page of that range
+     * @return STOPPED if the page is out of range or only a protected page could make room
+     */
+    PrefetchOutcome prefetchPage(uint64_t page_number, uint64_t protect_first, uint64_t protect_last);
+
+    /**
+     * @brief Find a victim for a prefetch past the protected pages at LRU's tail or FIFO's front
+     *
+     * Prefetched pages enter at that end, so the window being mapped is
+     * the first thing these policies would evict.
+     *
+     * @return false under other policies, or if every resident page is protected
+     */
+    bool findUnprotectedVictim(uint64_t protect_first, uint64_t protect_last, size_t& victim_page) const;
+
+    /**
+     * @brief Account the first access to a prefetched page, reading ahead at a marker
+     */
+    void notePrefetchHit(PageTableEntry& pte);
+
+    /**
+     * @brief Queue a mapping for FIFO under a new stamp, leaving any older entry stale
+     *
+     * @param front Queue it as the next victim instead of the last
+     */
+    void fifoEnqueue(PageTableEntry& pte, bool front = false);
+
+    /**
+     * @brief Check that a FIFO queue entry still stands for a resident mapping
+     */
+    bool fifoLive(const FifoEntry& entry) const;
+
+    /**
+     * @brief Enter a newly mapped page into the replacement policy's structures
+     *
+     * @param pte Valid mapping entry
+     * @param first_page First page the mapping covers
+     * @param prefetched Mapped ahead of use: enters at LRU's tail and FIFO's front,
+     *                   and without reuse credit in the other policies
+     */
+    void trackResident(PageTableEntry& pte, uint64_t first_page, bool prefetched = false);
+
+    /**
+     * @brief Insert a mapping into the LRU list before another (nullptr: at the tail)
+     */
+    void lruLink(PageTableEntry& pte, PageTableEntry* next);
+
+    /**
+     * @brief Remove a mapping from the LRU list (no-op under other policies)
+     */
+    void lruUnlink(PageTableEntry& pte);
+
+    /**
+     * @brief Take frames off the free bitmap and update the free-frame counts
+     */
+    void allocateFrames(Address first_frame, size_t count);
+
+    /**
+     * @brief Point the frames of a mapping at its entry in the frame table
+     */
+    void mapFrames(PageTableEntry& pte);
+
+    /**
+     * @brief Move a clock hand past the next resident mapping
+     *
+     * @param hand Frame under the hand; left on the frame after the mapping
+     * @return The mapping, or nullptr if no frame is in use
+     */
+    PageTableEntry* advanceHand(size_t& hand);
+
+    /**
+     * @brief Flush every level of the page-walk cache
+     */
+    void flushPageWalkCache();
+
     /**
      * @brief Handle page fault - load page into physical memory
      *
      * @param page_number Virtual page number to load
-     * @return Result containing frame number where page was loaded
+     * @return Result containing frame number where the page was loaded
+     *         (inside a huge page's run if one was mapped)
      */
     Result<Address> handlePageFault(size_t page_number);
 
     /**
      * @brief Select victim page for eviction
      *
-     * Uses configured page replacement policy (FIFO, LRU, Clock).
+     * Uses configured page replacement policy.
      *
      * @return Page number to evict
      */
@@ -182,7 +762,15 @@ private:
     void evictPage(size_t page_number);
 
     /**
-     * @brief Find a free physical frame
+     * @brief Find a run of free frames aligned to its length
+     *
+     * @param count Frames in the run (power of 2)
+     * @return First frame of the run, or error if none is free
+     */
+    Result<Address> findFreeFrameRun(size_t count);
+
+    /**
+     * @brief Find the lowest free physical frame
      *
      * @return Frame number if available, or error if all frames allocated
      */
@@ -191,7 +779,8 @@ private:
     /**
      * @brief Load page data from "disk" into physical frame
      *
-     * Simulates loading page from secondary storage.
+     * Reads the page's swap slot if it has one, otherwise simulates
+     * loading it from secondary storage.
      *
      * @param page_number Virtual page to load
      * @param frame_number Physical frame to load into
@@ -201,7 +790,7 @@ private:
     /**
      * @brief Write page data to "disk"
      *
-     * Simulates writing dirty page back to secondary storage.
+     * Writes it to its swap slot if a swap device is attached.
      *
      * @param page_number Virtual page to write
      * @param frame_number Physical frame to read from
@@ -217,8 +806,44 @@ private:
      * @brief Calculate number of bits needed to represent a value
      */
     static size_t calculateBits(size_t value);
+
+    /**
+     * @brief Index of a page size in VirtualMemoryStats::by_size
+     */
+    static size_t sizeIndex(PageSize size) { return static_cast<size_t>(size); }
 };
 
+/**
+ * @brief Helper function to convert PageReplacementPolicy to string
+ */
+inline std::string pageReplacementPolicyToString(PageReplacementPolicy policy) {
+    switch (policy) {
+        case PageReplacementPolicy::FIFO: return "FIFO";
+        case PageReplacementPolicy::LRU: return "LRU";
+        case PageReplacementPolicy::CLOCK: return "Clock";
+        case PageReplacementPolicy::CLOCK_PRO: return "CLOCK-Pro";
+        case PageReplacementPolicy::WSCLOCK: return "WSClock";
+        case PageReplacementPolicy::TWO_HANDED_CLOCK: return "Two-Handed Clock";
+        case PageReplacementPolicy::ARC: return "ARC";
+        case PageReplacementPolicy::TWO_Q: return "2Q";
+        case PageReplacementPolicy::LIRS: return "LIRS";
+        case PageReplacementPolicy::OPTIMAL: return "OPT";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief Helper function to convert PageSize to string
+ */
+inline std::string pageSizeToString(PageSize size) {
+    switch (size) {
+        case PageSize::BASE: return "Base";
+        case PageSize::HUGE_2M: return "2M";
+        case PageSize::HUGE_1G: return "1G";
+        default: return "Unknown";
+    }
+}
+
 } // namespace memsim
 
 #endif // MEMSIM_VIRTUAL_MEMORY_VIRTUAL_MEMORY_H
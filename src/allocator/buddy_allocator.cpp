@@ -416,4 +416,14 @@ Result<Address> BuddyAllocator::getBlockAddress(BlockId block_id) const {
     return Result<Address>::Ok(it->second->start_address);
 }
 
+Result<BlockId> BuddyAllocator::findBlockId(Address address) const {
+    for (const auto& item : allocated_blocks_) {
+        const BuddyBlock* block = item.second;
+        if (address >= block->start_address && address < block->endAddress()) {
+            return Result<BlockId>::Ok(block->id);
+        }
+    }
+    return Result<BlockId>::Err("Address not in an allocated block");
+}
+
 } // namespace memsim
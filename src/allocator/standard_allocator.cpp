@@ -389,4 +389,17 @@ Result<Address> StandardAllocator::getBlockAddress(BlockId block_id) const {
     return Result<Address>::Ok(it->second->start_address);
 }
 
+Result<BlockId> StandardAllocator::findBlockId(Address address) const {
+    // The list is in address order
+    for (MemoryBlock* current = head_; current && current->start_address <= address; current = current->next) {
+        if (address < current->endAddress()) {
+            if (current->is_free) {
+                break;
+            }
+            return Result<BlockId>::Ok(current->id);
+        }
+    }
+    return Result<BlockId>::Err("Address not in an allocated block");
+}
+
 } // namespace memsim
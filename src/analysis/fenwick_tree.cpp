@@ -0,0 +1,44 @@
+#include "analysis/fenwick_tree.h"
+
+namespace memsim {
+
+void FenwickTree::append(uint32_t value) {
+    // The new node covers (n - lowbit(n), n]: value plus the existing positions in it
+    size_t n = tree_.size();
+    uint64_t covered = prefixSum(n - 1) - prefixSum(n - lowbit(n));
+    tree_.push_back(static_cast<uint32_t>(value + covered));
+}
+
+void FenwickTree::add(size_t position, int32_t delta) {
+    for (size_t i = position; i < tree_.size(); i += lowbit(i)) {
+        tree_[i] = static_cast<uint32_t>(static_cast<int64_t>(tree_[i]) + delta);
+    }
+}
+
+uint64_t FenwickTree::prefixSum(size_t position) const {
+    uint64_t sum = 0;
+    for (size_t i = position; i > 0; i -= lowbit(i)) {
+        sum += tree_[i];
+    }
+    return sum;
+}
+
+uint64_t FenwickTree::rangeSum(size_t first, size_t last) const {
+    if (first > last) {
+        return 0;
+    }
+    return prefixSum(last) - prefixSum(first - 1);
+}
+
+void FenwickTree::reset(size_t n, uint32_t value) {
+    tree_.assign(n + 1, 0);
+    for (size_t i = 1; i <= n; i++) {
+        tree_[i] = static_cast<uint32_t>(value * lowbit(i));
+    }
+}
+
+size_t FenwickTree::lowbit(size_t i) {
+    return i & (~i + 1);
+}
+
+} // namespace memsim
@@ -0,0 +1,190 @@
+#include "analysis/parallel_simulator.h"
+#include "analysis/trace_ring.h"
+#include "memory/physical_memory.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace memsim {
+
+ParallelCacheSimulator::ParallelCacheSimulator(size_t memory_size, size_t chunk_records, size_t ring_chunks)
+    : memory_size_(memory_size),
+      chunk_records_(chunk_records),
+      ring_chunks_(ring_chunks),
+      records_(0),
+      seconds_(0.0) {
+    if (memory_size == 0) {
+        throw std::invalid_argument("Memory size must be greater than 0");
+    }
+    if (chunk_records == 0 || ring_chunks == 0) {
+        throw std::invalid_argument("Chunk size and ring capacity must be at least 1");
+    }
+}
+
+void ParallelCacheSimulator::addConfig(const SweepConfig& config) {
+    // Validate now so that the worker threads never see a bad configuration
+    PhysicalMemory probe_memory(1);
+    CacheHierarchy check(&probe_memory, config.levels, config.inclusion);
+    auto sampling = check.setSetSampling(config.sampling_ratio, config.sampling_mode);
+    if (!sampling.success) {
+        throw std::invalid_argument(sampling.error_message);
+    }
+    configs_.push_back(config);
+}
+
+Result<void> ParallelCacheSimulator::run(TraceReader& reader) {
+    return runWith([&reader, this](std::vector<TraceRecord>& chunk) {
+        return reader.read(chunk, chunk_records_);
+    });
+}
+
+Result<void> ParallelCacheSimulator::run(const std::vector<TraceRecord>& trace) {
+    size_t next = 0;
+    return runWith([&trace, &next, this](std::vector<TraceRecord>& chunk) {
+        size_t count = std::min(chunk_records_, trace.size() - next);
+        chunk.assign(trace.begin() + next, trace.begin() + next + count);
+        next += count;
+        return Result<size_t>::Ok(count);
+    });
+}
+
+std::string ParallelCacheSimulator::getReport() const {
+    std::ostringstream oss;
+    oss << "=== Parallel Cache Sweep ===\n";
+    oss << "Configurations: " << results_.size() << " (one thread each)\n";
+    oss << "Trace Records: " << records_ << " (decoded once)\n";
+    oss << "Wall Time: " << std::fixed << std::setprecision(3) << seconds_ << " s\n\n";
+
+    for (size_t i = 0; i < results_.size(); i++) {
+        const SweepResult& r = results_[i];
+        oss << "[" << (i + 1) << "] " << sweepConfigToString(r.config) << "\n";
+        if (r.sampling.ratio > 1) {
+            // Sampled: report the extrapolated miss ratios with their 95% margins
+            for (size_t level = 0; level < r.sampling.levels.size(); level++) {
+                const SampledEstimate& e = r.sampling.levels[level];
+                oss << "    L" << (level + 1) << ": ~" << e.misses << "/" << e.accesses << " misses ("
+                    << std::fixed << std::setprecision(2) << e.miss_ratio << "% +/- ";
+                if (e.margin < 0) {
+                    oss << "n/a";
+                } else {
+                    oss << e.margin << "%";
+                }
+                oss << ")\n";
+            }
+            oss << "    Memory Accesses: ~" << r.sampling.memory.misses << " (1 in "
+                << r.sampling.ratio << " sets simulated)";
+        } else {
+            for (size_t level = 0; level < r.stats.level_stats.size(); level++) {
+                const CacheStats& s = r.stats.level_stats[level];
+                oss << "    L" << (level + 1) << ": " << s.hits << "/" << s.accesses << " hits ("
+                    << std::fixed << std::setprecision(2) << s.getHitRatio() << "%)\n";
+            }
+            oss << "    Memory Accesses: " << r.stats.memory_accesses;
+        }
+        if (r.errors > 0) {
+            oss << ", Out-of-Range Accesses: " << r.errors;
+        }
+        oss << "\n";
+        oss << "    AMAT: " << (r.sampling.ratio > 1 ? "~" : "") << std::fixed << std::setprecision(2)
+            << r.stats.latency.getAMAT() << " cycles\n";
+    }
+    return oss.str();
+}
+
+// Private helper methods
+
+Result<void> ParallelCacheSimulator::runWith(
+        const std::function<Result<size_t>(std::vector<TraceRecord>&)>& next_chunk) {
+    results_.clear();
+    records_ = 0;
+    if (configs_.empty()) {
+        return Result<void>::Err("No configurations to simulate");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    TraceChunkRing ring(ring_chunks_, configs_.size());
+    results_.resize(configs_.size());
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < configs_.size(); i++) {
+        workers.emplace_back([this, &ring, i]() {
+            auto worker_start = std::chrono::steady_clock::now();
+            PhysicalMemory memory(memory_size_);
+            CacheHierarchy cache(&memory, configs_[i].levels, configs_[i].inclusion);
+            cache.setSetSampling(configs_[i].sampling_ratio, configs_[i].sampling_mode);
+            uint64_t errors = 0;
+
+            while (const std::vector<TraceRecord>* chunk = ring.acquireRead(i)) {
+                for (const auto& record : *chunk) {
+                    bool ok = record.is_write ? cache.write(record.address, 0).success
+                                              : cache.read(record.address).success;
+                    if (!ok) {
+                        errors++;
+                    }
+                }
+                ring.releaseRead(i);
+            }
+
+            SweepResult& result = results_[i];
+            result.config = configs_[i];
+            result.stats = cache.getStats();
+            result.sampling = cache.getSamplingStats();
+            result.errors = errors;
+            result.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - worker_start).count();
+        });
+    }
+
+    // Decode straight into ring slots on this thread
+    Result<void> status = Result<void>::Ok();
+    while (true) {
+        std::vector<TraceRecord>& slot = ring.acquireWrite();
+        auto read_result = next_chunk(slot);
+        if (!read_result.success) {
+            status = Result<void>::Err(read_result.error_message);
+            break;
+        }
+        if (read_result.value == 0) {
+            break;
+        }
+        records_ += read_result.value;
+        ring.commitWrite();
+    }
+    ring.close();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!status.success) {
+        results_.clear();
+    }
+    return status;
+}
+
+std::string sweepConfigToString(const SweepConfig& config) {
+    std::ostringstream oss;
+    for (size_t i = 0; i < config.levels.size(); i++) {
+        const CacheLevelConfig& level = config.levels[i];
+        if (i > 0) {
+            oss << " / ";
+        }
+        oss << level.sets << "x" << level.associativity << "x" << level.block_size
+            << " " << cachePolicyToString(level.policy);
+    }
+    if (config.levels.size() > 1) {
+        oss << " (" << inclusionPolicyToString(config.inclusion) << ")";
+    }
+    if (config.sampling_ratio > 1) {
+        oss << " [" << setSamplingModeToString(config.sampling_mode) << " sampling 1/"
+            << config.sampling_ratio << "]";
+    }
+    return oss.str();
+}
+
+} // namespace memsim
@@ -0,0 +1,184 @@
+#include "analysis/stack_distance.h"
+#include "common/bit_utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace memsim {
+
+StackDistanceAnalyzer::StackDistanceAnalyzer(size_t block_size, size_t max_sets)
+    : block_size_(block_size),
+      offset_bits_(0),
+      accesses_(0) {
+    if (!isPowerOfTwo(block_size)) {
+        throw std::invalid_argument("Block size must be power of 2");
+    }
+    if (!isPowerOfTwo(max_sets)) {
+        throw std::invalid_argument("Number of sets must be power of 2");
+    }
+
+    offset_bits_ = countTrailingZeros(block_size);
+    for (size_t sets = 1; sets <= max_sets; sets <<= 1) {
+        SetCountModel model;
+        model.num_sets = sets;
+        model.set_trees.resize(sets);
+        model.timestamps = 0;
+        models_.push_back(std::move(model));
+    }
+}
+
+void StackDistanceAnalyzer::access(Address address) {
+    accesses_++;
+    Address block = address >> offset_bits_;
+
+    auto inserted = block_ids_.emplace(block, blocks_.size());
+    size_t id = inserted.first->second;
+    if (inserted.second) {
+        blocks_.push_back(block);
+        last_access_.resize(last_access_.size() + models_.size(), 0);
+    }
+
+    for (size_t k = 0; k < models_.size(); k++) {
+        accessModel(k, id, block);
+    }
+}
+
+uint64_t StackDistanceAnalyzer::getColdMisses() const {
+    return blocks_.size();
+}
+
+const std::vector<uint64_t>& StackDistanceAnalyzer::getDistanceHistogram(size_t num_sets) const {
+    return getModel(num_sets).histogram;
+}
+
+uint64_t StackDistanceAnalyzer::getMisses(size_t num_sets, size_t associativity) const {
+    const SetCountModel& model = getModel(num_sets);
+    uint64_t misses = getColdMisses();
+    for (size_t d = associativity; d < model.histogram.size(); d++) {
+        misses += model.histogram[d];
+    }
+    return misses;
+}
+
+double StackDistanceAnalyzer::getMissRatio(size_t num_sets, size_t associativity) const {
+    if (accesses_ == 0) return 0.0;
+    return (static_cast<double>(getMisses(num_sets, associativity)) / accesses_) * 100.0;
+}
+
+std::vector<MissRatioPoint> StackDistanceAnalyzer::getMissRatioCurve(size_t num_sets,
+                                                                     size_t max_associativity) const {
+    const SetCountModel& model = getModel(num_sets);
+
+    // Misses for associativity a = cold + reuses at distance >= a: one suffix sweep
+    std::vector<MissRatioPoint> curve;
+    uint64_t far_reuses = 0;
+    for (size_t d = max_associativity; d < model.histogram.size(); d++) {
+        far_reuses += model.histogram[d];
+    }
+    for (size_t ways = max_associativity; ways >= 1; ways--) {
+        MissRatioPoint point;
+        point.num_sets = num_sets;
+        point.associativity = ways;
+        point.capacity_bytes = num_sets * ways * block_size_;
+        point.misses = getColdMisses() + far_reuses;
+        point.miss_ratio = (accesses_ == 0) ? 0.0
+                         : (static_cast<double>(point.misses) / accesses_) * 100.0;
+        curve.push_back(point);
+        if (ways - 1 < model.histogram.size()) {
+            far_reuses += model.histogram[ways - 1];
+        }
+    }
+    std::reverse(curve.begin(), curve.end());
+    return curve;
+}
+
+bool StackDistanceAnalyzer::isModelled(size_t num_sets) const {
+    return isPowerOfTwo(num_sets) && num_sets <= getMaxSets();
+}
+
+std::string StackDistanceAnalyzer::getReport(size_t max_associativity) const {
+    std::ostringstream oss;
+    oss << "=== Stack Distance Analysis ===\n";
+    oss << "Accesses: " << accesses_ << "\n";
+    oss << "Distinct Blocks (cold misses): " << getColdMisses() << "\n";
+    oss << "Block Size: " << block_size_ << " bytes\n";
+
+    for (const auto& model : models_) {
+        oss << "\n--- " << model.num_sets << (model.num_sets == 1 ? " set" : " sets")
+            << " (LRU) ---\n";
+        oss << std::setw(8) << "Ways" << std::setw(14) << "Capacity"
+            << std::setw(12) << "Misses" << std::setw(12) << "Miss Ratio" << "\n";
+        for (const auto& point : getMissRatioCurve(model.num_sets, max_associativity)) {
+            if (!isPowerOfTwo(point.associativity)) {
+                continue;
+            }
+            oss << std::setw(8) << point.associativity
+                << std::setw(12) << point.capacity_bytes << " B"
+                << std::setw(12) << point.misses
+                << std::setw(11) << std::fixed << std::setprecision(2) << point.miss_ratio << "%\n";
+        }
+    }
+    return oss.str();
+}
+
+// Private helper methods
+
+void StackDistanceAnalyzer::accessModel(size_t k, size_t id, Address block) {
+    SetCountModel& model = models_[k];
+    FenwickTree& tree = model.set_trees[block & (model.num_sets - 1)];
+    uint64_t& last = last_access_[id * models_.size() + k];
+
+    if (last != 0) {
+        // Distinct blocks of this set touched since the previous access
+        uint64_t distance = tree.rangeSum(last + 1, tree.size());
+        if (distance >= model.histogram.size()) {
+            model.histogram.resize(distance + 1, 0);
+        }
+        model.histogram[distance]++;
+
+        tree.add(last, -1);
+    }
+
+    tree.append(1);
+    model.timestamps++;
+    last = tree.size();
+
+    if (model.timestamps > 2 * blocks_.size() + COMPACT_SLACK) {
+        compact(k);
+    }
+}
+
+void StackDistanceAnalyzer::compact(size_t k) {
+    SetCountModel& model = models_[k];
+    size_t stride = models_.size();
+
+    // Order each set's blocks by their latest access, then number them 1..n
+    std::vector<std::vector<std::pair<uint64_t, size_t>>> by_set(model.num_sets);
+    for (size_t id = 0; id < blocks_.size(); id++) {
+        by_set[blocks_[id] & (model.num_sets - 1)].push_back({last_access_[id * stride + k], id});
+    }
+
+    for (size_t set = 0; set < model.num_sets; set++) {
+        auto& entries = by_set[set];
+        std::sort(entries.begin(), entries.end());
+        for (size_t i = 0; i < entries.size(); i++) {
+            last_access_[entries[i].second * stride + k] = i + 1;
+        }
+        model.set_trees[set].reset(entries.size(), 1);
+    }
+    model.timestamps = blocks_.size();
+}
+
+const StackDistanceAnalyzer::SetCountModel& StackDistanceAnalyzer::getModel(size_t num_sets) const {
+    if (!isModelled(num_sets)) {
+        throw std::invalid_argument("Number of sets is not modelled: " + std::to_string(num_sets));
+    }
+    return models_[countTrailingZeros(num_sets)];
+}
+
+bool StackDistanceAnalyzer::isPowerOfTwo(size_t value) {
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+} // namespace memsim
@@ -0,0 +1,87 @@
+#include "analysis/trace_reader.h"
+#include <cctype>
+#include <sstream>
+
+namespace memsim {
+
+Result<void> TraceReader::open(const std::string& path) {
+    file_.close();
+    file_.clear();
+    file_.open(path);
+    line_number_ = 0;
+    if (!file_.is_open()) {
+        return Result<void>::Err("Cannot open trace file: " + path);
+    }
+    return Result<void>::Ok();
+}
+
+Result<size_t> TraceReader::read(std::vector<TraceRecord>& records, size_t max_records) {
+    records.clear();
+    if (!file_.is_open()) {
+        return Result<size_t>::Err("Trace file not open");
+    }
+
+    std::string line;
+    while (records.size() < max_records && std::getline(file_, line)) {
+        line_number_++;
+        TraceRecord record;
+        auto result = parseLine(line, record);
+        if (!result.success) {
+            return Result<size_t>::Err("Line " + std::to_string(line_number_) + ": " +
+                                       result.error_message);
+        }
+        if (result.value) {
+            records.push_back(record);
+        }
+    }
+    return Result<size_t>::Ok(records.size());
+}
+
+Result<bool> TraceReader::parseLine(const std::string& line, TraceRecord& record) {
+    std::istringstream iss(line);
+    std::string first;
+    if (!(iss >> first) || first[0] == '#') {
+        return Result<bool>::Ok(false);
+    }
+
+    std::string address_str = first;
+    record.is_write = false;
+    if (first.size() == 1 && std::isalpha(static_cast<unsigned char>(first[0]))) {
+        char op = static_cast<char>(std::toupper(static_cast<unsigned char>(first[0])));
+        if (op != 'R' && op != 'W') {
+            return Result<bool>::Err("Invalid access type: " + first + " (expected R or W)");
+        }
+        record.is_write = (op == 'W');
+        if (!(iss >> address_str)) {
+            return Result<bool>::Err("Missing address");
+        }
+    }
+
+    try {
+        size_t pos = 0;
+        record.address = std::stoull(address_str, &pos, 0);
+        if (pos != address_str.size()) {
+            return Result<bool>::Err("Invalid address: " + address_str);
+        }
+    } catch (const std::exception&) {
+        return Result<bool>::Err("Invalid address: " + address_str);
+    }
+
+    record.core = 0;
+    std::string core_str;
+    if (iss >> core_str && core_str[0] != '#') {
+        try {
+            size_t pos = 0;
+            unsigned long core = std::stoul(core_str, &pos, 10);
+            if (pos != core_str.size() || core > UINT32_MAX) {
+                return Result<bool>::Err("Invalid core ID: " + core_str);
+            }
+            record.core = static_cast<uint32_t>(core);
+        } catch (const std::exception&) {
+            return Result<bool>::Err("Invalid core ID: " + core_str);
+        }
+    }
+    return Result<bool>::Ok(true);
+}
+
+} // namespace memsim
@@ -0,0 +1,73 @@
+#include "analysis/trace_ring.h"
+#include <stdexcept>
+#include <thread>
+
+namespace memsim {
+
+TraceChunkRing::TraceChunkRing(size_t capacity, size_t num_consumers)
+    : slots_(capacity),
+      cursors_(new Cursor[num_consumers]),
+      num_consumers_(num_consumers),
+      head_(0),
+      closed_(false),
+      slowest_(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Ring capacity must be at least 1");
+    }
+    if (num_consumers == 0) {
+        throw std::invalid_argument("Ring needs at least one consumer");
+    }
+}
+
+std::vector<TraceRecord>& TraceChunkRing::acquireWrite() {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+
+    // Full until the slowest consumer has released the chunk that used this slot
+    while (head - slowest_ >= slots_.size()) {
+        slowest_ = minCursor();
+        if (head - slowest_ >= slots_.size()) {
+            std::this_thread::yield();
+        }
+    }
+    return slots_[head % slots_.size()];
+}
+
+void TraceChunkRing::commitWrite() {
+    head_.fetch_add(1, std::memory_order_release);
+}
+
+void TraceChunkRing::close() {
+    closed_.store(true, std::memory_order_release);
+}
+
+const std::vector<TraceRecord>* TraceChunkRing::acquireRead(size_t consumer) {
+    uint64_t position = cursors_[consumer].position.load(std::memory_order_relaxed);
+    while (position == head_.load(std::memory_order_acquire)) {
+        if (closed_.load(std::memory_order_acquire)) {
+            // close() follows the last commit, so re-check before giving up
+            if (position == head_.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            break;
+        }
+        std::this_thread::yield();
+    }
+    return &slots_[position % slots_.size()];
+}
+
+void TraceChunkRing::releaseRead(size_t consumer) {
+    cursors_[consumer].position.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t TraceChunkRing::minCursor() const {
+    uint64_t slowest = cursors_[0].position.load(std::memory_order_acquire);
+    for (size_t i = 1; i < num_consumers_; i++) {
+        uint64_t position = cursors_[i].position.load(std::memory_order_acquire);
+        if (position < slowest) {
+            slowest = position;
+        }
+    }
+    return slowest;
+}
+
+} // namespace memsim
@@ -1,86 +1,282 @@
 #include "cache/cache_hierarchy.h"
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 namespace memsim {
 
+std::string LatencyStats::toString() const {
+    std::ostringstream oss;
+    oss << "AMAT: " << std::fixed << std::setprecision(2) << getAMAT() << " cycles ("
+        << (reads.count + writes.count) << " accesses, "
+        << (reads.total_cycles + writes.total_cycles) << " cycles)\n";
+    oss << "Reads: " << reads.count << ", average " << reads.getAverage()
+        << " cycles, max " << reads.max_cycles << "\n";
+    oss << "Writes: " << writes.count << ", average " << writes.getAverage()
+        << " cycles, max " << writes.max_cycles << "\n";
+    if (reads.count + writes.count == 0) {
+        return oss.str();
+    }
+
+    oss << std::left << std::setw(28) << "Latency Histogram (cycles):" << std::right
+        << std::setw(10) << "Reads" << "  " << std::setw(10) << "Writes" << "\n";
+    for (size_t b = 0; b < LatencyHistogram::NUM_BUCKETS; b++) {
+        if (reads.buckets[b] == 0 && writes.buckets[b] == 0) continue;
+        std::ostringstream range;
+        uint64_t low = b == 0 ? 0 : (static_cast<uint64_t>(1) << b);
+        if (b + 1 == LatencyHistogram::NUM_BUCKETS) {
+            range << low << "+";
+        } else {
+            range << low << "-" << ((static_cast<uint64_t>(1) << (b + 1)) - 1);
+        }
+        oss << "  " << std::left << std::setw(26) << range.str() << std::right
+            << std::setw(10) << reads.buckets[b] << "  " << std::setw(10) << writes.buckets[b] << "\n";
+    }
+    return oss.str();
+}
+
+CacheHierarchy::CacheHierarchy(PhysicalMemory* memory, const std::vector<CacheLevelConfig>& levels,
+                               InclusionPolicy inclusion)
+    : memory_(memory),
+      victim_mode_(VictimCacheMode::VICTIM),
+      inclusion_(inclusion),
+      memory_access_count_(0),
+      back_invalidation_count_(0),
+      read_clock_(0),
+      request_count_(0),
+      sampling_ratio_(1),
+      sampling_mode_(SetSamplingMode::HASH),
+      sampling_level_(1),
+      sample_shift_(0),
+      sample_groups_(1),
+      sampled_sets_(0),
+      last_access_cycles_(0) {
+
+    if (levels.empty()) {
+        throw std::invalid_argument("Cache hierarchy needs at least one level");
+    }
+    if (inclusion == InclusionPolicy::EXCLUSIVE) {
+        for (const auto& config : levels) {
+            if (config.block_size != levels[0].block_size) {
+                throw std::invalid_argument("Exclusive hierarchy requires equal block sizes");
+            }
+        }
+    }
+
+    // Create one cache per level, L1 first
+    for (size_t i = 0; i < levels.size(); i++) {
+        const auto& config = levels[i];
+        levels_.push_back(std::make_unique<CacheLevel>(
+            static_cast<int>(i + 1), config.sets, config.associativity,
+            config.block_size, config.policy, memory
+        ));
+    }
+    prefetch_slots_.resize(levels_.size());
+    latencies_ = defaultLatencies(levels_.size());
+}
+
 CacheHierarchy::CacheHierarchy(PhysicalMemory* memory,
                                size_t l1_sets, size_t l1_associativity,
                                size_t l1_block_size, CachePolicy l1_policy,
                                size_t l2_sets, size_t l2_associativity,
                                size_t l2_block_size, CachePolicy l2_policy)
-    : memory_(memory),
-      memory_access_count_(0) {
+    : CacheHierarchy(memory, {
+          {l1_sets, l1_associativity, l1_block_size, l1_policy},
+          {l2_sets, l2_associativity, l2_block_size, l2_policy}
+      }) {}
 
-    // Create L1 and L2 caches
-    l1_cache_ = std::make_unique<CacheLevel>(
-        1, l1_sets, l1_associativity, l1_block_size, l1_policy, memory
-    );
+Result<uint8_t> CacheHierarchy::read(Address address) {
+    request_count_++;
+    if (sampling_ratio_ == 1) {
+        return simulateRead(address);
+    }
 
-    l2_cache_ = std::make_unique<CacheLevel>(
-        2, l2_sets, l2_associativity, l2_block_size, l2_policy, memory
-    );
+    size_t cluster = sampleCluster(address);
+    if (cluster == NOT_SAMPLED) {
+        last_access_cycles_ = 0;
+        return memory_->read(address);
+    }
+    beginSample();
+    auto result = simulateRead(address);
+    endSample(cluster);
+    return result;
 }
 
-Result<uint8_t> CacheHierarchy::read(Address address) {
-    // Try L1 first
-    if (l1_cache_->contains(address)) {
-        return l1_cache_->read(address);
+Result<void> CacheHierarchy::write(Address address, uint8_t data) {
+    request_count_++;
+    if (sampling_ratio_ == 1) {
+        return simulateWrite(address, data);
     }
 
-    // L1 miss - try L2
-    if (l2_cache_->contains(address)) {
-        auto result = l2_cache_->read(address);
-        if (result.success) {
-            // Load into L1 as well
-            l1_cache_->write(address, result.value);
+    size_t cluster = sampleCluster(address);
+    if (cluster == NOT_SAMPLED) {
+        last_access_cycles_ = 0;
+        return memory_->write(address, data);
+    }
+    beginSample();
+    auto result = simulateWrite(address, data);
+    endSample(cluster);
+    return result;
+}
+
+Result<uint8_t> CacheHierarchy::simulateRead(Address address) {
+    read_clock_++;
+    for (size_t i = 0; i < levels_.size(); i++) {
+        completePrefetches(i);
+    }
+
+    // Walk down the hierarchy until the first level that holds the block,
+    // keeping each level's probe so the fills below need no second scan
+    size_t hit_level = levels_.size();
+    uint8_t value = 0;
+    bool prefetch_hit = false;
+    bool victim_hit = false;
+    CacheProbe victim_probe;
+    probes_.clear();
+    for (size_t i = 0; i < levels_.size(); i++) {
+        CacheLevel& cache = *levels_[i];
+        probes_.push_back(cache.probe(address));
+        const CacheProbe& probe = probes_.back();
+        if (probe.hit) {
+            value = cache.readData(probe);
+            prefetch_hit = probe.prefetch_hit;
+            hit_level = i;
+            break;
+        }
+
+        Address block = address & ~static_cast<Address>(cache.getBlockSize() - 1);
+        checkLatePrefetch(prefetch_slots_[i], block);
+
+        // An L1 miss consults the victim/miss cache before going further down
+        if (i == 0 && victim_) {
+            victim_probe = victim_->probe(address);
+            if (victim_probe.hit) {
+                value = victim_->readData(victim_probe);
+                victim_hit = true;
+                hit_level = 1;
+                break;
+            }
         }
-        return result;
     }
 
-    // L2 miss - access memory
-    memory_access_count_++;
-    auto result = memory_->read(address);
-    if (result.success) {
-        // Load into both L2 and L1
-        l2_cache_->write(address, result.value);
-        l1_cache_->write(address, result.value);
+    if (hit_level == levels_.size() && !victim_hit) {
+        // Every level and the buffer missed - access memory
+        memory_access_count_++;
+        auto result = memory_->read(address);
+        if (!result.success) {
+            return result;
+        }
+        value = result.value;
     }
-    return result;
+    // A buffer hit is served right after the L1 lookup
+    recordLatency(false, accessCycles(victim_hit ? 0 : hit_level, victim_ && hit_level > 0));
+
+    if (inclusion_ == InclusionPolicy::EXCLUSIVE) {
+        // Move the block up to L1; victims cascade down from there
+        if (hit_level > 0) {
+            if (victim_hit) {
+                victim_->invalidate(victim_probe);
+            } else if (hit_level < levels_.size()) {
+                levels_[hit_level]->invalidate(probes_[hit_level]);
+            }
+            install(0, probes_[0], address);
+        }
+    } else {
+        // A victim cache hit swaps: free the buffer line for L1's victim
+        if (victim_hit && victim_mode_ == VictimCacheMode::VICTIM) {
+            victim_->invalidate(victim_probe);
+        }
+
+        // Fill every level above the one that served the read, bottom-up
+        for (size_t i = hit_level; i-- > 0;) {
+            install(i, probes_[i], address);
+        }
+
+        // A miss cache keeps a copy of every block fetched from below it
+        if (hit_level > 0 && !victim_hit && victim_ && victim_mode_ == VictimCacheMode::MISS) {
+            victim_->fill(victim_probe, address);
+        }
+    }
+
+    // Train only after the fills: prefetch installs must not move lines under the probes
+    if (hit_level < levels_.size() && !victim_hit) {
+        trainPrefetcher(hit_level, address, true, prefetch_hit);
+    }
+    for (size_t i = hit_level; i-- > 0;) {
+        trainPrefetcher(i, address, false, false);
+    }
+    return Result<uint8_t>::Ok(value);
 }
 
-Result<void> CacheHierarchy::write(Address address, uint8_t data) {
+Result<void> CacheHierarchy::simulateWrite(Address address, uint8_t data) {
     // Write-through: write to memory first
     auto mem_result = memory_->write(address, data);
     if (!mem_result.success) {
         return mem_result;
     }
 
-    // Update L1 if present
-    if (l1_cache_->contains(address)) {
-        l1_cache_->write(address, data);
+    // Update every level that holds the block (no write-allocate)
+    size_t hit_level = levels_.size();
+    for (size_t i = 0; i < levels_.size(); i++) {
+        CacheProbe probe = levels_[i]->probeForWrite(address);
+        if (probe.hit) {
+            levels_[i]->writeData(probe, data);
+            if (hit_level == levels_.size()) {
+                hit_level = i;
+            }
+        }
     }
-
-    // Update L2 if present
-    if (l2_cache_->contains(address)) {
-        l2_cache_->write(address, data);
+    recordLatency(true, accessCycles(hit_level, false));
+    if (victim_) {
+        // Keep the buffered copy current without counting a lookup
+        CacheProbe probe = victim_->peek(address);
+        if (probe.hit) {
+            victim_->writeData(probe, data);
+        }
     }
 
     return Result<void>::Ok();
 }
 
 void CacheHierarchy::flush() {
-    l1_cache_->flush();
-    l2_cache_->flush();
+    for (auto& cache : levels_) {
+        cache->flush();
+    }
+    if (victim_) {
+        victim_->flush();
+    }
+
+    // Outstanding prefetches and training state refer to the flushed contents
+    for (auto& slot : prefetch_slots_) {
+        slot.in_flight.clear();
+        if (slot.prefetcher) {
+            slot.prefetcher->reset();
+        }
+    }
 }
 
 HierarchyStats CacheHierarchy::getStats() const {
     HierarchyStats stats;
-    stats.l1_stats = l1_cache_->getStats();
-    stats.l2_stats = l2_cache_->getStats();
-    stats.total_accesses = stats.l1_stats.accesses + stats.l2_stats.accesses;
+    for (size_t i = 0; i < levels_.size(); i++) {
+        CacheStats level = levels_[i]->getStats();
+        level.prefetch.issued = prefetch_slots_[i].issued;
+        level.prefetch.late = prefetch_slots_[i].late;
+        stats.total_accesses += level.accesses;
+        stats.level_stats.push_back(level);
+    }
+    stats.l1_stats = stats.level_stats[0];
+    if (stats.level_stats.size() > 1) {
+        stats.l2_stats = stats.level_stats[1];
+    }
+    if (victim_) {
+        stats.victim_stats = victim_->getStats();
+        stats.total_accesses += stats.victim_stats.accesses;
+    }
     stats.memory_accesses = memory_access_count_;
+    stats.back_invalidations = back_invalidation_count_;
+    stats.latency = latency_stats_;
     return stats;
 }
 
@@ -90,36 +286,555 @@ std::string CacheHierarchy::getStatsString() const {
 
     oss << "=== Cache Hierarchy Statistics ===\n\n";
 
-    // L1 stats
-    oss << l1_cache_->getStatsString() << "\n";
-
-    // L2 stats
-    oss << l2_cache_->getStatsString() << "\n";
+    // Per-level stats
+    for (const auto& cache : levels_) {
+        oss << cache->getStatsString() << "\n";
+    }
 
     // Overall stats
     oss << "=== Overall Statistics ===\n";
     oss << "Total Accesses: " << stats.total_accesses << "\n";
-    oss << "L1 Hits: " << stats.l1_stats.hits << "\n";
-    oss << "L2 Hits: " << stats.l2_stats.hits << "\n";
+    for (size_t i = 0; i < stats.level_stats.size(); i++) {
+        oss << "L" << (i + 1) << " Hits: " << stats.level_stats[i].hits << "\n";
+    }
+    if (victim_) {
+        oss << victimCacheModeToString(victim_mode_) << " Hits: " << stats.victim_stats.hits << "\n";
+    }
     oss << "Memory Accesses: " << stats.memory_accesses << "\n";
+    oss << "Inclusion Policy: " << inclusionPolicyToString(inclusion_) << "\n";
+    if (inclusion_ == InclusionPolicy::INCLUSIVE) {
+        oss << "Back-Invalidations: " << stats.back_invalidations << "\n";
+    }
     oss << "Overall Hit Ratio: " << std::fixed << std::setprecision(2)
         << stats.getOverallHitRatio() << "%\n";
 
+    oss << "\n=== Access Latency ===\n";
+    oss << "Latencies (cycles):";
+    for (size_t i = 0; i < latencies_.hit_cycles.size(); i++) {
+        oss << " L" << (i + 1) << " " << latencies_.hit_cycles[i] << ",";
+    }
+    if (victim_) {
+        oss << " " << victimCacheModeToString(victim_mode_) << " " << latencies_.victim_cycles << ",";
+    }
+    oss << " Memory " << latencies_.memory_cycles << "\n";
+    oss << stats.latency.toString();
+
+    if (victim_) {
+        // Every buffer hit is an L1 miss that did not reach the next level
+        const CacheStats& v = stats.victim_stats;
+        oss << "\n=== " << victimCacheModeToString(victim_mode_) << " ===\n";
+        oss << "Entries: " << victim_->getAssociativity() << " (fully associative, LRU)\n";
+        oss << "Lookups (L1 read misses): " << v.accesses << "\n";
+        oss << "Hits (L1 misses recovered): " << v.hits << "\n";
+        oss << "Misses: " << v.misses << "\n";
+        oss << "Hit Ratio: " << std::fixed << std::setprecision(2)
+            << v.getHitRatio() << "%\n";
+    }
+
+    if (sampling_ratio_ > 1) {
+        SamplingStats sampling = getSamplingStats();
+        oss << "\n=== Set Sampling ===\n";
+        oss << "Mode: " << setSamplingModeToString(sampling.mode) << ", 1 in " << sampling.ratio
+            << " " << samplingGroupName(sampling) << " (" << sampling.sampled_sets << " of "
+            << sampling.total_sets << " simulated)\n";
+        oss << "Requests: " << sampling.requests << " (" << sampling.simulated_requests
+            << " simulated; the statistics above cover only these)\n";
+        for (size_t i = 0; i < sampling.levels.size(); i++) {
+            const SampledEstimate& e = sampling.levels[i];
+            oss << "L" << (i + 1) << " Estimated Miss Ratio: " << std::fixed << std::setprecision(2)
+                << e.miss_ratio << "% +/- ";
+            if (e.margin < 0) {
+                oss << "n/a";
+            } else {
+                oss << e.margin << "%";
+            }
+            oss << " (" << e.misses << " of " << e.accesses << " accesses)\n";
+        }
+        oss << "Estimated Memory Accesses: " << sampling.memory.misses << "\n";
+    }
+
+    // Prefetch stats (only for levels with a prefetcher attached)
+    for (size_t i = 0; i < prefetch_slots_.size(); i++) {
+        const PrefetchSlot& slot = prefetch_slots_[i];
+        if (!slot.prefetcher) continue;
+        const PrefetchStats& p = stats.level_stats[i].prefetch;
+        oss << "\n=== L" << (i + 1) << " Prefetcher ===\n";
+        oss << "Configuration: " << slot.prefetcher->getConfigString()
+            << ", latency " << slot.latency << "\n";
+        oss << "Issued: " << p.issued << "\n";
+        oss << "Useful: " << p.useful << "\n";
+        oss << "Late: " << p.late << "\n";
+        oss << "Polluting: " << p.polluting << "\n";
+        oss << "Accuracy: " << std::fixed << std::setprecision(2)
+            << p.getAccuracy() << "%\n";
+    }
+
     return oss.str();
 }
 
+Result<void> CacheHierarchy::setLatencies(const LatencyConfig& latencies) {
+    if (latencies.hit_cycles.size() != levels_.size()) {
+        return Result<void>::Err("Expected " + std::to_string(levels_.size()) +
+                                 " hit latencies (one per level), got " +
+                                 std::to_string(latencies.hit_cycles.size()));
+    }
+    latencies_ = latencies;
+    return Result<void>::Ok();
+}
+
+LatencyConfig CacheHierarchy::defaultLatencies(size_t num_levels) {
+    LatencyConfig latencies;
+    uint64_t cycles = DEFAULT_L1_CYCLES;
+    for (size_t i = 0; i < num_levels; i++) {
+        latencies.hit_cycles.push_back(cycles);
+        cycles *= DEFAULT_LEVEL_CYCLES_FACTOR;
+    }
+    latencies.victim_cycles = DEFAULT_VICTIM_CYCLES;
+    latencies.memory_cycles = DEFAULT_MEMORY_CYCLES;
+    return latencies;
+}
+
 void CacheHierarchy::dump() const {
-    l1_cache_->dump();
-    std::cout << "\n";
-    l2_cache_->dump();
+    for (size_t i = 0; i < levels_.size(); i++) {
+        if (i > 0) {
+            std::cout << "\n";
+        }
+        levels_[i]->dump();
+    }
+}
+
+CacheLevel* CacheHierarchy::getLevel(int level) {
+    if (!isValidLevel(level)) {
+        return nullptr;
+    }
+    return levels_[level - 1].get();
+}
+
+bool CacheHierarchy::containsInLevel(int level, Address address) const {
+    if (!isValidLevel(level)) {
+        return false;
+    }
+    return levels_[level - 1]->contains(address);
 }
 
 bool CacheHierarchy::containsInL1(Address address) const {
-    return l1_cache_->contains(address);
+    return containsInLevel(1, address);
 }
 
 bool CacheHierarchy::containsInL2(Address address) const {
-    return l2_cache_->contains(address);
+    return containsInLevel(2, address);
+}
+
+Result<void> CacheHierarchy::setPrefetcher(int level, std::unique_ptr<IPrefetcher> prefetcher,
+                                          uint64_t latency) {
+    if (!isValidLevel(level)) {
+        return Result<void>::Err("Invalid cache level for prefetcher: " + std::to_string(level));
+    }
+
+    PrefetchSlot& slot = prefetch_slots_[level - 1];
+    slot.prefetcher = std::move(prefetcher);
+    slot.latency = latency;
+    slot.in_flight.clear();
+    return Result<void>::Ok();
+}
+
+Result<void> CacheHierarchy::setVictimCache(size_t entries, VictimCacheMode mode) {
+    if (entries == 0) {
+        victim_.reset();
+        return Result<void>::Ok();
+    }
+    if (mode == VictimCacheMode::MISS && inclusion_ == InclusionPolicy::EXCLUSIVE) {
+        return Result<void>::Err("A miss cache duplicates L1 blocks and cannot be used in an exclusive hierarchy");
+    }
+
+    victim_ = std::make_unique<CacheLevel>(
+        1, 1, entries, levels_[0]->getBlockSize(), CachePolicy::LRU, memory_
+    );
+    victim_mode_ = mode;
+    return Result<void>::Ok();
+}
+
+bool CacheHierarchy::containsInVictimCache(Address address) const {
+    return victim_ && victim_->contains(address);
+}
+
+void CacheHierarchy::setMissClassification(bool enable) {
+    for (auto& cache : levels_) {
+        cache->setMissClassification(enable);
+    }
+}
+
+Result<void> CacheHierarchy::setSetSampling(size_t ratio, SetSamplingMode mode) {
+    if (ratio == 0) {
+        return Result<void>::Err("Sampling ratio must be at least 1");
+    }
+
+    // Group by the set-index bits every level shares: a group is then made of
+    // whole sets of each level, even when their block sizes differ
+    size_t low = 0;
+    size_t high = SIZE_MAX;
+    for (const auto& cache : levels_) {
+        size_t offset_bits = floorLog2(cache->getBlockSize());
+        low = std::max(low, offset_bits);
+        high = std::min(high, offset_bits + floorLog2(cache->getNumSets()));
+    }
+    if (high <= low) {
+        if (ratio > 1) {
+            return Result<void>::Err("Cache levels share no set-index bits, so no set groups can be sampled");
+        }
+        high = low;
+    }
+    size_t num_sets = size_t{1} << (high - low);
+
+    // Name the level whose sets are the groups (the one with the fewest sets, with equal block sizes)
+    int level = 0;
+    for (size_t i = 0; i < levels_.size() && level == 0; i++) {
+        if (floorLog2(levels_[i]->getBlockSize()) == low && levels_[i]->getNumSets() == num_sets) {
+            level = static_cast<int>(i + 1);
+        }
+    }
+    if (ratio > num_sets) {
+        std::string groups = (level > 0) ? "sets of L" + std::to_string(level)
+                                         : "set groups shared by every level";
+        return Result<void>::Err("Sampling ratio " + std::to_string(ratio) + " exceeds the " +
+                                 std::to_string(num_sets) + " " + groups);
+    }
+
+    std::vector<size_t> clusters;
+    size_t sampled = 0;
+    if (ratio > 1) {
+        clusters.assign(num_sets, NOT_SAMPLED);
+        for (size_t set = 0; set < num_sets; set++) {
+            uint64_t key = (mode == SetSamplingMode::STRIDE) ? set : hashSetIndex(set);
+            if (key % ratio == 0) {
+                clusters[set] = sampled++;
+            }
+        }
+        if (sampled == 0) {
+            return Result<void>::Err("Hash sampling selected no set; use a smaller ratio or stride sampling");
+        }
+    }
+
+    // Writes to skipped sets bypass the caches, so lines kept from before would go stale
+    flush();
+
+    sampling_ratio_ = ratio;
+    sampling_mode_ = mode;
+    sampling_level_ = level;
+    sample_shift_ = low;
+    sample_groups_ = num_sets;
+    sampled_sets_ = (ratio > 1) ? sampled : num_sets;
+    sample_cluster_ = std::move(clusters);
+    cluster_counts_.assign((ratio > 1) ? sampled * (levels_.size() + 1) : 0, SampleCounts{0, 0});
+    sample_before_.assign(levels_.size() + 1, SampleCounts{0, 0});
+    request_count_ = 0;
+    return Result<void>::Ok();
+}
+
+SamplingStats CacheHierarchy::getSamplingStats() const {
+    SamplingStats sampling;
+    sampling.ratio = sampling_ratio_;
+    sampling.mode = sampling_mode_;
+    sampling.sampling_level = sampling_level_;
+    sampling.first_index_bit = sample_shift_;
+    sampling.total_sets = sample_groups_;
+    sampling.sampled_sets = (sampling_ratio_ > 1) ? sampled_sets_ : sampling.total_sets;
+    sampling.requests = request_count_;
+
+    if (sampling_ratio_ == 1) {
+        // Exact mode: the measured values, with no sampling error
+        sampling.simulated_requests = request_count_;
+        for (const auto& cache : levels_) {
+            CacheStats stats = cache->getStats();
+            SampledEstimate exact;
+            exact.miss_ratio = stats.getMissRatio();
+            exact.margin = 0.0;
+            exact.accesses = stats.accesses;
+            exact.misses = stats.misses;
+            sampling.levels.push_back(exact);
+        }
+        sampling.memory.accesses = request_count_;
+        sampling.memory.misses = memory_access_count_;
+        sampling.memory.margin = 0.0;
+        if (request_count_ > 0) {
+            sampling.memory.miss_ratio = 100.0 * memory_access_count_ / request_count_;
+        }
+        return sampling;
+    }
+
+    size_t stride = levels_.size() + 1;
+    for (size_t c = 0; c < sampled_sets_; c++) {
+        sampling.simulated_requests += cluster_counts_[c * stride + levels_.size()].accesses;
+    }
+    double scale = (sampling.simulated_requests == 0)
+        ? 0.0 : static_cast<double>(request_count_) / sampling.simulated_requests;
+    for (size_t i = 0; i < levels_.size(); i++) {
+        sampling.levels.push_back(estimateSlot(i, scale));
+    }
+    sampling.memory = estimateSlot(levels_.size(), scale);
+    return sampling;
+}
+
+const IPrefetcher* CacheHierarchy::getPrefetcher(int level) const {
+    if (!isValidLevel(level)) {
+        return nullptr;
+    }
+    return prefetch_slots_[level - 1].prefetcher.get();
+}
+
+// Private helper methods
+
+void CacheHierarchy::install(size_t level, Address address, bool prefetched) {
+    CacheProbe probe = levels_[level]->peek(address);
+    install(level, probe, address, prefetched);
+}
+
+void CacheHierarchy::install(size_t level, CacheProbe& probe, Address address, bool prefetched) {
+    CacheEviction eviction = levels_[level]->fill(probe, address, prefetched);
+    if (!eviction.valid) {
+        return;
+    }
+
+    if (level == 0 && victim_ && victim_mode_ == VictimCacheMode::VICTIM) {
+        // L1's victim is buffered; what the buffer drops continues down
+        eviction = victim_->fill(eviction.block_address);
+        if (!eviction.valid) {
+            return;
+        }
+    }
+
+    switch (inclusion_) {
+        case InclusionPolicy::NINE:
+            break;
+
+        case InclusionPolicy::INCLUSIVE:
+            backInvalidate(level, eviction.block_address);
+            break;
+
+        case InclusionPolicy::EXCLUSIVE:
+            // The victim moves one level down, displacing that level's victim in turn
+            for (size_t i = level + 1; i < levels_.size() && eviction.valid; i++) {
+                eviction = levels_[i]->fill(eviction.block_address);
+            }
+            break;
+    }
+}
+
+void CacheHierarchy::backInvalidate(size_t level, Address block_address) {
+    Address end = block_address + levels_[level]->getBlockSize();
+    for (size_t i = 0; i < level; i++) {
+        // Upper levels may use smaller blocks: drop every one the victim covers
+        size_t upper_block = levels_[i]->getBlockSize();
+        Address start = block_address & ~static_cast<Address>(upper_block - 1);
+        for (Address addr = start; addr < end; addr += upper_block) {
+            if (levels_[i]->invalidate(addr)) {
+                back_invalidation_count_++;
+            }
+        }
+    }
+
+    // The buffer between L1 and L2 must not outlive the lower copy either
+    if (level > 0 && victim_) {
+        size_t victim_block = victim_->getBlockSize();
+        Address start = block_address & ~static_cast<Address>(victim_block - 1);
+        for (Address addr = start; addr < end; addr += victim_block) {
+            if (victim_->invalidate(addr)) {
+                back_invalidation_count_++;
+            }
+        }
+    }
+}
+
+void CacheHierarchy::installPrefetch(size_t level, Address block_address) {
+    if (level == 0 && victim_mode_ == VictimCacheMode::VICTIM && containsInVictimCache(block_address)) {
+        return;  // A victim cache never duplicates an L1 line
+    }
+
+    switch (inclusion_) {
+        case InclusionPolicy::NINE:
+            break;
+
+        case InclusionPolicy::INCLUSIVE:
+            // Keep inclusion: the block must also be present in every level below
+            for (size_t i = levels_.size(); i-- > level + 1;) {
+                install(i, block_address, false);
+            }
+            break;
+
+        case InclusionPolicy::EXCLUSIVE:
+            // Never duplicate a block another level already holds
+            for (size_t i = 0; i < levels_.size(); i++) {
+                if (i != level && levels_[i]->contains(block_address)) {
+                    return;
+                }
+            }
+            if (containsInVictimCache(block_address)) {
+                return;
+            }
+            break;
+    }
+    install(level, block_address, true);
+}
+
+void CacheHierarchy::completePrefetches(size_t level) {
+    PrefetchSlot& slot = prefetch_slots_[level];
+    while (!slot.in_flight.empty() && slot.in_flight.front().ready_time <= read_clock_) {
+        Address block = slot.in_flight.front().block_address;
+        slot.in_flight.pop_front();
+        if (!levels_[level]->contains(block)) {
+            installPrefetch(level, block);
+        }
+    }
+}
+
+void CacheHierarchy::checkLatePrefetch(PrefetchSlot& slot, Address block_address) {
+    for (auto it = slot.in_flight.begin(); it != slot.in_flight.end(); ++it) {
+        if (it->block_address == block_address) {
+            // The demand fetch overtakes the prefetch, which is dropped
+            slot.late++;
+            slot.in_flight.erase(it);
+            return;
+        }
+    }
+}
+
+void CacheHierarchy::trainPrefetcher(size_t level, Address address, bool hit, bool prefetch_hit) {
+    PrefetchSlot& slot = prefetch_slots_[level];
+    CacheLevel& cache = *levels_[level];
+    if (!slot.prefetcher) {
+        return;
+    }
+
+    PrefetchTrigger trigger;
+    trigger.block_address = address & ~static_cast<Address>(cache.getBlockSize() - 1);
+    trigger.hit = hit;
+    trigger.prefetch_hit = prefetch_hit;
+
+    candidates_.clear();
+    slot.prefetcher->onAccess(trigger, candidates_);
+
+    for (Address block : candidates_) {
+        if (!memory_->isValidRange(block, cache.getBlockSize()) || cache.contains(block)) {
+            continue;
+        }
+        bool pending = false;
+        for (const auto& request : slot.in_flight) {
+            if (request.block_address == block) {
+                pending = true;
+                break;
+            }
+        }
+        if (pending) {
+            continue;
+        }
+
+        slot.issued++;
+        if (slot.latency == 0) {
+            installPrefetch(level, block);
+        } else {
+            slot.in_flight.push_back({block, read_clock_ + slot.latency});
+        }
+    }
+}
+
+uint64_t CacheHierarchy::accessCycles(size_t hit_level, bool victim_probed) const {
+    // Sequential lookup: every level down to the one that served the access
+    size_t probed = hit_level < levels_.size() ? hit_level + 1 : levels_.size();
+    uint64_t cycles = 0;
+    for (size_t i = 0; i < probed; i++) {
+        cycles += latencies_.hit_cycles[i];
+    }
+    if (victim_probed) {
+        cycles += latencies_.victim_cycles;
+    }
+    if (hit_level == levels_.size()) {
+        cycles += latencies_.memory_cycles;
+    }
+    return cycles;
+}
+
+void CacheHierarchy::recordLatency(bool is_write, uint64_t cycles) {
+    last_access_cycles_ = cycles;
+    if (is_write) {
+        latency_stats_.writes.record(cycles);
+    } else {
+        latency_stats_.reads.record(cycles);
+    }
+}
+
+size_t CacheHierarchy::sampleCluster(Address address) const {
+    return sample_cluster_[(address >> sample_shift_) & (sample_groups_ - 1)];
+}
+
+void CacheHierarchy::beginSample() {
+    for (size_t i = 0; i < levels_.size(); i++) {
+        CacheStats stats = levels_[i]->getStats();
+        sample_before_[i] = {stats.accesses, stats.misses};
+    }
+    sample_before_[levels_.size()] = {0, memory_access_count_};
+}
+
+void CacheHierarchy::endSample(size_t cluster) {
+    SampleCounts* counts = &cluster_counts_[cluster * (levels_.size() + 1)];
+    for (size_t i = 0; i < levels_.size(); i++) {
+        CacheStats stats = levels_[i]->getStats();
+        counts[i].accesses += stats.accesses - sample_before_[i].accesses;
+        counts[i].misses += stats.misses - sample_before_[i].misses;
+    }
+    // The memory slot counts requests as its accesses
+    counts[levels_.size()].accesses++;
+    counts[levels_.size()].misses += memory_access_count_ - sample_before_[levels_.size()].misses;
+}
+
+SampledEstimate CacheHierarchy::estimateSlot(size_t slot, double scale) const {
+    size_t stride = levels_.size() + 1;
+    size_t n = sampled_sets_;
+    double sum_accesses = 0.0;
+    double sum_misses = 0.0;
+    for (size_t c = 0; c < n; c++) {
+        sum_accesses += cluster_counts_[c * stride + slot].accesses;
+        sum_misses += cluster_counts_[c * stride + slot].misses;
+    }
+
+    SampledEstimate estimate;
+    estimate.accesses = static_cast<uint64_t>(sum_accesses * scale + 0.5);
+    estimate.misses = static_cast<uint64_t>(sum_misses * scale + 0.5);
+    if (sum_accesses == 0.0) {
+        return estimate;
+    }
+
+    // Ratio estimator over clusters (sampled sets), with finite population correction
+    double ratio = sum_misses / sum_accesses;
+    estimate.miss_ratio = ratio * 100.0;
+    if (n < 2) {
+        return estimate;
+    }
+    double residuals = 0.0;
+    for (size_t c = 0; c < n; c++) {
+        const SampleCounts& counts = cluster_counts_[c * stride + slot];
+        double residual = counts.misses - ratio * counts.accesses;
+        residuals += residual * residual;
+    }
+    double mean_accesses = sum_accesses / n;
+    double fraction = static_cast<double>(n) / sample_groups_;
+    double variance = (1.0 - fraction) * residuals / (n - 1) / (n * mean_accesses * mean_accesses);
+    estimate.margin = 1.96 * std::sqrt(variance) * 100.0;
+    return estimate;
+}
+
+uint64_t CacheHierarchy::hashSetIndex(size_t set) {
+    // 64-bit finalizer: nearby set indices land far apart
+    uint64_t x = set;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+bool CacheHierarchy::isValidLevel(int level) const {
+    return level >= 1 && static_cast<size_t>(level) <= levels_.size();
 }
 
 } // namespace memsim
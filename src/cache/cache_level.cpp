@@ -1,4 +1,5 @@
 #include "cache/cache_level.h"
+#include "common/bit_utils.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -20,6 +21,12 @@ CacheLevel::CacheLevel(int level,
       block_size_(block_size),
       policy_(policy),
       memory_(memory),
+      psel_(PSEL_MAX / 2),
+      brrip_fill_count_(0),
+      dueling_stride_(0),
+      lfu_aging_interval_(policy == CachePolicy::LFU
+                              ? LFU_AGING_LINES_FACTOR * num_sets * associativity : 0),
+      lfu_accesses_since_aging_(0),
       global_time_(0) {
 
     // Validate parameters
@@ -35,12 +42,33 @@ CacheLevel::CacheLevel(int level,
     if (memory == nullptr) {
         throw std::invalid_argument("Memory pointer cannot be null");
     }
+    if (policy == CachePolicy::TREE_PLRU || policy == CachePolicy::BIT_PLRU) {
+        if (associativity > 64) {
+            throw std::invalid_argument("PLRU policies support at most 64 ways");
+        }
+        if (policy == CachePolicy::TREE_PLRU && !isPowerOfTwo(associativity)) {
+            throw std::invalid_argument("Tree-PLRU associativity must be power of 2");
+        }
+        plru_bits_.assign(num_sets, 0);
+    }
+    if (policy == CachePolicy::DRRIP) {
+        if (num_sets < DRRIP_MIN_SETS) {
+            throw std::invalid_argument("DRRIP needs at least 4 sets so that follower sets exist");
+        }
+        size_t leaders = std::min(DRRIP_MAX_LEADER_SETS, std::max<size_t>(1, num_sets / 8));
+        dueling_stride_ = num_sets / leaders;
+    }
+    if (policy == CachePolicy::LFU || policy == CachePolicy::LFU_DA) {
+        lfu_buckets_.assign(num_sets, FrequencyBuckets(associativity));
+        lfu_age_.assign(num_sets, 0);
+    }
 
     // Calculate bit counts for address parsing
     offset_bits_ = calculateBits(block_size - 1);
     index_bits_ = calculateBits(num_sets - 1);
 
     // Initialize cache structure
+    valid_lines_.assign(num_sets, 0);
     sets_.resize(num_sets);
     for (auto& set : sets_) {
         set.reserve(associativity);
@@ -51,44 +79,16 @@ CacheLevel::CacheLevel(int level,
 }
 
 Result<uint8_t> CacheLevel::read(Address address) {
-    stats_.accesses++;
-    global_time_++;
-
-    // Parse address
-    Address tag;
-    size_t set_index, offset;
-    parseAddress(address, tag, set_index, offset);
-
-    // Look for matching line in set
-    CacheLine* line = findLine(set_index, tag);
-
-    if (line != nullptr) {
-        // Cache hit
-        stats_.hits++;
-        line->recordAccess(global_time_);
-        return Result<uint8_t>::Ok(line->data[offset]);
+    CacheProbe result = probe(address);
+    if (!result.hit) {
+        // Cache miss - select victim and load from memory
+        fill(result, address);
     }
-
-    // Cache miss - select victim and load from memory
-    stats_.misses++;
-    size_t victim_way = selectVictim(set_index);
-
-    // Load block from memory
-    loadBlock(address, tag, set_index, victim_way);
-
-    // Return requested byte
-    CacheLine& new_line = sets_[set_index][victim_way];
-    return Result<uint8_t>::Ok(new_line.data[offset]);
+    return Result<uint8_t>::Ok(readData(result));
 }
 
 Result<void> CacheLevel::write(Address address, uint8_t data) {
-    stats_.accesses++;
-    global_time_++;
-
-    // Parse address
-    Address tag;
-    size_t set_index, offset;
-    parseAddress(address, tag, set_index, offset);
+    CacheProbe result = probe(address);
 
     // Write-through: always write to memory
     auto write_result = memory_->write(address, data);
@@ -96,37 +96,115 @@ Result<void> CacheLevel::write(Address address, uint8_t data) {
         return write_result;
     }
 
-    // Look for matching line in set
-    CacheLine* line = findLine(set_index, tag);
-
-    if (line != nullptr) {
-        // Cache hit - update cache line
-        stats_.hits++;
-        line->data[offset] = data;
-        line->recordAccess(global_time_);
-    } else {
+    if (!result.hit) {
         // Cache miss - load block and update
-        stats_.misses++;
-        size_t victim_way = selectVictim(set_index);
-        loadBlock(address, tag, set_index, victim_way);
-        sets_[set_index][victim_way].data[offset] = data;
+        fill(result, address);
     }
-
+    writeData(result, data);
     return Result<void>::Ok();
 }
 
 bool CacheLevel::contains(Address address) const {
-    Address tag;
-    size_t set_index, offset;
-    parseAddress(address, tag, set_index, offset);
-
-    const auto& set = sets_[set_index];
-    for (const auto& line : set) {
-        if (line.valid && line.tag == tag) {
-            return true;
+    return peek(address).hit;
+}
+
+CacheProbe CacheLevel::probe(Address address) {
+    CacheProbe result = peek(address);
+    recordProbe(result, true);
+    return result;
+}
+
+CacheProbe CacheLevel::probeForWrite(Address address) {
+    CacheProbe result = peek(address);
+    recordProbe(result, false);
+    return result;
+}
+
+CacheProbe CacheLevel::peek(Address address) const {
+    CacheProbe result;
+    parseAddress(address, result.tag, result.set_index, result.offset);
+
+    // Single pass: find the matching line, remembering the first free way
+    const auto& set = sets_[result.set_index];
+    for (size_t i = 0; i < associativity_; i++) {
+        if (set[i].valid) {
+            if (set[i].tag == result.tag) {
+                result.hit = true;
+                result.way = i;
+                return result;
+            }
+        } else if (result.way == CacheProbe::NO_WAY) {
+            result.way = i;
         }
     }
-    return false;
+    return result;
+}
+
+uint8_t CacheLevel::readData(const CacheProbe& probe) const {
+    return sets_[probe.set_index][probe.way].data[probe.offset];
+}
+
+void CacheLevel::writeData(const CacheProbe& probe, uint8_t data) {
+    sets_[probe.set_index][probe.way].data[probe.offset] = data;
+}
+
+CacheEviction CacheLevel::fill(CacheProbe& probe, Address address, bool prefetched) {
+    CacheEviction eviction;
+    if (probe.hit) {
+        return eviction;
+    }
+
+    size_t victim_way = probe.way;
+    if (victim_way == CacheProbe::NO_WAY) {
+        // The set was full when probed, unless a line was invalidated since
+        victim_way = (valid_lines_[probe.set_index] < associativity_)
+                         ? selectVictim(probe.set_index)
+                         : selectPolicyVictim(probe.set_index);
+    }
+
+    const CacheLine& victim = sets_[probe.set_index][victim_way];
+    if (victim.valid) {
+        eviction.valid = true;
+        eviction.block_address = makeBlockAddress(victim.tag, probe.set_index);
+    }
+
+    loadBlock(address, probe.tag, probe.set_index, victim_way);
+    sets_[probe.set_index][victim_way].prefetched = prefetched;
+
+    probe.hit = true;
+    probe.way = victim_way;
+    return eviction;
+}
+
+CacheEviction CacheLevel::fill(Address address, bool prefetched) {
+    CacheProbe result = peek(address);
+    return fill(result, address, prefetched);
+}
+
+void CacheLevel::invalidate(const CacheProbe& probe) {
+    if (!lfu_buckets_.empty()) {
+        lfu_buckets_[probe.set_index].remove(probe.way);
+    }
+    sets_[probe.set_index][probe.way].invalidate();
+    valid_lines_[probe.set_index]--;
+}
+
+bool CacheLevel::invalidate(Address address) {
+    CacheProbe result = peek(address);
+    if (!result.hit) {
+        return false;
+    }
+    invalidate(result);
+    return true;
+}
+
+bool CacheLevel::prefetch(Address address) {
+    CacheProbe result = peek(address);
+    if (result.hit) {
+        return false;
+    }
+    fill(result, address, true);
+    return true;
 }
 
 void CacheLevel::flush() {
@@ -135,6 +213,26 @@ void CacheLevel::flush() {
             line.invalidate();
         }
     }
+    std::fill(valid_lines_.begin(), valid_lines_.end(), 0);
+    std::fill(plru_bits_.begin(), plru_bits_.end(), 0);
+    for (auto& buckets : lfu_buckets_) {
+        buckets.clear();
+    }
+    std::fill(lfu_age_.begin(), lfu_age_.end(), 0);
+    if (classifier_) {
+        classifier_->flush();
+    }
+}
+
+void CacheLevel::setMissClassification(bool enable) {
+    stats_.compulsory_misses = 0;
+    stats_.capacity_misses = 0;
+    stats_.conflict_misses = 0;
+    if (enable) {
+        classifier_ = std::make_unique<MissClassifier>(num_sets_ * associativity_);
+    } else {
+        classifier_.reset();
+    }
 }
 
 std::string CacheLevel::getStatsString() const {
@@ -148,6 +246,11 @@ std::string CacheLevel::getStatsString() const {
         << stats_.getHitRatio() << "%\n";
     oss << "Miss Ratio: " << std::fixed << std::setprecision(2)
         << stats_.getMissRatio() << "%\n";
+    if (classifier_) {
+        oss << "  Compulsory: " << stats_.compulsory_misses << "\n";
+        oss << "  Capacity: " << stats_.capacity_misses << "\n";
+        oss << "  Conflict: " << stats_.conflict_misses << "\n";
+    }
     return oss.str();
 }
 
@@ -184,12 +287,28 @@ void CacheLevel::dump() const {
                     case CachePolicy::LFU:
                         std::cout << " AccessCnt:" << line.access_count;
                         break;
+                    case CachePolicy::LFU_DA:
+                        std::cout << " AccessCnt:" << line.access_count
+                                  << " Key:" << lfu_buckets_[set_idx].getKey(way);
+                        break;
+                    case CachePolicy::TREE_PLRU:
+                    case CachePolicy::BIT_PLRU:
+                        // Per-set state shown after the lines
+                        break;
+                    case CachePolicy::SRRIP:
+                    case CachePolicy::BRRIP:
+                    case CachePolicy::DRRIP:
+                        std::cout << " RRPV:" << static_cast<int>(line.rrpv);
+                        break;
                 }
                 std::cout << "] ";
             } else {
                 std::cout << "[V:0 Tag:----] ";
             }
         }
+        if (!plru_bits_.empty()) {
+            std::cout << "PLRU:0x" << std::hex << plru_bits_[set_idx] << std::dec;
+        }
         std::cout << "\n";
     }
     std::cout << std::endl;
@@ -198,12 +317,11 @@ void CacheLevel::dump() const {
 std::string CacheLevel::getConfigString() const {
     std::ostringstream oss;
     oss << num_sets_ << " sets, " << associativity_ << "-way, "
-        << block_size_ << " bytes/block, ";
+        << block_size_ << " bytes/block, "
+        << cachePolicyToString(policy_);
 
-    switch (policy_) {
-        case CachePolicy::FIFO: oss << "FIFO"; break;
-        case CachePolicy::LRU: oss << "LRU"; break;
-        case CachePolicy::LFU: oss << "LFU"; break;
+    if (policy_ == CachePolicy::DRRIP) {
+        oss << " (PSEL " << psel_ << "/" << PSEL_MAX << ")";
     }
 
     return oss.str();
@@ -222,14 +340,57 @@ void CacheLevel::parseAddress(Address address, Address& tag, size_t& set_index,
     tag = address >> (offset_bits_ + index_bits_);
 }
 
-CacheLine* CacheLevel::findLine(size_t set_index, Address tag) {
-    auto& set = sets_[set_index];
-    for (auto& line : set) {
-        if (line.valid && line.tag == tag) {
-            return &line;
+Address CacheLevel::makeBlockAddress(Address tag, size_t set_index) const {
+    return (tag << (offset_bits_ + index_bits_)) | (static_cast<Address>(set_index) << offset_bits_);
+}
+
+void CacheLevel::recordProbe(CacheProbe& probe, bool count_miss) {
+    if (!probe.hit) {
+        if (count_miss) {
+            stats_.accesses++;
+            stats_.misses++;
+            global_time_++;
+            tickLfuAging();
+            if (policy_ == CachePolicy::DRRIP) {
+                // A leader's demand miss votes for the other policy
+                int role = duelingRole(probe.set_index);
+                if (role == 0 && psel_ < PSEL_MAX) {
+                    psel_++;
+                } else if (role == 1 && psel_ > 0) {
+                    psel_--;
+                }
+            }
+            if (classifier_) {
+                classifyMiss(makeBlockAddress(probe.tag, probe.set_index));
+            }
         }
+        return;
+    }
+
+    stats_.accesses++;
+    stats_.hits++;
+    global_time_++;
+    tickLfuAging();
+
+    CacheLine& line = sets_[probe.set_index][probe.way];
+    if (line.prefetched) {
+        stats_.prefetch.useful++;
+        line.prefetched = false;
+        probe.prefetch_hit = true;
+    }
+    line.recordAccess(global_time_);
+    updateReplacementState(probe.set_index, probe.way);
+    if (classifier_) {
+        classifier_->recordHit(makeBlockAddress(probe.tag, probe.set_index));
+    }
+}
+
+void CacheLevel::classifyMiss(Address block_address) {
+    switch (classifier_->recordMiss(block_address)) {
+        case MissType::COMPULSORY: stats_.compulsory_misses++; break;
+        case MissType::CAPACITY: stats_.capacity_misses++; break;
+        case MissType::CONFLICT: stats_.conflict_misses++; break;
     }
-    return nullptr;
 }
 
 size_t CacheLevel::selectVictim(size_t set_index) {
@@ -243,6 +404,12 @@ size_t CacheLevel::selectVictim(size_t set_index) {
     }
 
     // No empty lines, use replacement policy
+    return selectPolicyVictim(set_index);
+}
+
+size_t CacheLevel::selectPolicyVictim(size_t set_index) {
+    auto& set = sets_[set_index];
+
     switch (policy_) {
         case CachePolicy::FIFO: {
             // Find line with smallest insertion_order (oldest)
@@ -270,17 +437,44 @@ size_t CacheLevel::selectVictim(size_t set_index) {
             return victim;
         }
 
-        case CachePolicy::LFU: {
-            // Find line with smallest access_count (least frequently used)
-            size_t victim = 0;
-            uint64_t min_count = set[0].access_count;
-            for (size_t i = 1; i < associativity_; i++) {
-                if (set[i].access_count < min_count) {
-                    min_count = set[i].access_count;
-                    victim = i;
+        case CachePolicy::LFU:
+        case CachePolicy::LFU_DA:
+            // Head of the lowest-key bucket (oldest among equal keys)
+            return lfu_buckets_[set_index].victim();
+
+        case CachePolicy::TREE_PLRU: {
+            // Follow the direction bits from the root down to a leaf
+            uint64_t bits = plru_bits_[set_index];
+            size_t node = 1;
+            while (node < associativity_) {
+                node = 2 * node + ((bits >> node) & 1);
+            }
+            return node - associativity_;
+        }
+
+        case CachePolicy::BIT_PLRU: {
+            // First way whose MRU bit is clear (an epoch never sets all bits)
+            if (associativity_ == 1) {
+                return 0;
+            }
+            uint64_t mru = plru_bits_[set_index];
+            return countTrailingZeros(~mru);
+        }
+
+        case CachePolicy::SRRIP:
+        case CachePolicy::BRRIP:
+        case CachePolicy::DRRIP: {
+            // Find a line predicted for distant re-reference, aging the set until one exists
+            while (true) {
+                for (size_t i = 0; i < associativity_; i++) {
+                    if (set[i].rrpv >= RRPV_MAX) {
+                        return i;
+                    }
+                }
+                for (auto& line : set) {
+                    line.rrpv++;
                 }
             }
-            return victim;
         }
 
         default:
@@ -288,12 +482,140 @@ size_t CacheLevel::selectVictim(size_t set_index) {
     }
 }
 
+void CacheLevel::updateReplacementState(size_t set_index, size_t way_index) {
+    switch (policy_) {
+        case CachePolicy::TREE_PLRU: {
+            // Walk from the leaf to the root, pointing each node away from this way
+            uint64_t& bits = plru_bits_[set_index];
+            size_t node = way_index + associativity_;
+            while (node > 1) {
+                size_t parent = node / 2;
+                if (node % 2 == 0) {
+                    bits |= (1ULL << parent);   // Came from left, victim goes right
+                } else {
+                    bits &= ~(1ULL << parent);  // Came from right, victim goes left
+                }
+                node = parent;
+            }
+            break;
+        }
+
+        case CachePolicy::BIT_PLRU: {
+            uint64_t& mru = plru_bits_[set_index];
+            uint64_t all_ways = (associativity_ == 64) ? ~0ULL : ((1ULL << associativity_) - 1);
+            mru |= (1ULL << way_index);
+            if (mru == all_ways) {
+                // All ways recently used: start a new epoch with only this way set
+                mru = (1ULL << way_index);
+            }
+            break;
+        }
+
+        case CachePolicy::SRRIP:
+        case CachePolicy::BRRIP:
+        case CachePolicy::DRRIP:
+            // Hit priority: predict near-immediate re-reference
+            sets_[set_index][way_index].rrpv = 0;
+            break;
+
+        case CachePolicy::LFU:
+            // access_count was just incremented: move to the next bucket
+            lfu_buckets_[set_index].promote(way_index, sets_[set_index][way_index].access_count);
+            break;
+
+        case CachePolicy::LFU_DA:
+            // Priority is frequency plus the set's current age
+            lfu_buckets_[set_index].promote(
+                way_index, lfu_age_[set_index] + sets_[set_index][way_index].access_count);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void CacheLevel::updateInsertionState(size_t set_index, size_t way_index) {
+    if (policy_ == CachePolicy::LFU || policy_ == CachePolicy::LFU_DA) {
+        auto& buckets = lfu_buckets_[set_index];
+        if (buckets.contains(way_index)) {
+            // Replacing a valid line: LFU-DA ages the set to the victim's priority
+            if (policy_ == CachePolicy::LFU_DA) {
+                lfu_age_[set_index] = buckets.getKey(way_index);
+            }
+            buckets.remove(way_index);
+        }
+        uint64_t base = (policy_ == CachePolicy::LFU_DA) ? lfu_age_[set_index] : 0;
+        buckets.insert(way_index, base + sets_[set_index][way_index].access_count);
+        return;
+    }
+
+    if (!isRripPolicy()) {
+        updateReplacementState(set_index, way_index);
+        return;
+    }
+
+    bool use_brrip = (policy_ == CachePolicy::BRRIP);
+    if (policy_ == CachePolicy::DRRIP) {
+        int role = duelingRole(set_index);
+        use_brrip = role == 2 ? psel_ > PSEL_MAX / 2 : role == 1;
+    }
+
+    uint8_t rrpv = RRPV_MAX - 1;  // SRRIP: "long" re-reference interval
+    if (use_brrip) {
+        // BRRIP: mostly "distant", occasionally "long"
+        brrip_fill_count_++;
+        if (brrip_fill_count_ % BRRIP_LONG_INTERVAL != 0) {
+            rrpv = RRPV_MAX;
+        }
+    }
+    sets_[set_index][way_index].rrpv = rrpv;
+}
+
+void CacheLevel::tickLfuAging() {
+    if (policy_ != CachePolicy::LFU || lfu_aging_interval_ == 0) {
+        return;
+    }
+    if (++lfu_accesses_since_aging_ < lfu_aging_interval_) {
+        return;
+    }
+
+    // Halve every count so stale frequency decays (O(lines) once per interval)
+    lfu_accesses_since_aging_ = 0;
+    for (size_t set_idx = 0; set_idx < num_sets_; set_idx++) {
+        lfu_buckets_[set_idx].age();
+        for (auto& line : sets_[set_idx]) {
+            line.access_count >>= 1;
+        }
+    }
+}
+
+int CacheLevel::duelingRole(size_t set_index) const {
+    size_t offset = set_index % dueling_stride_;
+    if (offset == 0) return 0;
+    if (offset == dueling_stride_ / 2) return 1;
+    return 2;
+}
+
+bool CacheLevel::isRripPolicy() const {
+    return policy_ == CachePolicy::SRRIP ||
+           policy_ == CachePolicy::BRRIP ||
+           policy_ == CachePolicy::DRRIP;
+}
+
 void CacheLevel::loadBlock(Address address, Address tag, size_t set_index, size_t way_index) {
     // Align address to block boundary
     Address block_address = (address >> offset_bits_) << offset_bits_;
 
     auto& line = sets_[set_index][way_index];
 
+    // A prefetched line replaced before any demand use only displaced useful data
+    if (line.valid && line.prefetched) {
+        stats_.prefetch.polluting++;
+    }
+    if (!line.valid) {
+        valid_lines_[set_index]++;
+    }
+
     // Load entire block from memory
     for (size_t i = 0; i < block_size_; i++) {
         auto read_result = memory_->read(block_address + i);
@@ -310,6 +632,9 @@ void CacheLevel::loadBlock(Address address, Address tag, size_t set_index, size_
     line.insertion_order = global_time_;
     line.last_access_time = global_time_;
     line.access_count = 1;
+    line.prefetched = false;
+
+    updateInsertionState(set_index, way_index);
 }
 
 size_t CacheLevel::calculateBits(size_t value) {
@@ -0,0 +1,152 @@
+#include "cache/frequency_buckets.h"
+
+namespace memsim {
+
+FrequencyBuckets::FrequencyBuckets(size_t num_ways)
+    : buckets_(num_ways),
+      nodes_(num_ways),
+      head_(NIL) {
+    clear();
+}
+
+void FrequencyBuckets::insert(size_t way, uint64_t key) {
+    attach(static_cast<uint32_t>(way), key, NIL);
+}
+
+void FrequencyBuckets::remove(size_t way) {
+    if (!contains(way)) {
+        return;
+    }
+    detach(static_cast<uint32_t>(way));
+}
+
+void FrequencyBuckets::increment(size_t way) {
+    promote(way, getKey(way) + 1);
+}
+
+void FrequencyBuckets::promote(size_t way, uint64_t new_key) {
+    uint32_t w = static_cast<uint32_t>(way);
+    uint32_t start = detach(w);
+    attach(w, new_key, start);
+}
+
+void FrequencyBuckets::age() {
+    uint32_t b = head_;
+    while (b != NIL) {
+        uint32_t next = buckets_[b].next;
+        buckets_[b].key >>= 1;
+
+        // Halving keeps the order but may collapse a bucket onto its predecessor
+        uint32_t prev = buckets_[b].prev;
+        if (prev != NIL && buckets_[prev].key == buckets_[b].key) {
+            uint32_t way = buckets_[b].first_way;
+            while (way != NIL) {
+                uint32_t next_way = nodes_[way].next;
+                appendToBucket(prev, way);
+                way = next_way;
+            }
+            buckets_[b].first_way = NIL;
+            buckets_[b].last_way = NIL;
+            releaseBucket(b);
+        }
+        b = next;
+    }
+}
+
+size_t FrequencyBuckets::victim() const {
+    return buckets_[head_].first_way;
+}
+
+uint64_t FrequencyBuckets::getKey(size_t way) const {
+    return buckets_[nodes_[way].bucket].key;
+}
+
+bool FrequencyBuckets::contains(size_t way) const {
+    return nodes_[way].bucket != NIL;
+}
+
+void FrequencyBuckets::clear() {
+    head_ = NIL;
+    free_buckets_.clear();
+    for (size_t i = buckets_.size(); i > 0; i--) {
+        free_buckets_.push_back(static_cast<uint32_t>(i - 1));
+    }
+    for (auto& node : nodes_) {
+        node = {NIL, NIL, NIL};
+    }
+}
+
+// Private helper methods
+
+uint32_t FrequencyBuckets::detach(uint32_t way) {
+    Node& node = nodes_[way];
+    uint32_t b = node.bucket;
+    Bucket& bucket = buckets_[b];
+
+    if (node.prev != NIL) nodes_[node.prev].next = node.next;
+    else bucket.first_way = node.next;
+    if (node.next != NIL) nodes_[node.next].prev = node.prev;
+    else bucket.last_way = node.prev;
+    node = {NIL, NIL, NIL};
+
+    if (bucket.first_way != NIL) {
+        return b;
+    }
+    uint32_t prev = bucket.prev;
+    releaseBucket(b);
+    return prev;
+}
+
+void FrequencyBuckets::attach(uint32_t way, uint64_t key, uint32_t start) {
+    uint32_t prev = NIL;
+    uint32_t cur = head_;
+    if (start != NIL) {
+        prev = start;
+        cur = buckets_[start].next;
+        if (buckets_[start].key == key) {
+            appendToBucket(start, way);
+            return;
+        }
+    }
+
+    while (cur != NIL && buckets_[cur].key < key) {
+        prev = cur;
+        cur = buckets_[cur].next;
+    }
+
+    if (cur != NIL && buckets_[cur].key == key) {
+        appendToBucket(cur, way);
+    } else {
+        appendToBucket(createBucketAfter(prev, key), way);
+    }
+}
+
+void FrequencyBuckets::appendToBucket(uint32_t bucket, uint32_t way) {
+    Bucket& b = buckets_[bucket];
+    nodes_[way] = {bucket, b.last_way, NIL};
+    if (b.last_way != NIL) nodes_[b.last_way].next = way;
+    else b.first_way = way;
+    b.last_way = way;
+}
+
+uint32_t FrequencyBuckets::createBucketAfter(uint32_t prev, uint64_t key) {
+    uint32_t b = free_buckets_.back();
+    free_buckets_.pop_back();
+
+    uint32_t next = (prev == NIL) ? head_ : buckets_[prev].next;
+    buckets_[b] = {key, NIL, NIL, prev, next};
+    if (prev != NIL) buckets_[prev].next = b;
+    else head_ = b;
+    if (next != NIL) buckets_[next].prev = b;
+    return b;
+}
+
+void FrequencyBuckets::releaseBucket(uint32_t bucket) {
+    Bucket& b = buckets_[bucket];
+    if (b.prev != NIL) buckets_[b.prev].next = b.next;
+    else head_ = b.next;
+    if (b.next != NIL) buckets_[b.next].prev = b.prev;
+    free_buckets_.push_back(bucket);
+}
+
+} // namespace memsim
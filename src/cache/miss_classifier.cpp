@@ -0,0 +1,126 @@
+#include "cache/miss_classifier.h"
+#include <stdexcept>
+
+namespace memsim {
+
+MissClassifier::MissClassifier(size_t capacity_lines)
+    : capacity_(capacity_lines),
+      shadow_block_(capacity_lines),
+      shadow_prev_(capacity_lines),
+      shadow_next_(capacity_lines),
+      shadow_mru_(NIL),
+      shadow_lru_(NIL),
+      shadow_size_(0),
+      seen_(INITIAL_SEEN_SLOTS, 0),
+      seen_count_(0) {
+    if (capacity_lines == 0) {
+        throw std::invalid_argument("Miss classifier needs a cache of at least one line");
+    }
+    shadow_index_.reserve(capacity_lines);
+}
+
+void MissClassifier::recordHit(Address block) {
+    markSeen(block);
+    accessShadow(block);
+}
+
+MissType MissClassifier::recordMiss(Address block) {
+    bool first_touch = markSeen(block);
+    bool shadow_hit = accessShadow(block);
+
+    if (first_touch) {
+        return MissType::COMPULSORY;
+    }
+    return shadow_hit ? MissType::CONFLICT : MissType::CAPACITY;
+}
+
+void MissClassifier::flush() {
+    shadow_index_.clear();
+    shadow_mru_ = NIL;
+    shadow_lru_ = NIL;
+    shadow_size_ = 0;
+}
+
+// Private helper methods
+
+bool MissClassifier::accessShadow(Address block) {
+    auto it = shadow_index_.find(block);
+    if (it != shadow_index_.end()) {
+        size_t slot = it->second;
+        if (slot != shadow_mru_) {
+            unlinkShadow(slot);
+            pushShadowMru(slot);
+        }
+        return true;
+    }
+
+    size_t slot;
+    if (shadow_size_ < capacity_) {
+        slot = shadow_size_++;
+    } else {
+        // Full: recycle the LRU slot
+        slot = shadow_lru_;
+        shadow_index_.erase(shadow_block_[slot]);
+        unlinkShadow(slot);
+    }
+    shadow_block_[slot] = block;
+    shadow_index_[block] = slot;
+    pushShadowMru(slot);
+    return false;
+}
+
+void MissClassifier::unlinkShadow(size_t slot) {
+    size_t prev = shadow_prev_[slot];
+    size_t next = shadow_next_[slot];
+    if (prev != NIL) shadow_next_[prev] = next; else shadow_mru_ = next;
+    if (next != NIL) shadow_prev_[next] = prev; else shadow_lru_ = prev;
+}
+
+void MissClassifier::pushShadowMru(size_t slot) {
+    shadow_prev_[slot] = NIL;
+    shadow_next_[slot] = shadow_mru_;
+    if (shadow_mru_ != NIL) {
+        shadow_prev_[shadow_mru_] = slot;
+    } else {
+        shadow_lru_ = slot;
+    }
+    shadow_mru_ = slot;
+}
+
+bool MissClassifier::markSeen(Address block) {
+    Address key = block + 1;
+    size_t slot = seenSlot(key);
+    if (seen_[slot] == key) {
+        return false;
+    }
+
+    seen_[slot] = key;
+    seen_count_++;
+    if (seen_count_ * 2 > seen_.size()) {
+        growSeen();
+    }
+    return true;
+}
+
+void MissClassifier::growSeen() {
+    std::vector<Address> old;
+    old.swap(seen_);
+    seen_.assign(old.size() * 2, 0);
+    for (Address key : old) {
+        if (key != 0) {
+            seen_[seenSlot(key)] = key;
+        }
+    }
+}
+
+size_t MissClassifier::seenSlot(Address key) const {
+    // Fibonacci hashing spreads the block-aligned keys over the table
+    size_t mask = seen_.size() - 1;
+    size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    while (seen_[slot] != 0 && seen_[slot] != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+} // namespace memsim
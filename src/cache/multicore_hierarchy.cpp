@@ -0,0 +1,391 @@
+#include "cache/multicore_hierarchy.h"
+#include "common/bit_utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace memsim {
+
+MultiCoreHierarchy::MultiCoreHierarchy(PhysicalMemory* memory, size_t num_cores,
+                                       const CacheLevelConfig& l1, const CacheLevelConfig& l2,
+                                       CoherenceProtocol protocol)
+    : memory_(memory),
+      protocol_(protocol),
+      block_size_(l1.block_size),
+      mask_words_((l1.block_size + 63) / 64),
+      detect_false_sharing_(false) {
+
+    if (num_cores == 0 || num_cores > MAX_CORES) {
+        throw std::invalid_argument("Number of cores must be between 1 and " +
+                                    std::to_string(MAX_CORES));
+    }
+
+    for (size_t i = 0; i < num_cores; i++) {
+        l1s_.push_back(std::make_unique<CacheLevel>(
+            1, l1.sets, l1.associativity, l1.block_size, l1.policy, memory
+        ));
+    }
+    l2_ = std::make_unique<CacheLevel>(2, l2.sets, l2.associativity, l2.block_size, l2.policy, memory);
+}
+
+Result<uint8_t> MultiCoreHierarchy::read(size_t core, Address address) {
+    if (core >= l1s_.size()) {
+        return Result<uint8_t>::Err("Invalid core: " + std::to_string(core));
+    }
+    stats_.reads++;
+
+    CacheLevel& l1 = *l1s_[core];
+    CacheProbe probe = l1.probe(address);
+    if (!probe.hit) {
+        auto result = handleMiss(core, probe, address, false);
+        if (!result.success) {
+            return Result<uint8_t>::Err(result.error_message);
+        }
+    }
+    return Result<uint8_t>::Ok(l1.readData(probe));
+}
+
+Result<void> MultiCoreHierarchy::write(size_t core, Address address, uint8_t data) {
+    if (core >= l1s_.size()) {
+        return Result<void>::Err("Invalid core: " + std::to_string(core));
+    }
+
+    // Data is written through; the protocol below decides who may keep a copy
+    auto mem_result = memory_->write(address, data);
+    if (!mem_result.success) {
+        return mem_result;
+    }
+    stats_.writes++;
+
+    CacheLevel& l1 = *l1s_[core];
+    Address block = address & ~static_cast<Address>(block_size_ - 1);
+    CacheProbe probe = l1.probe(address);
+    if (probe.hit) {
+        DirectoryEntry& entry = directory_[block];
+        bool owner = entry.owner == static_cast<int>(core);
+        if (!owner || entry.owner_state == CoherenceState::OWNED) {
+            // Shared or Owned: gain the only copy before writing
+            stats_.upgrades++;
+            invalidateOthers(entry, block, core);
+        }
+        entry.owner = static_cast<int>(core);
+        entry.owner_state = CoherenceState::MODIFIED;
+    } else {
+        auto result = handleMiss(core, probe, address, true);
+        if (!result.success) {
+            return result;
+        }
+    }
+    l1.writeData(probe, data);
+
+    // Keep the shared L2 copy current without counting a lookup
+    CacheProbe l2_probe = l2_->peek(address);
+    if (l2_probe.hit) {
+        l2_->writeData(l2_probe, data);
+    }
+
+    size_t offset = static_cast<size_t>(address - block);
+    recordLostWrite(directory_[block], core, offset);
+    if (detect_false_sharing_) {
+        profileLine(block).write_masks[core * mask_words_ + offset / 64] |= 1ULL << (offset % 64);
+    }
+    return Result<void>::Ok();
+}
+
+void MultiCoreHierarchy::flush() {
+    for (const auto& item : directory_) {
+        if (item.second.owner >= 0 && isDirty(item.second.owner_state)) {
+            stats_.writebacks++;
+        }
+    }
+    directory_.clear();
+
+    for (auto& l1 : l1s_) {
+        l1->flush();
+    }
+    l2_->flush();
+}
+
+CoherenceState MultiCoreHierarchy::getState(size_t core, Address address) const {
+    if (core >= l1s_.size()) {
+        return CoherenceState::INVALID;
+    }
+
+    auto it = directory_.find(address & ~static_cast<Address>(block_size_ - 1));
+    if (it == directory_.end() || !((it->second.sharers >> core) & 1)) {
+        return CoherenceState::INVALID;
+    }
+    if (it->second.owner == static_cast<int>(core)) {
+        return it->second.owner_state;
+    }
+    return CoherenceState::SHARED;
+}
+
+std::string MultiCoreHierarchy::getStatsString() const {
+    std::ostringstream oss;
+    oss << "=== Multi-Core Cache Statistics ===\n";
+    oss << "Cores: " << l1s_.size() << " (private L1 each, shared L2)\n";
+    oss << "Protocol: " << coherenceProtocolToString(protocol_) << " (directory)\n\n";
+
+    for (size_t i = 0; i < l1s_.size(); i++) {
+        oss << "--- Core " << i << " ---\n";
+        oss << l1s_[i]->getStatsString() << "\n";
+    }
+    oss << "--- Shared ---\n";
+    oss << l2_->getStatsString() << "\n";
+
+    oss << "=== Coherence ===\n";
+    oss << "Reads: " << stats_.reads << "\n";
+    oss << "Writes: " << stats_.writes << "\n";
+    oss << "Invalidations: " << stats_.invalidations << "\n";
+    oss << "Interventions: " << stats_.interventions << "\n";
+    oss << "Upgrades: " << stats_.upgrades << "\n";
+    oss << "Writebacks: " << stats_.writebacks << "\n";
+    oss << "Coherence Misses: " << stats_.coherence_misses << "\n";
+    oss << "False Sharing Misses: " << stats_.false_sharing_misses;
+    if (stats_.coherence_misses > 0) {
+        oss << " (" << std::fixed << std::setprecision(2)
+            << (100.0 * stats_.false_sharing_misses / stats_.coherence_misses)
+            << "% of coherence misses)";
+    }
+    oss << "\n";
+    oss << "Memory Accesses: " << stats_.memory_accesses << "\n";
+    return oss.str();
+}
+
+void MultiCoreHierarchy::setFalseSharingDetection(bool enable) {
+    detect_false_sharing_ = enable;
+    line_profiles_.clear();
+}
+
+std::vector<FalseSharingLine> MultiCoreHierarchy::getFalseSharingLines(size_t top_n) const {
+    std::vector<FalseSharingLine> lines;
+    for (const auto& item : line_profiles_) {
+        const LineProfile& profile = item.second;
+
+        FalseSharingLine line;
+        line.block_address = item.first;
+        line.false_sharing_misses = profile.false_sharing_misses;
+        line.coherence_misses = profile.coherence_misses;
+        line.invalidations = profile.invalidations;
+        line.disjoint_writes = true;
+
+        std::vector<uint64_t> written(mask_words_, 0);
+        for (size_t core = 0; core < l1s_.size(); core++) {
+            const uint64_t* mask = &profile.write_masks[core * mask_words_];
+            LineWriter writer{core, 0, 0, 0};
+            for (size_t offset = 0; offset < block_size_; offset++) {
+                if ((mask[offset / 64] >> (offset % 64)) & 1) {
+                    if (writer.bytes_written == 0) {
+                        writer.first_byte = offset;
+                    }
+                    writer.last_byte = offset;
+                    writer.bytes_written++;
+                }
+            }
+            if (writer.bytes_written == 0) {
+                continue;
+            }
+            for (size_t w = 0; w < mask_words_; w++) {
+                if (written[w] & mask[w]) {
+                    line.disjoint_writes = false;
+                }
+                written[w] |= mask[w];
+            }
+            line.writers.push_back(writer);
+        }
+
+        bool disjoint_writers = line.disjoint_writes && line.writers.size() >= 2 && line.invalidations > 0;
+        if (line.false_sharing_misses > 0 || disjoint_writers) {
+            lines.push_back(std::move(line));
+        }
+    }
+
+    auto worse = [](const FalseSharingLine& a, const FalseSharingLine& b) {
+        if (a.false_sharing_misses != b.false_sharing_misses) {
+            return a.false_sharing_misses > b.false_sharing_misses;
+        }
+        if (a.invalidations != b.invalidations) {
+            return a.invalidations > b.invalidations;
+        }
+        return a.block_address < b.block_address;
+    };
+    size_t count = std::min(top_n, lines.size());
+    std::partial_sort(lines.begin(), lines.begin() + count, lines.end(), worse);
+    lines.resize(count);
+    return lines;
+}
+
+const CacheLevel* MultiCoreHierarchy::getL1(size_t core) const {
+    if (core >= l1s_.size()) {
+        return nullptr;
+    }
+    return l1s_[core].get();
+}
+
+// Private helper methods
+
+Result<void> MultiCoreHierarchy::handleMiss(size_t core, CacheProbe& probe, Address address,
+                                            bool for_write) {
+    Address block = address & ~static_cast<Address>(block_size_ - 1);
+    uint64_t core_bit = 1ULL << core;
+
+    auto it = directory_.find(block);
+    if (it != directory_.end()) {
+        DirectoryEntry& entry = it->second;
+        if (entry.invalidated & core_bit) {
+            classifyMiss(entry, block, core, static_cast<size_t>(address - block));
+        }
+    }
+
+    if (it != directory_.end() && it->second.owner >= 0) {
+        // The owner supplies the block instead of the L2
+        DirectoryEntry& entry = it->second;
+        stats_.interventions++;
+        if (!for_write) {
+            switch (entry.owner_state) {
+                case CoherenceState::MODIFIED:
+                    if (protocol_ == CoherenceProtocol::MOESI) {
+                        entry.owner_state = CoherenceState::OWNED;
+                    } else {
+                        stats_.writebacks++;
+                        entry.owner = -1;
+                        entry.owner_state = CoherenceState::INVALID;
+                    }
+                    break;
+
+                case CoherenceState::EXCLUSIVE:
+                    entry.owner = -1;
+                    entry.owner_state = CoherenceState::INVALID;
+                    break;
+
+                case CoherenceState::OWNED:
+                case CoherenceState::SHARED:
+                case CoherenceState::INVALID:
+                    break;
+            }
+        }
+    } else {
+        CacheProbe l2_probe = l2_->probe(address);
+        if (!l2_probe.hit) {
+            auto result = memory_->read(address);
+            if (!result.success) {
+                return Result<void>::Err(result.error_message);
+            }
+            stats_.memory_accesses++;
+            l2_->fill(l2_probe, address);
+        }
+    }
+
+    CacheEviction eviction = l1s_[core]->fill(probe, address);
+    if (eviction.valid) {
+        handleEviction(core, eviction.block_address);
+    }
+
+    DirectoryEntry& entry = directory_[block];
+    if (for_write) {
+        invalidateOthers(entry, block, core);
+        entry.owner = static_cast<int>(core);
+        entry.owner_state = CoherenceState::MODIFIED;
+    } else if ((entry.sharers & ~core_bit) == 0) {
+        entry.owner = static_cast<int>(core);
+        entry.owner_state = CoherenceState::EXCLUSIVE;
+    }
+    entry.sharers |= core_bit;
+    return Result<void>::Ok();
+}
+
+void MultiCoreHierarchy::invalidateOthers(DirectoryEntry& entry, Address block_address, size_t core) {
+    uint64_t others = entry.sharers & ~(1ULL << core);
+    if (others != 0 && entry.lost_writes.empty()) {
+        entry.lost_writes.assign(l1s_.size() * mask_words_, 0);
+    }
+
+    while (others != 0) {
+        size_t other = countTrailingZeros(others);
+        others &= others - 1;
+
+        l1s_[other]->invalidate(block_address);
+        stats_.invalidations++;
+        if (detect_false_sharing_) {
+            profileLine(block_address).invalidations++;
+        }
+
+        // Remember the loss so the next miss of that core counts as a coherence miss
+        entry.invalidated |= 1ULL << other;
+        std::fill_n(entry.lost_writes.begin() + other * mask_words_, mask_words_, 0);
+    }
+
+    entry.sharers &= 1ULL << core;
+    if (entry.owner >= 0 && entry.owner != static_cast<int>(core)) {
+        entry.owner = -1;
+        entry.owner_state = CoherenceState::INVALID;
+    }
+}
+
+void MultiCoreHierarchy::classifyMiss(DirectoryEntry& entry, Address block_address,
+                                      size_t core, size_t offset) {
+    const uint64_t* lost = &entry.lost_writes[core * mask_words_];
+    bool false_sharing = !((lost[offset / 64] >> (offset % 64)) & 1);
+    stats_.coherence_misses++;
+    if (false_sharing) {
+        stats_.false_sharing_misses++;
+    }
+    if (detect_false_sharing_) {
+        LineProfile& profile = profileLine(block_address);
+        profile.coherence_misses++;
+        if (false_sharing) {
+            profile.false_sharing_misses++;
+        }
+    }
+    entry.invalidated &= ~(1ULL << core);
+}
+
+void MultiCoreHierarchy::recordLostWrite(DirectoryEntry& entry, size_t writer, size_t offset) {
+    uint64_t lost = entry.invalidated & ~(1ULL << writer);
+    while (lost != 0) {
+        size_t core = countTrailingZeros(lost);
+        lost &= lost - 1;
+        entry.lost_writes[core * mask_words_ + offset / 64] |= 1ULL << (offset % 64);
+    }
+}
+
+void MultiCoreHierarchy::handleEviction(size_t core, Address block_address) {
+    auto it = directory_.find(block_address);
+    if (it == directory_.end()) {
+        return;
+    }
+
+    DirectoryEntry& entry = it->second;
+    entry.sharers &= ~(1ULL << core);
+    if (entry.owner == static_cast<int>(core)) {
+        if (isDirty(entry.owner_state)) {
+            stats_.writebacks++;
+        }
+        entry.owner = -1;
+        entry.owner_state = CoherenceState::INVALID;
+    }
+    releaseEntry(block_address);
+}
+
+void MultiCoreHierarchy::releaseEntry(Address block_address) {
+    auto it = directory_.find(block_address);
+    if (it != directory_.end() && it->second.sharers == 0 && it->second.invalidated == 0) {
+        directory_.erase(it);
+    }
+}
+
+MultiCoreHierarchy::LineProfile& MultiCoreHierarchy::profileLine(Address block_address) {
+    LineProfile& profile = line_profiles_[block_address];
+    if (profile.write_masks.empty()) {
+        profile.write_masks.assign(l1s_.size() * mask_words_, 0);
+    }
+    return profile;
+}
+
+bool MultiCoreHierarchy::isDirty(CoherenceState state) {
+    return state == CoherenceState::MODIFIED || state == CoherenceState::OWNED;
+}
+
+} // namespace memsim
@@ -0,0 +1,186 @@
+#include "cache/prefetcher.h"
+#include <sstream>
+#include <stdexcept>
+
+namespace memsim {
+
+// ===== NextLinePrefetcher =====
+
+NextLinePrefetcher::NextLinePrefetcher(size_t block_size, size_t degree)
+    : block_size_(block_size),
+      degree_(degree) {
+    if (degree == 0) {
+        throw std::invalid_argument("Prefetch degree must be at least 1");
+    }
+}
+
+void NextLinePrefetcher::onAccess(const PrefetchTrigger& trigger, std::vector<Address>& candidates) {
+    // Tagged prefetching: trigger on misses and on the first use of a prefetched line
+    if (trigger.hit && !trigger.prefetch_hit) {
+        return;
+    }
+    for (size_t i = 1; i <= degree_; i++) {
+        candidates.push_back(trigger.block_address + i * block_size_);
+    }
+}
+
+std::string NextLinePrefetcher::getConfigString() const {
+    std::ostringstream oss;
+    oss << prefetcherTypeToString(getType()) << " (degree " << degree_ << ")";
+    return oss.str();
+}
+
+// ===== StridePrefetcher =====
+
+StridePrefetcher::StridePrefetcher(size_t block_size, size_t degree)
+    : block_size_(block_size),
+      degree_(degree),
+      table_(TABLE_SIZE) {
+    if (degree == 0) {
+        throw std::invalid_argument("Prefetch degree must be at least 1");
+    }
+    reset();
+}
+
+void StridePrefetcher::onAccess(const PrefetchTrigger& trigger, std::vector<Address>& candidates) {
+    Address block = trigger.block_address;
+    Address region = block / (block_size_ * REGION_BLOCKS);
+    Entry& entry = table_[region % TABLE_SIZE];
+
+    if (!entry.valid || entry.region != region) {
+        // New stream (or conflict in the direct-mapped table): start training
+        entry = {true, region, block, 0, 0};
+        return;
+    }
+
+    int64_t stride = static_cast<int64_t>(block) - static_cast<int64_t>(entry.last_block);
+    if (stride == 0) {
+        return;  // Same block again: nothing to learn
+    }
+
+    if (stride == entry.stride) {
+        if (entry.confidence < CONFIDENCE_MAX) entry.confidence++;
+    } else {
+        // Keep a confident stride through one outlier, otherwise retrain
+        if (entry.confidence > 0) {
+            entry.confidence--;
+        }
+        if (entry.confidence == 0) {
+            entry.stride = stride;
+        }
+    }
+    entry.last_block = block;
+
+    if (entry.confidence < CONFIDENCE_THRESHOLD) {
+        return;
+    }
+    for (size_t i = 1; i <= degree_; i++) {
+        int64_t target = static_cast<int64_t>(block) + entry.stride * static_cast<int64_t>(i);
+        if (target < 0) {
+            break;
+        }
+        candidates.push_back(static_cast<Address>(target));
+    }
+}
+
+void StridePrefetcher::reset() {
+    for (auto& entry : table_) {
+        entry = {false, 0, 0, 0, 0};
+    }
+}
+
+std::string StridePrefetcher::getConfigString() const {
+    std::ostringstream oss;
+    oss << prefetcherTypeToString(getType()) << " (degree " << degree_
+        << ", " << TABLE_SIZE << "-entry table)";
+    return oss.str();
+}
+
+// ===== StreamBufferPrefetcher =====
+
+StreamBufferPrefetcher::StreamBufferPrefetcher(size_t block_size, size_t depth)
+    : block_size_(block_size),
+      depth_(depth),
+      streams_(NUM_STREAMS),
+      time_(0) {
+    if (depth == 0) {
+        throw std::invalid_argument("Stream buffer depth must be at least 1");
+    }
+    reset();
+}
+
+void StreamBufferPrefetcher::onAccess(const PrefetchTrigger& trigger, std::vector<Address>& candidates) {
+    time_++;
+    Address block = trigger.block_address;
+
+    // Access inside a buffer window: advance the stream past it and top the buffer up
+    for (auto& stream : streams_) {
+        if (stream.valid && block >= stream.head && block < stream.next_prefetch) {
+            stream.head = block + block_size_;
+            stream.last_use = time_;
+            Address limit = stream.head + depth_ * block_size_;
+            while (stream.next_prefetch < limit) {
+                candidates.push_back(stream.next_prefetch);
+                stream.next_prefetch += block_size_;
+            }
+            return;
+        }
+    }
+
+    if (trigger.hit) {
+        return;
+    }
+
+    // Miss outside every stream: reallocate the least recently used buffer
+    Stream* victim = &streams_[0];
+    for (auto& stream : streams_) {
+        if (!stream.valid) {
+            victim = &stream;
+            break;
+        }
+        if (stream.last_use < victim->last_use) {
+            victim = &stream;
+        }
+    }
+
+    victim->valid = true;
+    victim->head = block + block_size_;
+    victim->next_prefetch = victim->head;
+    victim->last_use = time_;
+    for (size_t i = 0; i < depth_; i++) {
+        candidates.push_back(victim->next_prefetch);
+        victim->next_prefetch += block_size_;
+    }
+}
+
+void StreamBufferPrefetcher::reset() {
+    for (auto& stream : streams_) {
+        stream = {false, 0, 0, 0};
+    }
+    time_ = 0;
+}
+
+std::string StreamBufferPrefetcher::getConfigString() const {
+    std::ostringstream oss;
+    oss << prefetcherTypeToString(getType()) << " (" << NUM_STREAMS
+        << " streams, depth " << depth_ << ")";
+    return oss.str();
+}
+
+// ===== Factory =====
+
+std::unique_ptr<IPrefetcher> createPrefetcher(PrefetcherType type, size_t block_size, size_t degree) {
+    switch (type) {
+        case PrefetcherType::NONE:
+            return nullptr;
+        case PrefetcherType::NEXT_LINE:
+            return std::make_unique<NextLinePrefetcher>(block_size, degree);
+        case PrefetcherType::STRIDE:
+            return std::make_unique<StridePrefetcher>(block_size, degree);
+        case PrefetcherType::STREAM_BUFFER:
+            return std::make_unique<StreamBufferPrefetcher>(block_size, degree);
+    }
+    return nullptr;
+}
+
+} // namespace memsim
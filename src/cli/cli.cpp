@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <limits>
+#include <cctype>
 
 namespace memsim {
 
@@ -148,7 +149,7 @@ void CLI::executeCommand(const Command& cmd) {
         case CommandType::INIT_CACHE: {
             if (cmd.args.size() < 8) {
                 std::cout << "Error: Missing arguments. Usage: init cache <l1_sets> <l1_assoc> <l1_block> <l1_policy> <l2_sets> <l2_assoc> <l2_block> <l2_policy>" << std::endl;
-                std::cout << "Policies: fifo, lru, lfu" << std::endl;
+                std::cout << "Policies: fifo, lru, lfu, lfu_da, tree_plru, bit_plru, srrip, brrip, drrip" << std::endl;
                 break;
             }
 
@@ -175,6 +176,33 @@ void CLI::executeCommand(const Command& cmd) {
             break;
         }
 
+        case CommandType::INIT_CACHE_LEVEL: {
+            if (cmd.args.size() < 5) {
+                std::cout << "Error: Missing arguments. Usage: init cache level <n> <sets> <assoc> <block> <policy>" << std::endl;
+                std::cout << "Policies: fifo, lru, lfu, lfu_da, tree_plru, bit_plru, srrip, brrip, drrip" << std::endl;
+                break;
+            }
+
+            auto level_result = parseSize(cmd.args[0]);
+            auto sets_result = parseSize(cmd.args[1]);
+            auto assoc_result = parseSize(cmd.args[2]);
+            auto block_result = parseSize(cmd.args[3]);
+            auto policy_result = parseCachePolicy(cmd.args[4]);
+
+            if (!level_result.success || !sets_result.success || !assoc_result.success ||
+                !block_result.success || !policy_result.success) {
+                std::cout << "Error: Invalid cache parameters" << std::endl;
+                break;
+            }
+
+            auto result = manager_.initCacheLevel(level_result.value, sets_result.value, assoc_result.value,
+                                                  block_result.value, policy_result.value);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
         case CommandType::CACHE_READ: {
             if (cmd.args.empty()) {
                 std::cout << "Error: Missing address. Usage: cache read <address>" << std::endl;
@@ -242,9 +270,182 @@ void CLI::executeCommand(const Command& cmd) {
             break;
         }
 
+        case CommandType::CACHE_INCLUSION: {
+            if (cmd.args.empty()) {
+                std::cout << "Error: Missing policy. Usage: cache inclusion <inclusive|exclusive|nine>" << std::endl;
+                break;
+            }
+
+            auto policy_result = parseInclusionPolicy(cmd.args[0]);
+            if (!policy_result.success) {
+                std::cout << "Error: " << policy_result.error_message << std::endl;
+                break;
+            }
+
+            auto result = manager_.setCacheInclusion(policy_result.value);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::CACHE_PREFETCH: {
+            if (cmd.args.size() < 2) {
+                std::cout << "Error: Missing arguments. Usage: cache prefetch <l1|l2|...> <type> [degree] [latency]" << std::endl;
+                std::cout << "Types: none, next_line, stride, stream" << std::endl;
+                break;
+            }
+
+            auto level_result = parseCacheLevel(cmd.args[0]);
+            if (!level_result.success) {
+                std::cout << "Error: " << level_result.error_message << std::endl;
+                break;
+            }
+
+            auto type_result = parsePrefetcherType(cmd.args[1]);
+            if (!type_result.success) {
+                std::cout << "Error: " << type_result.error_message << std::endl;
+                break;
+            }
+
+            size_t degree = DEFAULT_PREFETCH_DEGREE;
+            uint64_t latency = 0;
+            if (cmd.args.size() >= 3) {
+                auto degree_result = parseSize(cmd.args[2]);
+                if (!degree_result.success) {
+                    std::cout << "Error: " << degree_result.error_message << std::endl;
+                    break;
+                }
+                degree = degree_result.value;
+            }
+            if (cmd.args.size() >= 4) {
+                auto latency_result = parseSize(cmd.args[3]);
+                if (!latency_result.success) {
+                    std::cout << "Error: " << latency_result.error_message << std::endl;
+                    break;
+                }
+                latency = latency_result.value;
+            }
+
+            auto result = manager_.setCachePrefetcher(level_result.value, type_result.value, degree, latency);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::CACHE_VICTIM: {
+            if (cmd.args.empty()) {
+                std::cout << "Error: Missing arguments. Usage: cache victim <entries> [victim|miss]" << std::endl;
+                break;
+            }
+
+            auto entries_result = parseSize(cmd.args[0]);
+            if (!entries_result.success) {
+                std::cout << "Error: " << entries_result.error_message << std::endl;
+                break;
+            }
+
+            VictimCacheMode mode = VictimCacheMode::VICTIM;
+            if (cmd.args.size() >= 2) {
+                auto mode_result = parseVictimCacheMode(cmd.args[1]);
+                if (!mode_result.success) {
+                    std::cout << "Error: " << mode_result.error_message << std::endl;
+                    break;
+                }
+                mode = mode_result.value;
+            }
+
+            auto result = manager_.setCacheVictim(entries_result.value, mode);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::CACHE_SAMPLE: {
+            if (cmd.args.empty()) {
+                std::cout << "Error: Missing arguments. Usage: cache sample <ratio> [hash|stride]" << std::endl;
+                break;
+            }
+
+            auto ratio_result = parseSize(cmd.args[0]);
+            if (!ratio_result.success) {
+                std::cout << "Error: " << ratio_result.error_message << std::endl;
+                break;
+            }
+
+            SetSamplingMode mode = SetSamplingMode::HASH;
+            if (cmd.args.size() >= 2) {
+                auto mode_result = parseSetSamplingMode(cmd.args[1]);
+                if (!mode_result.success) {
+                    std::cout << "Error: " << mode_result.error_message << std::endl;
+                    break;
+                }
+                mode = mode_result.value;
+            }
+
+            auto result = manager_.setCacheSampling(ratio_result.value, mode);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::CACHE_LATENCY: {
+            if (cmd.args.size() < 2) {
+                std::cout << "Error: Missing arguments. Usage: cache latency <l1> [l2 ...] <memory>" << std::endl;
+                break;
+            }
+
+            std::vector<uint64_t> cycles;
+            bool valid = true;
+            for (const auto& arg : cmd.args) {
+                auto cycles_result = parseSize(arg);
+                if (!cycles_result.success) {
+                    std::cout << "Error: " << cycles_result.error_message << std::endl;
+                    valid = false;
+                    break;
+                }
+                cycles.push_back(cycles_result.value);
+            }
+            if (!valid) {
+                break;
+            }
+
+            uint64_t memory_cycles = cycles.back();
+            cycles.pop_back();
+            auto result = manager_.setCacheLatency(cycles, memory_cycles);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::CACHE_CLASSIFY: {
+            if (cmd.args.empty()) {
+                std::cout << "Error: Missing argument. Usage: cache classify <on|off>" << std::endl;
+                break;
+            }
+
+            std::string mode = cmd.args[0];
+            std::transform(mode.begin(), mode.end(), mode.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            if (mode != "on" && mode != "off") {
+                std::cout << "Error: Invalid argument: " << cmd.args[0] << " (valid: on, off)" << std::endl;
+                break;
+            }
+
+            auto result = manager_.setCacheMissClassification(mode == "on");
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
         case CommandType::INIT_VM: {
             if (cmd.args.size() < 4) {
-                std::cout << "Error: Missing arguments. Usage: init vm <num_virtual_pages> <num_physical_frames> <page_size> <policy>" << std::endl;
+                std::cout << "Error: Missing arguments. Usage: init vm <num_virtual_pages> <num_physical_frames> <page_size> <policy> [levels]" << std::endl;
                 std::cout << "Policies: fifo, lru, clock" << std::endl;
                 break;
             }
@@ -273,7 +474,18 @@ void CLI::executeCommand(const Command& cmd) {
                 break;
             }
 
-            auto result = manager_.initVirtualMemory(vp_result.value, pf_result.value, ps_result.value, policy_result.value);
+            size_t levels = DEFAULT_PAGE_TABLE_LEVELS;
+            if (cmd.args.size() >= 5) {
+                auto levels_result = parseSize(cmd.args[4]);
+                if (!levels_result.success) {
+                    std::cout << "Error parsing levels: " << levels_result.error_message << std::endl;
+                    break;
+                }
+                levels = levels_result.value;
+            }
+
+            auto result = manager_.initVirtualMemory(vp_result.value, pf_result.value, ps_result.value,
+                                                     policy_result.value, levels);
             if (!result.success) {
                 std::cout << "Error: " << result.error_message << std::endl;
             }
@@ -364,6 +576,426 @@ void CLI::executeCommand(const Command& cmd) {
             break;
         }
 
+        case CommandType::VM_TLB: {
+            std::string first = cmd.args[0];
+            std::transform(first.begin(), first.end(), first.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            if (first == "off") {
+                auto result = manager_.disableVMTLB();
+                if (!result.success) {
+                    std::cout << "Error: " << result.error_message << std::endl;
+                }
+                break;
+            }
+            if (cmd.args.size() < 4) {
+                std::cout << "Error: Missing arguments. Usage: vm tlb <dtlb_sets> <dtlb_assoc> <stlb_sets> <stlb_assoc> [policy] [walk_cycles]" << std::endl;
+                break;
+            }
+
+            auto dtlb_sets = parseSize(cmd.args[0]);
+            auto dtlb_assoc = parseSize(cmd.args[1]);
+            auto stlb_sets = parseSize(cmd.args[2]);
+            auto stlb_assoc = parseSize(cmd.args[3]);
+            if (!dtlb_sets.success || !dtlb_assoc.success || !stlb_sets.success || !stlb_assoc.success) {
+                std::cout << "Error: Invalid TLB geometry" << std::endl;
+                break;
+            }
+
+            TLBPolicy policy = TLBPolicy::LRU;
+            if (cmd.args.size() >= 5) {
+                auto policy_result = parseTLBPolicy(cmd.args[4]);
+                if (!policy_result.success) {
+                    std::cout << "Error: " << policy_result.error_message << std::endl;
+                    break;
+                }
+                policy = policy_result.value;
+            }
+
+            uint64_t walk_cycles = TLBHierarchy::DEFAULT_WALK_CYCLES;
+            if (cmd.args.size() >= 6) {
+                auto walk_result = parseSize(cmd.args[5]);
+                if (!walk_result.success) {
+                    std::cout << "Error: " << walk_result.error_message << std::endl;
+                    break;
+                }
+                walk_cycles = walk_result.value;
+            }
+
+            TLBConfig dtlb = {dtlb_sets.value, dtlb_assoc.value, policy, TLBHierarchy::DEFAULT_DTLB_CYCLES};
+            TLBConfig stlb = {stlb_sets.value, stlb_assoc.value, policy, TLBHierarchy::DEFAULT_STLB_CYCLES};
+            auto result = manager_.setVMTLB(dtlb, stlb, walk_cycles);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_WALK: {
+            auto entries_result = parseSize(cmd.args[0]);
+            if (!entries_result.success) {
+                std::cout << "Error: " << entries_result.error_message << std::endl;
+                break;
+            }
+
+            bool through_cache = false;
+            if (cmd.args.size() >= 2) {
+                std::string path = cmd.args[1];
+                std::transform(path.begin(), path.end(), path.begin(),
+                               [](unsigned char c) { return std::tolower(c); });
+                if (path != "cache" && path != "memory") {
+                    std::cout << "Error: Invalid walk path: " << cmd.args[1] << " (valid: cache, memory)" << std::endl;
+                    break;
+                }
+                through_cache = (path == "cache");
+            }
+
+            auto result = manager_.setVMPageWalk(entries_result.value, through_cache);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_THP: {
+            std::string mode = cmd.args[0];
+            std::transform(mode.begin(), mode.end(), mode.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            PageSize max_size = PageSize::BASE;
+            if (mode != "off") {
+                auto size_result = parsePageSize(cmd.args[0]);
+                if (!size_result.success) {
+                    std::cout << "Error: " << size_result.error_message << std::endl;
+                    break;
+                }
+                max_size = size_result.value;
+            }
+
+            auto result = manager_.setVMHugePages(max_size);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_PROMOTE: {
+            auto addr_result = parseAddress(cmd.args[0]);
+            if (!addr_result.success) {
+                std::cout << "Error: " << addr_result.error_message << std::endl;
+                break;
+            }
+            auto size_result = parsePageSize(cmd.args[1]);
+            if (!size_result.success) {
+                std::cout << "Error: " << size_result.error_message << std::endl;
+                break;
+            }
+
+            auto result = manager_.vmPromote(addr_result.value, size_result.value);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_DEMOTE: {
+            auto addr_result = parseAddress(cmd.args[0]);
+            if (!addr_result.success) {
+                std::cout << "Error: " << addr_result.error_message << std::endl;
+                break;
+            }
+
+            auto result = manager_.vmDemote(addr_result.value);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_CLOCK: {
+            std::string param = cmd.args[0];
+            std::transform(param.begin(), param.end(), param.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            auto value_result = parseSize(cmd.args[1]);
+            if (!value_result.success) {
+                std::cout << "Error: " << value_result.error_message << std::endl;
+                break;
+            }
+
+            Result<void> result = Result<void>::Ok();
+            if (param == "spread") {
+                result = manager_.setVMClockHandSpread(value_result.value);
+            } else if (param == "window") {
+                result = manager_.setVMWorkingSetWindow(value_result.value);
+            } else {
+                result = Result<void>::Err("Invalid clock parameter: " + cmd.args[0] + " (valid: spread, window)");
+            }
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_LATENCY: {
+            if (cmd.args.empty()) {
+                std::cout << "Error: Missing arguments. Usage: vm latency <page_load_cycles> [writeback_cycles]" << std::endl;
+                break;
+            }
+
+            auto load_result = parseSize(cmd.args[0]);
+            if (!load_result.success) {
+                std::cout << "Error: " << load_result.error_message << std::endl;
+                break;
+            }
+
+            uint64_t writeback_cycles = load_result.value;
+            if (cmd.args.size() >= 2) {
+                auto writeback_result = parseSize(cmd.args[1]);
+                if (!writeback_result.success) {
+                    std::cout << "Error: " << writeback_result.error_message << std::endl;
+                    break;
+                }
+                writeback_cycles = writeback_result.value;
+            }
+
+            auto result = manager_.setVMDiskLatency(load_result.value, writeback_cycles);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_SWAP: {
+            std::string mode = cmd.args[0];
+            std::transform(mode.begin(), mode.end(), mode.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            Result<void> result = Result<void>::Ok();
+            if (mode == "sync") {
+                result = manager_.setVMSwapAsync(0, SwapDevice::DEFAULT_BATCH_SIZE);
+            } else if (mode == "async") {
+                if (cmd.args.size() < 2) {
+                    std::cout << "Error: Missing arguments. Usage: vm swap async <threads> [batch]" << std::endl;
+                    break;
+                }
+                auto threads_result = parseSize(cmd.args[1]);
+                size_t batch_size = SwapDevice::DEFAULT_BATCH_SIZE;
+                if (cmd.args.size() > 2) {
+                    auto batch_result = parseSize(cmd.args[2]);
+                    if (!batch_result.success) {
+                        std::cout << "Error: " << batch_result.error_message << std::endl;
+                        break;
+                    }
+                    batch_size = batch_result.value;
+                }
+                if (!threads_result.success) {
+                    std::cout << "Error: " << threads_result.error_message << std::endl;
+                    break;
+                }
+                result = manager_.setVMSwapAsync(threads_result.value, batch_size);
+            } else if (mode == "delay") {
+                if (cmd.args.size() < 2) {
+                    std::cout << "Error: Missing arguments. Usage: vm swap delay <microseconds>" << std::endl;
+                    break;
+                }
+                auto delay_result = parseSize(cmd.args[1]);
+                if (!delay_result.success) {
+                    std::cout << "Error: " << delay_result.error_message << std::endl;
+                    break;
+                }
+                result = manager_.setVMSwapDelay(delay_result.value);
+            } else {
+                result = manager_.setVMSwapFile(cmd.args[0]);
+            }
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_PREFETCH: {
+            std::string mode = cmd.args[0];
+            std::transform(mode.begin(), mode.end(), mode.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+            auto pages_result = parseSize(cmd.args[1]);
+            if (!pages_result.success) {
+                std::cout << "Error: " << pages_result.error_message << std::endl;
+                break;
+            }
+
+            Result<void> result = Result<void>::Ok();
+            if (mode == "readahead") {
+                result = manager_.setVMReadahead(pages_result.value);
+            } else if (mode == "faultaround") {
+                result = manager_.setVMFaultAround(pages_result.value);
+            } else {
+                result = Result<void>::Err("Invalid prefetch mode: " + cmd.args[0] + " (valid: readahead, faultaround)");
+            }
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::VM_REPLAY: {
+            size_t lookahead = 32;
+            if (cmd.args.size() > 1) {
+                auto lookahead_result = parseSize(cmd.args[1]);
+                if (!lookahead_result.success) {
+                    std::cout << "Error: " << lookahead_result.error_message << std::endl;
+                    break;
+                }
+                lookahead = lookahead_result.value;
+            }
+
+            auto result = manager_.replayVMTrace(cmd.args[0], lookahead);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::ANALYZE_MRC: {
+            if (cmd.args.size() < 2) {
+                std::cout << "Error: Missing arguments. Usage: analyze mrc <trace_file> <block_size> [max_sets] [max_assoc]" << std::endl;
+                break;
+            }
+
+            auto block_result = parseSize(cmd.args[1]);
+            if (!block_result.success) {
+                std::cout << "Error: " << block_result.error_message << std::endl;
+                break;
+            }
+
+            size_t max_sets = DEFAULT_MRC_MAX_SETS;
+            size_t max_assoc = DEFAULT_MRC_MAX_ASSOC;
+            if (cmd.args.size() >= 3) {
+                auto sets_result = parseSize(cmd.args[2]);
+                if (!sets_result.success) {
+                    std::cout << "Error: " << sets_result.error_message << std::endl;
+                    break;
+                }
+                max_sets = sets_result.value;
+            }
+            if (cmd.args.size() >= 4) {
+                auto assoc_result = parseSize(cmd.args[3]);
+                if (!assoc_result.success) {
+                    std::cout << "Error: " << assoc_result.error_message << std::endl;
+                    break;
+                }
+                max_assoc = assoc_result.value;
+            }
+
+            auto result = manager_.analyzeStackDistance(cmd.args[0], block_result.value, max_sets, max_assoc);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::ANALYZE_SWEEP: {
+            if (cmd.args.size() < 3) {
+                std::cout << "Error: Missing arguments. Usage: analyze sweep <trace_file> <memory_size> <config> [config...]" << std::endl;
+                std::cout << "Config: <sets>x<assoc>x<block>:<policy>[/<next level>...][@<sampling ratio>]" << std::endl;
+                break;
+            }
+
+            auto memory_result = parseSize(cmd.args[1]);
+            if (!memory_result.success) {
+                std::cout << "Error: " << memory_result.error_message << std::endl;
+                break;
+            }
+
+            std::vector<SweepConfig> configs;
+            bool valid = true;
+            for (size_t i = 2; i < cmd.args.size(); i++) {
+                auto config_result = parseSweepConfig(cmd.args[i]);
+                if (!config_result.success) {
+                    std::cout << "Error: " << config_result.error_message << std::endl;
+                    valid = false;
+                    break;
+                }
+                configs.push_back(config_result.value);
+            }
+            if (!valid) {
+                break;
+            }
+
+            auto result = manager_.analyzeCacheSweep(cmd.args[0], memory_result.value, configs);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::ANALYZE_VM: {
+            auto pages_result = parseSize(cmd.args[1]);
+            auto frames_result = parseSize(cmd.args[2]);
+            auto page_size_result = parseSize(cmd.args[3]);
+            if (!pages_result.success || !frames_result.success || !page_size_result.success) {
+                std::cout << "Error: Invalid sizes. Usage: analyze vm <trace_file> <virtual_pages> <physical_frames> <page_size>" << std::endl;
+                break;
+            }
+
+            auto result = manager_.analyzePageReplacement(cmd.args[0], pages_result.value,
+                                                          frames_result.value, page_size_result.value);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
+        case CommandType::ANALYZE_COHERENCE: {
+            if (cmd.args.size() < 4) {
+                std::cout << "Error: Missing arguments. Usage: analyze coherence <trace_file> <memory_size> <cores> <l1>/<l2> [mesi|moesi] [top_n]" << std::endl;
+                break;
+            }
+
+            auto memory_result = parseSize(cmd.args[1]);
+            if (!memory_result.success) {
+                std::cout << "Error: " << memory_result.error_message << std::endl;
+                break;
+            }
+            auto cores_result = parseSize(cmd.args[2]);
+            if (!cores_result.success) {
+                std::cout << "Error: " << cores_result.error_message << std::endl;
+                break;
+            }
+            auto config_result = parseSweepConfig(cmd.args[3]);
+            if (!config_result.success) {
+                std::cout << "Error: " << config_result.error_message << std::endl;
+                break;
+            }
+            const SweepConfig& config = config_result.value;
+            if (config.levels.size() != 2 || config.sampling_ratio != 1) {
+                std::cout << "Error: Expected one private L1 and one shared L2: <sets>x<assoc>x<block>:<policy>/<sets>x<assoc>x<block>:<policy>" << std::endl;
+                break;
+            }
+
+            CoherenceProtocol protocol = CoherenceProtocol::MESI;
+            if (cmd.args.size() >= 5) {
+                auto protocol_result = parseCoherenceProtocol(cmd.args[4]);
+                if (!protocol_result.success) {
+                    std::cout << "Error: " << protocol_result.error_message << std::endl;
+                    break;
+                }
+                protocol = protocol_result.value;
+            }
+            size_t top_n = DEFAULT_FALSE_SHARING_LINES;
+            if (cmd.args.size() >= 6) {
+                auto top_result = parseSize(cmd.args[5]);
+                if (!top_result.success) {
+                    std::cout << "Error: " << top_result.error_message << std::endl;
+                    break;
+                }
+                top_n = top_result.value;
+            }
+
+            auto result = manager_.analyzeCoherence(cmd.args[0], memory_result.value, cores_result.value,
+                                                    config.levels[0], config.levels[1], protocol, top_n);
+            if (!result.success) {
+                std::cout << "Error: " << result.error_message << std::endl;
+            }
+            break;
+        }
+
         case CommandType::HELP: {
             CommandParser::printHelp();
             break;
@@ -465,9 +1097,24 @@ Result<PageReplacementPolicy> CLI::parsePageReplacementPolicy(const std::string&
         return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::LRU);
     } else if (lower == "clock") {
         return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::CLOCK);
+    } else if (lower == "clockpro" || lower == "clock-pro") {
+        return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::CLOCK_PRO);
+    } else if (lower == "wsclock") {
+        return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::WSCLOCK);
+    } else if (lower == "clock2" || lower == "twohand") {
+        return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::TWO_HANDED_CLOCK);
+    } else if (lower == "arc") {
+        return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::ARC);
+    } else if (lower == "2q") {
+        return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::TWO_Q);
+    } else if (lower == "lirs") {
+        return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::LIRS);
+    } else if (lower == "opt" || lower == "optimal") {
+        return Result<PageReplacementPolicy>::Ok(PageReplacementPolicy::OPTIMAL);
     } else {
         return Result<PageReplacementPolicy>::Err(
-            "Invalid page replacement policy: " + policy_str + " (valid: fifo, lru, clock)"
+            "Invalid page replacement policy: " + policy_str +
+            " (valid: fifo, lru, clock, clockpro, wsclock, clock2, arc, 2q, lirs, opt)"
         );
     }
 }
@@ -503,9 +1150,217 @@ Result<CachePolicy> CLI::parseCachePolicy(const std::string& policy_str) {
         return Result<CachePolicy>::Ok(CachePolicy::LRU);
     } else if (lower == "lfu") {
         return Result<CachePolicy>::Ok(CachePolicy::LFU);
+    } else if (lower == "lfu_da") {
+        return Result<CachePolicy>::Ok(CachePolicy::LFU_DA);
+    } else if (lower == "tree_plru" || lower == "plru") {
+        return Result<CachePolicy>::Ok(CachePolicy::TREE_PLRU);
+    } else if (lower == "bit_plru") {
+        return Result<CachePolicy>::Ok(CachePolicy::BIT_PLRU);
+    } else if (lower == "srrip") {
+        return Result<CachePolicy>::Ok(CachePolicy::SRRIP);
+    } else if (lower == "brrip") {
+        return Result<CachePolicy>::Ok(CachePolicy::BRRIP);
+    } else if (lower == "drrip") {
+        return Result<CachePolicy>::Ok(CachePolicy::DRRIP);
     } else {
         return Result<CachePolicy>::Err(
-            "Invalid cache policy: " + policy_str + " (valid: fifo, lru, lfu)"
+            "Invalid cache policy: " + policy_str +
+            " (valid: fifo, lru, lfu, lfu_da, tree_plru, bit_plru, srrip, brrip, drrip)"
+        );
+    }
+}
+
+Result<InclusionPolicy> CLI::parseInclusionPolicy(const std::string& policy_str) {
+    std::string lower = policy_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "nine") {
+        return Result<InclusionPolicy>::Ok(InclusionPolicy::NINE);
+    } else if (lower == "inclusive") {
+        return Result<InclusionPolicy>::Ok(InclusionPolicy::INCLUSIVE);
+    } else if (lower == "exclusive") {
+        return Result<InclusionPolicy>::Ok(InclusionPolicy::EXCLUSIVE);
+    } else {
+        return Result<InclusionPolicy>::Err(
+            "Invalid inclusion policy: " + policy_str +
+            " (valid: nine, inclusive, exclusive)"
+        );
+    }
+}
+
+Result<int> CLI::parseCacheLevel(const std::string& level_str) {
+    std::string lower = level_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower.size() >= 2 && lower[0] == 'l' &&
+        std::all_of(lower.begin() + 1, lower.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        try {
+            int level = std::stoi(lower.substr(1));
+            if (level >= 1) {
+                return Result<int>::Ok(level);
+            }
+        } catch (const std::exception&) {
+            // Fall through to the error below
+        }
+    }
+    return Result<int>::Err("Invalid cache level: " + level_str + " (expected l1, l2, ...)");
+}
+
+Result<PrefetcherType> CLI::parsePrefetcherType(const std::string& type_str) {
+    std::string lower = type_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "none") {
+        return Result<PrefetcherType>::Ok(PrefetcherType::NONE);
+    } else if (lower == "next_line") {
+        return Result<PrefetcherType>::Ok(PrefetcherType::NEXT_LINE);
+    } else if (lower == "stride") {
+        return Result<PrefetcherType>::Ok(PrefetcherType::STRIDE);
+    } else if (lower == "stream") {
+        return Result<PrefetcherType>::Ok(PrefetcherType::STREAM_BUFFER);
+    } else {
+        return Result<PrefetcherType>::Err(
+            "Invalid prefetcher type: " + type_str +
+            " (valid: none, next_line, stride, stream)"
+        );
+    }
+}
+
+Result<SetSamplingMode> CLI::parseSetSamplingMode(const std::string& mode_str) {
+    std::string lower = mode_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "hash") {
+        return Result<SetSamplingMode>::Ok(SetSamplingMode::HASH);
+    } else if (lower == "stride") {
+        return Result<SetSamplingMode>::Ok(SetSamplingMode::STRIDE);
+    } else {
+        return Result<SetSamplingMode>::Err(
+            "Invalid set sampling mode: " + mode_str +
+            " (valid: hash, stride)"
+        );
+    }
+}
+
+Result<SweepConfig> CLI::parseSweepConfig(const std::string& config_str) {
+    SweepConfig config;
+    config.inclusion = InclusionPolicy::NINE;
+
+    // Optional "@<ratio>" suffix: hash-sample one set in ratio
+    std::string levels_str = config_str;
+    size_t at = config_str.find('@');
+    if (at != std::string::npos) {
+        auto ratio_result = parseSize(config_str.substr(at + 1));
+        if (!ratio_result.success || ratio_result.value == 0) {
+            return Result<SweepConfig>::Err("Invalid sampling ratio: " + config_str.substr(at + 1));
+        }
+        config.sampling_ratio = ratio_result.value;
+        levels_str = config_str.substr(0, at);
+    }
+
+    std::istringstream levels(levels_str);
+    std::string level_str;
+    while (std::getline(levels, level_str, '/')) {
+        // <sets>x<assoc>x<block>:<policy>
+        size_t colon = level_str.find(':');
+        size_t first_x = level_str.find('x');
+        size_t second_x = (first_x == std::string::npos) ? first_x : level_str.find('x', first_x + 1);
+        if (colon == std::string::npos || second_x == std::string::npos || second_x > colon) {
+            return Result<SweepConfig>::Err("Invalid cache configuration: " + level_str +
+                                            " (expected <sets>x<assoc>x<block>:<policy>)");
+        }
+
+        auto sets_result = parseSize(level_str.substr(0, first_x));
+        auto assoc_result = parseSize(level_str.substr(first_x + 1, second_x - first_x - 1));
+        auto block_result = parseSize(level_str.substr(second_x + 1, colon - second_x - 1));
+        if (!sets_result.success || !assoc_result.success || !block_result.success) {
+            return Result<SweepConfig>::Err("Invalid cache configuration: " + level_str);
+        }
+        auto policy_result = parseCachePolicy(level_str.substr(colon + 1));
+        if (!policy_result.success) {
+            return Result<SweepConfig>::Err(policy_result.error_message);
+        }
+
+        config.levels.push_back({sets_result.value, assoc_result.value,
+                                 block_result.value, policy_result.value});
+    }
+
+    if (config.levels.empty()) {
+        return Result<SweepConfig>::Err("Empty cache configuration");
+    }
+    return Result<SweepConfig>::Ok(config);
+}
+
+Result<VictimCacheMode> CLI::parseVictimCacheMode(const std::string& mode_str) {
+    std::string lower = mode_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "victim") {
+        return Result<VictimCacheMode>::Ok(VictimCacheMode::VICTIM);
+    } else if (lower == "miss") {
+        return Result<VictimCacheMode>::Ok(VictimCacheMode::MISS);
+    } else {
+        return Result<VictimCacheMode>::Err(
+            "Invalid victim cache mode: " + mode_str +
+            " (valid: victim, miss)"
+        );
+    }
+}
+
+Result<CoherenceProtocol> CLI::parseCoherenceProtocol(const std::string& protocol_str) {
+    std::string lower = protocol_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "mesi") {
+        return Result<CoherenceProtocol>::Ok(CoherenceProtocol::MESI);
+    } else if (lower == "moesi") {
+        return Result<CoherenceProtocol>::Ok(CoherenceProtocol::MOESI);
+    } else {
+        return Result<CoherenceProtocol>::Err(
+            "Invalid coherence protocol: " + protocol_str +
+            " (valid: mesi, moesi)"
+        );
+    }
+}
+
+Result<TLBPolicy> CLI::parseTLBPolicy(const std::string& policy_str) {
+    std::string lower = policy_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "lru") {
+        return Result<TLBPolicy>::Ok(TLBPolicy::LRU);
+    } else if (lower == "fifo") {
+        return Result<TLBPolicy>::Ok(TLBPolicy::FIFO);
+    } else if (lower == "random") {
+        return Result<TLBPolicy>::Ok(TLBPolicy::RANDOM);
+    } else {
+        return Result<TLBPolicy>::Err(
+            "Invalid TLB policy: " + policy_str +
+            " (valid: lru, fifo, random)"
+        );
+    }
+}
+
+Result<PageSize> CLI::parsePageSize(const std::string& size_str) {
+    std::string lower = size_str;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (lower == "2m") {
+        return Result<PageSize>::Ok(PageSize::HUGE_2M);
+    } else if (lower == "1g") {
+        return Result<PageSize>::Ok(PageSize::HUGE_1G);
+    } else {
+        return Result<PageSize>::Err(
+            "Invalid page size: " + size_str +
+            " (valid: 2m, 1g)"
         );
     }
 }
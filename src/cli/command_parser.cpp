@@ -51,6 +51,11 @@ Command CommandParser::parse(const std::string& input) {
         // stats
         return Command(CommandType::STATS);
     }
+    else if (cmd == "init" && tokens.size() >= 3 && toLower(tokens[1]) == "cache" && toLower(tokens[2]) == "level") {
+        // init cache level <n> <sets> <assoc> <block> <policy>
+        std::vector<std::string> args(tokens.begin() + 3, tokens.end());
+        return Command(CommandType::INIT_CACHE_LEVEL, args);
+    }
     else if (cmd == "init" && tokens.size() >= 3 && toLower(tokens[1]) == "cache") {
         // init cache <l1_sets> <l1_assoc> <l1_block> <l1_policy> <l2_sets> <l2_assoc> <l2_block> <l2_policy>
         std::vector<std::string> args(tokens.begin() + 2, tokens.end());
@@ -74,12 +79,42 @@ Command CommandParser::parse(const std::string& input) {
         // cache dump
         return Command(CommandType::CACHE_DUMP);
     }
+    else if (cmd == "cache" && tokens.size() >= 3 && toLower(tokens[1]) == "inclusion") {
+        // cache inclusion <inclusive|exclusive|nine>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::CACHE_INCLUSION, args);
+    }
+    else if (cmd == "cache" && tokens.size() >= 4 && toLower(tokens[1]) == "prefetch") {
+        // cache prefetch <l1|l2|...> <type> [degree] [latency]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::CACHE_PREFETCH, args);
+    }
+    else if (cmd == "cache" && tokens.size() >= 3 && toLower(tokens[1]) == "victim") {
+        // cache victim <entries> [victim|miss]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::CACHE_VICTIM, args);
+    }
+    else if (cmd == "cache" && tokens.size() >= 3 && toLower(tokens[1]) == "classify") {
+        // cache classify <on|off>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::CACHE_CLASSIFY, args);
+    }
+    else if (cmd == "cache" && tokens.size() >= 3 && toLower(tokens[1]) == "sample") {
+        // cache sample <ratio> [hash|stride]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::CACHE_SAMPLE, args);
+    }
+    else if (cmd == "cache" && tokens.size() >= 4 && toLower(tokens[1]) == "latency") {
+        // cache latency <l1_cycles> [l2_cycles ...] <memory_cycles>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::CACHE_LATENCY, args);
+    }
     else if (cmd == "cache" && tokens.size() >= 2 && toLower(tokens[1]) == "flush") {
         // cache flush
         return Command(CommandType::CACHE_FLUSH);
     }
     else if (cmd == "init" && tokens.size() >= 3 && toLower(tokens[1]) == "vm") {
-        // init vm <num_virtual_pages> <num_physical_frames> <page_size> <policy>
+        // init vm <num_virtual_pages> <num_physical_frames> <page_size> <policy> [levels]
         std::vector<std::string> args(tokens.begin() + 2, tokens.end());
         return Command(CommandType::INIT_VM, args);
     }
@@ -106,6 +141,76 @@ Command CommandParser::parse(const std::string& input) {
         // vm dump
         return Command(CommandType::VM_DUMP);
     }
+    else if (cmd == "vm" && tokens.size() >= 3 && toLower(tokens[1]) == "tlb") {
+        // vm tlb <dtlb_sets> <dtlb_assoc> <stlb_sets> <stlb_assoc> [policy] [walk_cycles] | vm tlb off
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_TLB, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 3 && toLower(tokens[1]) == "walk") {
+        // vm walk <pwc_entries> [cache|memory]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_WALK, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 3 && toLower(tokens[1]) == "thp") {
+        // vm thp <off|2m|1g>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_THP, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 4 && toLower(tokens[1]) == "promote") {
+        // vm promote <virtual_address> <2m|1g>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_PROMOTE, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 4 && toLower(tokens[1]) == "clock") {
+        // vm clock <spread|window> <value>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_CLOCK, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 3 && toLower(tokens[1]) == "demote") {
+        // vm demote <virtual_address>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_DEMOTE, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 3 && toLower(tokens[1]) == "latency") {
+        // vm latency <page_load_cycles> [writeback_cycles]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_LATENCY, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 3 && toLower(tokens[1]) == "swap") {
+        // vm swap <file|off> | vm swap async <threads> [batch] | vm swap sync | vm swap delay <us>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_SWAP, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 3 && toLower(tokens[1]) == "replay") {
+        // vm replay <trace_file> [lookahead]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_REPLAY, args);
+    }
+    else if (cmd == "vm" && tokens.size() >= 4 && toLower(tokens[1]) == "prefetch") {
+        // vm prefetch <readahead|faultaround> <pages>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::VM_PREFETCH, args);
+    }
+    else if (cmd == "analyze" && tokens.size() >= 4 && toLower(tokens[1]) == "mrc") {
+        // analyze mrc <trace_file> <block_size> [max_sets] [max_assoc]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::ANALYZE_MRC, args);
+    }
+    else if (cmd == "analyze" && tokens.size() >= 5 && toLower(tokens[1]) == "sweep") {
+        // analyze sweep <trace_file> <memory_size> <config> [config...]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::ANALYZE_SWEEP, args);
+    }
+    else if (cmd == "analyze" && tokens.size() >= 6 && toLower(tokens[1]) == "coherence") {
+        // analyze coherence <trace_file> <memory_size> <cores> <l1>/<l2> [mesi|moesi] [top_n]
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::ANALYZE_COHERENCE, args);
+    }
+    else if (cmd == "analyze" && tokens.size() >= 6 && toLower(tokens[1]) == "vm") {
+        // analyze vm <trace_file> <virtual_pages> <physical_frames> <page_size>
+        std::vector<std::string> args(tokens.begin() + 2, tokens.end());
+        return Command(CommandType::ANALYZE_VM, args);
+    }
     else if (cmd == "help") {
         // help
         return Command(CommandType::HELP);
@@ -145,8 +250,13 @@ void CommandParser::printHelp() {
     std::cout << "                                 l1_s/l2_s: number of sets" << std::endl;
     std::cout << "                                 l1_a/l2_a: associativity (ways)" << std::endl;
     std::cout << "                                 l1_b/l2_b: block size in bytes" << std::endl;
-    std::cout << "                                 l1_p/l2_p: policy (fifo, lru, lfu)" << std::endl;
+    std::cout << "                                 l1_p/l2_p: policy (fifo, lru, lfu, lfu_da, tree_plru, bit_plru," << std::endl;
+    std::cout << "                                            srrip, brrip, drrip)" << std::endl;
     std::cout << "                                 Example: init cache 4 2 16 lru 8 4 32 lru" << std::endl;
+    std::cout << "  init cache level <n> <s> <a> <b> <p>" << std::endl;
+    std::cout << "                              - Configure cache level n (1 = L1) and rebuild the hierarchy" << std::endl;
+    std::cout << "                                 New levels are added below the current last level" << std::endl;
+    std::cout << "                                 Example: init cache level 3 64 16 64 drrip" << std::endl;
     std::cout << "  cache read <address>        - Read from cache (uses physical address)" << std::endl;
     std::cout << "                                 Example: cache read 1024" << std::endl;
     std::cout << "  cache write <address> <value>" << std::endl;
@@ -155,13 +265,33 @@ void CommandParser::printHelp() {
     std::cout << "  cache stats                 - Show cache statistics (hit ratio, miss ratio)" << std::endl;
     std::cout << "  cache dump                  - Display cache contents" << std::endl;
     std::cout << "  cache flush                 - Invalidate all cache lines" << std::endl;
+    std::cout << "  cache inclusion <policy>    - Set inclusion between levels (rebuilds the hierarchy)" << std::endl;
+    std::cout << "                                 Policies: nine, inclusive, exclusive" << std::endl;
+    std::cout << "                                 Example: cache inclusion exclusive" << std::endl;
+    std::cout << "  cache prefetch <l1|l2|...> <type> [degree] [latency]" << std::endl;
+    std::cout << "                              - Attach a hardware prefetcher to a cache level" << std::endl;
+    std::cout << "                                 Types: none, next_line, stride, stream" << std::endl;
+    std::cout << "                                 Example: cache prefetch l1 stride 2 4" << std::endl;
+    std::cout << "  cache victim <entries> [mode]" << std::endl;
+    std::cout << "                              - Add a fully-associative buffer between L1 and L2" << std::endl;
+    std::cout << "                                 Modes: victim (default), miss; 0 entries removes it" << std::endl;
+    std::cout << "                                 Example: cache victim 4" << std::endl;
+    std::cout << "  cache classify <on|off>     - Split misses into compulsory/capacity/conflict" << std::endl;
+    std::cout << "  cache sample <ratio> [mode] - Simulate one set in <ratio> and extrapolate (1 = exact)" << std::endl;
+    std::cout << "                                 Modes: hash (default), stride" << std::endl;
+    std::cout << "                                 Example: cache sample 16" << std::endl;
+    std::cout << "  cache latency <l1> [l2 ...] <memory>" << std::endl;
+    std::cout << "                              - Set hit latencies per level and memory latency (cycles)" << std::endl;
+    std::cout << "                                 Example: cache latency 4 12 200" << std::endl;
     std::cout << "\nVirtual Memory:" << std::endl;
-    std::cout << "  init vm <vp> <pf> <ps> <policy>" << std::endl;
+    std::cout << "  init vm <vp> <pf> <ps> <policy> [levels]" << std::endl;
     std::cout << "                              - Initialize virtual memory system" << std::endl;
     std::cout << "                                 vp: number of virtual pages" << std::endl;
     std::cout << "                                 pf: number of physical frames" << std::endl;
     std::cout << "                                 ps: page size in bytes" << std::endl;
-    std::cout << "                                 policy: fifo, lru, or clock" << std::endl;
+    std::cout << "                                 policy: fifo, lru, clock, clockpro, wsclock, clock2 (two-handed)," << std::endl;
+    std::cout << "                                 arc, 2q, lirs, or opt (needs the future: see analyze vm)" << std::endl;
+    std::cout << "                                 levels: radix page table levels, 2-5 (default 2)" << std::endl;
     std::cout << "                                 Example: init vm 16 4 256 lru" << std::endl;
     std::cout << "  vm read <virtual_addr>      - Read from virtual address" << std::endl;
     std::cout << "                                 Example: vm read 1024" << std::endl;
@@ -172,6 +302,60 @@ void CommandParser::printHelp() {
     std::cout << "                                 Example: vm translate 1024" << std::endl;
     std::cout << "  vm stats                    - Show virtual memory statistics (page faults, hit rate)" << std::endl;
     std::cout << "  vm dump                     - Display page table" << std::endl;
+    std::cout << "  vm tlb <ds> <da> <ss> <sa> [policy] [walk]" << std::endl;
+    std::cout << "                              - Put a dTLB (ds sets x da ways) and STLB in front of the page table" << std::endl;
+    std::cout << "                                 Policies: lru (default), fifo, random; walk: miss latency in cycles" << std::endl;
+    std::cout << "                                 Example: vm tlb 4 4 16 8 lru 30 ('vm tlb off' removes it)" << std::endl;
+    std::cout << "  vm walk <pwc_entries> [cache|memory]" << std::endl;
+    std::cout << "                              - Set page-walk cache entries per level (0 removes it)" << std::endl;
+    std::cout << "                                 cache: walk references go through the cache hierarchy" << std::endl;
+    std::cout << "                                 Example: vm walk 4 cache" << std::endl;
+    std::cout << "  vm thp <off|2m|1g>          - Let faults map huge pages up to a size (transparent huge pages)" << std::endl;
+    std::cout << "                                 2m/1g: entries one/two levels above the leaves" << std::endl;
+    std::cout << "  vm promote <virtual_addr> <2m|1g>" << std::endl;
+    std::cout << "                              - Collapse the region around an address into a huge page" << std::endl;
+    std::cout << "                                 Example: vm promote 0 2m" << std::endl;
+    std::cout << "  vm demote <virtual_addr>    - Split the huge page mapping an address" << std::endl;
+    std::cout << "  vm clock <spread|window> <n>" << std::endl;
+    std::cout << "                              - Set the two-handed clock's hand spread (frames)" << std::endl;
+    std::cout << "                                 or the WSClock working-set window (accesses)" << std::endl;
+    std::cout << "                                 Example: vm clock window 64" << std::endl;
+    std::cout << "  vm latency <load> [writeback]" << std::endl;
+    std::cout << "                              - Charge page faults disk latency (cycles)" << std::endl;
+    std::cout << "                                 Example: vm latency 100000 100000" << std::endl;
+    std::cout << "  vm swap <file|off>          - Keep evicted dirty pages in a swap file" << std::endl;
+    std::cout << "                                 Example: vm swap /tmp/memsim.swap" << std::endl;
+    std::cout << "  vm swap async <threads> [batch]" << std::endl;
+    std::cout << "                              - Swap I/O on a thread pool, writing back in batches" << std::endl;
+    std::cout << "                                 (default 16); vm swap sync goes back to blocking I/O" << std::endl;
+    std::cout << "  vm swap delay <us>          - Make every swap transfer take at least <us> microseconds" << std::endl;
+    std::cout << "                                 Example: vm swap delay 100" << std::endl;
+    std::cout << "  vm replay <trace> [lookahead]" << std::endl;
+    std::cout << "                              - Replay a trace of virtual addresses, prefetching swapped" << std::endl;
+    std::cout << "                                 pages lookahead accesses ahead (default 32)" << std::endl;
+    std::cout << "  vm prefetch <readahead|faultaround> <pages>" << std::endl;
+    std::cout << "                              - Read ahead of sequential faults (largest window), or map" << std::endl;
+    std::cout << "                                 the aligned block around a fault (0 disables)" << std::endl;
+    std::cout << "                                 Example: vm prefetch readahead 32" << std::endl;
+    std::cout << "\nTrace Analysis:" << std::endl;
+    std::cout << "  analyze mrc <trace> <block_size> [max_sets] [max_assoc]" << std::endl;
+    std::cout << "                              - LRU miss-ratio curves for every cache size in one pass" << std::endl;
+    std::cout << "                                 Trace lines: R <addr> or W <addr>" << std::endl;
+    std::cout << "                                 Example: analyze mrc trace.txt 64 64 16" << std::endl;
+    std::cout << "  analyze sweep <trace> <memory_size> <config> [config...]" << std::endl;
+    std::cout << "                              - Simulate several hierarchies in parallel over one trace pass" << std::endl;
+    std::cout << "                                 config: <sets>x<assoc>x<block>:<policy>[/<next level>...][@<ratio>]" << std::endl;
+    std::cout << "                                 @<ratio> simulates one set in <ratio> and extrapolates" << std::endl;
+    std::cout << "  analyze coherence <trace> <memory_size> <cores> <l1>/<l2> [protocol] [top_n]" << std::endl;
+    std::cout << "                              - Private L1 per core, shared L2, MESI or MOESI coherence" << std::endl;
+    std::cout << "                                 Lists the top_n falsely shared lines (default 10)" << std::endl;
+    std::cout << "                                 Trace lines: R <addr> <core> or W <addr> <core>" << std::endl;
+    std::cout << "                                 Example: analyze coherence trace.txt 65536 4 64x4x64:lru/512x8x64:lru moesi" << std::endl;
+    std::cout << "                                 Example: analyze sweep trace.txt 65536 64x4x64:lru 32x8x64:drrip/256x8x64:lru" << std::endl;
+    std::cout << "  analyze vm <trace> <vp> <pf> <ps>" << std::endl;
+    std::cout << "                              - Page faults of every replacement policy against OPT (Belady)" << std::endl;
+    std::cout << "                                 Trace addresses are virtual; vp/pf/ps as in init vm" << std::endl;
+    std::cout << "                                 Example: analyze vm trace.txt 1024 64 4096" << std::endl;
     std::cout << "\nVisualization & Statistics:" << std::endl;
     std::cout << "  dump memory                 - Display memory layout" << std::endl;
     std::cout << "  stats                       - Show allocator statistics (strategy, fragmentation, utilization)" << std::endl;
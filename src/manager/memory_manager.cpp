@@ -1,6 +1,8 @@
 #include "manager/memory_manager.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <chrono>
 
 namespace memsim {
 
@@ -9,6 +11,8 @@ MemoryManager::MemoryManager()
       allocator_(nullptr),
       virtual_memory_(nullptr),
       cache_(nullptr),
+      cache_inclusion_(InclusionPolicy::NINE),
+      walks_through_cache_(false),
       current_allocator_type_(AllocatorType::FIRST_FIT) {
 }
 
@@ -161,7 +165,8 @@ void MemoryManager::printStats() const {
 Result<void> MemoryManager::initVirtualMemory(size_t num_virtual_pages,
                                                size_t num_physical_frames,
                                                size_t page_size,
-                                               PageReplacementPolicy policy) {
+                                               PageReplacementPolicy policy,
+                                               size_t page_table_levels) {
     if (!isMemoryInitialized()) {
         return Result<void>::Err("Physical memory must be initialized first");
     }
@@ -172,22 +177,19 @@ Result<void> MemoryManager::initVirtualMemory(size_t num_virtual_pages,
             num_virtual_pages,
             num_physical_frames,
             page_size,
-            policy
+            policy,
+            page_table_levels
         );
+        walks_through_cache_ = false;
 
-        std::string policy_name;
-        switch (policy) {
-            case PageReplacementPolicy::FIFO: policy_name = "FIFO"; break;
-            case PageReplacementPolicy::LRU: policy_name = "LRU"; break;
-            case PageReplacementPolicy::CLOCK: policy_name = "Clock"; break;
-            default: policy_name = "Unknown"; break;
-        }
+        std::string policy_name = pageReplacementPolicyToString(policy);
 
         std::cout << "Virtual memory initialized: "
                   << num_virtual_pages << " virtual pages, "
                   << num_physical_frames << " physical frames, "
                   << page_size << " bytes/page, "
-                  << policy_name << " policy" << std::endl;
+                  << policy_name << " policy, "
+                  << page_table_levels << "-level page table" << std::endl;
 
         return Result<void>::Ok();
     } catch (const std::exception& e) {
@@ -219,6 +221,285 @@ Result<Address> MemoryManager::vmTranslate(Address virtual_addr) {
     return virtual_memory_->translate(virtual_addr);
 }
 
+Result<void> MemoryManager::setVMTLB(const TLBConfig& dtlb, const TLBConfig& stlb,
+                                     uint64_t walk_cycles) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    try {
+        auto tlb = std::make_unique<TLBHierarchy>(dtlb, stlb, walk_cycles);
+        std::cout << "TLB attached:" << std::endl;
+        std::cout << "  dTLB: " << tlb->getDTLB().getConfigString() << std::endl;
+        std::cout << "  STLB: " << tlb->getSTLB().getConfigString() << std::endl;
+        std::cout << "  Page walk: " << walk_cycles << " cycles" << std::endl;
+        virtual_memory_->setTLB(std::move(tlb));
+        return Result<void>::Ok();
+    } catch (const std::exception& e) {
+        return Result<void>::Err(std::string("Failed to configure TLB: ") + e.what());
+    }
+}
+
+Result<void> MemoryManager::disableVMTLB() {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    virtual_memory_->setTLB(nullptr);
+    std::cout << "TLB removed" << std::endl;
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMPageWalk(size_t pwc_entries, bool through_cache) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+    if (through_cache && !isCacheInitialized()) {
+        return Result<void>::Err("Cache not initialized");
+    }
+
+    virtual_memory_->setPageWalkCache(pwc_entries);
+    virtual_memory_->setPageWalkMemory(through_cache ? cache_.get() : nullptr);
+    walks_through_cache_ = through_cache;
+
+    if (pwc_entries > 0) {
+        std::cout << "Page-walk cache: " << pwc_entries << " entries per level" << std::endl;
+    } else {
+        std::cout << "Page-walk cache removed" << std::endl;
+    }
+    std::cout << "Page walks read " << (through_cache ? "through the cache hierarchy" : "untimed")
+              << std::endl;
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMHugePages(PageSize max_size) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    auto result = virtual_memory_->setTransparentHugePages(max_size);
+    if (!result.success) {
+        return result;
+    }
+    if (max_size == PageSize::BASE) {
+        std::cout << "Transparent huge pages disabled" << std::endl;
+    } else {
+        std::cout << "Transparent huge pages: faults map up to " << pageSizeToString(max_size)
+                  << " pages (" << virtual_memory_->getPagesPerMapping(max_size) << " base pages)"
+                  << std::endl;
+    }
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::vmPromote(Address virtual_addr, PageSize size) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    auto result = virtual_memory_->promote(virtual_addr, size);
+    if (result.success) {
+        std::cout << "Promoted 0x" << std::hex << virtual_addr << std::dec << " to a "
+                  << pageSizeToString(size) << " page" << std::endl;
+    }
+    return result;
+}
+
+Result<void> MemoryManager::vmDemote(Address virtual_addr) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    auto result = virtual_memory_->demote(virtual_addr);
+    if (result.success) {
+        std::cout << "Demoted the huge page at 0x" << std::hex << virtual_addr << std::dec << std::endl;
+    }
+    return result;
+}
+
+Result<void> MemoryManager::setVMClockHandSpread(size_t frames) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    auto result = virtual_memory_->setClockHandSpread(frames);
+    if (result.success) {
+        std::cout << "Two-handed clock: front hand " << frames << " frames ahead" << std::endl;
+    }
+    return result;
+}
+
+Result<void> MemoryManager::setVMWorkingSetWindow(uint64_t accesses) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    virtual_memory_->setWorkingSetWindow(accesses);
+    std::cout << "WSClock working-set window: " << accesses << " accesses" << std::endl;
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMReadahead(size_t max_pages) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    virtual_memory_->setReadahead(max_pages);
+    if (max_pages == 0) {
+        std::cout << "Readahead: off" << std::endl;
+    } else {
+        std::cout << "Readahead: windows of up to " << max_pages << " pages" << std::endl;
+    }
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMFaultAround(size_t pages) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    auto result = virtual_memory_->setFaultAround(pages);
+    if (!result.success) {
+        return result;
+    }
+    if (virtual_memory_->getFaultAround() == 0) {
+        std::cout << "Fault-around: off" << std::endl;
+    } else {
+        std::cout << "Fault-around: " << pages << "-page blocks" << std::endl;
+    }
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMDiskLatency(uint64_t page_load_cycles, uint64_t writeback_cycles) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    virtual_memory_->setDiskLatency(page_load_cycles, writeback_cycles);
+    std::cout << "Disk latency: " << page_load_cycles << " cycles per page load, "
+              << writeback_cycles << " per dirty writeback" << std::endl;
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMSwapFile(const std::string& path) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    if (path == "off") {
+        virtual_memory_->setSwapDevice(nullptr);
+        std::cout << "Swap detached: dirty pages are no longer kept" << std::endl;
+        return Result<void>::Ok();
+    }
+
+    auto swap = std::make_unique<SwapDevice>();
+    auto opened = swap->open(path, virtual_memory_->getBasePageSize());
+    if (!opened.success) {
+        return opened;
+    }
+    auto result = virtual_memory_->setSwapDevice(std::move(swap));
+    if (!result.success) {
+        return result;
+    }
+    std::cout << "Swap file: " << path << " (" << virtual_memory_->getBasePageSize()
+              << "-byte slots)" << std::endl;
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMSwapAsync(size_t num_threads, size_t batch_size) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    auto result = virtual_memory_->setSwapAsync(num_threads, batch_size);
+    if (!result.success) {
+        return result;
+    }
+    if (num_threads == 0) {
+        std::cout << "Swap I/O: synchronous" << std::endl;
+    } else {
+        std::cout << "Swap I/O: " << num_threads << " threads, write-back batches of "
+                  << batch_size << std::endl;
+    }
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setVMSwapDelay(uint64_t microseconds) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    auto result = virtual_memory_->setSwapDelay(microseconds);
+    if (!result.success) {
+        return result;
+    }
+    std::cout << "Swap device delay: " << microseconds << " us per transfer" << std::endl;
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::replayVMTrace(const std::string& trace_path, size_t lookahead) {
+    if (!isVMInitialized()) {
+        return Result<void>::Err("Virtual memory not initialized");
+    }
+
+    TraceReader reader;
+    auto open_result = reader.open(trace_path);
+    if (!open_result.success) {
+        return open_result;
+    }
+
+    VirtualMemoryStats before = virtual_memory_->getStats();
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t errors = 0;
+    uint64_t prefetches = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<TraceRecord> records;
+    while (true) {
+        auto read_result = reader.read(records, TRACE_CHUNK_RECORDS);
+        if (!read_result.success) {
+            return Result<void>::Err(read_result.error_message);
+        }
+        if (read_result.value == 0) {
+            break;
+        }
+
+        // Keep lookahead prefetches ahead of the replay within the chunk
+        for (size_t i = 0; i < std::min(lookahead, records.size()); i++) {
+            prefetches += virtual_memory_->prefetchSwap(records[i].address);
+        }
+        for (size_t i = 0; i < records.size(); i++) {
+            if (lookahead > 0 && i + lookahead < records.size()) {
+                prefetches += virtual_memory_->prefetchSwap(records[i + lookahead].address);
+            }
+            const TraceRecord& record = records[i];
+            bool ok = false;
+            if (record.is_write) {
+                writes++;
+                ok = virtual_memory_->write(record.address, static_cast<uint8_t>(record.address)).success;
+            } else {
+                reads++;
+                ok = virtual_memory_->read(record.address).success;
+            }
+            if (!ok) {
+                errors++;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    VirtualMemoryStats after = virtual_memory_->getStats();
+
+    std::cout << "=== VM Trace Replay ===" << std::endl;
+    std::cout << "Records: " << reads + writes << " (" << reads << " reads, " << writes
+              << " writes), " << errors << " errors" << std::endl;
+    std::cout << "Page Faults: " << after.page_faults - before.page_faults
+              << ", Dirty Writebacks: " << after.page_writebacks - before.page_writebacks
+              << ", Swap Prefetches: " << prefetches << std::endl;
+    std::cout << "Elapsed: " << std::fixed << std::setprecision(2) << seconds * 1000.0 << " ms, "
+              << std::setprecision(0) << (seconds > 0 ? (reads + writes) / seconds : 0.0)
+              << " accesses/s" << std::endl;
+    return Result<void>::Ok();
+}
+
 void MemoryManager::printVMStats() const {
     if (!isVMInitialized()) {
         std::cout << "Virtual memory not initialized" << std::endl;
@@ -239,57 +520,166 @@ void MemoryManager::dumpVM() const {
 
 Result<void> MemoryManager::initCache(size_t l1_sets, size_t l1_assoc, size_t l1_block_size, CachePolicy l1_policy,
                                        size_t l2_sets, size_t l2_assoc, size_t l2_block_size, CachePolicy l2_policy) {
-    if (!isMemoryInitialized()) {
-        return Result<void>::Err("Physical memory must be initialized first");
+    auto result = buildCache({
+        {l1_sets, l1_assoc, l1_block_size, l1_policy},
+        {l2_sets, l2_assoc, l2_block_size, l2_policy}
+    }, cache_inclusion_);
+    if (result.success) {
+        cache_prefetchers_.clear();
+    }
+    return result;
+}
+
+Result<void> MemoryManager::initCacheLevel(size_t level, size_t sets, size_t assoc, size_t block_size,
+                                            CachePolicy policy) {
+    if (level == 0 || level > cache_levels_.size() + 1) {
+        return Result<void>::Err("Invalid cache level: " + std::to_string(level) +
+                                 " (next new level is " + std::to_string(cache_levels_.size() + 1) + ")");
+    }
+
+    std::vector<CacheLevelConfig> levels = cache_levels_;
+    CacheLevelConfig config = {sets, assoc, block_size, policy};
+    if (level == levels.size() + 1) {
+        levels.push_back(config);
+    } else {
+        levels[level - 1] = config;
+    }
+    return rebuildCache(levels, cache_inclusion_);
+}
+
+Result<void> MemoryManager::setCacheInclusion(InclusionPolicy policy) {
+    if (!isCacheInitialized()) {
+        return Result<void>::Err("Cache not initialized");
+    }
+
+    return rebuildCache(cache_levels_, policy);
+}
+
+Result<uint8_t> MemoryManager::cacheRead(Address address) {
+    if (!isCacheInitialized()) {
+        return Result<uint8_t>::Err("Cache not initialized");
+    }
+
+    return cache_->read(address);
+}
+
+Result<void> MemoryManager::cacheWrite(Address address, uint8_t data) {
+    if (!isCacheInitialized()) {
+        return Result<void>::Err("Cache not initialized");
+    }
+
+    return cache_->write(address, data);
+}
+
+Result<void> MemoryManager::setCachePrefetcher(int level, PrefetcherType type,
+                                               size_t degree, uint64_t latency) {
+    if (!isCacheInitialized()) {
+        return Result<void>::Err("Cache not initialized");
+    }
+    CacheLevel* cache = cache_->getLevel(level);
+    if (cache == nullptr) {
+        return Result<void>::Err("Invalid cache level for prefetcher: " + std::to_string(level));
     }
 
     try {
-        cache_ = std::make_unique<CacheHierarchy>(
-            physical_memory_.get(),
-            l1_sets, l1_assoc, l1_block_size, l1_policy,
-            l2_sets, l2_assoc, l2_block_size, l2_policy
-        );
+        auto result = cache_->setPrefetcher(
+            level, createPrefetcher(type, cache->getBlockSize(), degree), latency);
+        if (!result.success) {
+            return result;
+        }
 
-        std::string l1_policy_name, l2_policy_name;
-        switch (l1_policy) {
-            case CachePolicy::FIFO: l1_policy_name = "FIFO"; break;
-            case CachePolicy::LRU: l1_policy_name = "LRU"; break;
-            case CachePolicy::LFU: l1_policy_name = "LFU"; break;
-            default: l1_policy_name = "Unknown"; break;
+        if (cache_prefetchers_.size() < static_cast<size_t>(level)) {
+            cache_prefetchers_.resize(level, PrefetcherSetting{PrefetcherType::NONE, 0, 0});
         }
-        switch (l2_policy) {
-            case CachePolicy::FIFO: l2_policy_name = "FIFO"; break;
-            case CachePolicy::LRU: l2_policy_name = "LRU"; break;
-            case CachePolicy::LFU: l2_policy_name = "LFU"; break;
-            default: l2_policy_name = "Unknown"; break;
+        cache_prefetchers_[level - 1] = PrefetcherSetting{type, degree, latency};
+
+        if (type == PrefetcherType::NONE) {
+            std::cout << "L" << level << " prefetcher disabled" << std::endl;
+        } else {
+            std::cout << "L" << level << " prefetcher set to: "
+                      << cache_->getPrefetcher(level)->getConfigString()
+                      << ", latency " << latency << std::endl;
         }
+        return Result<void>::Ok();
+    } catch (const std::exception& e) {
+        return Result<void>::Err(std::string("Failed to set prefetcher: ") + e.what());
+    }
+}
 
-        std::cout << "Cache hierarchy initialized:" << std::endl;
-        std::cout << "  L1: " << l1_sets << " sets, " << l1_assoc << "-way, "
-                  << l1_block_size << " bytes/block, " << l1_policy_name << std::endl;
-        std::cout << "  L2: " << l2_sets << " sets, " << l2_assoc << "-way, "
-                  << l2_block_size << " bytes/block, " << l2_policy_name << std::endl;
+Result<void> MemoryManager::setCacheVictim(size_t entries, VictimCacheMode mode) {
+    if (!isCacheInitialized()) {
+        return Result<void>::Err("Cache not initialized");
+    }
 
+    try {
+        auto result = cache_->setVictimCache(entries, mode);
+        if (!result.success) {
+            return result;
+        }
+
+        if (entries == 0) {
+            std::cout << "Victim cache removed" << std::endl;
+        } else {
+            std::cout << victimCacheModeToString(mode) << " set to " << entries
+                      << " entries (fully associative, LRU)" << std::endl;
+        }
         return Result<void>::Ok();
     } catch (const std::exception& e) {
-        return Result<void>::Err(std::string("Failed to initialize cache: ") + e.what());
+        return Result<void>::Err(std::string("Failed to set victim cache: ") + e.what());
     }
 }
 
-Result<uint8_t> MemoryManager::cacheRead(Address address) {
+Result<void> MemoryManager::setCacheMissClassification(bool enable) {
     if (!isCacheInitialized()) {
-        return Result<uint8_t>::Err("Cache not initialized");
+        return Result<void>::Err("Cache not initialized");
     }
 
-    return cache_->read(address);
+    cache_->setMissClassification(enable);
+    std::cout << "3C miss classification " << (enable ? "enabled" : "disabled") << std::endl;
+    return Result<void>::Ok();
 }
 
-Result<void> MemoryManager::cacheWrite(Address address, uint8_t data) {
+Result<void> MemoryManager::setCacheSampling(size_t ratio, SetSamplingMode mode) {
     if (!isCacheInitialized()) {
         return Result<void>::Err("Cache not initialized");
     }
 
-    return cache_->write(address, data);
+    auto result = cache_->setSetSampling(ratio, mode);
+    if (!result.success) {
+        return result;
+    }
+
+    if (ratio == 1) {
+        std::cout << "Set sampling disabled (exact simulation)" << std::endl;
+    } else {
+        SamplingStats sampling = cache_->getSamplingStats();
+        std::cout << "Set sampling: " << setSamplingModeToString(mode) << ", "
+                  << sampling.sampled_sets << " of " << sampling.total_sets << " "
+                  << samplingGroupName(sampling) << " simulated (caches flushed)" << std::endl;
+    }
+    return Result<void>::Ok();
+}
+
+Result<void> MemoryManager::setCacheLatency(const std::vector<uint64_t>& hit_cycles,
+                                            uint64_t memory_cycles) {
+    if (!isCacheInitialized()) {
+        return Result<void>::Err("Cache not initialized");
+    }
+
+    LatencyConfig latencies = cache_->getLatencies();
+    latencies.hit_cycles = hit_cycles;
+    latencies.memory_cycles = memory_cycles;
+    auto result = cache_->setLatencies(latencies);
+    if (!result.success) {
+        return result;
+    }
+
+    std::cout << "Cache latencies (cycles):";
+    for (size_t i = 0; i < hit_cycles.size(); i++) {
+        std::cout << " L" << (i + 1) << " " << hit_cycles[i] << ",";
+    }
+    std::cout << " Memory " << memory_cycles << std::endl;
+    return Result<void>::Ok();
 }
 
 void MemoryManager::printCacheStats() const {
@@ -320,4 +710,314 @@ void MemoryManager::flushCache() {
     std::cout << "Cache flushed" << std::endl;
 }
 
+Result<void> MemoryManager::analyzeStackDistance(const std::string& trace_path, size_t block_size,
+                                                 size_t max_sets, size_t max_assoc) {
+    if (max_assoc == 0) {
+        return Result<void>::Err("Associativity must be at least 1");
+    }
+
+    try {
+        StackDistanceAnalyzer analyzer(block_size, max_sets);
+        TraceReader reader;
+        auto open_result = reader.open(trace_path);
+        if (!open_result.success) {
+            return open_result;
+        }
+
+        std::vector<TraceRecord> records;
+        while (true) {
+            auto read_result = reader.read(records, TRACE_CHUNK_RECORDS);
+            if (!read_result.success) {
+                return Result<void>::Err(read_result.error_message);
+            }
+            if (read_result.value == 0) {
+                break;
+            }
+            for (const auto& record : records) {
+                analyzer.access(record.address);
+            }
+        }
+
+        std::cout << analyzer.getReport(max_assoc);
+        return Result<void>::Ok();
+    } catch (const std::exception& e) {
+        return Result<void>::Err(std::string("Failed to analyze trace: ") + e.what());
+    }
+}
+
+Result<void> MemoryManager::analyzeCacheSweep(const std::string& trace_path, size_t memory_size,
+                                              const std::vector<SweepConfig>& configs) {
+    try {
+        ParallelCacheSimulator simulator(memory_size, TRACE_CHUNK_RECORDS);
+        for (const auto& config : configs) {
+            simulator.addConfig(config);
+        }
+
+        TraceReader reader;
+        auto open_result = reader.open(trace_path);
+        if (!open_result.success) {
+            return open_result;
+        }
+        auto result = simulator.run(reader);
+        if (!result.success) {
+            return result;
+        }
+
+        std::cout << simulator.getReport();
+        return Result<void>::Ok();
+    } catch (const std::exception& e) {
+        return Result<void>::Err(std::string("Failed to run cache sweep: ") + e.what());
+    }
+}
+
+Result<void> MemoryManager::analyzeCoherence(const std::string& trace_path, size_t memory_size,
+                                             size_t num_cores, const CacheLevelConfig& l1,
+                                             const CacheLevelConfig& l2, CoherenceProtocol protocol,
+                                             size_t top_n) {
+    try {
+        PhysicalMemory memory(memory_size);
+        MultiCoreHierarchy hierarchy(&memory, num_cores, l1, l2, protocol);
+        hierarchy.setFalseSharingDetection(true);
+        TraceReader reader;
+        auto open_result = reader.open(trace_path);
+        if (!open_result.success) {
+            return open_result;
+        }
+
+        std::vector<TraceRecord> records;
+        uint64_t errors = 0;
+        while (true) {
+            auto read_result = reader.read(records, TRACE_CHUNK_RECORDS);
+            if (!read_result.success) {
+                return Result<void>::Err(read_result.error_message);
+            }
+            if (read_result.value == 0) {
+                break;
+            }
+            for (const auto& record : records) {
+                bool ok = record.is_write ? hierarchy.write(record.core, record.address, 0).success
+                                          : hierarchy.read(record.core, record.address).success;
+                if (!ok) {
+                    errors++;
+                }
+            }
+        }
+
+        std::cout << hierarchy.getStatsString();
+        if (errors > 0) {
+            std::cout << "Failed Accesses (bad address or core): " << errors << std::endl;
+        }
+        printFalseSharing(hierarchy, top_n);
+        return Result<void>::Ok();
+    } catch (const std::exception& e) {
+        return Result<void>::Err(std::string("Failed to analyze coherence: ") + e.what());
+    }
+}
+
+Result<void> MemoryManager::analyzePageReplacement(const std::string& trace_path,
+                                                   size_t num_virtual_pages,
+                                                   size_t num_physical_frames, size_t page_size) {
+    TraceReader reader;
+    auto open_result = reader.open(trace_path);
+    if (!open_result.success) {
+        return open_result;
+    }
+
+    // OPT needs every future access, so the trace is read in full
+    std::vector<TraceRecord> trace;
+    std::vector<TraceRecord> records;
+    while (true) {
+        auto read_result = reader.read(records, TRACE_CHUNK_RECORDS);
+        if (!read_result.success) {
+            return Result<void>::Err(read_result.error_message);
+        }
+        if (read_result.value == 0) {
+            break;
+        }
+        trace.insert(trace.end(), records.begin(), records.end());
+    }
+    std::vector<Address> addresses;
+    addresses.reserve(trace.size());
+    for (const auto& record : trace) {
+        addresses.push_back(record.address);
+    }
+
+    const PageReplacementPolicy policies[] = {
+        PageReplacementPolicy::FIFO, PageReplacementPolicy::LRU, PageReplacementPolicy::CLOCK,
+        PageReplacementPolicy::TWO_HANDED_CLOCK, PageReplacementPolicy::WSCLOCK,
+        PageReplacementPolicy::CLOCK_PRO, PageReplacementPolicy::ARC, PageReplacementPolicy::TWO_Q,
+        PageReplacementPolicy::LIRS, PageReplacementPolicy::OPTIMAL
+    };
+    struct Outcome {
+        std::string name;
+        std::string error;
+        VirtualMemoryStats stats;
+        uint64_t failed;
+    };
+    std::vector<Outcome> outcomes;
+    uint64_t optimal_faults = 0;
+    for (PageReplacementPolicy policy : policies) {
+        Outcome outcome{pageReplacementPolicyToString(policy), "", VirtualMemoryStats(), 0};
+        try {
+            PhysicalMemory memory(num_physical_frames * page_size);
+            VirtualMemory vm(&memory, num_virtual_pages, num_physical_frames, page_size, policy);
+            if (policy == PageReplacementPolicy::OPTIMAL) {
+                vm.setOptimalTrace(addresses);
+            }
+            for (const auto& record : trace) {
+                bool ok = record.is_write ? vm.write(record.address, 0).success
+                                          : vm.read(record.address).success;
+                if (!ok) {
+                    outcome.failed++;
+                }
+            }
+            outcome.stats = vm.getStats();
+            if (policy == PageReplacementPolicy::OPTIMAL) {
+                optimal_faults = outcome.stats.page_faults;
+            }
+        } catch (const std::exception& e) {
+            outcome.error = e.what();
+        }
+        outcomes.push_back(outcome);
+    }
+
+    std::cout << "=== Page Replacement Comparison ===" << std::endl;
+    std::cout << "Trace Records: " << trace.size() << ", " << num_virtual_pages << " virtual pages, "
+              << num_physical_frames << " physical frames, " << page_size << " bytes/page" << std::endl;
+    std::cout << std::left << std::setw(18) << "Policy" << std::right << std::setw(10) << "Faults"
+              << std::setw(12) << "Fault Rate" << std::setw(12) << "Writebacks"
+              << std::setw(10) << "vs OPT" << std::endl;
+    for (const auto& outcome : outcomes) {
+        if (!outcome.error.empty()) {
+            std::cout << std::left << std::setw(18) << outcome.name
+                      << std::right << "  n/a (" << outcome.error << ")" << std::endl;
+            continue;
+        }
+        std::cout << std::left << std::setw(18) << outcome.name << std::right
+                  << std::setw(10) << outcome.stats.page_faults
+                  << std::setw(11) << std::fixed << std::setprecision(2)
+                  << outcome.stats.getPageFaultRate() << "%"
+                  << std::setw(12) << outcome.stats.page_writebacks;
+        if (optimal_faults > 0) {
+            std::cout << std::setw(9) << std::fixed << std::setprecision(2)
+                      << static_cast<double>(outcome.stats.page_faults) / optimal_faults << "x";
+        }
+        std::cout << std::endl;
+    }
+    if (outcomes.back().failed > 0) {
+        std::cout << "Failed Accesses (address out of range): " << outcomes.back().failed << std::endl;
+    }
+    return Result<void>::Ok();
+}
+
+// Private helper methods
+
+Result<void> MemoryManager::buildCache(const std::vector<CacheLevelConfig>& levels,
+                                       InclusionPolicy inclusion) {
+    if (!isMemoryInitialized()) {
+        return Result<void>::Err("Physical memory must be initialized first");
+    }
+
+    try {
+        cache_ = std::make_unique<CacheHierarchy>(physical_memory_.get(), levels, inclusion);
+        if (walks_through_cache_ && virtual_memory_) {
+            virtual_memory_->setPageWalkMemory(cache_.get());
+        }
+        cache_levels_ = levels;
+        cache_inclusion_ = inclusion;
+
+        std::cout << "Cache hierarchy initialized:" << std::endl;
+        for (size_t i = 0; i < levels.size(); i++) {
+            std::cout << "  L" << (i + 1) << ": " << levels[i].sets << " sets, "
+                      << levels[i].associativity << "-way, "
+                      << levels[i].block_size << " bytes/block, "
+                      << cachePolicyToString(levels[i].policy) << std::endl;
+        }
+        if (levels.size() > 1) {
+            std::cout << "  Inclusion: " << inclusionPolicyToString(inclusion) << std::endl;
+        }
+
+        return Result<void>::Ok();
+    } catch (const std::exception& e) {
+        return Result<void>::Err(std::string("Failed to initialize cache: ") + e.what());
+    }
+}
+
+Result<void> MemoryManager::rebuildCache(const std::vector<CacheLevelConfig>& levels,
+                                         InclusionPolicy inclusion) {
+    if (!isCacheInitialized()) {
+        return buildCache(levels, inclusion);
+    }
+
+    LatencyConfig latencies = cache_->getLatencies();
+    bool had_victim = cache_->getVictimCache() != nullptr;
+    auto result = buildCache(levels, inclusion);
+    if (!result.success) {
+        return result;
+    }
+
+    // A level added by the rebuild gets its default hit latency
+    LatencyConfig defaults = CacheHierarchy::defaultLatencies(levels.size());
+    for (size_t i = latencies.hit_cycles.size(); i < levels.size(); i++) {
+        latencies.hit_cycles.push_back(defaults.hit_cycles[i]);
+    }
+    cache_->setLatencies(latencies);
+
+    for (size_t i = 0; i < cache_prefetchers_.size() && i < levels.size(); i++) {
+        const PrefetcherSetting& setting = cache_prefetchers_[i];
+        if (setting.type == PrefetcherType::NONE) {
+            continue;
+        }
+        int level = static_cast<int>(i + 1);
+        try {
+            cache_->setPrefetcher(level, createPrefetcher(setting.type, levels[i].block_size, setting.degree),
+                                  setting.latency);
+            std::cout << "  L" << level << " prefetcher kept: "
+                      << cache_->getPrefetcher(level)->getConfigString()
+                      << ", latency " << setting.latency << std::endl;
+        } catch (const std::exception& e) {
+            cache_prefetchers_[i].type = PrefetcherType::NONE;
+            std::cout << "  Warning: L" << level << " prefetcher removed: " << e.what() << std::endl;
+        }
+    }
+    if (had_victim) {
+        std::cout << "  Warning: victim cache removed (re-add it with cache victim)" << std::endl;
+    }
+    return Result<void>::Ok();
+}
+
+void MemoryManager::printFalseSharing(const MultiCoreHierarchy& hierarchy, size_t top_n) const {
+    auto lines = hierarchy.getFalseSharingLines(top_n);
+    std::cout << "\n=== Falsely Shared Lines (top " << top_n << ") ===" << std::endl;
+    if (lines.empty()) {
+        std::cout << "None found" << std::endl;
+        return;
+    }
+
+    for (size_t i = 0; i < lines.size(); i++) {
+        const FalseSharingLine& line = lines[i];
+        std::cout << "[" << (i + 1) << "] Line 0x" << std::hex << std::setfill('0') << std::setw(8)
+                  << line.block_address << std::dec << std::setfill(' ')
+                  << " - " << line.false_sharing_misses << " false-sharing misses, "
+                  << line.invalidations << " invalidations"
+                  << (line.disjoint_writes && line.writers.size() >= 2 ? " (cores write disjoint bytes)" : "")
+                  << std::endl;
+
+        for (const auto& writer : line.writers) {
+            std::cout << "    Core " << writer.core << " wrote bytes " << writer.first_byte
+                      << "-" << writer.last_byte << " (" << writer.bytes_written << " bytes)";
+            if (allocator_) {
+                // Name the allocation the writes landed in, so it can be padded
+                auto block = allocator_->findBlockId(line.block_address + writer.first_byte);
+                if (block.success) {
+                    std::cout << ", block id=" << block.value;
+                } else {
+                    std::cout << ", not allocated";
+                }
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
 } // namespace memsim
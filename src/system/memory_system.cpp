@@ -20,6 +20,16 @@ MemorySystem::MemorySystem(size_t memory_size, bool enable_vm, bool enable_cache
     // Default VM configuration
     vm_config_ = {64, 16, 512, PageReplacementPolicy::LRU}; // 64 pages, 16 frames, 512B pages
 
+    // Default TLB: 16-entry 4-way dTLB, 32-entry 8-way STLB
+    dtlb_config_ = {4, 4, TLBPolicy::LRU, TLBHierarchy::DEFAULT_DTLB_CYCLES};
+    stlb_config_ = {4, 8, TLBPolicy::LRU, TLBHierarchy::DEFAULT_STLB_CYCLES};
+    walk_cycles_ = TLBHierarchy::DEFAULT_WALK_CYCLES;
+
+    // Default latencies, no disk latency
+    latencies_ = CacheHierarchy::defaultLatencies(2);
+    page_load_cycles_ = 0;
+    writeback_cycles_ = 0;
+
     // Create allocator (always needed)
     allocator_ = std::make_unique<StandardAllocator>(
         memory_.get(),
@@ -40,11 +50,9 @@ MemorySystem::MemorySystem(size_t memory_size, bool enable_vm, bool enable_cache
 void MemorySystem::initializeCache() {
     cache_ = std::make_unique<CacheHierarchy>(
         memory_.get(),
-        l1_config_.sets, l1_config_.associativity,
-        l1_config_.block_size, l1_config_.policy,
-        l2_config_.sets, l2_config_.associativity,
-        l2_config_.block_size, l2_config_.policy
+        std::vector<CacheLevelConfig>{l1_config_, l2_config_}
     );
+    cache_->setLatencies(latencies_);
 }
 
 void MemorySystem::initializeVM() {
@@ -55,6 +63,19 @@ void MemorySystem::initializeVM() {
         vm_config_.page_size,
         vm_config_.policy
     );
+    vm_->setDiskLatency(page_load_cycles_, writeback_cycles_);
+    vm_->setTLB(std::make_unique<TLBHierarchy>(dtlb_config_, stlb_config_, walk_cycles_));
+}
+
+void MemorySystem::configureTLB(const TLBConfig& dtlb, const TLBConfig& stlb, uint64_t walk_cycles) {
+    // Validate before keeping the configuration
+    auto tlb = std::make_unique<TLBHierarchy>(dtlb, stlb, walk_cycles);
+    dtlb_config_ = dtlb;
+    stlb_config_ = stlb;
+    walk_cycles_ = walk_cycles;
+    if (vm_) {
+        vm_->setTLB(std::move(tlb));
+    }
 }
 
 void MemorySystem::configureCacheL1(size_t sets, size_t associativity,
@@ -81,6 +102,26 @@ void MemorySystem::configureVM(size_t num_virtual_pages, size_t num_physical_fra
     }
 }
 
+Result<void> MemorySystem::setLatencies(const LatencyConfig& latencies) {
+    if (latencies.hit_cycles.size() != 2) {
+        return Result<void>::Err("Expected 2 hit latencies (L1, L2), got " +
+                                 std::to_string(latencies.hit_cycles.size()));
+    }
+    latencies_ = latencies;
+    if (cache_) {
+        return cache_->setLatencies(latencies_);
+    }
+    return Result<void>::Ok();
+}
+
+void MemorySystem::setDiskLatency(uint64_t page_load_cycles, uint64_t writeback_cycles) {
+    page_load_cycles_ = page_load_cycles;
+    writeback_cycles_ = writeback_cycles;
+    if (vm_) {
+        vm_->setDiskLatency(page_load_cycles_, writeback_cycles_);
+    }
+}
+
 AccessLevel MemorySystem::determineAccessLevel(Address phys_addr, bool /* is_write */) {
     if (!cache_enabled_) {
         return AccessLevel::MEMORY;
@@ -110,6 +151,7 @@ AccessResult MemorySystem::read(Address address) {
     session_stats_.total_reads++;
 
     Address physical_addr = address;
+    uint64_t cycles = 0;
 
     // Step 1: Virtual memory translation (if enabled)
     if (vm_enabled_) {
@@ -119,6 +161,7 @@ AccessResult MemorySystem::read(Address address) {
         if (!translate_result.success) {
             result.success = false;
             result.level = AccessLevel::PAGE_FAULT;
+            result.translation = AccessLevel::PAGE_FAULT;
             session_stats_.page_faults++;
             recordAccess(result);
             return result;
@@ -127,11 +170,13 @@ AccessResult MemorySystem::read(Address address) {
         physical_addr = translate_result.value;
         result.physical_address = physical_addr;
 
-        // Check if page fault occurred
+        // Check where the translation was found and whether a page fault occurred
         auto vm_stats_after = vm_->getStats();
-        if (vm_stats_after.page_faults > vm_stats_before.page_faults) {
+        cycles += vm_stats_after.translation_cycles - vm_stats_before.translation_cycles;
+        cycles += vm_stats_after.disk_cycles - vm_stats_before.disk_cycles;
+        result.translation = recordTranslation(vm_stats_before, vm_stats_after);
+        if (result.translation == AccessLevel::PAGE_FAULT) {
             result.level = AccessLevel::PAGE_FAULT;
-            session_stats_.page_faults++;
         }
     } else {
         result.physical_address = physical_addr;
@@ -170,6 +215,7 @@ AccessResult MemorySystem::read(Address address) {
             session_stats_.memory_accesses++;
         }
 
+        cycles += cache_->getLastAccessCycles();
         result.success = true;
     } else {
         // No cache - direct memory access
@@ -178,6 +224,7 @@ AccessResult MemorySystem::read(Address address) {
         result.value = mem_result.value;
         result.level = AccessLevel::MEMORY;
         session_stats_.memory_accesses++;
+        cycles += latencies_.memory_cycles;
     }
 
     // Override with page fault if VM detected one
@@ -185,6 +232,8 @@ AccessResult MemorySystem::read(Address address) {
         // Already handled above
     }
 
+    result.cycles = cycles;
+    session_stats_.latency.reads.record(cycles);
     recordAccess(result);
 
     if (verbose_logging_) {
@@ -194,7 +243,8 @@ AccessResult MemorySystem::read(Address address) {
                   << std::setw(12) << std::left << accessLevelToString(result.level)
                   << "\033[0m"
                   << " (value: 0x" << std::hex << std::setw(2) << std::setfill('0')
-                  << static_cast<int>(result.value) << std::dec << ")"
+                  << static_cast<int>(result.value) << std::dec << ", "
+                  << cycles << " cycles)"
                   << std::endl;
     }
 
@@ -211,6 +261,7 @@ AccessResult MemorySystem::write(Address address, uint8_t data) {
     session_stats_.total_writes++;
 
     Address physical_addr = address;
+    uint64_t cycles = 0;
 
     // Step 1: Virtual memory translation (if enabled)
     if (vm_enabled_) {
@@ -220,23 +271,26 @@ AccessResult MemorySystem::write(Address address, uint8_t data) {
         if (!write_result.success) {
             result.success = false;
             result.level = AccessLevel::PAGE_FAULT;
+            result.translation = AccessLevel::PAGE_FAULT;
             session_stats_.page_faults++;
             recordAccess(result);
             return result;
         }
 
-        // Get physical address for cache check
-        auto translate_result = vm_->translate(address);
+        // Get physical address for cache check (the write already translated it)
+        auto translate_result = vm_->peek(address);
         if (translate_result.success) {
             physical_addr = translate_result.value;
             result.physical_address = physical_addr;
         }
 
-        // Check if page fault occurred
+        // Check where the translation was found and whether a page fault occurred
         auto vm_stats_after = vm_->getStats();
-        if (vm_stats_after.page_faults > vm_stats_before.page_faults) {
+        cycles += vm_stats_after.translation_cycles - vm_stats_before.translation_cycles;
+        cycles += vm_stats_after.disk_cycles - vm_stats_before.disk_cycles;
+        result.translation = recordTranslation(vm_stats_before, vm_stats_after);
+        if (result.translation == AccessLevel::PAGE_FAULT) {
             result.level = AccessLevel::PAGE_FAULT;
-            session_stats_.page_faults++;
         }
     } else {
         result.physical_address = physical_addr;
@@ -269,6 +323,7 @@ AccessResult MemorySystem::write(Address address, uint8_t data) {
             session_stats_.memory_accesses++;
         }
 
+        cycles += cache_->getLastAccessCycles();
         result.success = true;
     } else {
         // No cache - direct memory access
@@ -276,6 +331,7 @@ AccessResult MemorySystem::write(Address address, uint8_t data) {
         result.success = mem_result.success;
         result.level = AccessLevel::MEMORY;
         session_stats_.memory_accesses++;
+        cycles += latencies_.memory_cycles;
     }
 
     // Override with page fault if VM detected one
@@ -283,6 +339,8 @@ AccessResult MemorySystem::write(Address address, uint8_t data) {
         // Already handled above
     }
 
+    result.cycles = cycles;
+    session_stats_.latency.writes.record(cycles);
     recordAccess(result);
 
     if (verbose_logging_) {
@@ -292,13 +350,32 @@ AccessResult MemorySystem::write(Address address, uint8_t data) {
                   << std::setw(12) << std::left << accessLevelToString(result.level)
                   << "\033[0m"
                   << " (value: 0x" << std::hex << std::setw(2) << std::setfill('0')
-                  << static_cast<int>(data) << std::dec << ")"
+                  << static_cast<int>(data) << std::dec << ", "
+                  << cycles << " cycles)"
                   << std::endl;
     }
 
     return result;
 }
 
+AccessLevel MemorySystem::recordTranslation(const VirtualMemoryStats& before,
+                                            const VirtualMemoryStats& after) {
+    if (after.page_faults > before.page_faults) {
+        session_stats_.page_faults++;
+        return AccessLevel::PAGE_FAULT;
+    }
+    if (after.dtlb_hits > before.dtlb_hits) {
+        session_stats_.dtlb_hits++;
+        return AccessLevel::DTLB_HIT;
+    }
+    if (after.stlb_hits > before.stlb_hits) {
+        session_stats_.stlb_hits++;
+        return AccessLevel::STLB_HIT;
+    }
+    session_stats_.page_walks++;
+    return AccessLevel::PAGE_WALK;
+}
+
 void MemorySystem::recordAccess(const AccessResult& result) {
     access_history_.push_back(result);
 
@@ -375,6 +452,33 @@ std::string MemorySystem::getSessionReport() const {
     }
     oss << "\n";
 
+    if (vm_enabled_) {
+        oss << "Address Translation (Current Session):\n";
+        oss << "───────────────────────────────────────────────────────────────\n";
+        oss << "  dTLB Hits:          " << std::setw(10) << session_stats_.dtlb_hits << "\n";
+        oss << "  STLB Hits:          " << std::setw(10) << session_stats_.stlb_hits << "\n";
+        oss << "  Page Walks:         " << std::setw(10) << session_stats_.page_walks << "\n";
+        oss << "  Page Faults:        " << std::setw(10) << session_stats_.page_faults << "\n";
+        oss << "\n";
+    }
+
+    // Latency (Current Session)
+    oss << "Access Latency (Current Session):\n";
+    oss << "───────────────────────────────────────────────────────────────\n";
+    oss << "  Latencies: L1 " << latencies_.hit_cycles[0] << ", L2 " << latencies_.hit_cycles[1]
+        << ", Memory " << latencies_.memory_cycles << " cycles";
+    if (vm_enabled_) {
+        oss << "; disk " << page_load_cycles_ << " per page load, "
+            << writeback_cycles_ << " per writeback";
+    }
+    oss << "\n";
+    std::istringstream latency_lines(session_stats_.latency.toString());
+    std::string line;
+    while (std::getline(latency_lines, line)) {
+        oss << "  " << line << "\n";
+    }
+    oss << "\n";
+
     // Component Statistics (Cumulative)
     if (cache_) {
         auto cache_stats = cache_->getStats();
@@ -0,0 +1,191 @@
+#include "virtual_memory/clock_pro.h"
+#include <stdexcept>
+
+namespace memsim {
+
+ClockPro::ClockPro(size_t capacity)
+    : capacity_(capacity) {
+    if (capacity < 2) {
+        throw std::invalid_argument("CLOCK-Pro needs at least 2 frames");
+    }
+    clear();
+}
+
+bool ClockPro::insert(uint64_t page_number, PageTableEntry* pte, bool prefetched) {
+    bool test_hit = false;
+    auto found = index_.find(page_number);
+    if (found != index_.end()) {
+        Node& node = *found->second;
+        if (node.status != Status::TEST) {
+            node.pte = pte;   // Already resident
+            return false;
+        }
+        // Reused within its test period: cold pages deserve more frames
+        test_hit = !prefetched;
+        if (test_hit && cold_target_ < capacity_ - 1) {
+            cold_target_++;
+        }
+        test_--;
+        erase(found->second);
+    }
+
+    pte->referenced = false;   // The access that loaded the page is not a reuse
+    Node node{page_number, test_hit ? Status::HOT : Status::COLD, !test_hit, pte};
+    Iterator it;
+    if (ring_.empty()) {
+        ring_.push_back(node);
+        it = ring_.begin();
+        hand_hot_ = hand_cold_ = hand_test_ = it;
+    } else {
+        it = ring_.insert(hand_hot_, node);   // Newest: the last node the hot hand reaches
+    }
+    index_[page_number] = it;
+    if (test_hit) {
+        hot_++;
+    } else {
+        cold_++;
+    }
+    balance();
+    return test_hit;
+}
+
+bool ClockPro::selectVictim(uint64_t& page_number) {
+    if (hot_ + cold_ == 0) {
+        return false;
+    }
+
+    while (true) {
+        if (cold_ == 0) {
+            runHandHot();   // Demotes a hot page within two sweeps
+            continue;
+        }
+
+        Iterator it = hand_cold_;
+        hand_cold_ = next(it);
+        Node& node = *it;
+        if (node.status != Status::COLD) {
+            continue;
+        }
+
+        if (node.pte->referenced) {
+            // Reused: a page in its test period turns hot, others restart the test
+            node.pte->referenced = false;
+            if (node.in_test) {
+                node.status = Status::HOT;
+                cold_--;
+                hot_++;
+            } else {
+                node.in_test = true;
+            }
+            ring_.splice(hand_hot_, ring_, it);
+            balance();
+            continue;
+        }
+
+        page_number = node.page_number;
+        cold_--;
+        if (node.in_test) {
+            // Keep the metadata until the test period ends
+            node.status = Status::TEST;
+            node.pte = nullptr;
+            test_++;
+        } else {
+            erase(it);
+        }
+        balance();
+        return true;
+    }
+}
+
+void ClockPro::remove(uint64_t page_number) {
+    auto found = index_.find(page_number);
+    if (found == index_.end()) {
+        return;
+    }
+    switch (found->second->status) {
+        case Status::HOT: hot_--; break;
+        case Status::COLD: cold_--; break;
+        case Status::TEST: return;   // Evicted by selectVictim(), still being tested
+    }
+    erase(found->second);
+}
+
+void ClockPro::clear() {
+    ring_.clear();
+    index_.clear();
+    cold_target_ = 1;
+    hot_ = 0;
+    cold_ = 0;
+    test_ = 0;
+    hand_hot_ = hand_cold_ = hand_test_ = ring_.end();
+}
+
+// Private helper methods
+
+void ClockPro::erase(Iterator it) {
+    index_.erase(it->page_number);
+    if (ring_.size() == 1) {
+        ring_.clear();
+        hand_hot_ = hand_cold_ = hand_test_ = ring_.end();
+        return;
+    }
+    Iterator following = next(it);
+    if (hand_hot_ == it) hand_hot_ = following;
+    if (hand_cold_ == it) hand_cold_ = following;
+    if (hand_test_ == it) hand_test_ = following;
+    ring_.erase(it);
+}
+
+void ClockPro::runHandHot() {
+    Iterator it = hand_hot_;
+    hand_hot_ = next(it);
+    Node& node = *it;
+    switch (node.status) {
+        case Status::HOT:
+            if (node.pte->referenced) {
+                node.pte->referenced = false;
+            } else {
+                node.status = Status::COLD;
+                node.in_test = false;
+                hot_--;
+                cold_++;
+            }
+            break;
+        case Status::COLD:
+            node.in_test = false;   // The hot hand ends test periods it passes
+            break;
+        case Status::TEST:
+            test_--;
+            if (cold_target_ > 1) {
+                cold_target_--;
+            }
+            erase(it);
+            break;
+    }
+}
+
+void ClockPro::runHandTest() {
+    Iterator it = hand_test_;
+    hand_test_ = next(it);
+    Node& node = *it;
+    if (node.status == Status::COLD) {
+        node.in_test = false;
+    } else if (node.status == Status::TEST) {
+        test_--;
+        if (cold_target_ > 1) {
+            cold_target_--;
+        }
+        erase(it);
+    }
+}
+
+void ClockPro::balance() {
+    while (hot_ > 0 && hot_ + cold_target_ > capacity_) {
+        runHandHot();
+    }
+    while (test_ > capacity_) {
+        runHandTest();
+    }
+}
+
+} // namespace memsim
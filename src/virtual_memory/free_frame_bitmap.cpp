@@ -0,0 +1,124 @@
+#include "virtual_memory/free_frame_bitmap.h"
+#include "common/bit_utils.h"
+
+namespace memsim {
+
+FreeFrameBitmap::FreeFrameBitmap(size_t num_frames)
+    : num_frames_(num_frames),
+      free_frames_(0),
+      words_((num_frames + WORD_BITS - 1) / WORD_BITS, 0),
+      summary_((words_.size() + WORD_BITS - 1) / WORD_BITS, 0),
+      first_summary_(0) {
+    reset();
+}
+
+bool FreeFrameBitmap::findFree(size_t& frame) const {
+    if (first_summary_ == summary_.size()) {
+        return false;
+    }
+    size_t word = first_summary_ * WORD_BITS + countTrailingZeros(summary_[first_summary_]);
+    frame = word * WORD_BITS + countTrailingZeros(words_[word]);
+    return true;
+}
+
+bool FreeFrameBitmap::findFreeRun(size_t count, size_t& first) const {
+    if (count <= 1) {
+        return count == 1 && findFree(first);
+    }
+
+    if (count >= WORD_BITS) {
+        // Whole words: every word of the run must be fully free
+        size_t run_words = count / WORD_BITS;
+        for (size_t start = 0; start + run_words <= words_.size(); start += run_words) {
+            size_t word = start;
+            while (word < start + run_words && words_[word] == ~0ULL) {
+                word++;
+            }
+            if (word == start + run_words) {
+                first = start * WORD_BITS;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Within a word: after folding, bit p is set if frames p..p+count-1 are free
+    uint64_t aligned = 0;
+    for (size_t bit = 0; bit < WORD_BITS; bit += count) {
+        aligned |= 1ULL << bit;
+    }
+    for (size_t index = first_summary_; index < summary_.size(); index++) {
+        for (uint64_t pending = summary_[index]; pending != 0; pending &= pending - 1) {
+            size_t word = index * WORD_BITS + countTrailingZeros(pending);
+            uint64_t runs = words_[word];
+            for (size_t shift = 1; shift < count; shift <<= 1) {
+                runs &= runs >> shift;
+            }
+            runs &= aligned;
+            if (runs != 0) {
+                first = word * WORD_BITS + countTrailingZeros(runs);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void FreeFrameBitmap::allocate(size_t first, size_t count) {
+    for (size_t frame = first; frame < first + count; frame++) {
+        uint64_t bit = 1ULL << (frame % WORD_BITS);
+        uint64_t& word = words_[frame / WORD_BITS];
+        if (word & bit) {
+            word &= ~bit;
+            free_frames_--;
+        }
+        if (frame % WORD_BITS == WORD_BITS - 1 || frame + 1 == first + count) {
+            updateSummary(frame / WORD_BITS);
+        }
+    }
+}
+
+void FreeFrameBitmap::release(size_t first, size_t count) {
+    for (size_t frame = first; frame < first + count; frame++) {
+        uint64_t bit = 1ULL << (frame % WORD_BITS);
+        uint64_t& word = words_[frame / WORD_BITS];
+        if (!(word & bit)) {
+            word |= bit;
+            free_frames_++;
+        }
+        if (frame % WORD_BITS == WORD_BITS - 1 || frame + 1 == first + count) {
+            updateSummary(frame / WORD_BITS);
+        }
+    }
+}
+
+void FreeFrameBitmap::reset() {
+    first_summary_ = summary_.size();
+    for (size_t word = 0; word < words_.size(); word++) {
+        size_t frames = num_frames_ - word * WORD_BITS;
+        words_[word] = frames >= WORD_BITS ? ~0ULL : (1ULL << frames) - 1;
+        updateSummary(word);
+    }
+    free_frames_ = num_frames_;
+}
+
+// Private helper methods
+
+void FreeFrameBitmap::updateSummary(size_t word) {
+    size_t index = word / WORD_BITS;
+    uint64_t bit = 1ULL << (word % WORD_BITS);
+    if (words_[word] != 0) {
+        summary_[index] |= bit;
+        if (index < first_summary_) {
+            first_summary_ = index;
+        }
+        return;
+    }
+
+    summary_[index] &= ~bit;
+    while (first_summary_ < summary_.size() && summary_[first_summary_] == 0) {
+        first_summary_++;
+    }
+}
+
+} // namespace memsim
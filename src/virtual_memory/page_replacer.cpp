@@ -0,0 +1,514 @@
+#include "virtual_memory/page_replacer.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace memsim {
+
+// ===== ARC =====
+
+ArcReplacer::ArcReplacer(size_t capacity)
+    : capacity_(capacity), target_(0), pending_(0), pending_in_b2_(false) {}
+
+void ArcReplacer::onAccess(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end() && (found->second.list == T1 || found->second.list == T2)) {
+        moveTo(page_number, T2);   // Seen twice: frequency side
+    }
+}
+
+void ArcReplacer::onFault(uint64_t page_number) {
+    pending_ = page_number;
+    pending_in_b2_ = false;
+    auto found = entries_.find(page_number);
+    if (found == entries_.end()) {
+        return;
+    }
+
+    // A ghost hit shows which side evicted too early: grow the other side's loss
+    size_t b1 = lists_[B1].size();
+    size_t b2 = lists_[B2].size();
+    if (found->second.list == B1) {
+        size_t delta = std::max<size_t>(1, b2 / b1);
+        target_ = std::min(capacity_, target_ + delta);
+    } else if (found->second.list == B2) {
+        size_t delta = std::max<size_t>(1, b1 / b2);
+        target_ = target_ > delta ? target_ - delta : 0;
+        pending_in_b2_ = true;
+    }
+}
+
+bool ArcReplacer::selectVictim(uint64_t& page_number) {
+    size_t t1 = lists_[T1].size();
+    if (t1 == 0 && lists_[T2].empty()) {
+        return false;
+    }
+    bool from_t1 = t1 > 0 && (t1 > target_ || (pending_in_b2_ && t1 == target_) || lists_[T2].empty());
+    page_number = lists_[from_t1 ? T1 : T2].back();
+    return true;
+}
+
+void ArcReplacer::onEvict(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end()) {
+        return;
+    }
+    if (found->second.list == T1) {
+        moveTo(page_number, B1);
+    } else if (found->second.list == T2) {
+        moveTo(page_number, B2);
+    }
+    trimGhosts();
+}
+
+void ArcReplacer::insert(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end()) {
+        moveTo(page_number, T1);
+    } else if (found->second.list == B1 || found->second.list == B2) {
+        moveTo(page_number, T2);   // Back within the ghost window: reused
+    }
+    pending_in_b2_ = false;
+    trimGhosts();
+}
+
+void ArcReplacer::insertPrefetched(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end() || found->second.list == B1 || found->second.list == B2) {
+        moveTo(page_number, T1);   // Not a reuse: a ghost neither adapts p nor reaches T2
+        trimGhosts();
+    }
+}
+
+void ArcReplacer::remove(uint64_t page_number) {
+    erase(page_number);
+}
+
+void ArcReplacer::reset() {
+    for (auto& list : lists_) {
+        list.clear();
+    }
+    entries_.clear();
+    target_ = 0;
+    pending_in_b2_ = false;
+}
+
+std::string ArcReplacer::getStateString() const {
+    std::ostringstream oss;
+    oss << "ARC: T1 " << lists_[T1].size() << ", T2 " << lists_[T2].size()
+        << ", B1 " << lists_[B1].size() << ", B2 " << lists_[B2].size()
+        << " pages, T1 target " << target_;
+    return oss.str();
+}
+
+void ArcReplacer::moveTo(uint64_t page_number, List list) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end()) {
+        lists_[found->second.list].erase(found->second.position);
+    }
+    lists_[list].push_front(page_number);
+    entries_[page_number] = Entry{list, lists_[list].begin()};
+}
+
+void ArcReplacer::erase(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end()) {
+        lists_[found->second.list].erase(found->second.position);
+        entries_.erase(found);
+    }
+}
+
+void ArcReplacer::trimGhosts() {
+    // The directory tracks at most capacity pages in T1 + B1 and twice that overall
+    while (!lists_[B1].empty() && lists_[T1].size() + lists_[B1].size() > capacity_) {
+        erase(lists_[B1].back());
+    }
+    while (entries_.size() > 2 * capacity_ && !(lists_[B1].empty() && lists_[B2].empty())) {
+        erase(lists_[B2].empty() ? lists_[B1].back() : lists_[B2].back());
+    }
+}
+
+// ===== 2Q =====
+
+TwoQueueReplacer::TwoQueueReplacer(size_t capacity)
+    : in_limit_(std::max<size_t>(1, capacity / 4)),
+      out_limit_(std::max<size_t>(1, capacity / 2)) {}
+
+void TwoQueueReplacer::onAccess(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end() && found->second.list == AM) {
+        moveTo(page_number, AM);   // A1in stays FIFO: correlated re-references do not count
+    }
+}
+
+bool TwoQueueReplacer::selectVictim(uint64_t& page_number) {
+    if (!lists_[A1_IN].empty() && (lists_[A1_IN].size() > in_limit_ || lists_[AM].empty())) {
+        page_number = lists_[A1_IN].back();
+        return true;
+    }
+    if (lists_[AM].empty()) {
+        return false;
+    }
+    page_number = lists_[AM].back();
+    return true;
+}
+
+void TwoQueueReplacer::onEvict(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end()) {
+        return;
+    }
+    if (found->second.list == A1_IN) {
+        moveTo(page_number, A1_OUT);
+        while (lists_[A1_OUT].size() > out_limit_) {
+            erase(lists_[A1_OUT].back());
+        }
+    } else {
+        erase(page_number);
+    }
+}
+
+void TwoQueueReplacer::insert(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end()) {
+        moveTo(page_number, A1_IN);
+    } else if (found->second.list == A1_OUT) {
+        moveTo(page_number, AM);
+    }
+}
+
+void TwoQueueReplacer::insertPrefetched(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end() || found->second.list == A1_OUT) {
+        moveTo(page_number, A1_IN);
+    }
+}
+
+void TwoQueueReplacer::remove(uint64_t page_number) {
+    erase(page_number);
+}
+
+void TwoQueueReplacer::reset() {
+    for (auto& list : lists_) {
+        list.clear();
+    }
+    entries_.clear();
+}
+
+std::string TwoQueueReplacer::getStateString() const {
+    std::ostringstream oss;
+    oss << "2Q: A1in " << lists_[A1_IN].size() << " (limit " << in_limit_ << "), Am "
+        << lists_[AM].size() << ", A1out " << lists_[A1_OUT].size() << " (limit " << out_limit_ << ")";
+    return oss.str();
+}
+
+void TwoQueueReplacer::moveTo(uint64_t page_number, List list) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end()) {
+        lists_[found->second.list].erase(found->second.position);
+    }
+    lists_[list].push_front(page_number);
+    entries_[page_number] = Entry{list, lists_[list].begin()};
+}
+
+void TwoQueueReplacer::erase(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end()) {
+        lists_[found->second.list].erase(found->second.position);
+        entries_.erase(found);
+    }
+}
+
+// ===== LIRS =====
+
+LirsReplacer::LirsReplacer(size_t capacity)
+    : capacity_(capacity), lir_limit_(0), lir_count_(0) {
+    if (capacity < 2) {
+        throw std::invalid_argument("LIRS needs at least 2 frames");
+    }
+    // About 1% of the frames for resident HIR pages, at least one
+    lir_limit_ = capacity - std::max<size_t>(1, capacity / 100);
+}
+
+void LirsReplacer::onAccess(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end() || found->second.status == Status::NON_RESIDENT) {
+        return;
+    }
+    Entry& entry = found->second;
+
+    if (entry.status == Status::LIR) {
+        bool at_bottom = std::next(entry.stack_position) == stack_.end();
+        stack_.erase(entry.stack_position);
+        pushStack(page_number, entry);
+        if (at_bottom) {
+            prune();
+        }
+        return;
+    }
+
+    // Resident HIR page
+    if (entry.in_stack) {
+        // Reused within the LIR pages' recency: becomes LIR, the oldest LIR page steps down
+        stack_.erase(entry.stack_position);
+        queue_.erase(entry.queue_position);
+        entry.status = Status::LIR;
+        lir_count_++;
+        pushStack(page_number, entry);
+        if (lir_count_ > lir_limit_) {
+            demoteBottom();
+        }
+        prune();
+    } else {
+        pushStack(page_number, entry);
+        queue_.erase(entry.queue_position);
+        queue_.push_back(page_number);
+        entry.queue_position = std::prev(queue_.end());
+    }
+}
+
+bool LirsReplacer::selectVictim(uint64_t& page_number) {
+    if (!queue_.empty()) {
+        page_number = queue_.front();
+        return true;
+    }
+    if (stack_.empty()) {
+        return false;
+    }
+    page_number = stack_.back();   // No resident HIR page: the oldest LIR page
+    return true;
+}
+
+void LirsReplacer::onEvict(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end()) {
+        return;
+    }
+    Entry& entry = found->second;
+    if (entry.status != Status::HIR || !entry.in_stack) {
+        forget(page_number);
+        prune();
+        return;
+    }
+
+    // Keep it in S as non-resident, so a quick return is recognized
+    queue_.erase(entry.queue_position);
+    entry.status = Status::NON_RESIDENT;
+    ghosts_.push_back(page_number);
+    entry.queue_position = std::prev(ghosts_.end());
+    while (ghosts_.size() > capacity_) {
+        forget(ghosts_.front());
+    }
+}
+
+void LirsReplacer::insert(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end() && found->second.status != Status::NON_RESIDENT) {
+        return;   // Already resident
+    }
+
+    if (found != entries_.end()) {
+        // Faulted back while still in S: its reuse beat the oldest LIR page
+        Entry& entry = found->second;
+        ghosts_.erase(entry.queue_position);
+        stack_.erase(entry.stack_position);
+        entry.status = Status::LIR;
+        lir_count_++;
+        pushStack(page_number, entry);
+        if (lir_count_ > lir_limit_) {
+            demoteBottom();
+        }
+        prune();
+        return;
+    }
+
+    Entry& entry = entries_[page_number];
+    if (lir_count_ < lir_limit_) {
+        entry.status = Status::LIR;   // Warming up: the first pages fill the LIR set
+        lir_count_++;
+    } else {
+        entry.status = Status::HIR;
+        queue_.push_back(page_number);
+        entry.queue_position = std::prev(queue_.end());
+    }
+    pushStack(page_number, entry);
+}
+
+void LirsReplacer::insertPrefetched(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found != entries_.end() && found->second.status != Status::NON_RESIDENT) {
+        return;   // Already resident
+    }
+    forget(page_number);
+
+    // Resident HIR outside S: only an access puts it in S, where a second can make it LIR
+    Entry& entry = entries_[page_number];
+    entry.status = Status::HIR;
+    entry.in_stack = false;
+    queue_.push_back(page_number);
+    entry.queue_position = std::prev(queue_.end());
+}
+
+void LirsReplacer::remove(uint64_t page_number) {
+    forget(page_number);
+    prune();
+}
+
+void LirsReplacer::reset() {
+    stack_.clear();
+    queue_.clear();
+    ghosts_.clear();
+    entries_.clear();
+    lir_count_ = 0;
+}
+
+std::string LirsReplacer::getStateString() const {
+    std::ostringstream oss;
+    oss << "LIRS: " << lir_count_ << " LIR (limit " << lir_limit_ << "), " << queue_.size()
+        << " resident HIR, " << ghosts_.size() << " non-resident HIR, stack " << stack_.size();
+    return oss.str();
+}
+
+void LirsReplacer::pushStack(uint64_t page_number, Entry& entry) {
+    stack_.push_front(page_number);
+    entry.stack_position = stack_.begin();
+    entry.in_stack = true;
+}
+
+void LirsReplacer::demoteBottom() {
+    uint64_t bottom = stack_.back();
+    Entry& entry = entries_[bottom];
+    stack_.pop_back();
+    entry.in_stack = false;
+    entry.status = Status::HIR;
+    lir_count_--;
+    queue_.push_back(bottom);
+    entry.queue_position = std::prev(queue_.end());
+}
+
+void LirsReplacer::prune() {
+    while (!stack_.empty()) {
+        uint64_t bottom = stack_.back();
+        Entry& entry = entries_[bottom];
+        if (entry.status == Status::LIR) {
+            break;
+        }
+        stack_.pop_back();
+        entry.in_stack = false;
+        if (entry.status == Status::NON_RESIDENT) {
+            forget(bottom);
+        }
+    }
+}
+
+void LirsReplacer::forget(uint64_t page_number) {
+    auto found = entries_.find(page_number);
+    if (found == entries_.end()) {
+        return;
+    }
+    Entry& entry = found->second;
+    if (entry.in_stack) {
+        stack_.erase(entry.stack_position);
+    }
+    switch (entry.status) {
+        case Status::LIR: lir_count_--; break;
+        case Status::HIR: queue_.erase(entry.queue_position); break;
+        case Status::NON_RESIDENT: ghosts_.erase(entry.queue_position); break;
+    }
+    entries_.erase(found);
+}
+
+// ===== OPT =====
+
+void OptimalReplacer::setFuture(const std::vector<uint64_t>& pages) {
+    uses_.clear();
+    for (uint64_t position = 0; position < pages.size(); position++) {
+        uses_[pages[position]].push_back(position);
+    }
+    length_ = pages.size();
+    position_ = 0;
+
+    // Re-key the resident pages against the new sequence
+    by_next_use_.clear();
+    for (auto& resident : next_use_) {
+        resident.second = nextUse(resident.first, position_);
+        by_next_use_.insert({resident.second, resident.first});
+    }
+}
+
+uint64_t OptimalReplacer::nextUse(uint64_t page_number, uint64_t from) const {
+    auto found = uses_.find(page_number);
+    if (found == uses_.end()) {
+        return NEVER;
+    }
+    auto next = std::lower_bound(found->second.begin(), found->second.end(), from);
+    return next == found->second.end() ? NEVER : *next;
+}
+
+void OptimalReplacer::onAccess(uint64_t page_number) {
+    position_++;
+    auto found = next_use_.find(page_number);
+    if (found != next_use_.end()) {
+        by_next_use_.erase({found->second, page_number});
+        found->second = nextUse(page_number, position_);
+        by_next_use_.insert({found->second, page_number});
+    }
+}
+
+bool OptimalReplacer::selectVictim(uint64_t& page_number) {
+    if (by_next_use_.empty()) {
+        return false;
+    }
+    page_number = by_next_use_.rbegin()->second;   // Used furthest in the future
+    return true;
+}
+
+void OptimalReplacer::insert(uint64_t page_number) {
+    if (next_use_.count(page_number) > 0) {
+        return;
+    }
+    uint64_t next = nextUse(page_number, position_);
+    next_use_[page_number] = next;
+    by_next_use_.insert({next, page_number});
+}
+
+void OptimalReplacer::remove(uint64_t page_number) {
+    auto found = next_use_.find(page_number);
+    if (found != next_use_.end()) {
+        by_next_use_.erase({found->second, page_number});
+        next_use_.erase(found);
+    }
+}
+
+void OptimalReplacer::reset() {
+    by_next_use_.clear();
+    next_use_.clear();
+}
+
+std::string OptimalReplacer::getStateString() const {
+    std::ostringstream oss;
+    oss << "OPT: " << next_use_.size() << " resident pages, position " << position_
+        << " of " << length_ << " future accesses";
+    return oss.str();
+}
+
+// ===== Factory =====
+
+std::unique_ptr<IPageReplacer> createPageReplacer(PageReplacementPolicy policy, size_t capacity) {
+    switch (policy) {
+        case PageReplacementPolicy::ARC: return std::make_unique<ArcReplacer>(capacity);
+        case PageReplacementPolicy::TWO_Q: return std::make_unique<TwoQueueReplacer>(capacity);
+        case PageReplacementPolicy::LIRS: return std::make_unique<LirsReplacer>(capacity);
+        case PageReplacementPolicy::OPTIMAL: return std::make_unique<OptimalReplacer>();
+        case PageReplacementPolicy::FIFO:
+        case PageReplacementPolicy::LRU:
+        case PageReplacementPolicy::CLOCK:
+        case PageReplacementPolicy::CLOCK_PRO:
+        case PageReplacementPolicy::WSCLOCK:
+        case PageReplacementPolicy::TWO_HANDED_CLOCK:
+            return nullptr;
+    }
+    return nullptr;
+}
+
+} // namespace memsim
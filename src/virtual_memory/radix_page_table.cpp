@@ -0,0 +1,200 @@
+#include "virtual_memory/radix_page_table.h"
+#include <stdexcept>
+
+namespace memsim {
+
+RadixPageTable::RadixPageTable(size_t page_number_bits, size_t levels)
+    : num_nodes_(0),
+      table_bytes_(0),
+      next_offset_(0) {
+
+    if (levels < MIN_LEVELS || levels > MAX_LEVELS) {
+        throw std::invalid_argument("Page table levels must be between 2 and 5");
+    }
+    if (page_number_bits > 64) {
+        throw std::invalid_argument("Page number cannot exceed 64 bits");
+    }
+
+    // Spread the bits evenly; the lowest levels absorb the remainder
+    bits_.assign(levels, page_number_bits / levels);
+    for (size_t i = 0; i < page_number_bits % levels; i++) {
+        bits_[levels - 1 - i]++;
+    }
+    shifts_.assign(levels, 0);
+    for (size_t level = levels - 1; level-- > 0;) {
+        shifts_[level] = shifts_[level + 1] + bits_[level + 1];
+    }
+
+    clear();
+}
+
+PageTableEntry* RadixPageTable::find(uint64_t page_number) {
+    Node* node = root_.get();
+    for (size_t level = 0; level + 1 < bits_.size(); level++) {
+        size_t index = indexAt(page_number, level);
+        if (hasHugeEntry(*node, index)) {
+            return &node->entries[index];
+        }
+        node = node->children[index].get();
+        if (!node) {
+            return nullptr;
+        }
+    }
+    return &node->entries[indexAt(page_number, bits_.size() - 1)];
+}
+
+const PageTableEntry* RadixPageTable::find(uint64_t page_number) const {
+    return const_cast<RadixPageTable*>(this)->find(page_number);
+}
+
+PageTableEntry& RadixPageTable::insert(uint64_t page_number) {
+    return insert(page_number, bits_.size() - 1);
+}
+
+PageTableEntry& RadixPageTable::insert(uint64_t page_number, size_t level) {
+    Node* node = root_.get();
+    for (size_t l = 0; l < level; l++) {
+        auto& child = node->children[indexAt(page_number, l)];
+        if (!child) {
+            child = makeNode(l + 1);
+        }
+        node = child.get();
+    }
+    if (node->entries.empty()) {
+        node->entries.resize(static_cast<size_t>(1) << bits_[level]);
+    }
+    return node->entries[indexAt(page_number, level)];
+}
+
+void RadixPageTable::collapse(uint64_t page_number, size_t level) {
+    Node* node = root_.get();
+    for (size_t l = 0; l < level; l++) {
+        node = node->children[indexAt(page_number, l)].get();
+        if (!node) {
+            return;
+        }
+    }
+    auto& child = node->children[indexAt(page_number, level)];
+    if (child) {
+        releaseNode(*child, level + 1);
+        child.reset();
+    }
+}
+
+size_t RadixPageTable::walk(uint64_t page_number, std::vector<uint64_t>& entry_offsets) const {
+    entry_offsets.clear();
+    const Node* node = root_.get();
+    for (size_t level = 0; level < bits_.size(); level++) {
+        size_t index = indexAt(page_number, level);
+        entry_offsets.push_back(node->offset + index * PTE_BYTES);
+        if (level + 1 == bits_.size() || hasHugeEntry(*node, index)) {
+            break;
+        }
+        node = node->children[index].get();
+        if (!node) {
+            break;   // Non-present entry: the walk ends in a fault
+        }
+    }
+    return entry_offsets.size();
+}
+
+void RadixPageTable::forEachValid(const std::function<void(uint64_t, PageTableEntry&)>& visit) {
+    visitNode(*root_, 0, 0, visit);
+}
+
+void RadixPageTable::forEachValid(const std::function<void(uint64_t, const PageTableEntry&)>& visit) const {
+    const_cast<RadixPageTable*>(this)->visitNode(*root_, 0, 0,
+        [&visit](uint64_t page_number, PageTableEntry& pte) { visit(page_number, pte); });
+}
+
+bool RadixPageTable::nextValid(uint64_t from, uint64_t& page_number) const {
+    return searchNode(*root_, 0, 0, from, page_number);
+}
+
+void RadixPageTable::clear() {
+    num_nodes_ = 0;
+    table_bytes_ = 0;
+    next_offset_ = 0;
+    root_ = makeNode(0);
+}
+
+// Private helper methods
+
+std::unique_ptr<RadixPageTable::Node> RadixPageTable::makeNode(size_t level) {
+    auto node = std::make_unique<Node>();
+    size_t fanout = static_cast<size_t>(1) << bits_[level];
+    node->offset = next_offset_;
+    if (level + 1 == bits_.size()) {
+        node->entries.resize(fanout);
+    } else {
+        node->children.resize(fanout);
+    }
+    num_nodes_++;
+    table_bytes_ += fanout * PTE_BYTES;
+    next_offset_ += fanout * PTE_BYTES;
+    return node;
+}
+
+void RadixPageTable::releaseNode(const Node& node, size_t level) {
+    for (const auto& child : node.children) {
+        if (child) {
+            releaseNode(*child, level + 1);
+        }
+    }
+    num_nodes_--;
+    table_bytes_ -= (static_cast<uint64_t>(1) << bits_[level]) * PTE_BYTES;
+}
+
+void RadixPageTable::visitNode(Node& node, size_t level, uint64_t base,
+                               const std::function<void(uint64_t, PageTableEntry&)>& visit) {
+    if (level + 1 == bits_.size()) {
+        for (size_t i = 0; i < node.entries.size(); i++) {
+            if (node.entries[i].valid) {
+                visit(base | i, node.entries[i]);
+            }
+        }
+        return;
+    }
+    for (size_t i = 0; i < node.children.size(); i++) {
+        uint64_t start = base | (static_cast<uint64_t>(i) << shifts_[level]);
+        if (hasHugeEntry(node, i)) {
+            visit(start, node.entries[i]);
+        } else if (node.children[i]) {
+            visitNode(*node.children[i], level + 1, start, visit);
+        }
+    }
+}
+
+bool RadixPageTable::searchNode(const Node& node, size_t level, uint64_t base, uint64_t from,
+                                uint64_t& page_number) const {
+    uint64_t span_mask = shifts_[level] >= 64 ? ~0ULL : (1ULL << shifts_[level]) - 1;
+    if (level + 1 == bits_.size()) {
+        for (size_t i = 0; i < node.entries.size(); i++) {
+            uint64_t page = base | i;
+            if (page >= from && node.entries[i].valid) {
+                page_number = page;
+                return true;
+            }
+        }
+        return false;
+    }
+    for (size_t i = 0; i < node.children.size(); i++) {
+        uint64_t start = base | (static_cast<uint64_t>(i) << shifts_[level]);
+        if (hasHugeEntry(node, i)) {
+            if (start >= from) {
+                page_number = start;
+                return true;
+            }
+            continue;   // Starts before from
+        }
+        if (!node.children[i] || (start | span_mask) < from) {
+            continue;   // Empty, or every page below it precedes from
+        }
+        if (searchNode(*node.children[i], level + 1, start, from, page_number)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace memsim
@@ -0,0 +1,327 @@
+#include "virtual_memory/swap_device.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace memsim {
+
+namespace {
+
+uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+SwapDevice::~SwapDevice() {
+    close();
+}
+
+Result<void> SwapDevice::open(const std::string& path, size_t page_size) {
+    if (page_size == 0) {
+        return Result<void>::Err("Swap page size must be positive");
+    }
+    close();
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd_ < 0) {
+        return Result<void>::Err("Cannot open swap file " + path + ": " + std::strerror(errno));
+    }
+    path_ = path;
+    page_size_ = page_size;
+    stats_ = SwapStats();
+    return Result<void>::Ok();
+}
+
+void SwapDevice::close() {
+    if (engine_) {
+        sync();
+        engine_.reset();   // Joins the workers before the descriptor goes away
+    }
+    writes_.clear();
+    prefetched_.clear();
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    slots_.clear();
+    free_slots_.clear();
+    next_slot_ = 0;
+}
+
+Result<void> SwapDevice::setAsync(size_t num_threads, size_t batch_size) {
+    if (fd_ < 0) {
+        return Result<void>::Err("Swap file not open");
+    }
+    if (batch_size == 0) {
+        return Result<void>::Err("Swap batch size must be positive");
+    }
+    if (engine_) {
+        sync();
+        engine_.reset();
+        prefetched_.clear();
+    }
+    if (num_threads > 0) {
+        engine_ = std::make_unique<SwapIoEngine>(fd_, num_threads);
+        engine_->setDelay(delay_);
+    }
+    batch_size_ = batch_size;
+    return Result<void>::Ok();
+}
+
+void SwapDevice::setDeviceDelay(uint64_t microseconds) {
+    delay_ = std::chrono::microseconds(microseconds);
+    if (engine_) {
+        engine_->setDelay(delay_);
+    }
+}
+
+Result<void> SwapDevice::writePage(uint64_t page_number, const uint8_t* data) {
+    if (fd_ < 0) {
+        return Result<void>::Err("Swap file not open");
+    }
+
+    if (!engine_) {
+        uint64_t slot = allocateSlot(page_number);
+        auto start = std::chrono::steady_clock::now();
+        int error = SwapIoEngine::transfer(fd_, true, const_cast<uint8_t*>(data), page_size_,
+                                           slot * page_size_, delay_);
+        uint64_t elapsed = nanosecondsSince(start);
+        recordLatency(elapsed);
+        stats_.wait_ns += elapsed;
+        if (error != 0) {
+            stats_.errors++;
+            return Result<void>::Err("Swap write failed: " + std::string(std::strerror(error)));
+        }
+        stats_.writes++;
+        stats_.bytes_written += page_size_;
+        return Result<void>::Ok();
+    }
+
+    reap();
+    prefetched_.erase(page_number);   // The page's contents are about to change
+    auto pending = writes_.find(page_number);
+    if (pending != writes_.end()) {
+        if (!pending->second->submitted) {
+            // Still gathering: the newer contents replace the queued copy
+            std::copy(data, data + page_size_, pending->second->data.begin());
+            return Result<void>::Ok();
+        }
+        waitFor(pending->second);   // Keep writes to the slot in order
+        reap();
+    }
+
+    auto request = std::make_shared<SwapRequest>(true, page_number, allocateSlot(page_number), page_size_);
+    std::copy(data, data + page_size_, request->data.begin());
+    writes_[page_number] = request;
+    batch_.push_back(request);
+    if (batch_.size() >= batch_size_) {
+        submitBatch();
+    }
+    return Result<void>::Ok();
+}
+
+Result<bool> SwapDevice::readPage(uint64_t page_number, uint8_t* data) {
+    if (fd_ < 0) {
+        return Result<bool>::Ok(false);
+    }
+
+    if (engine_) {
+        reap();
+        auto pending = writes_.find(page_number);
+        if (pending != writes_.end()) {
+            // Only the engine's read of the copy can overlap this one
+            std::copy(pending->second->data.begin(), pending->second->data.end(), data);
+            stats_.buffer_hits++;
+            return Result<bool>::Ok(true);
+        }
+
+        auto issued = prefetched_.find(page_number);
+        if (issued != prefetched_.end()) {
+            Request request = issued->second;
+            prefetched_.erase(issued);
+            waitFor(request);
+            reap();
+            if (request->error != 0) {
+                return Result<bool>::Err("Swap read failed: " + std::string(std::strerror(request->error)));
+            }
+            std::copy(request->data.begin(), request->data.end(), data);
+            stats_.prefetch_hits++;
+            return Result<bool>::Ok(true);
+        }
+    }
+
+    auto found = slots_.find(page_number);
+    if (found == slots_.end()) {
+        return Result<bool>::Ok(false);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int error = SwapIoEngine::transfer(fd_, false, data, page_size_, found->second * page_size_, delay_);
+    uint64_t elapsed = nanosecondsSince(start);
+    recordLatency(elapsed);
+    stats_.wait_ns += elapsed;
+    if (error != 0) {
+        stats_.errors++;
+        return Result<bool>::Err("Swap read failed: " + std::string(std::strerror(error)));
+    }
+    stats_.reads++;
+    stats_.bytes_read += page_size_;
+    return Result<bool>::Ok(true);
+}
+
+bool SwapDevice::prefetch(uint64_t page_number) {
+    auto found = slots_.find(page_number);
+    if (!engine_ || found == slots_.end() || writes_.count(page_number) ||
+        prefetched_.count(page_number)) {
+        return false;
+    }
+
+    // Make room by dropping finished reads nobody asked for
+    if (prefetched_.size() >= MAX_PREFETCHES) {
+        reap();
+        for (auto it = prefetched_.begin(); it != prefetched_.end();) {
+            it = engine_->isDone(it->second) ? prefetched_.erase(it) : std::next(it);
+        }
+        if (prefetched_.size() >= MAX_PREFETCHES) {
+            return false;
+        }
+    }
+
+    auto request = std::make_shared<SwapRequest>(false, page_number, found->second, page_size_);
+    prefetched_[page_number] = request;
+    recordDepth(engine_->submit({request}));
+    stats_.prefetches++;
+    return true;
+}
+
+void SwapDevice::sync() {
+    if (!engine_) {
+        return;
+    }
+    submitBatch();
+    auto start = std::chrono::steady_clock::now();
+    engine_->drain();
+    stats_.wait_ns += nanosecondsSince(start);
+    reap();
+}
+
+void SwapDevice::release(uint64_t page_number) {
+    auto pending = writes_.find(page_number);
+    if (pending != writes_.end()) {
+        Request request = pending->second;
+        if (request->submitted) {
+            waitFor(request);   // The slot may be reused as soon as it is free
+        } else {
+            batch_.erase(std::find(batch_.begin(), batch_.end(), request));
+        }
+        writes_.erase(page_number);
+    }
+    prefetched_.erase(page_number);
+
+    auto found = slots_.find(page_number);
+    if (found != slots_.end()) {
+        free_slots_.push_back(found->second);
+        slots_.erase(found);
+    }
+}
+
+void SwapDevice::releaseAll() {
+    sync();
+    writes_.clear();
+    prefetched_.clear();
+    slots_.clear();
+    free_slots_.clear();
+    next_slot_ = 0;
+    if (fd_ >= 0 && ::ftruncate(fd_, 0) != 0) {
+        stats_.errors++;
+    }
+}
+
+// Private helper methods
+
+uint64_t SwapDevice::allocateSlot(uint64_t page_number) {
+    auto found = slots_.find(page_number);
+    if (found != slots_.end()) {
+        return found->second;
+    }
+
+    uint64_t slot = 0;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = next_slot_++;
+    }
+    slots_[page_number] = slot;
+    stats_.peak_slots = std::max<uint64_t>(stats_.peak_slots, slots_.size());
+    return slot;
+}
+
+void SwapDevice::submitBatch() {
+    if (batch_.empty()) {
+        return;
+    }
+    recordDepth(engine_->submit(batch_));
+    stats_.batches++;
+    batch_.clear();
+}
+
+void SwapDevice::recordDepth(size_t depth) {
+    stats_.submissions++;
+    stats_.total_queue_depth += depth;
+    stats_.max_queue_depth = std::max<uint64_t>(stats_.max_queue_depth, depth);
+}
+
+void SwapDevice::recordLatency(uint64_t latency_ns) {
+    stats_.completed++;
+    stats_.total_latency_ns += latency_ns;
+    stats_.max_latency_ns = std::max(stats_.max_latency_ns, latency_ns);
+}
+
+void SwapDevice::reap() {
+    engine_->collect(completed_);
+    for (const Request& request : completed_) {
+        recordLatency(request->latency_ns);
+        if (!request->is_write) {
+            if (request->error != 0) {
+                stats_.errors++;
+            } else {
+                stats_.reads++;
+                stats_.bytes_read += page_size_;
+            }
+            continue;
+        }
+
+        auto pending = writes_.find(request->page_number);
+        bool latest = pending != writes_.end() && pending->second == request;
+        if (latest) {
+            writes_.erase(pending);
+        }
+        if (request->error == 0) {
+            stats_.writes++;
+            stats_.bytes_written += page_size_;
+            continue;
+        }
+
+        // The slot holds no valid copy: the page falls back to a fresh load
+        stats_.errors++;
+        auto found = slots_.find(request->page_number);
+        if (latest && found != slots_.end()) {
+            free_slots_.push_back(found->second);
+            slots_.erase(found);
+        }
+    }
+    completed_.clear();
+}
+
+void SwapDevice::waitFor(const Request& request) {
+    auto start = std::chrono::steady_clock::now();
+    engine_->wait(request);
+    stats_.wait_ns += nanosecondsSince(start);
+}
+
+} // namespace memsim
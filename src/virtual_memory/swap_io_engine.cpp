@@ -0,0 +1,140 @@
+#include "virtual_memory/swap_io_engine.h"
+#include <cerrno>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace memsim {
+
+SwapIoEngine::SwapIoEngine(int fd, size_t num_threads)
+    : fd_(fd), in_flight_(0), waiters_(0), delay_(0), stopping_(false) {
+    if (num_threads == 0) {
+        throw std::invalid_argument("Swap I/O needs at least one thread");
+    }
+    for (size_t i = 0; i < num_threads; i++) {
+        workers_.emplace_back(&SwapIoEngine::run, this);
+    }
+}
+
+SwapIoEngine::~SwapIoEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t SwapIoEngine::submit(const std::vector<std::shared_ptr<SwapRequest>>& batch) {
+    size_t depth = 0;
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& request : batch) {
+            request->submitted = true;
+            request->submitted_at = now;
+            queue_.push_back(request);
+        }
+        in_flight_ += batch.size();
+        depth = in_flight_;
+    }
+    if (batch.size() == 1) {
+        work_ready_.notify_one();
+    } else {
+        work_ready_.notify_all();
+    }
+    return depth;
+}
+
+void SwapIoEngine::wait(const std::shared_ptr<SwapRequest>& request) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiters_++;
+    work_done_.wait(lock, [&request]() { return request->done; });
+    waiters_--;
+}
+
+void SwapIoEngine::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiters_++;
+    work_done_.wait(lock, [this]() { return in_flight_ == 0; });
+    waiters_--;
+}
+
+bool SwapIoEngine::isDone(const std::shared_ptr<SwapRequest>& request) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return request->done;
+}
+
+void SwapIoEngine::collect(std::vector<std::shared_ptr<SwapRequest>>& completed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed.insert(completed.end(), completed_.begin(), completed_.end());
+    completed_.clear();
+}
+
+size_t SwapIoEngine::getInFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+void SwapIoEngine::setDelay(std::chrono::microseconds delay) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    delay_ = delay;
+}
+
+int SwapIoEngine::transfer(int fd, bool is_write, uint8_t* data, size_t size, uint64_t offset,
+                           std::chrono::microseconds delay) {
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+    size_t done = 0;
+    while (done < size) {
+        ssize_t moved = is_write
+            ? ::pwrite(fd, data + done, size - done, static_cast<off_t>(offset + done))
+            : ::pread(fd, data + done, size - done, static_cast<off_t>(offset + done));
+        if (moved < 0 && errno == EINTR) {
+            continue;
+        }
+        if (moved < 0) {
+            return errno;
+        }
+        if (moved == 0) {
+            return EIO;   // Read past the end of the file
+        }
+        done += static_cast<size_t>(moved);
+    }
+    return 0;
+}
+
+// Private helper methods
+
+void SwapIoEngine::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_ready_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;   // Stopping with nothing left to do
+        }
+        std::shared_ptr<SwapRequest> request = queue_.front();
+        queue_.pop_front();
+        std::chrono::microseconds delay = delay_;
+        lock.unlock();
+
+        int error = transfer(fd_, request->is_write, request->data.data(), request->data.size(),
+                             request->slot * request->data.size(), delay);
+        uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - request->submitted_at).count());
+
+        lock.lock();
+        request->error = error;
+        request->latency_ns = elapsed;
+        request->done = true;
+        completed_.push_back(request);
+        in_flight_--;
+        if (waiters_ > 0) {
+            work_done_.notify_all();
+        }
+    }
+}
+
+} // namespace memsim
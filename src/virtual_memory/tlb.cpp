@@ -0,0 +1,204 @@
+#include "virtual_memory/tlb.h"
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace memsim {
+
+TLB::TLB(const std::string& name, const TLBConfig& config)
+    : name_(name),
+      config_(config),
+      clock_(0),
+      random_state_(0x9E3779B97F4A7C15ull) {
+
+    if (config.sets == 0 || (config.sets & (config.sets - 1)) != 0) {
+        throw std::invalid_argument(name + " sets must be a power of 2");
+    }
+    if (config.associativity == 0) {
+        throw std::invalid_argument(name + " associativity must be > 0");
+    }
+    entries_.resize(config.sets * config.associativity);
+}
+
+bool TLB::lookup(uint64_t page_number, Address& frame_number) {
+    stats_.accesses++;
+    clock_++;
+
+    size_t index = find(page_number);
+    if (index == entries_.size()) {
+        stats_.misses++;
+        return false;
+    }
+
+    stats_.hits++;
+    entries_[index].last_used = clock_;
+    frame_number = entries_[index].frame_number;
+    return true;
+}
+
+void TLB::insert(uint64_t page_number, Address frame_number) {
+    clock_++;
+
+    size_t index = find(page_number);
+    if (index == entries_.size()) {
+        size_t set = static_cast<size_t>(page_number & (config_.sets - 1));
+        index = selectVictim(set);
+        if (entries_[index].valid) {
+            stats_.evictions++;
+        }
+        entries_[index].valid = true;
+        entries_[index].page_number = page_number;
+        entries_[index].inserted = clock_;
+    }
+    entries_[index].frame_number = frame_number;
+    entries_[index].last_used = clock_;
+}
+
+bool TLB::invalidate(uint64_t page_number) {
+    size_t index = find(page_number);
+    if (index == entries_.size()) {
+        return false;
+    }
+    entries_[index] = Entry();
+    stats_.invalidations++;
+    return true;
+}
+
+void TLB::flush() {
+    for (auto& entry : entries_) {
+        entry = Entry();
+    }
+}
+
+bool TLB::contains(uint64_t page_number) const {
+    return find(page_number) != entries_.size();
+}
+
+std::string TLB::getStatsString() const {
+    std::ostringstream oss;
+    oss << "=== " << name_ << " Statistics ===\n";
+    oss << "Configuration: " << getConfigString() << "\n";
+    oss << "Hits: " << stats_.hits << "\n";
+    oss << "Misses: " << stats_.misses << "\n";
+    oss << "Total Accesses: " << stats_.accesses << "\n";
+    oss << "Hit Ratio: " << std::fixed << std::setprecision(2)
+        << stats_.getHitRatio() << "%\n";
+    oss << "Evictions: " << stats_.evictions << "\n";
+    oss << "Shootdown Invalidations: " << stats_.invalidations << "\n";
+    return oss.str();
+}
+
+std::string TLB::getConfigString() const {
+    std::ostringstream oss;
+    oss << entries_.size() << " entries (" << config_.sets << " sets, "
+        << config_.associativity << "-way), " << tlbPolicyToString(config_.policy)
+        << ", " << config_.hit_cycles << " cycles";
+    return oss.str();
+}
+
+// Private helper methods
+
+size_t TLB::find(uint64_t page_number) const {
+    size_t set = static_cast<size_t>(page_number & (config_.sets - 1));
+    size_t base = set * config_.associativity;
+    for (size_t way = 0; way < config_.associativity; way++) {
+        const Entry& entry = entries_[base + way];
+        if (entry.valid && entry.page_number == page_number) {
+            return base + way;
+        }
+    }
+    return entries_.size();
+}
+
+size_t TLB::selectVictim(size_t set) {
+    size_t base = set * config_.associativity;
+    for (size_t way = 0; way < config_.associativity; way++) {
+        if (!entries_[base + way].valid) {
+            return base + way;
+        }
+    }
+
+    switch (config_.policy) {
+        case TLBPolicy::LRU:
+        case TLBPolicy::FIFO: {
+            size_t victim = base;
+            for (size_t way = 1; way < config_.associativity; way++) {
+                const Entry& entry = entries_[base + way];
+                const Entry& best = entries_[victim];
+                bool older = config_.policy == TLBPolicy::LRU ? entry.last_used < best.last_used
+                                                             : entry.inserted < best.inserted;
+                if (older) {
+                    victim = base + way;
+                }
+            }
+            return victim;
+        }
+
+        case TLBPolicy::RANDOM: {
+            random_state_ ^= random_state_ << 13;
+            random_state_ ^= random_state_ >> 7;
+            random_state_ ^= random_state_ << 17;
+            return base + static_cast<size_t>(random_state_ % config_.associativity);
+        }
+
+        default:
+            return base;
+    }
+}
+
+TLBHierarchy::TLBHierarchy(const TLBConfig& dtlb, const TLBConfig& stlb, uint64_t walk_cycles)
+    : dtlb_("dTLB", dtlb),
+      stlb_("STLB", stlb),
+      walk_cycles_(walk_cycles),
+      shootdowns_(0) {}
+
+TLBOutcome TLBHierarchy::lookup(uint64_t page_number, Address& frame_number) {
+    if (dtlb_.lookup(page_number, frame_number)) {
+        return TLBOutcome::DTLB_HIT;
+    }
+    if (stlb_.lookup(page_number, frame_number)) {
+        dtlb_.insert(page_number, frame_number);
+        return TLBOutcome::STLB_HIT;
+    }
+    return TLBOutcome::MISS;
+}
+
+void TLBHierarchy::fill(uint64_t page_number, Address frame_number) {
+    stlb_.insert(page_number, frame_number);
+    dtlb_.insert(page_number, frame_number);
+}
+
+void TLBHierarchy::shootdown(uint64_t page_number) {
+    shootdowns_++;
+    dtlb_.invalidate(page_number);
+    stlb_.invalidate(page_number);
+}
+
+void TLBHierarchy::flush() {
+    dtlb_.flush();
+    stlb_.flush();
+}
+
+uint64_t TLBHierarchy::getCycles(TLBOutcome outcome) const {
+    switch (outcome) {
+        case TLBOutcome::DTLB_HIT:
+            return dtlb_.getConfig().hit_cycles;
+        case TLBOutcome::STLB_HIT:
+            return dtlb_.getConfig().hit_cycles + stlb_.getConfig().hit_cycles;
+        case TLBOutcome::MISS:
+            return dtlb_.getConfig().hit_cycles + stlb_.getConfig().hit_cycles + walk_cycles_;
+        default:
+            return 0;
+    }
+}
+
+std::string TLBHierarchy::getStatsString() const {
+    std::ostringstream oss;
+    oss << dtlb_.getStatsString() << "\n";
+    oss << stlb_.getStatsString() << "\n";
+    oss << "Page Walks: " << stlb_.getStats().misses << " (" << walk_cycles_ << " cycles each)\n";
+    oss << "Shootdowns: " << shootdowns_ << "\n";
+    return oss.str();
+}
+
+} // namespace memsim
@@ -1,4 +1,5 @@
 #include "virtual_memory/virtual_memory.h"
+#include "cache/cache_hierarchy.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -11,14 +12,33 @@ VirtualMemory::VirtualMemory(PhysicalMemory* memory,
                              size_t num_virtual_pages,
                              size_t num_physical_frames,
                              size_t page_size,
-                             PageReplacementPolicy policy)
+                             PageReplacementPolicy policy,
+                             size_t page_table_levels)
     : memory_(memory),
       num_virtual_pages_(num_virtual_pages),
       num_physical_frames_(num_physical_frames),
       page_size_(page_size),
       policy_(policy),
+      page_table_(calculateBits(num_virtual_pages > 0 ? num_virtual_pages - 1 : 0), page_table_levels),
+      free_frames_(num_physical_frames),
+      fifo_stamp_(0),
       clock_hand_(0),
-      global_time_(0) {
+      front_hand_(0),
+      hand_spread_(0),
+      working_set_window_(0),
+      lru_head_(nullptr),
+      lru_tail_(nullptr),
+      global_time_(0),
+      page_load_cycles_(0),
+      writeback_cycles_(0),
+      readahead_max_(0),
+      readahead_limit_(0),
+      fault_around_(0),
+      streams_(READAHEAD_STREAMS, ReadaheadStream{NO_PAGE, NO_PAGE, 0, 0}),
+      thp_size_(PageSize::BASE),
+      walk_memory_(nullptr),
+      walk_table_base_(0),
+      walk_table_span_(0) {
 
     // Validate parameters
     if (!isPowerOfTwo(page_size)) {
@@ -47,11 +67,17 @@ VirtualMemory::VirtualMemory(PhysicalMemory* memory,
     offset_bits_ = calculateBits(page_size - 1);
     page_number_bits_ = calculateBits(num_virtual_pages - 1);
 
-    // Initialize page table
-    page_table_.resize(num_virtual_pages);
-
-    // Initialize frame allocation tracker
-    frame_allocated_.resize(num_physical_frames, false);
+    // Initialize the frame table and the clock parameters
+    frame_table_.assign(num_physical_frames, nullptr);
+    stats_.free_frames = num_physical_frames;
+    stats_.min_free_frames = num_physical_frames;
+    hand_spread_ = num_physical_frames / 2;
+    front_hand_ = hand_spread_;
+    working_set_window_ = num_physical_frames;
+    if (policy == PageReplacementPolicy::CLOCK_PRO) {
+        clock_pro_ = std::make_unique<ClockPro>(num_physical_frames);
+    }
+    replacer_ = createPageReplacer(policy, num_physical_frames);
 }
 
 Result<Address> VirtualMemory::translate(Address virtual_addr) {
@@ -67,24 +93,68 @@ Result<Address> VirtualMemory::translate(Address virtual_addr) {
         return Result<Address>::Err("Invalid virtual address: page number out of range");
     }
 
-    auto& pte = page_table_[page_number];
+    if (tlb_) {
+        // A TLB hit skips the page table walk
+        Address frame_number = 0;
+        PageSize tlb_size = PageSize::BASE;
+        uint64_t key = probeTLBKey(page_number, tlb_size);
+        TLBOutcome outcome = tlb_->lookup(key, frame_number);
+        if (outcome == TLBOutcome::MISS && walk_memory_) {
+            // The walk is charged by its references instead of a fixed latency
+            stats_.translation_cycles += tlb_->getCycles(TLBOutcome::STLB_HIT);
+        } else {
+            stats_.translation_cycles += tlb_->getCycles(outcome);
+        }
+        if (outcome != TLBOutcome::MISS) {
+            if (outcome == TLBOutcome::DTLB_HIT) {
+                stats_.dtlb_hits++;
+            } else {
+                stats_.stlb_hits++;
+            }
+            stats_.page_hits++;
+            stats_.by_size[sizeIndex(tlb_size)].tlb_hits++;
+            recordAccess(*page_table_.find(page_number));
+            frame_number += page_number & (getPagesPerMapping(tlb_size) - 1);
+            return Result<Address>::Ok(constructPhysicalAddress(frame_number, offset));
+        }
+        stats_.page_walks++;
+    }
 
-    if (pte.valid) {
+    walkPageTable(page_number);
+    PageTableEntry* found = page_table_.find(page_number);
+    if (found && found->valid) {
+        auto& pte = *found;
         // Page hit
         stats_.page_hits++;
-        pte.recordAccess(global_time_);
+        recordAccess(pte);
+        if (tlb_) {
+            tlb_->fill(tlbKey(page_number, pte.size), pte.frame_number);
+            stats_.by_size[sizeIndex(pte.size)].tlb_misses++;
+        }
 
         // Construct physical address
-        Address physical_addr = constructPhysicalAddress(pte.frame_number, offset);
-        return Result<Address>::Ok(physical_addr);
+        Address frame_number = pte.frame_number + (page_number & (getPagesPerMapping(pte.size) - 1));
+        return Result<Address>::Ok(constructPhysicalAddress(frame_number, offset));
     }
 
     // Page fault - need to load page
     stats_.page_faults++;
+    if (swap_ && swap_->isAsync()) {
+        startFaultReads(page_number);
+    }
     auto frame_result = handlePageFault(page_number);
     if (!frame_result.success) {
         return Result<Address>::Err(frame_result.error_message);
     }
+    if (tlb_) {
+        const PageTableEntry& pte = *page_table_.find(page_number);
+        tlb_->fill(tlbKey(page_number, pte.size), pte.frame_number);
+        stats_.by_size[sizeIndex(pte.size)].tlb_misses++;
+    }
+    if ((readahead_max_ > 0 || fault_around_ > 1) &&
+        page_table_.find(page_number)->size == PageSize::BASE) {
+        prefetchAfterFault(page_number);
+    }
 
     // Construct physical address
     Address physical_addr = constructPhysicalAddress(frame_result.value, offset);
@@ -109,20 +179,341 @@ Result<void> VirtualMemory::write(Address virtual_addr, uint8_t data) {
     // Mark page as dirty
     size_t page_number, offset;
     parseAddress(virtual_addr, page_number, offset);
-    page_table_[page_number].dirty = true;
+    page_table_.find(page_number)->dirty = true;
 
     return memory_->write(translate_result.value, data);
 }
 
+Result<Address> VirtualMemory::peek(Address virtual_addr) const {
+    size_t page_number, offset;
+    parseAddress(virtual_addr, page_number, offset);
+    const PageTableEntry* pte = page_number < num_virtual_pages_ ? page_table_.find(page_number) : nullptr;
+    if (!pte || !pte->valid) {
+        return Result<Address>::Err("Page not resident");
+    }
+    Address frame_number = pte->frame_number + (page_number & (getPagesPerMapping(pte->size) - 1));
+    return Result<Address>::Ok(constructPhysicalAddress(frame_number, offset));
+}
+
+Result<PageSize> VirtualMemory::getPageSize(Address virtual_addr) const {
+    size_t page_number, offset;
+    parseAddress(virtual_addr, page_number, offset);
+    const PageTableEntry* pte = page_number < num_virtual_pages_ ? page_table_.find(page_number) : nullptr;
+    if (!pte || !pte->valid) {
+        return Result<PageSize>::Err("Page not resident");
+    }
+    return Result<PageSize>::Ok(pte->size);
+}
+
+Result<void> VirtualMemory::setTransparentHugePages(PageSize max_size) {
+    if (max_size != PageSize::BASE) {
+        auto supported = checkPageSize(max_size);
+        if (!supported.success) {
+            return supported;
+        }
+    }
+    thp_size_ = max_size;
+    return Result<void>::Ok();
+}
+
+Result<void> VirtualMemory::promote(Address virtual_addr, PageSize size) {
+    size_t page_number, offset;
+    parseAddress(virtual_addr, page_number, offset);
+    if (page_number >= num_virtual_pages_) {
+        return Result<void>::Err("Invalid virtual address: page number out of range");
+    }
+    if (size == PageSize::BASE) {
+        return Result<void>::Err("Promotion needs a huge page size");
+    }
+    auto supported = checkPageSize(size);
+    if (!supported.success) {
+        return supported;
+    }
+
+    uint64_t count = getPagesPerMapping(size);
+    uint64_t first_page = page_number & ~(count - 1);
+    if (first_page + count > num_virtual_pages_) {
+        return Result<void>::Err("Huge page would extend past the virtual address space");
+    }
+    const PageTableEntry* current = page_table_.find(page_number);
+    if (current && current->valid && sizeIndex(current->size) >= sizeIndex(size)) {
+        return Result<void>::Err("Page is already mapped by a " + pageSizeToString(current->size) + " page");
+    }
+
+    // Resident mappings inside the region move into the huge page
+    std::vector<uint64_t> members;
+    uint64_t page = first_page;
+    while (page_table_.nextValid(page, page) && page < first_page + count) {
+        members.push_back(page);
+        page += getPagesPerMapping(page_table_.find(page)->size);
+    }
+
+    // Pick the aligned run that evicts the fewest other pages, using the frame table
+    auto foreign = [&](size_t frame) {
+        const PageTableEntry* owner = frame_table_[frame];
+        return owner && (owner->virtual_page < first_page || owner->virtual_page >= first_page + count);
+    };
+    size_t best_run = 0;
+    size_t best_cost = SIZE_MAX;
+    for (size_t run = 0; run + count <= num_physical_frames_; run += count) {
+        size_t cost = 0;
+        for (size_t frame = run; frame < run + count; frame++) {
+            cost += foreign(frame) ? 1 : 0;
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_run = run;
+        }
+    }
+    for (size_t frame = best_run; frame < best_run + count; frame++) {
+        if (foreign(frame)) {
+            evictPage(static_cast<size_t>(frame_table_[frame]->virtual_page));
+        }
+    }
+
+    // Copy out the member pages, then release their mappings
+    std::vector<uint8_t> data(count * page_size_);
+    std::vector<bool> present(count, false);
+    bool dirty = false;
+    uint64_t load_time = global_time_;
+    uint64_t last_access = 0;
+    for (uint64_t member : members) {
+        PageTableEntry& pte = *page_table_.find(member);
+        uint64_t pages = getPagesPerMapping(pte.size);
+        for (uint64_t i = 0; i < pages; i++) {
+            size_t slot = static_cast<size_t>(member - first_page + i);
+            present[slot] = true;
+            Address frame_start = (pte.frame_number + i) * page_size_;
+            for (size_t byte = 0; byte < page_size_; byte++) {
+                data[slot * page_size_ + byte] = memory_->read(frame_start + byte).value;
+            }
+        }
+        dirty = dirty || pte.dirty;
+        load_time = std::min(load_time, pte.load_time);
+        last_access = std::max(last_access, pte.last_access);
+        if (replacer_) {
+            replacer_->remove(member);
+        }
+        removeMapping(member, pte);
+    }
+    size_t level = mappingLevel(size);
+    page_table_.collapse(first_page, level);
+
+    // Fill the run: moved pages from the copy, the rest from disk
+    allocateFrames(best_run, static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; i++) {
+        Address frame = best_run + i;
+        if (present[i]) {
+            for (size_t byte = 0; byte < page_size_; byte++) {
+                memory_->write(frame * page_size_ + byte, data[i * page_size_ + byte]);
+            }
+        } else {
+            loadPageFromDisk(first_page + i, frame);
+        }
+    }
+
+    PageTableEntry& pte = page_table_.insert(first_page, level);
+    pte.valid = true;
+    pte.frame_number = best_run;
+    pte.dirty = dirty;
+    pte.referenced = true;
+    pte.size = size;
+    pte.load_time = load_time;
+    pte.last_access = last_access;
+    stats_.by_size[sizeIndex(size)].mappings++;
+    stats_.promotions++;
+    trackResident(pte, first_page);
+    flushPageWalkCache();
+    return Result<void>::Ok();
+}
+
+Result<void> VirtualMemory::demote(Address virtual_addr) {
+    size_t page_number, offset;
+    parseAddress(virtual_addr, page_number, offset);
+    PageTableEntry* found = page_number < num_virtual_pages_ ? page_table_.find(page_number) : nullptr;
+    if (!found || !found->valid || found->size == PageSize::BASE) {
+        return Result<void>::Err("Page is not mapped by a huge page");
+    }
+
+    // Split into the next smaller size, keeping the frames in place
+    PageTableEntry huge = *found;
+    PageSize smaller = static_cast<PageSize>(sizeIndex(huge.size) - 1);
+    uint64_t count = getPagesPerMapping(huge.size);
+    uint64_t step = getPagesPerMapping(smaller);
+    uint64_t first_page = page_number & ~(count - 1);
+    if (tlb_) {
+        tlb_->shootdown(tlbKey(first_page, huge.size));
+    }
+    PageTableEntry* lru_position = found->lru_next;   // The pieces take the huge page's place
+    lruUnlink(*found);
+    if (clock_pro_) {
+        clock_pro_->remove(first_page);
+    }
+    if (replacer_) {
+        replacer_->remove(first_page);
+    }
+    found->invalidate();
+    stats_.by_size[sizeIndex(huge.size)].mappings--;
+
+    for (uint64_t i = 0; i < count / step; i++) {
+        PageTableEntry& pte = page_table_.insert(first_page + i * step, mappingLevel(smaller));
+        pte = huge;
+        pte.frame_number = huge.frame_number + i * step;
+        pte.size = smaller;
+        pte.virtual_page = first_page + i * step;
+        stats_.by_size[sizeIndex(smaller)].mappings++;
+        mapFrames(pte);
+        if (policy_ == PageReplacementPolicy::LRU) {
+            lruLink(pte, lru_position);
+        }
+        if (policy_ == PageReplacementPolicy::FIFO && i > 0) {
+            fifoEnqueue(pte);   // The first piece keeps the huge page's entry
+        }
+        if (clock_pro_) {
+            clock_pro_->insert(pte.virtual_page, &pte);
+        }
+        if (replacer_) {
+            replacer_->insert(pte.virtual_page);
+        }
+    }
+    stats_.demotions++;
+    flushPageWalkCache();
+    return Result<void>::Ok();
+}
+
+Result<void> VirtualMemory::setOptimalTrace(const std::vector<Address>& virtual_addrs) {
+    if (policy_ != PageReplacementPolicy::OPTIMAL) {
+        return Result<void>::Err("Future accesses are only used by the OPT policy");
+    }
+    std::vector<uint64_t> pages;
+    pages.reserve(virtual_addrs.size());
+    for (Address addr : virtual_addrs) {
+        // translate() rejects these before OPT sees them, so leave them out
+        if ((addr >> offset_bits_) < num_virtual_pages_) {
+            pages.push_back(addr >> offset_bits_);
+        }
+    }
+    static_cast<OptimalReplacer*>(replacer_.get())->setFuture(pages);
+    return Result<void>::Ok();
+}
+
+Result<void> VirtualMemory::setClockHandSpread(size_t frames) {
+    if (frames >= num_physical_frames_) {
+        return Result<void>::Err("Hand spread must be below the number of frames (" +
+                                 std::to_string(num_physical_frames_) + ")");
+    }
+    hand_spread_ = frames;
+    front_hand_ = (clock_hand_ + hand_spread_) % num_physical_frames_;
+    return Result<void>::Ok();
+}
+
+void VirtualMemory::setTLB(std::unique_ptr<TLBHierarchy> tlb) {
+    tlb_ = std::move(tlb);
+}
+
+Result<void> VirtualMemory::setSwapDevice(std::unique_ptr<SwapDevice> swap) {
+    if (swap && !swap->isOpen()) {
+        return Result<void>::Err("Swap device is not open");
+    }
+    if (swap && swap->getPageSize() != page_size_) {
+        return Result<void>::Err("Swap device page size " + std::to_string(swap->getPageSize()) +
+                                 " does not match the " + std::to_string(page_size_) + "-byte pages");
+    }
+    swap_ = std::move(swap);
+    swap_buffer_.assign(swap_ ? page_size_ : 0, 0);
+    return Result<void>::Ok();
+}
+
+Result<void> VirtualMemory::setSwapAsync(size_t num_threads, size_t batch_size) {
+    if (!swap_) {
+        return Result<void>::Err("No swap device attached");
+    }
+    return swap_->setAsync(num_threads, batch_size);
+}
+
+Result<void> VirtualMemory::setSwapDelay(uint64_t microseconds) {
+    if (!swap_) {
+        return Result<void>::Err("No swap device attached");
+    }
+    swap_->setDeviceDelay(microseconds);
+    return Result<void>::Ok();
+}
+
+void VirtualMemory::setReadahead(size_t max_pages) {
+    readahead_max_ = max_pages;
+    readahead_limit_ = max_pages;
+    std::fill(streams_.begin(), streams_.end(), ReadaheadStream{NO_PAGE, NO_PAGE, 0, 0});
+}
+
+Result<void> VirtualMemory::setFaultAround(size_t pages) {
+    if (pages > 1 && !isPowerOfTwo(pages)) {
+        return Result<void>::Err("Fault-around block must be a power of two pages");
+    }
+    fault_around_ = pages > 1 ? pages : 0;
+    return Result<void>::Ok();
+}
+
+bool VirtualMemory::prefetchSwap(Address virtual_addr) {
+    size_t page_number = virtual_addr >> offset_bits_;
+    if (!swap_ || !swap_->isAsync() || page_number >= num_virtual_pages_) {
+        return false;
+    }
+    const PageTableEntry* pte = page_table_.find(page_number);
+    if (pte && pte->valid) {
+        return false;
+    }
+    return swap_->prefetch(page_number);
+}
+
+void VirtualMemory::setPageWalkCache(size_t entries_per_level) {
+    walk_cache_levels_.clear();
+    if (entries_per_level == 0) {
+        return;
+    }
+    TLBConfig config{1, entries_per_level, TLBPolicy::LRU, 0};
+    for (size_t level = 0; level + 1 < page_table_.getLevels(); level++) {
+        walk_cache_levels_.push_back(
+            std::make_unique<TLB>("PWC L" + std::to_string(level), config));
+    }
+}
+
+void VirtualMemory::setPageWalkMemory(CacheHierarchy* cache) {
+    walk_memory_ = cache;
+
+    // Place the table after the frames; if they fill memory, share it with them
+    size_t frames_end = num_physical_frames_ * page_size_;
+    size_t memory_size = memory_->getTotalSize();
+    walk_table_base_ = frames_end < memory_size ? frames_end : 0;
+    walk_table_span_ = memory_size - walk_table_base_;
+}
+
 void VirtualMemory::flush() {
-    for (auto& pte : page_table_) {
-        pte.invalidate();
+    page_table_.clear();
+    if (tlb_) {
+        tlb_->flush();
     }
-    std::fill(frame_allocated_.begin(), frame_allocated_.end(), false);
-    while (!fifo_queue_.empty()) {
-        fifo_queue_.pop();
+    flushPageWalkCache();
+    for (auto& size_stats : stats_.by_size) {
+        size_stats.mappings = 0;
     }
+    std::fill(frame_table_.begin(), frame_table_.end(), nullptr);
+    free_frames_.reset();
+    stats_.free_frames = num_physical_frames_;
+    lru_head_ = nullptr;
+    lru_tail_ = nullptr;
+    fifo_queue_.clear();
     clock_hand_ = 0;
+    front_hand_ = hand_spread_;
+    if (clock_pro_) {
+        clock_pro_->clear();
+    }
+    if (replacer_) {
+        replacer_->reset();
+    }
+    if (swap_) {
+        swap_->releaseAll();
+    }
+    setReadahead(readahead_max_);
 }
 
 std::string VirtualMemory::getStatsString() const {
@@ -136,6 +527,114 @@ std::string VirtualMemory::getStatsString() const {
         << stats_.getPageFaultRate() << "%\n";
     oss << "Page Hit Rate: " << std::fixed << std::setprecision(2)
         << stats_.getPageHitRate() << "%\n";
+    oss << "Dirty Page Writebacks: " << stats_.page_writebacks << "\n";
+    oss << "Clean Evictions: " << stats_.clean_evictions << " (writeback skipped)\n";
+    oss << "Free Frames: " << stats_.free_frames << " of " << num_physical_frames_
+        << " (lowest " << stats_.min_free_frames << ")\n";
+    if (page_load_cycles_ > 0 || writeback_cycles_ > 0) {
+        oss << "Disk Latency: " << page_load_cycles_ << " cycles per page load, "
+            << writeback_cycles_ << " per writeback\n";
+        oss << "Disk Cycles: " << stats_.disk_cycles << "\n";
+    }
+    if (readahead_max_ > 0 || fault_around_ > 0 || stats_.readahead_pages + stats_.fault_around_pages > 0) {
+        oss << "Readahead: " << readahead_max_ << " pages max, window limit " << readahead_limit_
+            << ", " << stats_.readahead_windows << " windows (" << stats_.readahead_pages << " pages)\n";
+        oss << "Fault-Around: " << fault_around_ << " pages (" << stats_.fault_around_pages
+            << " pages mapped)\n";
+        uint64_t decided = stats_.prefetch_hits + stats_.prefetch_wasted;
+        oss << "Prefetch Hits: " << stats_.prefetch_hits << ", Wasted: " << stats_.prefetch_wasted
+            << " (" << std::fixed << std::setprecision(2)
+            << (decided > 0 ? 100.0 * stats_.prefetch_hits / decided : 0.0) << "% used)\n";
+    }
+    if (swap_) {
+        const SwapStats& swap = swap_->getStats();
+        oss << "Swap File: " << swap_->getPath() << ", " << swap_->getSlotsInUse()
+            << " slots in use (peak " << swap.peak_slots << ", file " << swap_->getFileSlots()
+            << " slots)\n";
+        oss << "Swap I/O: " << swap.reads << " reads (" << swap.bytes_read << " bytes), "
+            << swap.writes << " writes (" << swap.bytes_written << " bytes), "
+            << swap.errors << " errors, "
+            << swap.reads * page_load_cycles_ + swap.writes * writeback_cycles_ << " cycles\n";
+        oss << "Swap Latency: " << std::fixed << std::setprecision(2) << swap.getAverageLatencyUs()
+            << " us average, " << swap.max_latency_ns / 1000.0 << " us max over "
+            << swap.completed << " transfers, " << swap.wait_ns / 1000.0 << " us blocked";
+        if (swap_->getDeviceDelay() > 0) {
+            oss << " (device delay " << swap_->getDeviceDelay() << " us)";
+        }
+        oss << "\n";
+        if (swap_->isAsync()) {
+            oss << "Swap Engine: thread pool, " << swap_->getNumThreads() << " threads, batches of "
+                << swap_->getBatchSize() << " (" << swap.batches << " submitted)\n";
+            oss << "Swap Queue Depth: " << swap_->getQueueDepth() << " now, "
+                << swap.getAverageQueueDepth() << " average, " << swap.max_queue_depth << " max\n";
+            oss << "Swap Buffer Hits: " << swap.buffer_hits << ", Prefetches: " << swap.prefetches
+                << " (" << swap.prefetch_hits << " used)\n";
+        }
+    }
+    oss << "Page Table: " << page_table_.getLevels() << " levels (";
+    for (size_t level = 0; level < page_table_.getLevels(); level++) {
+        oss << (level > 0 ? "/" : "") << page_table_.getLevelBits(level);
+    }
+    oss << " index bits), " << page_table_.getNumNodes() << " nodes, "
+        << page_table_.getTableBytes() << " bytes\n";
+    oss << "Walk References: " << stats_.walk_references << "\n";
+    if (!walk_cache_levels_.empty()) {
+        oss << "Page-Walk Cache: " << getPageWalkCacheEntries() << " entries per level, "
+            << stats_.pwc_hits << " hits, " << stats_.pwc_misses << " misses\n";
+        for (size_t level = 0; level < walk_cache_levels_.size(); level++) {
+            const TLBStats& level_stats = walk_cache_levels_[level]->getStats();
+            oss << "  L" << level << ": " << level_stats.hits << " hits, "
+                << level_stats.misses << " misses\n";
+        }
+    }
+    if (walk_memory_) {
+        oss << "Walk Cycles (through cache): " << stats_.walk_cycles << "\n";
+    }
+    bool huge_used = thp_size_ != PageSize::BASE || stats_.promotions > 0;
+    for (size_t index = 1; index < NUM_PAGE_SIZES; index++) {
+        huge_used = huge_used || stats_.by_size[index].faults > 0 || stats_.by_size[index].mappings > 0;
+    }
+    if (huge_used) {
+        oss << "Transparent Huge Pages: "
+            << (thp_size_ == PageSize::BASE ? "off" : "up to " + pageSizeToString(thp_size_)) << "\n";
+        for (size_t index = 0; index < NUM_PAGE_SIZES && index < page_table_.getLevels(); index++) {
+            PageSize size = static_cast<PageSize>(index);
+            const PageSizeStats& size_stats = stats_.by_size[index];
+            oss << "  " << pageSizeToString(size) << " pages ("
+                << getPagesPerMapping(size) * page_size_ << " bytes): "
+                << size_stats.mappings << " resident, " << size_stats.faults << " faults";
+            if (tlb_) {
+                oss << ", " << size_stats.tlb_hits << " TLB hits, " << size_stats.tlb_misses << " TLB misses";
+            }
+            oss << "\n";
+        }
+        oss << "Promotions: " << stats_.promotions << ", Demotions: " << stats_.demotions
+            << ", Huge Fallbacks: " << stats_.huge_fallbacks << "\n";
+    }
+    if (stats_.clock_scans > 0) {
+        oss << "Clock Scans: " << stats_.clock_scans << " mappings\n";
+    }
+    if (policy_ == PageReplacementPolicy::WSCLOCK) {
+        oss << "Working-Set Window: " << working_set_window_ << " accesses, "
+            << stats_.page_cleanings << " pages cleaned ahead of eviction\n";
+    }
+    if (policy_ == PageReplacementPolicy::TWO_HANDED_CLOCK) {
+        oss << "Hand Spread: " << hand_spread_ << " frames\n";
+    }
+    if (replacer_) {
+        oss << replacer_->getStateString() << "\n";
+    }
+    if (clock_pro_) {
+        oss << "CLOCK-Pro: " << clock_pro_->getHotPages() << " hot, "
+            << clock_pro_->getColdPages() << " cold, " << clock_pro_->getTestPages()
+            << " non-resident test pages, cold target " << clock_pro_->getColdTarget() << "\n";
+    }
+    if (tlb_ || walk_memory_) {
+        oss << "Translation Cycles: " << stats_.translation_cycles << "\n";
+    }
+    if (tlb_) {
+        oss << "\n" << tlb_->getStatsString();
+    }
     return oss.str();
 }
 
@@ -143,15 +642,15 @@ void VirtualMemory::dump() const {
     std::cout << "=== Page Table ===\n";
     std::cout << getConfigString() << "\n\n";
 
-    for (size_t i = 0; i < num_virtual_pages_; i++) {
-        const auto& pte = page_table_[i];
-        if (!pte.valid) continue;  // Skip invalid entries
-
+    page_table_.forEachValid([this](uint64_t i, const PageTableEntry& pte) {
         std::cout << "Page " << std::setw(4) << i << ": ";
         std::cout << "Valid=" << pte.valid << ", ";
         std::cout << "Frame=" << std::setw(4) << pte.frame_number << ", ";
         std::cout << "Dirty=" << pte.dirty << ", ";
         std::cout << "Ref=" << pte.referenced;
+        if (pte.size != PageSize::BASE) {
+            std::cout << ", Size=" << pageSizeToString(pte.size);
+        }
 
         // Show replacement metadata
         switch (policy_) {
@@ -159,14 +658,23 @@ void VirtualMemory::dump() const {
                 std::cout << ", LoadTime=" << pte.load_time;
                 break;
             case PageReplacementPolicy::LRU:
+            case PageReplacementPolicy::WSCLOCK:
                 std::cout << ", LastAccess=" << pte.last_access;
                 break;
             case PageReplacementPolicy::CLOCK:
+            case PageReplacementPolicy::CLOCK_PRO:
+            case PageReplacementPolicy::TWO_HANDED_CLOCK:
                 // Referenced bit already shown
                 break;
+            case PageReplacementPolicy::ARC:
+            case PageReplacementPolicy::TWO_Q:
+            case PageReplacementPolicy::LIRS:
+            case PageReplacementPolicy::OPTIMAL:
+                // Order kept by the replacer (see stats)
+                break;
         }
         std::cout << "\n";
-    }
+    });
     std::cout << std::endl;
 }
 
@@ -174,18 +682,100 @@ std::string VirtualMemory::getConfigString() const {
     std::ostringstream oss;
     oss << num_virtual_pages_ << " virtual pages, "
         << num_physical_frames_ << " physical frames, "
-        << page_size_ << " bytes/page, ";
+        << page_size_ << " bytes/page, "
+        << page_table_.getLevels() << "-level page table, "
+        << pageReplacementPolicyToString(policy_);
+    return oss.str();
+}
 
-    switch (policy_) {
-        case PageReplacementPolicy::FIFO: oss << "FIFO"; break;
-        case PageReplacementPolicy::LRU: oss << "LRU"; break;
-        case PageReplacementPolicy::CLOCK: oss << "Clock"; break;
+// Private helper methods
+
+Result<void> VirtualMemory::checkPageSize(PageSize size) const {
+    if (sizeIndex(size) >= page_table_.getLevels()) {
+        return Result<void>::Err(pageSizeToString(size) + " pages need a page table of more than " +
+                                 std::to_string(sizeIndex(size)) + " levels");
+    }
+    if (getPagesPerMapping(size) > num_physical_frames_) {
+        return Result<void>::Err(pageSizeToString(size) + " pages (" +
+                                 std::to_string(getPagesPerMapping(size)) +
+                                 " frames) do not fit in physical memory");
+    }
+    if (page_number_bits_ > TLB_SIZE_TAG_SHIFT) {
+        return Result<void>::Err("Huge pages need page numbers below 2^" +
+                                 std::to_string(TLB_SIZE_TAG_SHIFT));
     }
+    return Result<void>::Ok();
+}
 
-    return oss.str();
+uint64_t VirtualMemory::tlbKey(uint64_t page_number, PageSize size) const {
+    if (size == PageSize::BASE) {
+        return page_number;
+    }
+    uint64_t huge_page = page_number / getPagesPerMapping(size);
+    return huge_page | (static_cast<uint64_t>(sizeIndex(size)) << TLB_SIZE_TAG_SHIFT);
 }
 
-// Private helper methods
+uint64_t VirtualMemory::probeTLBKey(uint64_t page_number, PageSize& size) const {
+    // Huge mappings are tagged by size; probe the sizes in use without touching TLB state
+    for (size_t index = NUM_PAGE_SIZES - 1; index > 0; index--) {
+        if (stats_.by_size[index].mappings == 0) {
+            continue;
+        }
+        PageSize candidate = static_cast<PageSize>(index);
+        uint64_t key = tlbKey(page_number, candidate);
+        if (tlb_->getDTLB().contains(key) || tlb_->getSTLB().contains(key)) {
+            size = candidate;
+            return key;
+        }
+    }
+    size = PageSize::BASE;
+    return page_number;
+}
+
+void VirtualMemory::flushPageWalkCache() {
+    for (auto& level : walk_cache_levels_) {
+        level->flush();
+    }
+}
+
+void VirtualMemory::walkPageTable(size_t page_number) {
+    size_t levels = page_table_.getLevels();
+    size_t read = page_table_.walk(page_number, walk_offsets_);
+
+    // Start below the deepest level whose entry the page-walk cache holds
+    size_t start = 0;
+    if (!walk_cache_levels_.empty()) {
+        Address unused = 0;
+        for (size_t level = levels - 1; level-- > 0;) {
+            if (walk_cache_levels_[level]->lookup(page_table_.prefix(page_number, level), unused)) {
+                start = level + 1;
+                break;
+            }
+        }
+        if (start > 0) {
+            stats_.pwc_hits++;
+        } else {
+            stats_.pwc_misses++;
+        }
+    }
+
+    for (size_t level = start; level < read; level++) {
+        stats_.walk_references++;
+        if (walk_memory_) {
+            Address entry_addr = walk_table_base_ + walk_offsets_[level] % walk_table_span_;
+            walk_memory_->read(entry_addr);
+            stats_.walk_cycles += walk_memory_->getLastAccessCycles();
+            stats_.translation_cycles += walk_memory_->getLastAccessCycles();
+        }
+    }
+
+    // Remember the non-leaf entries that led to an existing node
+    if (!walk_cache_levels_.empty()) {
+        for (size_t level = start; level + 1 < levels && level + 1 < read; level++) {
+            walk_cache_levels_[level]->insert(page_table_.prefix(page_number, level), 0);
+        }
+    }
+}
 
 void VirtualMemory::parseAddress(Address virtual_addr, size_t& page_number, size_t& offset) const {
     // Extract page offset (lowest bits)
@@ -200,6 +790,51 @@ Address VirtualMemory::constructPhysicalAddress(Address frame_number, size_t off
 }
 
 Result<Address> VirtualMemory::handlePageFault(size_t page_number) {
+    if (replacer_) {
+        replacer_->onFault(page_number);
+    }
+
+    // Transparent huge pages: map the largest enabled size whose region is
+    // unmapped and has a free aligned frame run, else fall back
+    bool fell_back = false;
+    for (size_t index = sizeIndex(thp_size_); index > 0; index--) {
+        PageSize size = static_cast<PageSize>(index);
+        uint64_t count = getPagesPerMapping(size);
+        uint64_t first_page = page_number & ~(count - 1);
+        uint64_t mapped = 0;
+        if (first_page + count > num_virtual_pages_ ||
+            (page_table_.nextValid(first_page, mapped) && mapped < first_page + count)) {
+            continue;
+        }
+        auto run = findFreeFrameRun(static_cast<size_t>(count));
+        if (!run.success) {
+            fell_back = true;
+            continue;
+        }
+
+        allocateFrames(run.value, static_cast<size_t>(count));
+        for (uint64_t i = 0; i < count; i++) {
+            loadPageFromDisk(first_page + i, run.value + i);
+        }
+        size_t level = mappingLevel(size);
+        page_table_.collapse(first_page, level);   // Drop leftover empty nodes
+        auto& pte = page_table_.insert(first_page, level);
+        pte.valid = true;
+        pte.frame_number = run.value;
+        pte.dirty = false;
+        pte.referenced = true;
+        pte.size = size;
+        pte.load_time = global_time_;
+        pte.last_access = global_time_;
+        stats_.by_size[index].faults++;
+        stats_.by_size[index].mappings++;
+        trackResident(pte, first_page);
+        return Result<Address>::Ok(run.value + (page_number - first_page));
+    }
+    if (fell_back) {
+        stats_.huge_fallbacks++;
+    }
+
     // Try to find free frame first
     auto free_frame = findFreeFrame();
 
@@ -219,26 +854,25 @@ Result<Address> VirtualMemory::handlePageFault(size_t page_number) {
         }
         frame_number = free_frame.value;
     }
-
-    // Mark frame as allocated
-    frame_allocated_[frame_number] = true;
+    allocateFrames(frame_number, 1);
 
     // Load page from "disk"
     loadPageFromDisk(page_number, frame_number);
 
     // Update page table entry
-    auto& pte = page_table_[page_number];
+    auto& pte = page_table_.insert(page_number);
     pte.valid = true;
     pte.frame_number = frame_number;
     pte.dirty = false;
     pte.referenced = true;  // Set reference bit on page load
+    pte.size = PageSize::BASE;
     pte.load_time = global_time_;
     pte.last_access = global_time_;
+    stats_.by_size[sizeIndex(PageSize::BASE)].faults++;
+    stats_.by_size[sizeIndex(PageSize::BASE)].mappings++;
 
     // Update replacement policy data structures
-    if (policy_ == PageReplacementPolicy::FIFO) {
-        fifo_queue_.push(page_number);
-    }
+    trackResident(pte, page_number);
 
     return Result<Address>::Ok(frame_number);
 }
@@ -246,102 +880,447 @@ Result<Address> VirtualMemory::handlePageFault(size_t page_number) {
 size_t VirtualMemory::selectVictimPage() {
     switch (policy_) {
         case PageReplacementPolicy::FIFO: {
-            if (fifo_queue_.empty()) {
-                for (size_t i = 0; i < num_virtual_pages_; i++) {
-                    if (page_table_[i].valid) return i;
+            // Skip stale entries (evicted out of order, merged into a huge page, or requeued)
+            while (!fifo_queue_.empty()) {
+                if (fifoLive(fifo_queue_.front())) {
+                    return static_cast<size_t>(fifo_queue_.front().page);
                 }
-                return 0;
+                fifo_queue_.pop_front();
             }
-            return fifo_queue_.front();
+            uint64_t first = 0;
+            return page_table_.nextValid(0, first) ? static_cast<size_t>(first) : 0;
         }
 
         case PageReplacementPolicy::LRU: {
-            // LRU: find page with smallest last_access time
-            size_t victim = 0;
-            uint64_t min_time = UINT64_MAX;
-            for (size_t i = 0; i < num_virtual_pages_; i++) {
-                if (page_table_[i].valid && page_table_[i].last_access < min_time) {
-                    min_time = page_table_[i].last_access;
-                    victim = i;
-                }
-            }
-            return victim;
+            // LRU: the tail of the list is the least recently used mapping
+            return lru_tail_ ? static_cast<size_t>(lru_tail_->virtual_page) : 0;
         }
 
         case PageReplacementPolicy::CLOCK: {
-            // Clock algorithm: circular scan with reference bit
-            // Scan only valid pages (those currently in memory)
-            size_t scanned = 0;
-            size_t max_scans = num_virtual_pages_ * 2;  // Prevent infinite loop
-
-            while (scanned < max_scans) {
-                auto& pte = page_table_[clock_hand_];
-
-                if (pte.valid) {
-                    if (!pte.referenced) {
-                        // Found victim - page with ref bit = 0
-                        size_t victim = clock_hand_;
-                        clock_hand_ = (clock_hand_ + 1) % num_virtual_pages_;
-                        return victim;
-                    } else {
-                        // Give second chance - clear reference bit
-                        pte.referenced = false;
-                    }
+            // Clock algorithm: the hand sweeps the frame table, giving
+            // referenced mappings a second chance. Every bit is clear after one pass.
+            for (size_t scanned = 0; scanned <= 2 * num_physical_frames_; scanned++) {
+                PageTableEntry* pte = advanceHand(clock_hand_);
+                if (!pte) {
+                    break;  // Nothing resident
                 }
-
-                // Move to next page
-                clock_hand_ = (clock_hand_ + 1) % num_virtual_pages_;
-                scanned++;
+                stats_.clock_scans++;
+                if (!pte->referenced) {
+                    return static_cast<size_t>(pte->virtual_page);
+                }
+                pte->referenced = false;
             }
+            return 0;
+        }
 
-            // Fallback: return first valid page (shouldn't reach here)
-            for (size_t i = 0; i < num_virtual_pages_; i++) {
-                if (page_table_[i].valid) return i;
+        case PageReplacementPolicy::TWO_HANDED_CLOCK: {
+            // The front hand clears bits; a mapping not used again before
+            // the back hand arrives is evicted
+            for (size_t scanned = 0; scanned <= 3 * num_physical_frames_; scanned++) {
+                PageTableEntry* cleared = advanceHand(front_hand_);
+                if (!cleared) {
+                    break;
+                }
+                cleared->referenced = false;
+                PageTableEntry* pte = advanceHand(clock_hand_);
+                stats_.clock_scans++;
+                if (!pte->referenced) {
+                    return static_cast<size_t>(pte->virtual_page);
+                }
             }
             return 0;
         }
 
+        case PageReplacementPolicy::WSCLOCK: {
+            // Evict a clean mapping outside the working set; clean old dirty
+            // ones on the way so the second pass can take them
+            PageTableEntry* fallback = nullptr;
+            for (size_t scanned = 0; scanned <= 2 * num_physical_frames_; scanned++) {
+                PageTableEntry* pte = advanceHand(clock_hand_);
+                if (!pte) {
+                    break;
+                }
+                stats_.clock_scans++;
+                if (pte->referenced) {
+                    pte->referenced = false;   // Used since the last pass: in the working set
+                    continue;
+                }
+                if (global_time_ - pte->last_access <= working_set_window_) {
+                    if (!fallback || (fallback->dirty && !pte->dirty)) {
+                        fallback = pte;
+                    }
+                    continue;
+                }
+                if (!pte->dirty) {
+                    return static_cast<size_t>(pte->virtual_page);
+                }
+                for (uint64_t i = 0; i < getPagesPerMapping(pte->size); i++) {
+                    writePageToDisk(pte->virtual_page + i, pte->frame_number + i);
+                }
+                pte->dirty = false;
+                stats_.page_cleanings++;
+            }
+            // The whole resident set is the working set: take a clean mapping if there is one
+            return fallback ? static_cast<size_t>(fallback->virtual_page) : 0;
+        }
+
+        case PageReplacementPolicy::CLOCK_PRO: {
+            uint64_t victim = 0;
+            return clock_pro_->selectVictim(victim) ? static_cast<size_t>(victim) : 0;
+        }
+
+        case PageReplacementPolicy::ARC:
+        case PageReplacementPolicy::TWO_Q:
+        case PageReplacementPolicy::LIRS:
+        case PageReplacementPolicy::OPTIMAL: {
+            uint64_t victim = 0;
+            return replacer_->selectVictim(victim) ? static_cast<size_t>(victim) : 0;
+        }
+
         default:
             return 0;
     }
 }
 
 void VirtualMemory::evictPage(size_t page_number) {
-    auto& pte = page_table_[page_number];
-
-    if (!pte.valid) {
+    PageTableEntry* found = page_table_.find(page_number);
+    if (!found || !found->valid) {
         return;  // Already evicted
     }
+    auto& pte = *found;
+    uint64_t count = getPagesPerMapping(pte.size);
+    uint64_t first_page = page_number & ~(count - 1);
 
-    // If page is dirty, write back to "disk"
+    // If page is dirty, write back to "disk" (every base page of a huge page)
     if (pte.dirty) {
-        writePageToDisk(page_number, pte.frame_number);
+        for (uint64_t i = 0; i < count; i++) {
+            writePageToDisk(first_page + i, pte.frame_number + i);
+        }
+    } else {
+        stats_.clean_evictions++;
+    }
+    if (pte.prefetched) {
+        stats_.prefetch_wasted++;
+        if (readahead_limit_ > 1) {
+            readahead_limit_--;
+        }
     }
 
-    // Free the frame
-    frame_allocated_[pte.frame_number] = false;
+    // Shoot down the mapping, free its frames and invalidate the entry
+    removeMapping(first_page, pte);
+    if (replacer_) {
+        replacer_->onEvict(first_page);
+    }
+}
 
-    // Invalidate page table entry
+void VirtualMemory::removeMapping(uint64_t first_page, PageTableEntry& pte) {
+    if (tlb_) {
+        tlb_->shootdown(tlbKey(first_page, pte.size));
+    }
+    size_t count = static_cast<size_t>(getPagesPerMapping(pte.size));
+    for (size_t i = 0; i < count; i++) {
+        frame_table_[pte.frame_number + i] = nullptr;
+    }
+    free_frames_.release(static_cast<size_t>(pte.frame_number), count);
+    stats_.free_frames = free_frames_.getFreeFrames();
+    stats_.by_size[sizeIndex(pte.size)].mappings--;
+    lruUnlink(pte);
+    if (clock_pro_) {
+        clock_pro_->remove(first_page);
+    }
     pte.invalidate();
+}
 
-    // Update FIFO queue if needed
-    if (policy_ == PageReplacementPolicy::FIFO && !fifo_queue_.empty()) {
-        fifo_queue_.pop();  // Remove evicted page from front
+void VirtualMemory::recordAccess(PageTableEntry& pte) {
+    pte.recordAccess(global_time_);
+    if (replacer_) {
+        replacer_->onAccess(pte.virtual_page);
+    }
+    if (policy_ == PageReplacementPolicy::LRU && lru_head_ != &pte) {
+        lruUnlink(pte);
+        lruLink(pte, lru_head_);
+    }
+    if (pte.prefetched) {
+        notePrefetchHit(pte);
     }
 }
 
-Result<Address> VirtualMemory::findFreeFrame() {
-    for (size_t i = 0; i < num_physical_frames_; i++) {
-        if (!frame_allocated_[i]) {
-            return Result<Address>::Ok(i);
+void VirtualMemory::prefetchAfterFault(uint64_t page_number) {
+    if (readahead_max_ > 0) {
+        ReadaheadStream* oldest = &streams_[0];
+        for (auto& stream : streams_) {
+            if (stream.next_page == page_number) {
+                // The stream continues: open (or grow) its window after this page
+                size_t window = stream.window == 0 ? READAHEAD_INITIAL_WINDOW : 2 * stream.window;
+                stream.window = std::min(window, readahead_limit_);
+                stream.next_page = page_number + 1;
+                stream.last_use = global_time_;
+                readAhead(stream, page_number);
+                return;
+            }
+            if (stream.last_use < oldest->last_use) {
+                oldest = &stream;
+            }
+        }
+        *oldest = ReadaheadStream{page_number + 1, NO_PAGE, 0, global_time_};
+    }
+
+    if (fault_around_ > 1) {
+        uint64_t first = page_number & ~static_cast<uint64_t>(fault_around_ - 1);
+        uint64_t last = std::min<uint64_t>(first + fault_around_, num_virtual_pages_) - 1;
+        for (uint64_t page = first; page <= last; page++) {
+            PrefetchOutcome outcome = page == page_number ? PrefetchOutcome::RESIDENT
+                                                          : prefetchPage(page, first, last);
+            if (outcome == PrefetchOutcome::STOPPED) {
+                break;
+            }
+            if (outcome == PrefetchOutcome::MAPPED) {
+                stats_.fault_around_pages++;
+            }
+        }
+    }
+}
+
+void VirtualMemory::readAhead(ReadaheadStream& stream, uint64_t protect_first) {
+    uint64_t first = stream.next_page;
+    size_t window = stream.window;
+    stats_.readahead_windows++;
+    startSwapReads(first, first + window - 1);
+    for (uint64_t page = first; page < first + window; page++) {
+        PrefetchOutcome outcome = prefetchPage(page, protect_first, first + window - 1);
+        if (outcome == PrefetchOutcome::STOPPED) {
+            break;
+        }
+        if (outcome == PrefetchOutcome::MAPPED) {
+            stats_.readahead_pages++;
+        }
+    }
+    stream.marker = first + window / 2;
+    stream.next_page = first + window;
+}
+
+void VirtualMemory::startFaultReads(uint64_t page_number) {
+    // The pages prefetchAfterFault() will map once the fault is handled
+    uint64_t first = page_number + 1;
+    uint64_t last = page_number;
+    if (readahead_max_ > 0) {
+        for (const auto& stream : streams_) {
+            if (stream.next_page == page_number) {
+                size_t window = stream.window == 0 ? READAHEAD_INITIAL_WINDOW : 2 * stream.window;
+                last = page_number + std::min(window, readahead_limit_);
+                break;
+            }
+        }
+    }
+    if (last == page_number && fault_around_ > 1) {
+        first = page_number & ~static_cast<uint64_t>(fault_around_ - 1);
+        last = first + fault_around_ - 1;
+    }
+
+    swap_->prefetch(page_number);
+    startSwapReads(first, last);
+}
+
+void VirtualMemory::startSwapReads(uint64_t first, uint64_t last) {
+    if (!swap_ || !swap_->isAsync()) {
+        return;
+    }
+    for (uint64_t page = first; page <= last && page < num_virtual_pages_; page++) {
+        const PageTableEntry* pte = page_table_.find(page);
+        if (!pte || !pte->valid) {
+            swap_->prefetch(page);
+        }
+    }
+}
+
+VirtualMemory::PrefetchOutcome VirtualMemory::prefetchPage(uint64_t page_number,
+                                                           uint64_t protect_first,
+                                                           uint64_t protect_last) {
+    if (page_number >= num_virtual_pages_) {
+        return PrefetchOutcome::STOPPED;
+    }
+    const PageTableEntry* existing = page_table_.find(page_number);
+    if (existing && existing->valid) {
+        return PrefetchOutcome::RESIDENT;
+    }
+
+    auto free_frame = findFreeFrame();
+    if (!free_frame.success) {
+        // The clocks' victim searches move hands, clear reference bits, clean
+        // dirty pages (WSClock) or move pages between lists (CLOCK-Pro), so a
+        // search that found a protected page could not be abandoned cleanly
+        if (policy_ == PageReplacementPolicy::CLOCK || policy_ == PageReplacementPolicy::WSCLOCK ||
+            policy_ == PageReplacementPolicy::TWO_HANDED_CLOCK || clock_pro_) {
+            return PrefetchOutcome::STOPPED;
+        }
+        size_t victim_page = selectVictimPage();
+        if (victim_page >= protect_first && victim_page <= protect_last &&
+            !findUnprotectedVictim(protect_first, protect_last, victim_page)) {
+            return PrefetchOutcome::STOPPED;
+        }
+        evictPage(victim_page);
+        free_frame = findFreeFrame();
+        if (!free_frame.success) {
+            return PrefetchOutcome::STOPPED;
+        }
+    }
+    allocateFrames(free_frame.value, 1);
+    loadPageFromDisk(page_number, free_frame.value);
+
+    // Unreferenced, so an unused prefetch is among the first pages a clock takes back
+    auto& pte = page_table_.insert(page_number);
+    pte.valid = true;
+    pte.frame_number = free_frame.value;
+    pte.dirty = false;
+    pte.referenced = false;
+    pte.size = PageSize::BASE;
+    pte.prefetched = true;
+    pte.load_time = global_time_;
+    pte.last_access = global_time_;
+    stats_.by_size[sizeIndex(PageSize::BASE)].mappings++;
+    trackResident(pte, page_number, true);
+    return PrefetchOutcome::MAPPED;
+}
+
+bool VirtualMemory::findUnprotectedVictim(uint64_t protect_first, uint64_t protect_last,
+                                          size_t& victim_page) const {
+    auto is_protected = [&](uint64_t page) { return page >= protect_first && page <= protect_last; };
+    if (policy_ == PageReplacementPolicy::LRU) {
+        for (const PageTableEntry* pte = lru_tail_; pte; pte = pte->lru_prev) {
+            if (!is_protected(pte->virtual_page)) {
+                victim_page = static_cast<size_t>(pte->virtual_page);
+                return true;
+            }
+        }
+    } else if (policy_ == PageReplacementPolicy::FIFO) {
+        for (const FifoEntry& entry : fifo_queue_) {
+            if (fifoLive(entry) && !is_protected(entry.page)) {
+                victim_page = static_cast<size_t>(entry.page);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void VirtualMemory::notePrefetchHit(PageTableEntry& pte) {
+    pte.prefetched = false;
+    stats_.prefetch_hits++;
+    if (policy_ == PageReplacementPolicy::FIFO) {
+        // Queued at the front while unused: it joins the queue at its first access
+        fifoEnqueue(pte);
+    }
+    readahead_limit_ = std::min(readahead_limit_ + 1, readahead_max_);
+    for (auto& stream : streams_) {
+        if (stream.marker == pte.virtual_page) {
+            // The stream reached its marker: read the next window before it gets there
+            stream.window = std::min(std::max<size_t>(2 * stream.window, 1), readahead_limit_);
+            stream.last_use = global_time_;
+            readAhead(stream, pte.virtual_page);
+            return;
         }
     }
+}
+
+void VirtualMemory::trackResident(PageTableEntry& pte, uint64_t first_page, bool prefetched) {
+    pte.virtual_page = first_page;
+    mapFrames(pte);
+    if (policy_ == PageReplacementPolicy::FIFO) {
+        fifoEnqueue(pte, prefetched);
+    } else if (policy_ == PageReplacementPolicy::LRU) {
+        lruLink(pte, prefetched ? nullptr : lru_head_);
+    } else if (clock_pro_) {
+        clock_pro_->insert(first_page, &pte, prefetched);
+    } else if (replacer_ && prefetched) {
+        replacer_->insertPrefetched(first_page);
+    } else if (replacer_) {
+        replacer_->insert(first_page);
+    }
+}
+
+void VirtualMemory::fifoEnqueue(PageTableEntry& pte, bool front) {
+    pte.fifo_stamp = ++fifo_stamp_;
+    if (front) {
+        fifo_queue_.push_front(FifoEntry{pte.virtual_page, pte.fifo_stamp});
+    } else {
+        fifo_queue_.push_back(FifoEntry{pte.virtual_page, pte.fifo_stamp});
+    }
+}
+
+bool VirtualMemory::fifoLive(const FifoEntry& entry) const {
+    const PageTableEntry* pte = page_table_.find(entry.page);
+    return pte && pte->valid && pte->virtual_page == entry.page && pte->fifo_stamp == entry.stamp;
+}
+
+void VirtualMemory::allocateFrames(Address first_frame, size_t count) {
+    free_frames_.allocate(static_cast<size_t>(first_frame), count);
+    stats_.free_frames = free_frames_.getFreeFrames();
+    stats_.min_free_frames = std::min(stats_.min_free_frames, stats_.free_frames);
+}
+
+void VirtualMemory::mapFrames(PageTableEntry& pte) {
+    for (uint64_t i = 0; i < getPagesPerMapping(pte.size); i++) {
+        frame_table_[pte.frame_number + i] = &pte;
+    }
+}
+
+PageTableEntry* VirtualMemory::advanceHand(size_t& hand) {
+    for (size_t step = 0; step < num_physical_frames_; step++) {
+        PageTableEntry* pte = frame_table_[hand];
+        hand = (hand + 1) % num_physical_frames_;
+        if (pte) {
+            // Skip the rest of a huge page's frames
+            hand = static_cast<size_t>((pte->frame_number + getPagesPerMapping(pte->size)) % num_physical_frames_);
+            return pte;
+        }
+    }
+    return nullptr;
+}
+
+void VirtualMemory::lruLink(PageTableEntry& pte, PageTableEntry* next) {
+    PageTableEntry* prev = next ? next->lru_prev : lru_tail_;
+    pte.lru_prev = prev;
+    pte.lru_next = next;
+    (prev ? prev->lru_next : lru_head_) = &pte;
+    (next ? next->lru_prev : lru_tail_) = &pte;
+}
+
+void VirtualMemory::lruUnlink(PageTableEntry& pte) {
+    if (policy_ != PageReplacementPolicy::LRU) {
+        return;
+    }
+    (pte.lru_prev ? pte.lru_prev->lru_next : lru_head_) = pte.lru_next;
+    (pte.lru_next ? pte.lru_next->lru_prev : lru_tail_) = pte.lru_prev;
+    pte.lru_prev = nullptr;
+    pte.lru_next = nullptr;
+}
+
+Result<Address> VirtualMemory::findFreeFrameRun(size_t count) {
+    size_t first = 0;
+    if (free_frames_.findFreeRun(count, first)) {
+        return Result<Address>::Ok(first);
+    }
+    return Result<Address>::Err("No free aligned frame run available");
+}
+
+Result<Address> VirtualMemory::findFreeFrame() {
+    size_t frame = 0;
+    if (free_frames_.findFree(frame)) {
+        return Result<Address>::Ok(frame);
+    }
     return Result<Address>::Err("No free frames available");
 }
 
 void VirtualMemory::loadPageFromDisk(size_t page_number, Address frame_number) {
-    // Simulate disk load with deterministic pattern
+    stats_.disk_cycles += page_load_cycles_;
     Address frame_start = frame_number * page_size_;
+    if (swap_ && swap_->hasSlot(page_number) &&
+        swap_->readPage(page_number, swap_buffer_.data()).success) {
+        memory_->write(frame_start, swap_buffer_.data(), page_size_);
+        return;
+    }
+
+    // Simulate disk load with deterministic pattern
     for (size_t i = 0; i < page_size_; i++) {
         uint8_t value = static_cast<uint8_t>((page_number * page_size_ + i) % 256);
         memory_->write(frame_start + i, value);
@@ -349,9 +1328,17 @@ void VirtualMemory::loadPageFromDisk(size_t page_number, Address frame_number) {
 }
 
 void VirtualMemory::writePageToDisk(size_t page_number, Address frame_number) {
-    // Disk write simulation (no-op)
-    (void)page_number;
-    (void)frame_number;
+    stats_.page_writebacks++;
+    stats_.disk_cycles += writeback_cycles_;
+    if (!swap_) {
+        return;   // Disk write simulation: only the cost is accounted
+    }
+
+    // A failed write is counted in the device's errors; the page reloads its pattern
+    memory_->read(frame_number * page_size_, swap_buffer_.data(), page_size_);
+    if (!swap_->writePage(page_number, swap_buffer_.data()).success) {
+        swap_->release(page_number);
+    }
 }
 
 bool VirtualMemory::isPowerOfTwo(size_t value) {
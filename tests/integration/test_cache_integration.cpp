@@ -431,6 +431,33 @@ TEST_F(CacheHierarchyTest, WriteNoAllocateOnMiss) {
     EXPECT_GT(after_write.l1_stats.misses, before.l1_stats.misses);
 }
 
+TEST_F(CacheHierarchyTest, WriteHitProbesEachLevelOnce) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::FIFO,
+        8, 2, 32, CachePolicy::LRU
+    );
+
+    hierarchy->read(200);  // Block now in L1 and L2
+    auto before = hierarchy->getStats();
+    ASSERT_TRUE(hierarchy->write(200, 77).success);
+    auto after = hierarchy->getStats();
+
+    // One hit per holding level, no misses, memory read path untouched
+    EXPECT_EQ(after.l1_stats.accesses - before.l1_stats.accesses, 1);
+    EXPECT_EQ(after.l1_stats.hits - before.l1_stats.hits, 1);
+    EXPECT_EQ(after.l2_stats.accesses - before.l2_stats.accesses, 1);
+    EXPECT_EQ(after.l2_stats.hits - before.l2_stats.hits, 1);
+    EXPECT_EQ(after.memory_accesses, before.memory_accesses);
+
+    // Both copies and memory hold the new value
+    CacheLevel* l1 = hierarchy->getL1();
+    CacheLevel* l2 = hierarchy->getL2();
+    EXPECT_EQ(l1->readData(l1->peek(200)), 77);
+    EXPECT_EQ(l2->readData(l2->peek(200)), 77);
+    EXPECT_EQ(memory->read(200).value, 77);
+}
+
 // ===== Cache Invariant Tests =====
 
 TEST_F(CacheHierarchyTest, CacheInvariants) {
@@ -498,8 +525,666 @@ TEST_F(CacheHierarchyTest, CacheMemoryConsistency) {
     }
 }
 
+// ===== Prefetcher Tests =====
+
+TEST_F(CacheHierarchyTest, NextLinePrefetch_SequentialReadsHitL1) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+    ASSERT_TRUE(hierarchy->setPrefetcher(1, createPrefetcher(PrefetcherType::NEXT_LINE, 16, 1)).success);
+
+    // Tagged next-line: only the first block misses
+    for (Address addr = 0; addr < 256; addr += 16) {
+        auto result = hierarchy->read(addr);
+        ASSERT_TRUE(result.success);
+        EXPECT_EQ(result.value, static_cast<uint8_t>(addr % 256));
+    }
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.l1_stats.misses, 1);
+    EXPECT_EQ(stats.l1_stats.hits, 15);
+    EXPECT_EQ(stats.l1_stats.prefetch.issued, 16);
+    EXPECT_EQ(stats.l1_stats.prefetch.useful, 15);
+    EXPECT_EQ(stats.l1_stats.prefetch.late, 0);
+    EXPECT_EQ(stats.memory_accesses, 1);
+}
+
+TEST_F(CacheHierarchyTest, StridePrefetch_LearnsConstantStride) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+    ASSERT_TRUE(hierarchy->setPrefetcher(1, createPrefetcher(PrefetcherType::STRIDE, 16, 1)).success);
+
+    // 64-byte stride: two accesses to learn it, two more to gain confidence
+    for (Address addr = 0; addr < 1024; addr += 64) {
+        ASSERT_TRUE(hierarchy->read(addr).success);
+    }
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.l1_stats.misses, 4);
+    EXPECT_EQ(stats.l1_stats.hits, 12);
+    EXPECT_EQ(stats.l1_stats.prefetch.useful, 12);
+}
+
+TEST_F(CacheHierarchyTest, StreamBufferPrefetch_AttachedToL2) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+    ASSERT_TRUE(hierarchy->setPrefetcher(2, createPrefetcher(PrefetcherType::STREAM_BUFFER, 32, 4)).success);
+
+    // Every read misses L1 (one per 32-byte L2 block), the stream keeps L2 ahead
+    for (Address addr = 0; addr < 512; addr += 32) {
+        ASSERT_TRUE(hierarchy->read(addr).success);
+    }
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.l1_stats.hits, 0);
+    EXPECT_EQ(stats.l2_stats.misses, 1);
+    EXPECT_EQ(stats.l2_stats.hits, 15);
+    EXPECT_EQ(stats.l2_stats.prefetch.useful, 15);
+    EXPECT_EQ(stats.memory_accesses, 1);
+}
+
+TEST_F(CacheHierarchyTest, PrefetchLatency_CountsLatePrefetches) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+    ASSERT_TRUE(hierarchy->setPrefetcher(1, createPrefetcher(PrefetcherType::NEXT_LINE, 16, 1), 10).success);
+
+    hierarchy->read(0);    // Miss, prefetch of block 16 in flight for 10 reads
+    hierarchy->read(16);   // Demand miss overtakes it
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.l1_stats.prefetch.issued, 2);
+    EXPECT_EQ(stats.l1_stats.prefetch.late, 1);
+    EXPECT_EQ(stats.l1_stats.misses, 2);
+
+    // The prefetch of block 32 completes once its latency has elapsed
+    for (int i = 0; i < 10; i++) {
+        hierarchy->read(16);
+    }
+    EXPECT_TRUE(hierarchy->containsInL1(32));
+}
+
+TEST_F(CacheHierarchyTest, Prefetch_EvictedBeforeUseIsPolluting) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+    ASSERT_TRUE(hierarchy->setPrefetcher(1, createPrefetcher(PrefetcherType::NEXT_LINE, 16, 1)).success);
+
+    hierarchy->read(0);    // Prefetches block 16 into set 1
+    hierarchy->read(80);   // Block 80 also maps to set 1 and evicts it unused
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.l1_stats.prefetch.polluting, 1);
+    EXPECT_EQ(stats.l1_stats.prefetch.useful, 0);
+    EXPECT_FALSE(hierarchy->containsInL1(16));
+}
+
+TEST_F(CacheHierarchyTest, SetPrefetcher_InvalidLevel) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+
+    EXPECT_FALSE(hierarchy->setPrefetcher(3, createPrefetcher(PrefetcherType::NEXT_LINE, 16, 1)).success);
+    EXPECT_TRUE(hierarchy->setPrefetcher(1, nullptr).success);
+    EXPECT_EQ(hierarchy->getPrefetcher(1), nullptr);
+    EXPECT_THROW(createPrefetcher(PrefetcherType::STRIDE, 16, 0), std::invalid_argument);
+}
+
+// ===== N-Level Hierarchy Tests =====
+
+TEST_F(CacheHierarchyTest, ThreeLevel_StopsAtFirstHitAndFillsUpperLevels) {
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), std::vector<CacheLevelConfig>{
+        {2, 1, 16, CachePolicy::LRU},   // L1: 32 bytes
+        {4, 1, 16, CachePolicy::LRU},   // L2: 64 bytes
+        {16, 4, 16, CachePolicy::LRU}   // L3: 1 KB
+    });
+    ASSERT_EQ(hierarchy->getNumLevels(), 3);
+
+    // Miss everywhere: filled into all three levels
+    ASSERT_TRUE(hierarchy->read(0).success);
+    EXPECT_TRUE(hierarchy->containsInLevel(1, 0));
+    EXPECT_TRUE(hierarchy->containsInLevel(2, 0));
+    EXPECT_TRUE(hierarchy->containsInLevel(3, 0));
+
+    // Evict block 0 from L1 and L2 (both direct-mapped), L3 keeps it
+    ASSERT_TRUE(hierarchy->read(64).success);
+    EXPECT_FALSE(hierarchy->containsInLevel(1, 0));
+    EXPECT_FALSE(hierarchy->containsInLevel(2, 0));
+    EXPECT_TRUE(hierarchy->containsInLevel(3, 0));
+
+    // L3 hit: stops there and refills L1 and L2
+    auto before = hierarchy->getStats();
+    auto result = hierarchy->read(0);
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.value, 0);
+    auto after = hierarchy->getStats();
+
+    EXPECT_EQ(after.level_stats[2].hits, before.level_stats[2].hits + 1);
+    EXPECT_EQ(after.level_stats[2].accesses, before.level_stats[2].accesses + 1);
+    EXPECT_EQ(after.memory_accesses, before.memory_accesses);
+    EXPECT_TRUE(hierarchy->containsInLevel(1, 0));
+    EXPECT_TRUE(hierarchy->containsInLevel(2, 0));
+
+    // L1 hit: lower levels are not accessed
+    hierarchy->read(0);
+    auto last = hierarchy->getStats();
+    EXPECT_EQ(last.level_stats[1].accesses, after.level_stats[1].accesses);
+    EXPECT_EQ(last.level_stats[2].accesses, after.level_stats[2].accesses);
+}
+
+TEST_F(CacheHierarchyTest, ThreeLevel_StatsPerLevel) {
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), std::vector<CacheLevelConfig>{
+        {4, 1, 16, CachePolicy::FIFO},
+        {8, 2, 32, CachePolicy::LRU},
+        {16, 8, 64, CachePolicy::DRRIP}
+    });
+
+    for (Address addr = 0; addr < 2048; addr += 8) {
+        ASSERT_TRUE(hierarchy->read(addr).success);
+    }
+
+    auto stats = hierarchy->getStats();
+    ASSERT_EQ(stats.level_stats.size(), 3);
+    uint64_t total = 0;
+    uint64_t hits = 0;
+    for (const auto& level : stats.level_stats) {
+        EXPECT_EQ(level.hits + level.misses, level.accesses);
+        total += level.accesses;
+        hits += level.hits;
+    }
+    EXPECT_EQ(stats.total_accesses, total);
+    EXPECT_EQ(stats.level_stats[0].hits, stats.l1_stats.hits);
+    EXPECT_EQ(stats.level_stats[1].hits, stats.l2_stats.hits);
+
+    // Every read is served by exactly one level or by memory
+    EXPECT_EQ(hits + stats.memory_accesses, 256);
+    EXPECT_EQ(stats.memory_accesses, 2048 / 64);
+    EXPECT_NE(hierarchy->getStatsString().find("L3 Hits"), std::string::npos);
+}
+
+TEST_F(CacheHierarchyTest, LevelAccessors_OutOfRange) {
+    EXPECT_THROW(CacheHierarchy(memory.get(), std::vector<CacheLevelConfig>{}), std::invalid_argument);
+
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), std::vector<CacheLevelConfig>{
+        {4, 1, 16, CachePolicy::LRU}
+    });
+    EXPECT_NE(hierarchy->getL1(), nullptr);
+    EXPECT_EQ(hierarchy->getL2(), nullptr);
+    EXPECT_EQ(hierarchy->getLevel(0), nullptr);
+    EXPECT_FALSE(hierarchy->containsInL2(0));
+    EXPECT_FALSE(hierarchy->setPrefetcher(2, nullptr).success);
+
+    ASSERT_TRUE(hierarchy->read(0).success);
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.level_stats.size(), 1);
+    EXPECT_EQ(stats.l2_stats.accesses, 0);
+    EXPECT_EQ(stats.memory_accesses, 1);
+}
+
+// ===== Inclusion Policy Tests =====
+
+TEST_F(CacheHierarchyTest, Inclusive_BackInvalidatesUpperLevel) {
+    std::vector<CacheLevelConfig> levels = {
+        {4, 1, 16, CachePolicy::LRU},   // L1: 4 blocks
+        {1, 2, 16, CachePolicy::LRU}    // L2: 2 blocks (smaller than L1)
+    };
+
+    // NINE: L2 evicting block 0 leaves L1's copy alone
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), levels, InclusionPolicy::NINE);
+    hierarchy->read(0);
+    hierarchy->read(16);
+    hierarchy->read(32);
+    EXPECT_TRUE(hierarchy->containsInL1(0));
+    EXPECT_FALSE(hierarchy->containsInL2(0));
+    EXPECT_EQ(hierarchy->getStats().back_invalidations, 0);
+
+    // Inclusive: the L2 eviction back-invalidates L1
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), levels, InclusionPolicy::INCLUSIVE);
+    hierarchy->read(0);
+    hierarchy->read(16);
+    hierarchy->read(32);
+    EXPECT_FALSE(hierarchy->containsInL1(0));
+    EXPECT_FALSE(hierarchy->containsInL2(0));
+    EXPECT_EQ(hierarchy->getStats().back_invalidations, 1);
+    EXPECT_NE(hierarchy->getStatsString().find("Back-Invalidations: 1"), std::string::npos);
+}
+
+TEST_F(CacheHierarchyTest, Inclusive_LowerLevelsHoldSuperset) {
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), std::vector<CacheLevelConfig>{
+        {4, 2, 16, CachePolicy::LRU},
+        {4, 2, 32, CachePolicy::FIFO},
+        {8, 2, 64, CachePolicy::LRU}
+    }, InclusionPolicy::INCLUSIVE);
+
+    for (size_t i = 0; i < 2000; i++) {
+        Address addr = (i * 2654435761u) % 4096;  // Pseudo-random
+        auto result = hierarchy->read(addr);
+        ASSERT_TRUE(result.success);
+        EXPECT_EQ(result.value, static_cast<uint8_t>(addr % 256));
+    }
+
+    for (Address block = 0; block < 4096; block += 16) {
+        if (hierarchy->containsInLevel(1, block)) {
+            EXPECT_TRUE(hierarchy->containsInLevel(2, block));
+        }
+        if (hierarchy->containsInLevel(2, block)) {
+            EXPECT_TRUE(hierarchy->containsInLevel(3, block));
+        }
+    }
+    EXPECT_GT(hierarchy->getStats().back_invalidations, 0);
+}
+
+TEST_F(CacheHierarchyTest, Exclusive_SwapsL1VictimIntoL2) {
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), std::vector<CacheLevelConfig>{
+        {1, 1, 16, CachePolicy::LRU},
+        {1, 2, 16, CachePolicy::LRU}
+    }, InclusionPolicy::EXCLUSIVE);
+
+    hierarchy->read(0);    // Memory -> L1 only
+    EXPECT_TRUE(hierarchy->containsInL1(0));
+    EXPECT_FALSE(hierarchy->containsInL2(0));
+
+    hierarchy->read(16);   // L1 victim 0 moves to L2
+    EXPECT_TRUE(hierarchy->containsInL1(16));
+    EXPECT_TRUE(hierarchy->containsInL2(0));
+
+    auto result = hierarchy->read(0);   // L2 hit: 0 and 16 swap places
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.value, 0);
+    EXPECT_TRUE(hierarchy->containsInL1(0));
+    EXPECT_FALSE(hierarchy->containsInL2(0));
+    EXPECT_TRUE(hierarchy->containsInL2(16));
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.l2_stats.hits, 1);
+    EXPECT_EQ(stats.memory_accesses, 2);
+}
+
+TEST_F(CacheHierarchyTest, Exclusive_AddsCapacityOverNine) {
+    std::vector<CacheLevelConfig> levels = {
+        {1, 1, 16, CachePolicy::LRU},
+        {1, 2, 16, CachePolicy::LRU}
+    };
+
+    // Three blocks cycled: only fits when L1 and L2 do not duplicate
+    auto run = [&](InclusionPolicy inclusion) {
+        hierarchy = std::make_unique<CacheHierarchy>(memory.get(), levels, inclusion);
+        for (int pass = 0; pass < 10; pass++) {
+            for (Address addr : {0, 16, 32}) {
+                hierarchy->read(addr);
+            }
+        }
+        return hierarchy->getStats().memory_accesses;
+    };
+
+    EXPECT_EQ(run(InclusionPolicy::EXCLUSIVE), 3);
+    EXPECT_EQ(run(InclusionPolicy::NINE), 30);
+}
+
+TEST_F(CacheHierarchyTest, Exclusive_RequiresEqualBlockSizes) {
+    EXPECT_THROW(CacheHierarchy(memory.get(), std::vector<CacheLevelConfig>{
+        {4, 1, 16, CachePolicy::LRU},
+        {8, 2, 32, CachePolicy::LRU}
+    }, InclusionPolicy::EXCLUSIVE), std::invalid_argument);
+}
+
+// ===== Victim / Miss Cache Tests =====
+
+TEST_F(CacheHierarchyTest, VictimCacheRecoversConflictMisses) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,    // Direct-mapped L1
+        16, 4, 16, CachePolicy::LRU
+    );
+    ASSERT_TRUE(hierarchy->setVictimCache(2).success);
+
+    // 0 and 64 map to the same L1 set and keep evicting each other
+    for (int i = 0; i < 10; i++) {
+        auto result = hierarchy->read(i % 2 == 0 ? 0 : 64);
+        ASSERT_TRUE(result.success);
+        EXPECT_EQ(result.value, i % 2 == 0 ? 0 : 64);
+    }
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.l1_stats.hits, 0);
+    EXPECT_EQ(stats.victim_stats.accesses, 10);
+    EXPECT_EQ(stats.victim_stats.hits, 8);
+    EXPECT_EQ(stats.l2_stats.accesses, 2);    // Only the cold misses got past the buffer
+    EXPECT_EQ(stats.memory_accesses, 2);
+
+    // Swapping keeps each block in exactly one of L1 and the buffer
+    EXPECT_TRUE(hierarchy->containsInL1(64));
+    EXPECT_FALSE(hierarchy->containsInVictimCache(64));
+    EXPECT_TRUE(hierarchy->containsInVictimCache(0));
+    EXPECT_FALSE(hierarchy->containsInL1(0));
+
+    // Writes keep the buffered copy current
+    ASSERT_TRUE(hierarchy->write(0, 99).success);
+    EXPECT_EQ(hierarchy->read(0).value, 99);
+
+    std::string stats_str = hierarchy->getStatsString();
+    EXPECT_NE(stats_str.find("Victim Cache"), std::string::npos);
+}
+
+TEST_F(CacheHierarchyTest, VictimCacheServesSingleLevelHierarchy) {
+    hierarchy = std::make_unique<CacheHierarchy>(memory.get(), std::vector<CacheLevelConfig>{
+        {1, 1, 64, CachePolicy::LRU}   // One line: 0 and 64 evict each other
+    });
+    ASSERT_TRUE(hierarchy->setVictimCache(4).success);
+
+    hierarchy->read(0);
+    hierarchy->read(64);
+    auto result = hierarchy->read(0);    // Served by the buffer, not by memory
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.value, 0);
+
+    auto stats = hierarchy->getStats();
+    EXPECT_EQ(stats.victim_stats.hits, 1);
+    EXPECT_EQ(stats.memory_accesses, 2);
+    EXPECT_TRUE(hierarchy->containsInL1(0));
+    EXPECT_TRUE(hierarchy->containsInVictimCache(64));
+}
+
+TEST_F(CacheHierarchyTest, MissCacheKeepsCopyOnHit) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        16, 4, 16, CachePolicy::LRU
+    );
+    ASSERT_TRUE(hierarchy->setVictimCache(2, VictimCacheMode::MISS).success);
+
+    hierarchy->read(0);
+    EXPECT_TRUE(hierarchy->containsInL1(0));
+    EXPECT_TRUE(hierarchy->containsInVictimCache(0));
+
+    hierarchy->read(64);     // Evicts 0 from L1; both blocks now buffered
+    auto before = hierarchy->getStats();
+    hierarchy->read(0);      // Reloaded from the miss cache
+    auto after = hierarchy->getStats();
+
+    EXPECT_EQ(after.victim_stats.hits - before.victim_stats.hits, 1);
+    EXPECT_EQ(after.l2_stats.accesses, before.l2_stats.accesses);
+    EXPECT_TRUE(hierarchy->containsInL1(0));
+    EXPECT_TRUE(hierarchy->containsInVictimCache(0));
+    EXPECT_TRUE(hierarchy->containsInVictimCache(64));
+}
+
+TEST_F(CacheHierarchyTest, ExclusiveVictimCacheCascadesToL2) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        std::vector<CacheLevelConfig>{
+            {4, 1, 16, CachePolicy::LRU},
+            {16, 4, 16, CachePolicy::LRU}
+        },
+        InclusionPolicy::EXCLUSIVE
+    );
+    EXPECT_FALSE(hierarchy->setVictimCache(2, VictimCacheMode::MISS).success);
+    ASSERT_TRUE(hierarchy->setVictimCache(1).success);
+
+    hierarchy->read(0);
+    hierarchy->read(64);     // 0 moves to the buffer
+    hierarchy->read(128);    // 64 moves to the buffer, pushing 0 on to L2
+
+    EXPECT_TRUE(hierarchy->containsInL1(128));
+    EXPECT_TRUE(hierarchy->containsInVictimCache(64));
+    EXPECT_FALSE(hierarchy->containsInL2(64));
+    EXPECT_TRUE(hierarchy->containsInL2(0));
+    EXPECT_FALSE(hierarchy->containsInVictimCache(0));
+}
+
+TEST_F(CacheHierarchyTest, InclusiveEvictionBackInvalidatesVictimCache) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        std::vector<CacheLevelConfig>{
+            {4, 1, 16, CachePolicy::LRU},
+            {1, 2, 16, CachePolicy::LRU}
+        },
+        InclusionPolicy::INCLUSIVE
+    );
+    ASSERT_TRUE(hierarchy->setVictimCache(4).success);
+
+    hierarchy->read(0);
+    hierarchy->read(64);     // 0 moves to the buffer; L2 holds 0 and 64
+    ASSERT_TRUE(hierarchy->containsInVictimCache(0));
+
+    hierarchy->read(128);    // L2 evicts 0, which must leave the buffer too
+    EXPECT_FALSE(hierarchy->containsInL2(0));
+    EXPECT_FALSE(hierarchy->containsInVictimCache(0));
+    EXPECT_GE(hierarchy->getStats().back_invalidations, 1);
+}
+
+// ===== Set Sampling Tests =====
+
+TEST_F(CacheHierarchyTest, StrideSamplingSimulatesEveryNthSet) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        8, 2, 16, CachePolicy::LRU,
+        16, 4, 16, CachePolicy::LRU
+    );
+    hierarchy->read(16);
+    ASSERT_TRUE(hierarchy->setSetSampling(4, SetSamplingMode::STRIDE).success);
+    EXPECT_FALSE(hierarchy->containsInL1(16));   // Enabling sampling flushes
+
+    auto value = hierarchy->read(16);            // L1 set 1: skipped
+    ASSERT_TRUE(value.success);
+    EXPECT_EQ(value.value, 16);
+    EXPECT_FALSE(hierarchy->containsInL1(16));
+    hierarchy->read(64);                         // L1 set 4: simulated
+    EXPECT_TRUE(hierarchy->containsInL1(64));
+
+    // A write to a skipped set still reaches memory
+    ASSERT_TRUE(hierarchy->write(17, 99).success);
+    EXPECT_EQ(memory->read(17).value, 99);
+
+    SamplingStats sampling = hierarchy->getSamplingStats();
+    EXPECT_EQ(sampling.sampling_level, 1);
+    EXPECT_EQ(sampling.sampled_sets, 2);
+    EXPECT_EQ(sampling.total_sets, 8);
+    EXPECT_EQ(sampling.requests, 3);
+    EXPECT_EQ(sampling.simulated_requests, 1);
+    EXPECT_EQ(hierarchy->getStats().l1_stats.accesses, 2);  // The read before sampling, then 64
+}
+
+TEST_F(CacheHierarchyTest, SetSamplingRejectsBadRatios) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        8, 2, 16, CachePolicy::LRU,
+        4, 4, 16, CachePolicy::LRU
+    );
+    EXPECT_FALSE(hierarchy->setSetSampling(0).success);
+    EXPECT_FALSE(hierarchy->setSetSampling(8).success);   // L2 has only 4 sets
+    ASSERT_TRUE(hierarchy->setSetSampling(4, SetSamplingMode::STRIDE).success);
+    EXPECT_EQ(hierarchy->getSamplingStats().sampling_level, 2);
+
+    // Back to exact mode: every access is simulated
+    ASSERT_TRUE(hierarchy->setSetSampling(1).success);
+    hierarchy->read(16);
+    hierarchy->read(16);
+    SamplingStats sampling = hierarchy->getSamplingStats();
+    EXPECT_EQ(sampling.simulated_requests, 2);
+    EXPECT_DOUBLE_EQ(sampling.levels[0].miss_ratio, 50.0);
+    EXPECT_DOUBLE_EQ(sampling.levels[0].margin, 0.0);
+}
+
+TEST(CacheHierarchySamplingTest, EstimateCoversExactMissRatio) {
+    const size_t memory_size = 64 * 1024;
+    std::vector<Address> trace;
+    for (uint64_t i = 0; i < 200000; i++) {
+        // A hot 4 KB region plus uniform accesses over the whole memory
+        uint64_t span = (i % 4 == 0) ? memory_size : 4096;
+        trace.push_back((i * 2654435761u) % span);
+    }
+    std::vector<CacheLevelConfig> levels = {
+        {64, 4, 32, CachePolicy::LRU},
+        {256, 8, 32, CachePolicy::LRU}
+    };
+
+    PhysicalMemory exact_memory(memory_size);
+    CacheHierarchy exact(&exact_memory, levels);
+    for (Address address : trace) {
+        exact.read(address);
+    }
+
+    for (SetSamplingMode mode : {SetSamplingMode::HASH, SetSamplingMode::STRIDE}) {
+        PhysicalMemory memory(memory_size);
+        CacheHierarchy sampled(&memory, levels);
+        ASSERT_TRUE(sampled.setSetSampling(8, mode).success);
+        for (Address address : trace) {
+            sampled.read(address);
+        }
+
+        SamplingStats sampling = sampled.getSamplingStats();
+        EXPECT_EQ(sampling.requests, trace.size());
+        EXPECT_LT(sampling.simulated_requests, trace.size() / 4);
+        for (size_t i = 0; i < levels.size(); i++) {
+            CacheStats truth = exact.getStats().level_stats[i];
+            const SampledEstimate& estimate = sampling.levels[i];
+            ASSERT_GT(estimate.margin, 0.0);
+            EXPECT_NEAR(estimate.miss_ratio, truth.getMissRatio(), estimate.margin);
+            EXPECT_NEAR(static_cast<double>(estimate.accesses), truth.accesses, truth.accesses * 0.1);
+        }
+    }
+}
+
+TEST_F(CacheHierarchyTest, SamplingGroupsWholeSetsAcrossBlockSizes) {
+    // L1 indexes address bits 4-5, L2 bits 5-7: only bit 5 is shared
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 2, 16, CachePolicy::LRU,
+        8, 4, 32, CachePolicy::LRU
+    );
+    EXPECT_FALSE(hierarchy->setSetSampling(4).success);
+    ASSERT_TRUE(hierarchy->setSetSampling(2, SetSamplingMode::STRIDE).success);
+    SamplingStats sampling = hierarchy->getSamplingStats();
+    EXPECT_EQ(sampling.sampling_level, 0);
+    EXPECT_EQ(sampling.first_index_bit, 5u);
+    EXPECT_EQ(sampling.total_sets, 2u);
+
+    // Both halves of a 32-byte L2 block are simulated, so the second is an L2 hit
+    hierarchy->read(0);
+    hierarchy->read(16);
+    hierarchy->read(32);                          // Bit 5 set: skipped
+    EXPECT_EQ(hierarchy->getStats().level_stats[1].accesses, 2);
+    EXPECT_EQ(hierarchy->getStats().level_stats[1].hits, 1);
+    EXPECT_FALSE(hierarchy->containsInL1(32));
+
+    // 64-byte L1 blocks over 2 sets (bit 6) and 16-byte L2 blocks over 4 sets (bits 4-5)
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        2, 2, 64, CachePolicy::LRU,
+        4, 2, 16, CachePolicy::LRU
+    );
+    EXPECT_FALSE(hierarchy->setSetSampling(2).success);
+    EXPECT_TRUE(hierarchy->setSetSampling(1).success);
+}
+
+TEST(CacheHierarchySamplingTest, EstimateCoversExactMissRatioAcrossBlockSizes) {
+    const size_t memory_size = 64 * 1024;
+    std::vector<Address> trace;
+    for (uint64_t i = 0; i < 200000; i++) {
+        // Sequential runs through a hot region plus scattered accesses, so L2 gets spatial hits
+        uint64_t span = (i % 4 == 0) ? memory_size : 8192;
+        trace.push_back(((i / 8) * 2654435761u + (i % 8) * 16) % span);
+    }
+    // L1 indexes bits 5-10, L2 bits 6-12: sampling groups by bits 6-10
+    std::vector<CacheLevelConfig> levels = {
+        {64, 4, 32, CachePolicy::LRU},
+        {128, 8, 64, CachePolicy::LRU}
+    };
+
+    PhysicalMemory exact_memory(memory_size);
+    CacheHierarchy exact(&exact_memory, levels);
+    for (Address address : trace) {
+        exact.read(address);
+    }
+
+    PhysicalMemory memory(memory_size);
+    CacheHierarchy sampled(&memory, levels);
+    ASSERT_TRUE(sampled.setSetSampling(4, SetSamplingMode::STRIDE).success);
+    for (Address address : trace) {
+        sampled.read(address);
+    }
+    SamplingStats sampling = sampled.getSamplingStats();
+    EXPECT_EQ(sampling.first_index_bit, 6u);
+    for (size_t i = 0; i < levels.size(); i++) {
+        CacheStats truth = exact.getStats().level_stats[i];
+        const SampledEstimate& estimate = sampling.levels[i];
+        ASSERT_GT(estimate.margin, 0.0);
+        EXPECT_NEAR(estimate.miss_ratio, truth.getMissRatio(), estimate.margin) << "L" << (i + 1);
+    }
+}
+
 // ===== Large Hierarchy Test =====
 
+TEST_F(CacheHierarchyTest, LatencyModelChargesProbedLevels) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+    // Defaults: L1 4, L2 12, memory 200 cycles
+    hierarchy->read(0);                       // Misses both levels
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 216u);
+    hierarchy->read(0);                       // L1 hit
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 4u);
+    hierarchy->read(16);                      // Other half of the 32-byte L2 block
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 16u);
+    hierarchy->write(0, 7);                   // Held by L1
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 4u);
+    hierarchy->write(1000, 7);                // Held nowhere: no write-allocate
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 216u);
+
+    LatencyStats latency = hierarchy->getStats().latency;
+    EXPECT_EQ(latency.reads.count, 3u);
+    EXPECT_EQ(latency.reads.total_cycles, 236u);
+    EXPECT_EQ(latency.writes.total_cycles, 220u);
+    EXPECT_EQ(latency.reads.max_cycles, 216u);
+    EXPECT_DOUBLE_EQ(latency.getAMAT(), 456.0 / 5);
+    EXPECT_EQ(latency.reads.buckets[2], 1u);   // 4 cycles
+    EXPECT_EQ(latency.reads.buckets[4], 1u);   // 16 cycles
+    EXPECT_EQ(latency.reads.buckets[7], 1u);   // 216 cycles
+    EXPECT_EQ(latency.writes.buckets[7], 1u);
+    EXPECT_NE(hierarchy->getStatsString().find("AMAT: 91.20 cycles"), std::string::npos);
+}
+
+TEST_F(CacheHierarchyTest, CustomLatenciesIncludeVictimLookup) {
+    hierarchy = std::make_unique<CacheHierarchy>(
+        memory.get(),
+        4, 1, 16, CachePolicy::LRU,
+        8, 2, 32, CachePolicy::LRU
+    );
+    LatencyConfig latencies;
+    latencies.hit_cycles = {1};
+    EXPECT_FALSE(hierarchy->setLatencies(latencies).success);   // One per level
+
+    latencies.hit_cycles = {1, 10};
+    latencies.victim_cycles = 2;
+    latencies.memory_cycles = 100;
+    ASSERT_TRUE(hierarchy->setLatencies(latencies).success);
+    ASSERT_TRUE(hierarchy->setVictimCache(2).success);
+
+    hierarchy->read(0);                       // L1, buffer, L2 and memory
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 113u);
+    hierarchy->read(64);                      // Conflicts with 0 in L1, which moves to the buffer
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 113u);
+    hierarchy->read(0);                       // Recovered from the buffer
+    EXPECT_EQ(hierarchy->getLastAccessCycles(), 3u);
+}
+
 TEST(CacheHierarchyLargeTest, LargeHierarchy) {
     PhysicalMemory memory(1024 * 1024);  // 1 MB
 
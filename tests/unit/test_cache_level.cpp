@@ -279,6 +279,326 @@ TEST_F(CacheLevelSetAssociativeTest, LFU_AccessCounting) {
     EXPECT_TRUE(cache->contains(64));
 }
 
+TEST_F(CacheLevelSetAssociativeTest, LFU_TieBreaksOnOldest) {
+    cache = std::make_unique<CacheLevel>(
+        1, 1, 4, 16, CachePolicy::LFU, memory.get()
+    );
+
+    cache->read(0);
+    cache->read(16);
+    cache->read(32);
+    cache->read(48);
+    cache->read(0);    // 0 -> count 2
+    cache->read(16);   // 16 -> count 2
+    cache->read(64);   // Count-1 candidates: 32 (older), 48 -> evict 32
+
+    EXPECT_FALSE(cache->contains(32));
+    EXPECT_TRUE(cache->contains(48));
+}
+
+TEST_F(CacheLevelSetAssociativeTest, LFU_AgingEvictsStaleHotLine) {
+    auto run = [&](uint64_t aging_interval) {
+        cache = std::make_unique<CacheLevel>(1, 1, 2, 16, CachePolicy::LFU, memory.get());
+        cache->setLfuAgingInterval(aging_interval);
+
+        // Line 0 is very hot early on
+        for (int i = 0; i < 64; i++) {
+            cache->read(0);
+        }
+        // Then the working set shifts to 16/32/48, repeated pairwise
+        for (int round = 0; round < 40; round++) {
+            for (Address addr : {16, 32, 48}) {
+                cache->read(addr);
+                cache->read(addr);
+            }
+        }
+        return cache->contains(0);
+    };
+
+    EXPECT_TRUE(run(0));    // Without aging the stale line is never evicted
+    EXPECT_FALSE(run(8));   // Halving lets it decay and be replaced
+}
+
+TEST_F(CacheLevelSetAssociativeTest, LFU_DefaultAgingInterval) {
+    cache = std::make_unique<CacheLevel>(
+        1, 4, 2, 16, CachePolicy::LFU, memory.get()
+    );
+    EXPECT_EQ(cache->getLfuAgingInterval(), CacheLevel::LFU_AGING_LINES_FACTOR * 4 * 2);
+
+    CacheLevel lru(1, 4, 2, 16, CachePolicy::LRU, memory.get());
+    EXPECT_EQ(lru.getLfuAgingInterval(), 0u);
+}
+
+TEST_F(CacheLevelSetAssociativeTest, LFUDA_AgesOutStaleHotLine) {
+    cache = std::make_unique<CacheLevel>(
+        1, 1, 2, 16, CachePolicy::LFU_DA, memory.get()
+    );
+
+    for (int i = 0; i < 8; i++) {
+        cache->read(0);     // Key 8
+    }
+    // Each eviction raises the set age to the victim's key, so new lines
+    // are inserted with ever-higher priority until they overtake line 0
+    for (Address addr = 16; addr < 16 * 40; addr += 16) {
+        cache->read(addr);
+        cache->read(addr);
+    }
+
+    EXPECT_FALSE(cache->contains(0));
+
+    testing::internal::CaptureStdout();
+    cache->dump();
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE(output.find("Key:"), std::string::npos);
+}
+
+TEST(FrequencyBucketsTest, OrdersByKeyThenAge) {
+    FrequencyBuckets buckets(4);
+    EXPECT_TRUE(buckets.empty());
+
+    buckets.insert(0, 1);
+    buckets.insert(1, 1);
+    buckets.insert(2, 1);
+    EXPECT_EQ(buckets.victim(), 0u);
+
+    buckets.increment(0);
+    EXPECT_EQ(buckets.victim(), 1u);
+    EXPECT_EQ(buckets.getKey(0), 2u);
+
+    buckets.promote(1, 7);
+    buckets.remove(2);
+    EXPECT_EQ(buckets.victim(), 0u);
+
+    buckets.insert(3, 3);
+    buckets.age();  // Keys 2,3,7 -> 1,1,3; ways 0 and 3 share a bucket
+    EXPECT_EQ(buckets.getKey(3), 1u);
+    EXPECT_EQ(buckets.getKey(1), 3u);
+    EXPECT_EQ(buckets.victim(), 0u);
+
+    buckets.clear();
+    EXPECT_TRUE(buckets.empty());
+    EXPECT_FALSE(buckets.contains(0));
+}
+
+// ===== Pseudo-LRU Replacement Policy Tests =====
+
+TEST_F(CacheLevelSetAssociativeTest, TreePLRU_InvalidAssociativity) {
+    EXPECT_THROW({
+        cache = std::make_unique<CacheLevel>(
+            1, 4, 3, 16, CachePolicy::TREE_PLRU, memory.get()
+        );
+    }, std::invalid_argument);
+
+    EXPECT_THROW({
+        cache = std::make_unique<CacheLevel>(
+            1, 1, 128, 16, CachePolicy::BIT_PLRU, memory.get()
+        );
+    }, std::invalid_argument);
+}
+
+TEST_F(CacheLevelSetAssociativeTest, TreePLRU_Replacement) {
+    // 4-way, 1 set: every block maps to set 0
+    cache = std::make_unique<CacheLevel>(
+        1, 1, 4, 16, CachePolicy::TREE_PLRU, memory.get()
+    );
+
+    cache->read(0);    // way 0
+    cache->read(16);   // way 1
+    cache->read(32);   // way 2
+    cache->read(48);   // way 3
+    cache->read(0);    // Hit way 0 - tree now points to the right half
+    cache->read(32);   // Hit way 2 - tree points to way 1 (left half, right leaf)
+    cache->read(64);   // Evicts way 1
+
+    EXPECT_TRUE(cache->contains(0));
+    EXPECT_FALSE(cache->contains(16));
+    EXPECT_TRUE(cache->contains(32));
+    EXPECT_TRUE(cache->contains(48));
+    EXPECT_TRUE(cache->contains(64));
+}
+
+TEST_F(CacheLevelSetAssociativeTest, TreePLRU_MatchesLRUForTwoWays) {
+    // With two ways tree-PLRU degenerates to exact LRU
+    cache = std::make_unique<CacheLevel>(
+        1, 4, 2, 16, CachePolicy::TREE_PLRU, memory.get()
+    );
+
+    cache->read(0);
+    cache->read(64);
+    cache->read(0);
+    cache->read(128);  // Evicts 64
+
+    EXPECT_TRUE(cache->contains(0));
+    EXPECT_FALSE(cache->contains(64));
+    EXPECT_TRUE(cache->contains(128));
+}
+
+TEST_F(CacheLevelSetAssociativeTest, BitPLRU_Replacement) {
+    cache = std::make_unique<CacheLevel>(
+        1, 1, 4, 16, CachePolicy::BIT_PLRU, memory.get()
+    );
+
+    cache->read(0);    // MRU = {0}
+    cache->read(16);   // MRU = {0,1}
+    cache->read(32);   // MRU = {0,1,2}
+    cache->read(48);   // All set - reset to {3}
+    cache->read(16);   // MRU = {1,3}
+    cache->read(64);   // Evicts way 0 (first clear bit)
+
+    EXPECT_FALSE(cache->contains(0));
+    EXPECT_TRUE(cache->contains(16));
+    EXPECT_TRUE(cache->contains(48));
+    EXPECT_TRUE(cache->contains(64));
+
+    cache->read(80);   // MRU = {0,1,3} -> evicts way 2 (address 32)
+    EXPECT_FALSE(cache->contains(32));
+    EXPECT_TRUE(cache->contains(80));
+}
+
+TEST_F(CacheLevelSetAssociativeTest, PLRU_HotLineSurvivesStream) {
+    // 8-way: a line touched between every miss is never the PLRU victim
+    for (auto policy : {CachePolicy::TREE_PLRU, CachePolicy::BIT_PLRU}) {
+        cache = std::make_unique<CacheLevel>(1, 1, 8, 16, policy, memory.get());
+
+        cache->read(0);
+        for (Address addr = 16; addr < 1024; addr += 16) {
+            cache->read(addr);
+            cache->read(0);
+        }
+        EXPECT_TRUE(cache->contains(0)) << cachePolicyToString(policy);
+    }
+}
+
+TEST_F(CacheLevelSetAssociativeTest, PLRU_FlushResetsState) {
+    cache = std::make_unique<CacheLevel>(
+        1, 1, 4, 16, CachePolicy::TREE_PLRU, memory.get()
+    );
+
+    for (Address addr = 0; addr < 64; addr += 16) {
+        cache->read(addr);
+    }
+    cache->flush();
+
+    // Refill after flush uses ways in order, then victim is way 0 again
+    for (Address addr = 128; addr < 192; addr += 16) {
+        cache->read(addr);
+    }
+    cache->read(256);
+    EXPECT_FALSE(cache->contains(128));
+    EXPECT_TRUE(cache->contains(256));
+}
+
+// ===== RRIP Replacement Policy Tests =====
+
+TEST_F(CacheLevelSetAssociativeTest, SRRIP_HotLinesSurviveScan) {
+    // 4-way, 1 set
+    cache = std::make_unique<CacheLevel>(
+        1, 1, 4, 16, CachePolicy::SRRIP, memory.get()
+    );
+
+    // Two hot lines, re-referenced (RRPV 0)
+    cache->read(0);
+    cache->read(16);
+    cache->read(0);
+    cache->read(16);
+
+    // Short scan of 4 never-reused blocks
+    for (Address addr = 256; addr < 320; addr += 16) {
+        cache->read(addr);
+    }
+
+    EXPECT_TRUE(cache->contains(0));
+    EXPECT_TRUE(cache->contains(16));
+}
+
+TEST_F(CacheLevelSetAssociativeTest, LRU_LosesHotLinesToScan) {
+    // Same pattern as above: LRU is not scan resistant
+    cache = std::make_unique<CacheLevel>(
+        1, 1, 4, 16, CachePolicy::LRU, memory.get()
+    );
+
+    cache->read(0);
+    cache->read(16);
+    cache->read(0);
+    cache->read(16);
+    for (Address addr = 256; addr < 320; addr += 16) {
+        cache->read(addr);
+    }
+
+    EXPECT_FALSE(cache->contains(0));
+    EXPECT_FALSE(cache->contains(16));
+}
+
+TEST_F(CacheLevelSetAssociativeTest, BRRIP_ThrashResistant) {
+    // Cyclic working set of 5 blocks in a 4-way set: LRU never hits
+    auto run = [&](CachePolicy policy) {
+        cache = std::make_unique<CacheLevel>(1, 1, 4, 16, policy, memory.get());
+        for (int round = 0; round < 50; round++) {
+            for (Address addr = 0; addr < 80; addr += 16) {
+                cache->read(addr);
+            }
+        }
+        return cache->getStats().hits;
+    };
+
+    EXPECT_EQ(run(CachePolicy::LRU), 0u);
+    EXPECT_GT(run(CachePolicy::BRRIP), 100u);
+}
+
+TEST(CacheLevelRripTest, DRRIP_SetDuelingPicksBRRIPUnderThrashing) {
+    PhysicalMemory memory(64 * 1024);
+
+    // 128 sets -> 16 leaders each, stride 8: sets 0,8,.. SRRIP leaders; 4,12,.. BRRIP leaders
+    CacheLevel drrip(2, 128, 4, 16, CachePolicy::DRRIP, &memory);
+    CacheLevel srrip(2, 128, 4, 16, CachePolicy::SRRIP, &memory);
+    uint32_t initial_psel = drrip.getPsel();
+
+    // Cyclic footprint of 5 blocks per set (cache holds 4)
+    const Address stride = 128 * 16;
+    for (int round = 0; round < 40; round++) {
+        for (Address block = 0; block < 5; block++) {
+            for (Address set = 0; set < 128; set++) {
+                drrip.read(block * stride + set * 16);
+                srrip.read(block * stride + set * 16);
+            }
+        }
+    }
+
+    EXPECT_GT(drrip.getPsel(), initial_psel);
+    EXPECT_GT(drrip.getStats().hits, srrip.getStats().hits);
+    EXPECT_NE(drrip.getConfigString().find("PSEL"), std::string::npos);
+}
+
+TEST(CacheLevelRripTest, DRRIP_FollowerSetsFollowPsel) {
+    PhysicalMemory memory(64 * 1024);
+    EXPECT_THROW(CacheLevel(2, 2, 4, 16, CachePolicy::DRRIP, &memory), std::invalid_argument);
+
+    // 8 sets: set 0 leads SRRIP, set 4 leads BRRIP, the other six follow PSEL
+    const Address stride = 8 * 16;
+    auto thrash = [&](CacheLevel& cache, Address set, int rounds) {
+        for (int round = 0; round < rounds; round++) {
+            for (Address block = 0; block < 5; block++) {
+                cache.read(block * stride + set * 16);
+            }
+        }
+    };
+    auto followerHits = [&](Address leader_set) {
+        CacheLevel cache(2, 8, 4, 16, CachePolicy::DRRIP, &memory);
+        thrash(cache, leader_set, 4);           // Leader misses move PSEL
+        uint32_t psel = cache.getPsel();
+        uint64_t hits = cache.getStats().hits;
+        thrash(cache, 1, 50);                   // Follower misses leave it alone
+        EXPECT_EQ(cache.getPsel(), psel);
+        return cache.getStats().hits - hits;
+    };
+
+    // SRRIP leader misses select BRRIP for followers, which keeps part of the loop
+    uint64_t brrip_hits = followerHits(0);
+    uint64_t srrip_hits = followerHits(4);
+    EXPECT_GT(brrip_hits, 100u);
+    EXPECT_LT(srrip_hits, brrip_hits);
+}
+
 // ===== Flush Tests =====
 
 TEST_F(CacheLevelDirectMappedTest, Flush) {
@@ -362,6 +682,175 @@ TEST_F(CacheLevelDirectMappedTest, ContainsBlockRange) {
     EXPECT_FALSE(cache->contains(16));
 }
 
+// ===== Lookup / Fill / Invalidate Tests =====
+
+TEST_F(CacheLevelSetAssociativeTest, ProbeDoesNotAllocateOnMiss) {
+    cache = std::make_unique<CacheLevel>(
+        2, 2, 2, 16, CachePolicy::LRU, memory.get()
+    );
+
+    CacheProbe probe = cache->probe(40);
+    EXPECT_FALSE(probe.hit);
+    EXPECT_FALSE(cache->contains(40));
+
+    cache->fill(40);
+    probe = cache->probe(40);
+    ASSERT_TRUE(probe.hit);
+    EXPECT_EQ(cache->readData(probe), 40);
+
+    auto stats = cache->getStats();
+    EXPECT_EQ(stats.accesses, 2);
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+}
+
+TEST_F(CacheLevelSetAssociativeTest, FillUsesProbedWay) {
+    cache = std::make_unique<CacheLevel>(
+        2, 2, 2, 16, CachePolicy::LRU, memory.get()
+    );
+
+    // A miss probe remembers the free way; filling through it turns it into a hit
+    CacheProbe probe = cache->probe(0x24);
+    ASSERT_FALSE(probe.hit);
+    EXPECT_NE(probe.way, CacheProbe::NO_WAY);
+    EXPECT_FALSE(cache->fill(probe, 0x24).valid);
+    ASSERT_TRUE(probe.hit);
+    EXPECT_EQ(cache->readData(probe), 0x24);
+
+    cache->writeData(probe, 0xAB);
+    EXPECT_EQ(cache->readData(cache->peek(0x24)), 0xAB);
+
+    // Set 0 is now full: a miss probe carries no way and fill picks the LRU victim
+    cache->fill(0x40);
+    probe = cache->peek(0x60);
+    EXPECT_EQ(probe.way, CacheProbe::NO_WAY);
+    CacheEviction eviction = cache->fill(probe, 0x60);
+    ASSERT_TRUE(eviction.valid);
+    EXPECT_EQ(eviction.block_address, 0x20);
+
+    // Peeking never touches the statistics
+    EXPECT_EQ(cache->getStats().accesses, 1);
+}
+
+TEST_F(CacheLevelSetAssociativeTest, FillAfterInvalidateReusesFreedWay) {
+    cache = std::make_unique<CacheLevel>(
+        2, 2, 2, 16, CachePolicy::LRU, memory.get()
+    );
+
+    cache->fill(0x20);
+    cache->fill(0x40);
+    CacheProbe probe = cache->peek(0x60);
+    ASSERT_EQ(probe.way, CacheProbe::NO_WAY);
+
+    // A line invalidated after the probe is reused instead of evicting a valid one
+    cache->invalidate(0x40);
+    EXPECT_FALSE(cache->fill(probe, 0x60).valid);
+    EXPECT_TRUE(cache->contains(0x20));
+    EXPECT_TRUE(cache->contains(0x60));
+}
+
+TEST_F(CacheLevelSetAssociativeTest, FillReportsEvictedBlock) {
+    cache = std::make_unique<CacheLevel>(
+        2, 2, 2, 16, CachePolicy::LRU, memory.get()
+    );
+
+    // Blocks 0x20, 0x40 and 0x60 all map to set 0 (2 sets x 16 bytes)
+    EXPECT_FALSE(cache->fill(0x20).valid);
+    EXPECT_FALSE(cache->fill(0x45).valid);
+    EXPECT_FALSE(cache->fill(0x40).valid);   // Already present: no change
+
+    CacheEviction eviction = cache->fill(0x60);
+    ASSERT_TRUE(eviction.valid);
+    EXPECT_EQ(eviction.block_address, 0x20);
+    EXPECT_EQ(cache->getStats().accesses, 0);
+}
+
+TEST_F(CacheLevelSetAssociativeTest, InvalidateFreesWayForLfu) {
+    cache = std::make_unique<CacheLevel>(
+        2, 1, 2, 16, CachePolicy::LFU, memory.get()
+    );
+
+    cache->read(0);
+    cache->read(0);
+    cache->read(16);
+    EXPECT_TRUE(cache->invalidate(0));
+    EXPECT_FALSE(cache->invalidate(0));
+    EXPECT_FALSE(cache->contains(0));
+
+    // The freed way is reused before the remaining line is evicted
+    cache->read(32);
+    EXPECT_TRUE(cache->contains(16));
+    EXPECT_TRUE(cache->contains(32));
+    cache->read(48);
+    EXPECT_EQ(cache->contains(16) + cache->contains(32), 1);
+}
+
+// ===== 3C Miss Classification Tests =====
+
+TEST_F(CacheLevelDirectMappedTest, MissClassification_ConflictMisses) {
+    cache = std::make_unique<CacheLevel>(
+        1, 4, 1, 16, CachePolicy::LRU, memory.get()
+    );
+    cache->setMissClassification(true);
+
+    // 0 and 64 share set 0; a 4-line fully-associative cache would hold both
+    for (int i = 0; i < 10; i++) {
+        cache->read(i % 2 == 0 ? 0 : 64);
+    }
+
+    auto stats = cache->getStats();
+    EXPECT_EQ(stats.misses, 10);
+    EXPECT_EQ(stats.compulsory_misses, 2);
+    EXPECT_EQ(stats.capacity_misses, 0);
+    EXPECT_EQ(stats.conflict_misses, 8);
+}
+
+TEST_F(CacheLevelSetAssociativeTest, MissClassification_CapacityMisses) {
+    auto big_memory = std::make_unique<PhysicalMemory>(65536);
+    cache = std::make_unique<CacheLevel>(
+        1, 2, 2, 16, CachePolicy::LRU, big_memory.get()
+    );
+    cache->setMissClassification(true);
+
+    // Two sweeps over 4096 blocks: first touches, then a working set far beyond 4 lines
+    for (int pass = 0; pass < 2; pass++) {
+        for (Address addr = 0; addr < 65536; addr += 16) {
+            cache->read(addr);
+        }
+    }
+
+    auto stats = cache->getStats();
+    EXPECT_EQ(stats.compulsory_misses, 4096);
+    EXPECT_EQ(stats.capacity_misses, 4096);
+    EXPECT_EQ(stats.conflict_misses, 0);
+    EXPECT_EQ(stats.compulsory_misses + stats.capacity_misses + stats.conflict_misses,
+              stats.misses);
+    cache.reset();
+}
+
+TEST_F(CacheLevelSetAssociativeTest, MissClassification_DisabledByDefault) {
+    cache = std::make_unique<CacheLevel>(
+        1, 4, 2, 16, CachePolicy::LRU, memory.get()
+    );
+    EXPECT_FALSE(cache->isMissClassificationEnabled());
+
+    cache->read(0);
+    cache->read(512);
+    EXPECT_EQ(cache->getStats().compulsory_misses, 0);
+    EXPECT_EQ(cache->getStatsString().find("Compulsory"), std::string::npos);
+
+    // A hit marks the block as seen, so its miss after a flush is not compulsory
+    cache->setMissClassification(true);
+    cache->read(0);
+    cache->flush();
+    cache->read(0);
+    cache->read(256);
+    auto stats = cache->getStats();
+    EXPECT_EQ(stats.compulsory_misses, 1);
+    EXPECT_EQ(stats.capacity_misses, 1);
+    EXPECT_NE(cache->getStatsString().find("Compulsory"), std::string::npos);
+}
+
 // ===== Dump and Stats String Tests =====
 
 TEST_F(CacheLevelDirectMappedTest, DumpDoesNotCrash) {
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "virtual_memory/clock_pro.h"
+#include <array>
+#include <unordered_map>
+
+using namespace memsim;
+
+TEST(ClockProTest, TestPeriodHitsTurnPagesHot) {
+    std::array<PageTableEntry, 8> ptes;
+    ClockPro clock(4);
+    for (uint64_t page = 0; page < 4; page++) {
+        EXPECT_FALSE(clock.insert(page, &ptes[page]));
+    }
+    EXPECT_EQ(clock.getColdPages(), 4u);
+    EXPECT_EQ(clock.getColdTarget(), 1u);
+
+    // The cold hand starts at the oldest page; evicted, it stays as a test page
+    uint64_t victim = 0;
+    ASSERT_TRUE(clock.selectVictim(victim));
+    EXPECT_EQ(victim, 0u);
+    EXPECT_EQ(clock.getTestPages(), 1u);
+    clock.remove(0);                              // Eviction leaves the test page alone
+    EXPECT_EQ(clock.getTestPages(), 1u);
+
+    // Faulting it back within its test period: hot, and cold pages earn a frame
+    EXPECT_TRUE(clock.insert(0, &ptes[0]));
+    EXPECT_EQ(clock.getHotPages(), 1u);
+    EXPECT_EQ(clock.getTestPages(), 0u);
+    EXPECT_EQ(clock.getColdTarget(), 2u);
+
+    // A referenced cold page in its test period turns hot instead of being evicted
+    ptes[1].referenced = true;
+    ASSERT_TRUE(clock.selectVictim(victim));
+    EXPECT_EQ(victim, 2u);
+    EXPECT_FALSE(ptes[1].referenced);
+    EXPECT_EQ(clock.getHotPages(), 2u);
+
+    clock.remove(3);
+    EXPECT_EQ(clock.getColdPages(), 0u);
+    clock.clear();
+    EXPECT_EQ(clock.getHotPages() + clock.getColdPages() + clock.getTestPages(), 0u);
+    EXPECT_FALSE(clock.selectVictim(victim));
+    EXPECT_THROW(ClockPro(1), std::invalid_argument);
+}
+
+TEST(ClockProTest, TestPagesStayBounded) {
+    // Entries keyed by page; unordered_map keeps them in place as others come and go
+    std::unordered_map<uint64_t, PageTableEntry> resident;
+    ClockPro clock(4);
+    for (uint64_t page = 0; page < 4; page++) {
+        clock.insert(page, &resident[page]);
+    }
+    EXPECT_FALSE(clock.insert(0, &resident[0]));  // Already resident: nothing changes
+    uint64_t victim = 0;
+    ASSERT_TRUE(clock.selectVictim(victim));
+    resident.erase(victim);
+    EXPECT_TRUE(clock.insert(victim, &resident[victim]));
+    EXPECT_EQ(clock.getColdTarget(), 2u);
+
+    // A long scan of pages used once: test periods expire and the cold target shrinks back
+    for (uint64_t page = 100; page < 200; page++) {
+        ASSERT_TRUE(clock.selectVictim(victim));
+        resident.erase(victim);
+        clock.insert(page, &resident[page]);
+        EXPECT_LE(clock.getTestPages(), 4u);
+        EXPECT_EQ(clock.getHotPages() + clock.getColdPages(), 4u);
+    }
+    EXPECT_EQ(clock.getColdTarget(), 1u);
+    EXPECT_EQ(resident.size(), 4u);
+}
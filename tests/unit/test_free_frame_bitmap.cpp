@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "virtual_memory/free_frame_bitmap.h"
+#include "virtual_memory/virtual_memory.h"
+#include "memory/physical_memory.h"
+
+using namespace memsim;
+
+TEST(FreeFrameBitmapTest, FindsLowestFreeFrameAcrossWords) {
+    // 5000 frames: 79 words, two summary words, a partial last word
+    FreeFrameBitmap bitmap(5000);
+    size_t frame = 0;
+    ASSERT_TRUE(bitmap.findFree(frame));
+    EXPECT_EQ(frame, 0u);
+
+    bitmap.allocate(0, 4500);
+    EXPECT_EQ(bitmap.getFreeFrames(), 500u);
+    ASSERT_TRUE(bitmap.findFree(frame));
+    EXPECT_EQ(frame, 4500u);                      // In the second summary word
+
+    bitmap.release(70);
+    ASSERT_TRUE(bitmap.findFree(frame));
+    EXPECT_EQ(frame, 70u);
+    EXPECT_TRUE(bitmap.isFree(70));
+    bitmap.allocate(70);
+    bitmap.allocate(70);                          // Allocating twice counts once
+    EXPECT_EQ(bitmap.getFreeFrames(), 500u);
+
+    bitmap.allocate(4500, 500);
+    EXPECT_EQ(bitmap.getFreeFrames(), 0u);
+    EXPECT_FALSE(bitmap.findFree(frame));
+
+    bitmap.reset();
+    EXPECT_EQ(bitmap.getFreeFrames(), 5000u);
+    EXPECT_TRUE(bitmap.isFree(4999));
+}
+
+TEST(FreeFrameBitmapTest, CursorFollowsLowestFreeFrame) {
+    // 20000 frames: five summary words
+    FreeFrameBitmap bitmap(20000);
+    size_t frame = 0;
+    for (size_t expected = 0; expected < 20000; expected++) {
+        ASSERT_TRUE(bitmap.findFree(frame));
+        ASSERT_EQ(frame, expected);
+        bitmap.allocate(frame);
+    }
+    EXPECT_FALSE(bitmap.findFree(frame));
+
+    // Releases move the cursor back; refilling a summary word moves it forward again
+    bitmap.release(12345);
+    bitmap.release(9000);
+    ASSERT_TRUE(bitmap.findFree(frame));
+    EXPECT_EQ(frame, 9000u);
+    bitmap.allocate(9000);
+    ASSERT_TRUE(bitmap.findFree(frame));
+    EXPECT_EQ(frame, 12345u);
+    bitmap.allocate(12345);
+    EXPECT_FALSE(bitmap.findFree(frame));
+
+    bitmap.release(19999);
+    ASSERT_TRUE(bitmap.findFreeRun(1, frame));
+    EXPECT_EQ(frame, 19999u);
+}
+
+TEST(FreeFrameBitmapTest, FindsAlignedRuns) {
+    FreeFrameBitmap bitmap(300);
+    size_t first = 0;
+
+    // Runs inside a word must start at a multiple of their length
+    bitmap.allocate(1);
+    ASSERT_TRUE(bitmap.findFreeRun(4, first));
+    EXPECT_EQ(first, 4u);
+    bitmap.allocate(9);
+    ASSERT_TRUE(bitmap.findFreeRun(8, first));
+    EXPECT_EQ(first, 16u);
+    ASSERT_TRUE(bitmap.findFreeRun(32, first));
+    EXPECT_EQ(first, 32u);
+
+    // Runs of whole words skip any word with an allocated frame
+    ASSERT_TRUE(bitmap.findFreeRun(64, first));
+    EXPECT_EQ(first, 64u);
+    ASSERT_TRUE(bitmap.findFreeRun(128, first));
+    EXPECT_EQ(first, 128u);
+    bitmap.allocate(200);
+    EXPECT_FALSE(bitmap.findFreeRun(128, first));  // Frames 256-299 are too few
+    EXPECT_FALSE(bitmap.findFreeRun(512, first));
+}
+
+TEST(FreeFrameBitmapTest, VirtualMemoryReportsFreeFrames) {
+    PhysicalMemory memory(4096);
+    VirtualMemory vm(&memory, 32, 16, 256, PageReplacementPolicy::CLOCK);
+    EXPECT_EQ(vm.getStats().free_frames, 16u);
+
+    for (size_t page = 0; page < 20; page++) {
+        vm.read(page * 256);
+    }
+    auto stats = vm.getStats();
+    EXPECT_EQ(stats.free_frames, 0u);
+    EXPECT_EQ(stats.min_free_frames, 0u);
+
+    vm.flush();
+    vm.read(0);
+    stats = vm.getStats();
+    EXPECT_EQ(stats.free_frames, 15u);
+    EXPECT_EQ(stats.min_free_frames, 0u);         // The low watermark survives a flush
+    EXPECT_EQ(vm.translate(256).value, 256u);     // Lowest free frame after frame 0
+}
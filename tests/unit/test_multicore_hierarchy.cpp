@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "cache/multicore_hierarchy.h"
+#include "memory/physical_memory.h"
+
+using namespace memsim;
+
+class MultiCoreHierarchyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memory = std::make_unique<PhysicalMemory>(4096);
+        for (size_t i = 0; i < 4096; i++) {
+            memory->write(i, static_cast<uint8_t>(i % 256));
+        }
+    }
+
+    std::unique_ptr<MultiCoreHierarchy> build(size_t cores, CoherenceProtocol protocol) {
+        return std::make_unique<MultiCoreHierarchy>(
+            memory.get(), cores,
+            CacheLevelConfig{4, 2, 64, CachePolicy::LRU},
+            CacheLevelConfig{16, 4, 64, CachePolicy::LRU},
+            protocol
+        );
+    }
+
+    std::unique_ptr<PhysicalMemory> memory;
+};
+
+TEST_F(MultiCoreHierarchyTest, ReadersShareACleanBlock) {
+    auto hierarchy = build(2, CoherenceProtocol::MESI);
+
+    EXPECT_EQ(hierarchy->read(0, 100).value, 100);
+    EXPECT_EQ(hierarchy->getState(0, 100), CoherenceState::EXCLUSIVE);
+    EXPECT_EQ(hierarchy->getStats().memory_accesses, 1);
+
+    // The exclusive holder supplies the block and both end up shared
+    EXPECT_EQ(hierarchy->read(1, 101).value, 101);
+    EXPECT_EQ(hierarchy->getState(0, 100), CoherenceState::SHARED);
+    EXPECT_EQ(hierarchy->getState(1, 100), CoherenceState::SHARED);
+    EXPECT_EQ(hierarchy->getStats().interventions, 1);
+    EXPECT_EQ(hierarchy->getStats().memory_accesses, 1);
+
+    EXPECT_FALSE(hierarchy->read(2, 100).success);
+    EXPECT_THROW(build(0, CoherenceProtocol::MESI), std::invalid_argument);
+}
+
+TEST_F(MultiCoreHierarchyTest, WriteInvalidatesOtherCopies) {
+    auto hierarchy = build(3, CoherenceProtocol::MESI);
+    hierarchy->read(0, 0);
+    hierarchy->read(1, 0);
+    hierarchy->read(2, 0);
+
+    ASSERT_TRUE(hierarchy->write(0, 5, 42).success);
+    EXPECT_EQ(hierarchy->getState(0, 0), CoherenceState::MODIFIED);
+    EXPECT_EQ(hierarchy->getState(1, 0), CoherenceState::INVALID);
+    EXPECT_EQ(hierarchy->getState(2, 0), CoherenceState::INVALID);
+    EXPECT_EQ(hierarchy->getStats().upgrades, 1);
+    EXPECT_EQ(hierarchy->getStats().invalidations, 2);
+
+    // A write miss takes ownership from the modified holder
+    ASSERT_TRUE(hierarchy->write(1, 6, 43).success);
+    EXPECT_EQ(hierarchy->getState(0, 0), CoherenceState::INVALID);
+    EXPECT_EQ(hierarchy->getState(1, 0), CoherenceState::MODIFIED);
+    EXPECT_EQ(hierarchy->getStats().interventions, 2);  // The second reader's fetch, then this one
+    EXPECT_EQ(hierarchy->getStats().invalidations, 3);
+
+    EXPECT_EQ(hierarchy->read(2, 5).value, 42);
+    EXPECT_EQ(hierarchy->read(2, 6).value, 43);
+}
+
+TEST_F(MultiCoreHierarchyTest, MoesiSharesDirtyBlockWithoutWriteback) {
+    auto mesi = build(2, CoherenceProtocol::MESI);
+    mesi->write(0, 0, 1);
+    mesi->read(1, 0);
+    EXPECT_EQ(mesi->getState(0, 0), CoherenceState::SHARED);
+    EXPECT_EQ(mesi->getStats().writebacks, 1);
+
+    auto moesi = build(2, CoherenceProtocol::MOESI);
+    moesi->write(0, 0, 1);
+    moesi->read(1, 0);
+    EXPECT_EQ(moesi->getState(0, 0), CoherenceState::OWNED);
+    EXPECT_EQ(moesi->getState(1, 0), CoherenceState::SHARED);
+    EXPECT_EQ(moesi->getStats().writebacks, 0);
+
+    // The owner writing again must upgrade; evicting the dirty line writes it back
+    moesi->write(0, 0, 2);
+    EXPECT_EQ(moesi->getStats().upgrades, 1);
+    EXPECT_EQ(moesi->getState(1, 0), CoherenceState::INVALID);
+    moesi->read(0, 256);   // Same L1 set (4 sets of 64 bytes), 2 ways
+    moesi->read(0, 512);
+    EXPECT_EQ(moesi->getState(0, 0), CoherenceState::INVALID);
+    EXPECT_EQ(moesi->getStats().writebacks, 1);
+}
+
+TEST_F(MultiCoreHierarchyTest, CountsFalseSharingMisses) {
+    auto hierarchy = build(2, CoherenceProtocol::MESI);
+
+    // Core 1 reads byte 32 of a block; core 0 keeps writing byte 0
+    hierarchy->read(1, 32);
+    hierarchy->write(0, 0, 7);
+    hierarchy->read(1, 32);
+    EXPECT_EQ(hierarchy->getStats().coherence_misses, 1);
+    EXPECT_EQ(hierarchy->getStats().false_sharing_misses, 1);
+
+    // Reading the byte that was actually written is true sharing
+    hierarchy->write(0, 0, 8);
+    EXPECT_EQ(hierarchy->read(1, 0).value, 8);
+    EXPECT_EQ(hierarchy->getStats().coherence_misses, 2);
+    EXPECT_EQ(hierarchy->getStats().false_sharing_misses, 1);
+
+    // A capacity miss after an ordinary eviction is not a coherence miss
+    hierarchy->read(1, 256);
+    hierarchy->read(1, 512);
+    hierarchy->read(1, 0);
+    EXPECT_EQ(hierarchy->getStats().coherence_misses, 2);
+}
+
+TEST_F(MultiCoreHierarchyTest, RanksFalselySharedLines) {
+    auto hierarchy = build(2, CoherenceProtocol::MESI);
+    hierarchy->setFalseSharingDetection(true);
+
+    for (int i = 0; i < 10; i++) {
+        // Line 0: each core writes its own half, and also reads it back
+        hierarchy->write(0, 0, 1);
+        hierarchy->write(1, 40, 1);
+        hierarchy->read(0, 1);
+        hierarchy->read(1, 41);
+        // Line 64: both cores write the same byte (true sharing)
+        hierarchy->write(0, 64, 2);
+        hierarchy->write(1, 64, 2);
+        // Line 128: written by core 0 only
+        hierarchy->write(0, 128, 3);
+        hierarchy->read(0, 128);
+    }
+
+    auto lines = hierarchy->getFalseSharingLines(5);
+    ASSERT_EQ(lines.size(), 1);
+    const FalseSharingLine& line = lines[0];
+    EXPECT_EQ(line.block_address, 0);
+    EXPECT_TRUE(line.disjoint_writes);
+    EXPECT_GT(line.false_sharing_misses, 10);
+    EXPECT_EQ(line.false_sharing_misses, line.coherence_misses);
+    ASSERT_EQ(line.writers.size(), 2);
+    EXPECT_EQ(line.writers[0].core, 0);
+    EXPECT_EQ(line.writers[0].first_byte, 0);
+    EXPECT_EQ(line.writers[0].last_byte, 0);
+    EXPECT_EQ(line.writers[1].core, 1);
+    EXPECT_EQ(line.writers[1].first_byte, 40);
+    EXPECT_EQ(line.writers[1].bytes_written, 1);
+
+    EXPECT_TRUE(hierarchy->getFalseSharingLines(0).empty());
+    hierarchy->setFalseSharingDetection(false);
+    EXPECT_TRUE(hierarchy->getFalseSharingLines(5).empty());
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "virtual_memory/page_replacer.h"
+#include "virtual_memory/virtual_memory.h"
+#include "memory/physical_memory.h"
+#include <set>
+
+using namespace memsim;
+
+namespace {
+
+// Drive a replacer the way VirtualMemory does and count the faults
+size_t countFaults(IPageReplacer& replacer, size_t capacity, const std::vector<uint64_t>& pages) {
+    std::set<uint64_t> resident;
+    size_t faults = 0;
+    for (uint64_t page : pages) {
+        if (resident.count(page)) {
+            replacer.onAccess(page);
+            continue;
+        }
+        faults++;
+        replacer.onFault(page);
+        if (resident.size() == capacity) {
+            uint64_t victim = 0;
+            EXPECT_TRUE(replacer.selectVictim(victim));
+            EXPECT_EQ(resident.erase(victim), 1u);
+            replacer.onEvict(victim);
+        }
+        resident.insert(page);
+        replacer.insert(page);
+    }
+    return faults;
+}
+
+// Two hot pages touched twice, a one-pass scan, then the hot pages again
+std::vector<uint64_t> hotThenScan(size_t hot, size_t scan) {
+    std::vector<uint64_t> pages;
+    for (int round = 0; round < 2; round++) {
+        for (uint64_t page = 1; page <= hot; page++) {
+            pages.push_back(page);
+        }
+    }
+    for (uint64_t page = 100; page < 100 + scan; page++) {
+        pages.push_back(page);
+    }
+    for (uint64_t page = 1; page <= hot; page++) {
+        pages.push_back(page);
+    }
+    return pages;
+}
+
+} // namespace
+
+TEST(PageReplacerTest, ArcResistsScansAndAdapts) {
+    ArcReplacer arc(4);
+    EXPECT_EQ(countFaults(arc, 4, hotThenScan(2, 20)), 22u);   // Hot pages survive the scan
+    EXPECT_EQ(arc.getTarget(), 0u);
+
+    // 117 was evicted from T1 a moment ago: its ghost hit grows T1's target
+    ArcReplacer adapting(4);
+    std::vector<uint64_t> pages = hotThenScan(2, 20);
+    pages.push_back(117);
+    EXPECT_EQ(countFaults(adapting, 4, pages), 23u);
+    EXPECT_GT(adapting.getTarget(), 0u);
+    EXPECT_NE(arc.getStateString().find("T1 target"), std::string::npos);
+
+    arc.reset();
+    EXPECT_EQ(arc.getTarget(), 0u);
+}
+
+TEST(PageReplacerTest, TwoQueueKeepsReusedPagesOutOfScans) {
+    TwoQueueReplacer two_q(8);
+    // 1 and 2 fault twice (A1in, then from A1out into Am), the scan stays in A1in
+    std::vector<uint64_t> pages = {1, 2, 50, 51, 52};
+    std::vector<uint64_t> rest = hotThenScan(2, 40);
+    pages.insert(pages.end(), rest.begin(), rest.end());
+    EXPECT_EQ(countFaults(two_q, 8, pages), 2u + 3u + 2u + 40u);
+}
+
+TEST(PageReplacerTest, LirsKeepsLirPagesResident) {
+    LirsReplacer lirs(4);
+    EXPECT_EQ(countFaults(lirs, 4, hotThenScan(3, 20)), 23u);
+    EXPECT_EQ(lirs.getLirPages(), 3u);
+    EXPECT_EQ(lirs.getResidentHirPages(), 1u);
+    EXPECT_LE(lirs.getNonResidentPages(), 4u);
+
+    EXPECT_THROW(LirsReplacer(1), std::invalid_argument);
+}
+
+TEST(PageReplacerTest, PrefetchedPagesGetNoReuseCredit) {
+    // Fault in 1 and 2, then 3 in place of a victim, which is left as a ghost
+    auto evictOne = [](IPageReplacer& replacer) {
+        for (uint64_t page : {1, 2}) {
+            replacer.onFault(page);
+            replacer.insert(page);
+        }
+        replacer.onFault(3);
+        uint64_t victim = 0;
+        EXPECT_TRUE(replacer.selectVictim(victim));
+        replacer.onEvict(victim);
+        replacer.insert(3);
+        return victim;
+    };
+
+    // Prefetched while remembered, the victim enters as a first fault would
+    ArcReplacer arc(2);
+    arc.insertPrefetched(evictOne(arc));
+    EXPECT_EQ(arc.getListSize(0), 3u);   // T1
+    EXPECT_EQ(arc.getListSize(1), 0u);   // T2
+    EXPECT_EQ(arc.getListSize(2), 0u);   // B1
+    EXPECT_EQ(arc.getTarget(), 0u);
+
+    TwoQueueReplacer two_q(2);
+    two_q.insertPrefetched(evictOne(two_q));
+    EXPECT_EQ(two_q.getListSize(1), 0u);   // Am
+    EXPECT_EQ(two_q.getListSize(2), 0u);   // A1out
+
+    LirsReplacer lirs(2);
+    lirs.insertPrefetched(evictOne(lirs));
+    EXPECT_EQ(lirs.getLirPages(), 1u);
+    EXPECT_EQ(lirs.getResidentHirPages(), 2u);
+    EXPECT_EQ(lirs.getNonResidentPages(), 0u);
+}
+
+TEST(PageReplacerTest, OptimalMatchesBelady) {
+    // Belady's anomaly sequence: OPT needs 7 faults with 3 frames
+    std::vector<uint64_t> pages = {1, 2, 3, 4, 1, 2, 5, 1, 2, 3, 4, 5};
+    OptimalReplacer opt;
+    opt.setFuture(pages);
+    EXPECT_EQ(opt.nextUse(1, 0), 0u);
+    EXPECT_EQ(opt.nextUse(1, 1), 4u);
+    EXPECT_EQ(opt.nextUse(5, 12), OptimalReplacer::NEVER);
+    EXPECT_EQ(countFaults(opt, 3, pages), 7u);
+
+    // Through VirtualMemory, against FIFO's 9
+    std::vector<Address> addresses;
+    for (uint64_t page : pages) {
+        addresses.push_back(page * 4096);
+    }
+    for (auto policy : {PageReplacementPolicy::OPTIMAL, PageReplacementPolicy::FIFO}) {
+        PhysicalMemory memory(3 * 4096);
+        VirtualMemory vm(&memory, 16, 3, 4096, policy);
+        if (policy == PageReplacementPolicy::OPTIMAL) {
+            ASSERT_TRUE(vm.setOptimalTrace(addresses).success);
+        } else {
+            EXPECT_FALSE(vm.setOptimalTrace(addresses).success);
+        }
+        for (Address address : addresses) {
+            ASSERT_TRUE(vm.read(address).success);
+        }
+        EXPECT_EQ(vm.getStats().page_faults, policy == PageReplacementPolicy::OPTIMAL ? 7u : 9u);
+    }
+}
+
+TEST(PageReplacerTest, OptimalSkipsOutOfRangeAddresses) {
+    // The Belady sequence again with a rejected address after the first
+    // 2; counting it would leave OPT one access behind (9 faults)
+    std::vector<Address> addresses = {1 * 4096, 2 * 4096, 16 * 4096};
+    for (uint64_t page : {3, 4, 1, 2, 5, 1, 2, 3, 4, 5}) {
+        addresses.push_back(page * 4096);
+    }
+    PhysicalMemory memory(3 * 4096);
+    VirtualMemory vm(&memory, 16, 3, 4096, PageReplacementPolicy::OPTIMAL);
+    ASSERT_TRUE(vm.setOptimalTrace(addresses).success);
+    for (Address address : addresses) {
+        EXPECT_EQ(vm.read(address).success, address < 16 * 4096);
+    }
+    EXPECT_EQ(vm.getStats().page_faults, 7u);
+}
+
+TEST(PageReplacerTest, EveryPolicyFaultsAtLeastAsOftenAsOptimal) {
+    std::vector<Address> addresses;
+    uint64_t state = 12345;
+    for (size_t i = 0; i < 2000; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t page = (state >> 33) % 4 == 0 ? (state >> 40) % 48 : (state >> 40) % 6;
+        addresses.push_back(page * 256);
+    }
+
+    auto faults = [&](PageReplacementPolicy policy) {
+        PhysicalMemory memory(8 * 256);
+        VirtualMemory vm(&memory, 64, 8, 256, policy);
+        if (policy == PageReplacementPolicy::OPTIMAL) {
+            vm.setOptimalTrace(addresses);
+        }
+        for (Address address : addresses) {
+            vm.read(address);
+        }
+        return vm.getStats().page_faults;
+    };
+
+    uint64_t optimal = faults(PageReplacementPolicy::OPTIMAL);
+    for (auto policy : {PageReplacementPolicy::FIFO, PageReplacementPolicy::LRU,
+                        PageReplacementPolicy::CLOCK, PageReplacementPolicy::CLOCK_PRO,
+                        PageReplacementPolicy::ARC, PageReplacementPolicy::TWO_Q,
+                        PageReplacementPolicy::LIRS}) {
+        EXPECT_GE(faults(policy), optimal) << pageReplacementPolicyToString(policy);
+    }
+    EXPECT_GT(faults(PageReplacementPolicy::FIFO), optimal);
+}
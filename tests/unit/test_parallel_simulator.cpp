@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "analysis/parallel_simulator.h"
+#include "analysis/trace_ring.h"
+#include "memory/physical_memory.h"
+#include <thread>
+
+using namespace memsim;
+
+// ===== Trace Chunk Ring Tests =====
+
+TEST(TraceChunkRingTest, EveryConsumerSeesEveryChunkInOrder) {
+    constexpr size_t NUM_CONSUMERS = 3;
+    constexpr uint64_t NUM_CHUNKS = 200;
+    TraceChunkRing ring(4, NUM_CONSUMERS);
+
+    std::vector<uint64_t> next_expected(NUM_CONSUMERS, 0);
+    std::vector<bool> in_order(NUM_CONSUMERS, true);
+    std::vector<std::thread> consumers;
+    for (size_t c = 0; c < NUM_CONSUMERS; c++) {
+        consumers.emplace_back([&, c]() {
+            while (const std::vector<TraceRecord>* chunk = ring.acquireRead(c)) {
+                for (const auto& record : *chunk) {
+                    if (record.address != next_expected[c]) {
+                        in_order[c] = false;
+                    }
+                    next_expected[c]++;
+                }
+                ring.releaseRead(c);
+            }
+        });
+    }
+
+    // Chunk i holds records 2i and 2i + 1; the ring is far smaller than the stream
+    for (uint64_t i = 0; i < NUM_CHUNKS; i++) {
+        std::vector<TraceRecord>& slot = ring.acquireWrite();
+        slot.assign({{2 * i, false}, {2 * i + 1, true}});
+        ring.commitWrite();
+    }
+    ring.close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    for (size_t c = 0; c < NUM_CONSUMERS; c++) {
+        EXPECT_TRUE(in_order[c]);
+        EXPECT_EQ(next_expected[c], 2 * NUM_CHUNKS);
+    }
+    EXPECT_THROW(TraceChunkRing(0, 1), std::invalid_argument);
+}
+
+// ===== Parallel Simulator Tests =====
+
+TEST(ParallelCacheSimulatorTest, MatchesSequentialSimulation) {
+    constexpr size_t MEMORY_SIZE = 16384;
+    std::vector<TraceRecord> trace;
+    for (uint64_t i = 0; i < 5000; i++) {
+        trace.push_back({(i * 2654435761u) % MEMORY_SIZE, i % 7 == 0});
+    }
+
+    std::vector<SweepConfig> configs = {
+        {{{16, 2, 32, CachePolicy::LRU}}, InclusionPolicy::NINE},
+        {{{8, 4, 64, CachePolicy::DRRIP}, {64, 8, 64, CachePolicy::LRU}}, InclusionPolicy::INCLUSIVE},
+        {{{4, 1, 16, CachePolicy::FIFO}, {32, 4, 16, CachePolicy::LFU}}, InclusionPolicy::EXCLUSIVE}
+    };
+
+    // Small chunks and ring so the decoder wraps around many times
+    ParallelCacheSimulator simulator(MEMORY_SIZE, 64, 4);
+    for (const auto& config : configs) {
+        simulator.addConfig(config);
+    }
+    ASSERT_TRUE(simulator.run(trace).success);
+    EXPECT_EQ(simulator.getRecords(), trace.size());
+    ASSERT_EQ(simulator.getResults().size(), configs.size());
+
+    for (size_t i = 0; i < configs.size(); i++) {
+        PhysicalMemory memory(MEMORY_SIZE);
+        CacheHierarchy cache(&memory, configs[i].levels, configs[i].inclusion);
+        for (const auto& record : trace) {
+            if (record.is_write) {
+                cache.write(record.address, 0);
+            } else {
+                cache.read(record.address);
+            }
+        }
+
+        HierarchyStats expected = cache.getStats();
+        const SweepResult& result = simulator.getResults()[i];
+        EXPECT_EQ(result.errors, 0);
+        EXPECT_EQ(result.stats.memory_accesses, expected.memory_accesses);
+        ASSERT_EQ(result.stats.level_stats.size(), expected.level_stats.size());
+        for (size_t level = 0; level < expected.level_stats.size(); level++) {
+            EXPECT_EQ(result.stats.level_stats[level].hits, expected.level_stats[level].hits);
+            EXPECT_EQ(result.stats.level_stats[level].misses, expected.level_stats[level].misses);
+        }
+    }
+
+    EXPECT_NE(simulator.getReport().find("8x4x64 DRRIP"), std::string::npos);
+}
+
+TEST(ParallelCacheSimulatorTest, ErrorsAndValidation) {
+    ParallelCacheSimulator simulator(1024);
+    EXPECT_FALSE(simulator.run(std::vector<TraceRecord>{{0, false}}).success);
+
+    EXPECT_THROW(simulator.addConfig({{{3, 1, 16, CachePolicy::LRU}}, InclusionPolicy::NINE}),
+                 std::invalid_argument);
+    EXPECT_EQ(simulator.getNumConfigs(), 0);
+
+    // Accesses past the simulated memory are counted, not fatal
+    simulator.addConfig({{{4, 1, 16, CachePolicy::LRU}}, InclusionPolicy::NINE});
+    ASSERT_TRUE(simulator.run(std::vector<TraceRecord>{{0, false}, {4096, false}, {8, true}}).success);
+    EXPECT_EQ(simulator.getResults()[0].errors, 1);
+    EXPECT_EQ(simulator.getResults()[0].stats.l1_stats.misses, 2);   // The failed read still missed
+    EXPECT_EQ(simulator.getResults()[0].stats.l1_stats.hits, 1);     // Write to the cached block
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "virtual_memory/radix_page_table.h"
+#include "virtual_memory/virtual_memory.h"
+#include "cache/cache_hierarchy.h"
+#include "memory/physical_memory.h"
+
+using namespace memsim;
+
+TEST(RadixPageTableTest, AllocatesNodesLazily) {
+    // 48-bit virtual addresses with 4 KB pages: 36-bit page numbers, 9 bits per level
+    RadixPageTable table(36, 4);
+    EXPECT_EQ(table.getLevelBits(0), 9u);
+    EXPECT_EQ(table.getNumNodes(), 1u);
+    EXPECT_EQ(table.find(1ULL << 35), nullptr);
+
+    table.insert(1ULL << 35).valid = true;
+    EXPECT_EQ(table.getNumNodes(), 4u);          // One node per level on the path
+    table.insert((1ULL << 35) + 1).valid = true;
+    EXPECT_EQ(table.getNumNodes(), 4u);          // Same leaf
+    table.insert(0).valid = true;
+    EXPECT_EQ(table.getNumNodes(), 7u);          // Shares only the root
+    EXPECT_EQ(table.getTableBytes(), 7u * 512 * RadixPageTable::PTE_BYTES);
+    ASSERT_NE(table.find(1ULL << 35), nullptr);
+    EXPECT_TRUE(table.find(1ULL << 35)->valid);
+
+    // Uneven split: the lower levels take the extra bits
+    RadixPageTable uneven(10, 3);
+    EXPECT_EQ(uneven.getLevelBits(0), 3u);
+    EXPECT_EQ(uneven.getLevelBits(2), 4u);
+
+    EXPECT_THROW(RadixPageTable(36, 1), std::invalid_argument);
+    EXPECT_THROW(RadixPageTable(36, 6), std::invalid_argument);
+}
+
+TEST(RadixPageTableTest, WalksAndScansValidEntries) {
+    RadixPageTable table(8, 2);                  // 16 entries per node
+    std::vector<uint64_t> offsets;
+    EXPECT_EQ(table.walk(0x35, offsets), 1u);    // Root entry 3 has no node below
+    EXPECT_EQ(offsets[0], 3u * RadixPageTable::PTE_BYTES);
+
+    table.insert(0x35).valid = true;
+    table.insert(0x12).valid = true;
+    table.insert(0x31);                          // Allocated but not valid
+    ASSERT_EQ(table.walk(0x35, offsets), 2u);
+    EXPECT_EQ(offsets[1], 16u * RadixPageTable::PTE_BYTES + 5 * RadixPageTable::PTE_BYTES);
+    EXPECT_EQ(table.prefix(0x35, 0), 0x3u);
+    EXPECT_EQ(table.prefix(0x35, 1), 0x35u);
+
+    std::vector<uint64_t> pages;
+    table.forEachValid([&](uint64_t page, PageTableEntry&) { pages.push_back(page); });
+    EXPECT_EQ(pages, (std::vector<uint64_t>{0x12, 0x35}));
+
+    uint64_t page = 0;
+    EXPECT_TRUE(table.nextValid(0x13, page));
+    EXPECT_EQ(page, 0x35u);
+    EXPECT_FALSE(table.nextValid(0x36, page));
+
+    table.clear();
+    EXPECT_EQ(table.getNumNodes(), 1u);
+    EXPECT_EQ(table.find(0x35), nullptr);
+}
+
+TEST(RadixPageTableTest, PageWalkCacheSkipsUpperLevels) {
+    PhysicalMemory memory(64 * 1024);
+    VirtualMemory vm(&memory, 1ULL << 36, 4, 4096, PageReplacementPolicy::CLOCK, 4);
+    vm.setPageWalkCache(4);
+
+    Address high = 0x7FFF00000000ULL;
+    ASSERT_TRUE(vm.read(high).success);          // Fault: the walk stops at the root
+    EXPECT_EQ(vm.getStats().walk_references, 1u);
+    ASSERT_TRUE(vm.read(high + 4096).success);   // Full walk of the nodes the fault built
+    EXPECT_EQ(vm.getStats().walk_references, 5u);
+    ASSERT_TRUE(vm.read(high + 8192).success);   // Same leaf: only its entry is read
+    EXPECT_EQ(vm.getStats().walk_references, 6u);
+    EXPECT_EQ(vm.getStats().pwc_hits, 1u);
+    EXPECT_EQ(vm.getStats().pwc_misses, 2u);
+    EXPECT_EQ(vm.getPageTable().getNumNodes(), 4u);
+
+    // Evicting pages keeps the clock working over the sparse table
+    for (size_t i = 0; i < 8; i++) {
+        ASSERT_TRUE(vm.read(i * (1ULL << 30)).success);
+    }
+    EXPECT_EQ(vm.getStats().page_faults, 11u);
+
+    vm.flush();
+    EXPECT_EQ(vm.getPageTable().getNumNodes(), 1u);
+    EXPECT_FALSE(vm.peek(high).success);
+}
+
+TEST(RadixPageTableTest, WalkReferencesGoThroughCache) {
+    PhysicalMemory memory(64 * 1024);
+    VirtualMemory vm(&memory, 1ULL << 36, 4, 4096, PageReplacementPolicy::LRU, 4);
+    vm.setTLB(std::make_unique<TLBHierarchy>(TLBConfig{1, 1, TLBPolicy::LRU, 0},
+                                             TLBConfig{1, 1, TLBPolicy::LRU, 7}, 30));
+    CacheHierarchy cache(&memory, 4, 1, 16, CachePolicy::LRU, 8, 2, 32, CachePolicy::LRU);
+    vm.setPageWalkMemory(&cache);
+    EXPECT_TRUE(vm.isPageWalkThroughCache());
+
+    // The table sits after the 4 frames; cold entries cost 216 cycles (L1 + L2 + memory)
+    vm.read(0);                                  // Walk reads the root entry, then faults
+    EXPECT_EQ(vm.getStats().walk_cycles, 216u);
+    EXPECT_EQ(vm.getStats().translation_cycles, 7u + 216u);
+    vm.read(0);                                  // dTLB hit: no walk
+    vm.read(4096);                               // Root entry hits L1, three cold entries below
+    EXPECT_EQ(vm.getStats().walk_references, 5u);
+    EXPECT_EQ(vm.getStats().walk_cycles, 216u + 4u + 3 * 216u);
+    EXPECT_EQ(vm.getStats().translation_cycles, 7u + 216u + 7u + 4u + 3 * 216u);
+
+    vm.setPageWalkMemory(nullptr);
+    vm.read(8192);                               // Back to the fixed walk latency
+    EXPECT_EQ(vm.getStats().translation_cycles, 7u + 216u + 7u + 4u + 3 * 216u + 37u);
+}
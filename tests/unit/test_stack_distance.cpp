@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "analysis/stack_distance.h"
+#include "analysis/trace_reader.h"
+#include "cache/cache_level.h"
+#include "memory/physical_memory.h"
+#include <fstream>
+
+using namespace memsim;
+
+// ===== Stack Distance Tests =====
+
+TEST(StackDistanceTest, HistogramOfSimpleSequence) {
+    StackDistanceAnalyzer analyzer(16);
+
+    // Blocks A B C A B A: A and B are reused at distance 2, then A at distance 1
+    for (Address addr : {0, 16, 32, 4, 20, 8}) {
+        analyzer.access(addr);
+    }
+
+    EXPECT_EQ(analyzer.getAccesses(), 6);
+    EXPECT_EQ(analyzer.getColdMisses(), 3);
+    const auto& histogram = analyzer.getDistanceHistogram();
+    ASSERT_EQ(histogram.size(), 3);
+    EXPECT_EQ(histogram[0], 0);
+    EXPECT_EQ(histogram[1], 1);
+    EXPECT_EQ(histogram[2], 2);
+
+    EXPECT_EQ(analyzer.getMisses(1, 1), 6);
+    EXPECT_EQ(analyzer.getMisses(1, 2), 5);
+    EXPECT_EQ(analyzer.getMisses(1, 3), 3);
+}
+
+TEST(StackDistanceTest, MatchesLruCacheForEveryGeometry) {
+    constexpr size_t MEMORY_SIZE = 8192;
+    constexpr size_t BLOCK_SIZE = 16;
+    PhysicalMemory memory(MEMORY_SIZE);
+
+    // Enough accesses over few blocks to force several timestamp renumberings
+    std::vector<Address> stream;
+    for (uint64_t i = 0; i < 20000; i++) {
+        Address hot = (i * 2654435761u) % 1024;
+        Address cold = (i * 40503u) % MEMORY_SIZE;
+        stream.push_back(i % 4 == 0 ? cold : hot);
+    }
+
+    StackDistanceAnalyzer analyzer(BLOCK_SIZE, 8);
+    for (Address addr : stream) {
+        analyzer.access(addr);
+    }
+
+    for (size_t sets = 1; sets <= 8; sets *= 2) {
+        for (size_t ways = 1; ways <= 8; ways *= 2) {
+            CacheLevel cache(1, sets, ways, BLOCK_SIZE, CachePolicy::LRU, &memory);
+            for (Address addr : stream) {
+                cache.read(addr);
+            }
+            EXPECT_EQ(analyzer.getMisses(sets, ways), cache.getStats().misses)
+                << sets << " sets, " << ways << " ways";
+        }
+    }
+}
+
+TEST(StackDistanceTest, MissRatioCurve) {
+    StackDistanceAnalyzer analyzer(64, 4);
+    for (uint64_t i = 0; i < 5000; i++) {
+        analyzer.access(((i * 2654435761u) % 256) * 64);
+    }
+
+    auto curve = analyzer.getMissRatioCurve(2, 16);
+    ASSERT_EQ(curve.size(), 16);
+    for (size_t i = 0; i < curve.size(); i++) {
+        EXPECT_EQ(curve[i].associativity, i + 1);
+        EXPECT_EQ(curve[i].capacity_bytes, 2 * (i + 1) * 64);
+        EXPECT_EQ(curve[i].misses, analyzer.getMisses(2, i + 1));
+        if (i > 0) {
+            EXPECT_LE(curve[i].misses, curve[i - 1].misses);   // LRU has no Belady anomaly
+        }
+    }
+
+    EXPECT_FALSE(analyzer.isModelled(8));
+    EXPECT_THROW(analyzer.getMisses(8, 1), std::invalid_argument);
+    EXPECT_THROW(StackDistanceAnalyzer(48), std::invalid_argument);
+    EXPECT_NE(analyzer.getReport(16).find("4 sets"), std::string::npos);
+}
+
+// ===== Trace Reader Tests =====
+
+TEST(TraceReaderTest, ParsesReadsWritesAndComments) {
+    std::string path = ::testing::TempDir() + "memsim_trace_reader_test.txt";
+    {
+        std::ofstream out(path);
+        out << "# comment\n"
+            << "R 0x40\n"
+            << "\n"
+            << "w 128\n"
+            << "256\n";
+    }
+
+    TraceReader reader;
+    ASSERT_TRUE(reader.open(path).success);
+    std::vector<TraceRecord> records;
+    auto result = reader.read(records, 2);
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(result.value, 2);
+    EXPECT_EQ(records[0].address, 0x40);
+    EXPECT_FALSE(records[0].is_write);
+    EXPECT_EQ(records[1].address, 128);
+    EXPECT_TRUE(records[1].is_write);
+
+    result = reader.read(records, 2);
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(result.value, 1);
+    EXPECT_EQ(records[0].address, 256);
+    EXPECT_EQ(reader.read(records, 2).value, 0);
+
+    TraceRecord record;
+    EXPECT_FALSE(TraceReader::parseLine("X 10", record).success);
+    EXPECT_FALSE(TraceReader::parseLine("R 12ab", record).success);
+    ASSERT_TRUE(TraceReader::parseLine("W 0x80 3", record).success);
+    EXPECT_EQ(record.core, 3u);
+    EXPECT_TRUE(record.is_write);
+    EXPECT_FALSE(TraceReader::parseLine("R 12 core1", record).success);
+    EXPECT_FALSE(reader.open(path + ".missing").success);
+}
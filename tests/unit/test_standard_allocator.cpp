@@ -366,6 +366,22 @@ TEST_F(StandardAllocatorTest, Dump_ShowsMemoryLayout) {
     EXPECT_FALSE(output.empty());
 }
 
+TEST_F(StandardAllocatorTest, FindBlockIdMapsAddressesToBlocks) {
+    createAllocator(AllocatorType::FIRST_FIT);
+    auto a = allocator->allocate(40);
+    auto b = allocator->allocate(24);
+    ASSERT_TRUE(a.success);
+    ASSERT_TRUE(b.success);
+
+    EXPECT_EQ(allocator->findBlockId(0).value, a.value);
+    EXPECT_EQ(allocator->findBlockId(39).value, a.value);
+    EXPECT_EQ(allocator->findBlockId(40).value, b.value);
+    EXPECT_FALSE(allocator->findBlockId(64).success);   // Free space
+
+    ASSERT_TRUE(allocator->deallocate(a.value).success);
+    EXPECT_FALSE(allocator->findBlockId(0).success);
+}
+
 // ===== Stress Tests =====
 
 TEST_F(StandardAllocatorTest, StressTest_ManySmallAllocations) {
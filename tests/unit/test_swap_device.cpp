@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "virtual_memory/swap_device.h"
+#include "virtual_memory/virtual_memory.h"
+#include "memory/physical_memory.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace memsim;
+
+TEST(SwapDeviceTest, AllocatesAndReusesSlots) {
+    std::string path = ::testing::TempDir() + "memsim_swap_slots";
+    SwapDevice swap;
+    ASSERT_TRUE(swap.open(path, 64).success);
+
+    std::vector<uint8_t> page(64, 0xAB), back(64, 0);
+    EXPECT_FALSE(swap.readPage(7, back.data()).value);   // Never written
+    ASSERT_TRUE(swap.writePage(7, page.data()).success);
+    page[0] = 0xCD;
+    ASSERT_TRUE(swap.writePage(9, page.data()).success);
+    ASSERT_TRUE(swap.writePage(7, page.data()).success);  // Same slot again
+    EXPECT_EQ(swap.getFileSlots(), 2u);
+
+    ASSERT_TRUE(swap.readPage(7, back.data()).value);
+    EXPECT_EQ(back, page);
+
+    swap.release(7);
+    EXPECT_FALSE(swap.hasSlot(7));
+    ASSERT_TRUE(swap.writePage(11, page.data()).success);  // Takes 7's slot
+    EXPECT_EQ(swap.getFileSlots(), 2u);
+    EXPECT_EQ(swap.getStats().writes, 4u);
+    EXPECT_EQ(swap.getStats().bytes_read, 64u);
+    EXPECT_EQ(swap.getStats().peak_slots, 2u);
+
+    swap.releaseAll();
+    EXPECT_EQ(swap.getSlotsInUse(), 0u);
+    EXPECT_FALSE(swap.open("/nonexistent/memsim_swap", 64).success);
+    std::remove(path.c_str());
+}
+
+TEST(SwapDeviceTest, DirtyPagesSurviveEviction) {
+    std::string path = ::testing::TempDir() + "memsim_swap_vm";
+    PhysicalMemory memory(2 * 256);
+    VirtualMemory vm(&memory, 16, 2, 256, PageReplacementPolicy::FIFO);
+    auto swap = std::make_unique<SwapDevice>();
+    ASSERT_TRUE(swap->open(path, 128).success);
+    EXPECT_FALSE(vm.setSwapDevice(std::move(swap)).success);   // Slot size must match
+
+    swap = std::make_unique<SwapDevice>();
+    ASSERT_TRUE(swap->open(path, 256).success);
+    ASSERT_TRUE(vm.setSwapDevice(std::move(swap)).success);
+
+    ASSERT_TRUE(vm.write(0x10, 0x5A).success);
+    ASSERT_TRUE(vm.read(0x110).success);                   // Clean page
+    ASSERT_TRUE(vm.read(0x210).success);                   // Evicts the dirty page
+    ASSERT_TRUE(vm.read(0x310).success);                   // Evicts the clean one
+    EXPECT_EQ(vm.getStats().page_writebacks, 1u);
+    EXPECT_EQ(vm.getStats().clean_evictions, 1u);
+    EXPECT_EQ(vm.getSwapDevice()->getSlotsInUse(), 1u);
+
+    auto value = vm.read(0x10);
+    ASSERT_TRUE(value.success);
+    EXPECT_EQ(value.value, 0x5A);
+    EXPECT_EQ(vm.getSwapDevice()->getStats().reads, 1u);
+    EXPECT_EQ(vm.read(0x110).value, 0x10);                 // Never swapped: its pattern
+
+    vm.flush();
+    EXPECT_EQ(vm.getSwapDevice()->getSlotsInUse(), 0u);
+    ASSERT_TRUE(vm.setSwapDevice(nullptr).success);
+    std::remove(path.c_str());
+}
+
+TEST(SwapDeviceTest, AsyncWritesBatchAndReadBack) {
+    std::string path = ::testing::TempDir() + "memsim_swap_async";
+    SwapDevice swap;
+    EXPECT_FALSE(swap.setAsync(2, 4).success);             // Not open yet
+    ASSERT_TRUE(swap.open(path, 64).success);
+    ASSERT_TRUE(swap.setAsync(2, 4).success);
+    EXPECT_FALSE(swap.setAsync(2, 0).success);
+    EXPECT_TRUE(swap.isAsync());
+
+    std::vector<uint8_t> page(64), back(64);
+    for (uint64_t i = 0; i < 10; i++) {
+        std::fill(page.begin(), page.end(), static_cast<uint8_t>(i));
+        ASSERT_TRUE(swap.writePage(i, page.data()).success);
+    }
+    std::fill(page.begin(), page.end(), 0xEE);
+    ASSERT_TRUE(swap.writePage(9, page.data()).success);    // Replaces the queued copy
+    ASSERT_TRUE(swap.readPage(9, back.data()).value);       // Served from the queued copy
+    EXPECT_EQ(back, page);
+    EXPECT_EQ(swap.getStats().batches, 2u);
+
+    swap.sync();
+    EXPECT_EQ(swap.getQueueDepth(), 0u);
+    EXPECT_EQ(swap.getStats().writes, 10u);
+    EXPECT_GE(swap.getStats().max_queue_depth, 1u);
+    EXPECT_EQ(swap.getStats().completed, 10u);
+
+    EXPECT_TRUE(swap.prefetch(3));
+    EXPECT_FALSE(swap.prefetch(3));                         // Already issued
+    EXPECT_FALSE(swap.prefetch(42));                        // No slot
+    ASSERT_TRUE(swap.readPage(3, back.data()).value);
+    EXPECT_EQ(back, std::vector<uint8_t>(64, 3));
+    EXPECT_EQ(swap.getStats().prefetch_hits, 1u);
+    ASSERT_TRUE(swap.readPage(9, back.data()).value);       // Blocking read of the file
+    EXPECT_EQ(back, page);
+
+    // Back to synchronous I/O with the same slots
+    ASSERT_TRUE(swap.setAsync(0).success);
+    EXPECT_FALSE(swap.prefetch(5));
+    ASSERT_TRUE(swap.readPage(5, back.data()).value);
+    EXPECT_EQ(back, std::vector<uint8_t>(64, 5));
+    swap.close();
+    std::remove(path.c_str());
+}
+
+TEST(SwapDeviceTest, AsyncSwapKeepsDirtyPagesThroughReplay) {
+    std::string path = ::testing::TempDir() + "memsim_swap_replay";
+    PhysicalMemory memory(4 * 256);
+    VirtualMemory vm(&memory, 64, 4, 256, PageReplacementPolicy::LRU);
+    EXPECT_FALSE(vm.setSwapAsync(2, 4).success);           // No device yet
+    auto swap = std::make_unique<SwapDevice>();
+    ASSERT_TRUE(swap->open(path, 256).success);
+    ASSERT_TRUE(vm.setSwapDevice(std::move(swap)).success);
+    ASSERT_TRUE(vm.setSwapAsync(2, 4).success);
+
+    for (int round = 0; round < 3; round++) {
+        for (Address page = 0; page < 32; page++) {
+            if (round == 0) {
+                ASSERT_TRUE(vm.write(page * 256 + 7, static_cast<uint8_t>(page + 100)).success);
+            } else {
+                vm.prefetchSwap((page + 2) * 256);
+                auto value = vm.read(page * 256 + 7);
+                ASSERT_TRUE(value.success);
+                EXPECT_EQ(value.value, page + 100) << "page " << page << ", round " << round;
+            }
+        }
+    }
+    EXPECT_FALSE(vm.prefetchSwap(31 * 256));               // Resident
+    // Each page comes back from a queued write or from the file, prefetched or not
+    const SwapStats& stats = vm.getSwapDevice()->getStats();
+    EXPECT_GT(stats.prefetches + stats.buffer_hits, 0u);
+    EXPECT_EQ(vm.getStats().page_writebacks, 32u);
+    std::remove(path.c_str());
+}
+
+TEST(SwapDeviceTest, AsyncFaultReadsItsPrefetchedPagesTogether) {
+    std::string path = ::testing::TempDir() + "memsim_swap_fault_around";
+    PhysicalMemory memory(8 * 256);
+    VirtualMemory vm(&memory, 64, 8, 256, PageReplacementPolicy::LRU);
+    EXPECT_FALSE(vm.setSwapDelay(100).success);            // No device yet
+    auto swap = std::make_unique<SwapDevice>();
+    ASSERT_TRUE(swap->open(path, 256).success);
+    ASSERT_TRUE(vm.setSwapDevice(std::move(swap)).success);
+    ASSERT_TRUE(vm.setSwapAsync(4, 4).success);
+    for (Address page = 0; page < 32; page++) {
+        ASSERT_TRUE(vm.write(page * 256, static_cast<uint8_t>(page + 100)).success);
+    }
+    ASSERT_TRUE(vm.setSwapAsync(4, 4).success);            // Finishes the writes
+    ASSERT_TRUE(vm.setFaultAround(4).success);
+    ASSERT_TRUE(vm.setSwapDelay(20000).success);
+    EXPECT_EQ(vm.getSwapDevice()->getDeviceDelay(), 20000u);
+
+    // Pages 0-3 are read on the pool at once: about one delay, not four
+    uint64_t hits_before = vm.getSwapDevice()->getStats().prefetch_hits;
+    auto start = std::chrono::steady_clock::now();
+    auto value = vm.read(1 * 256);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(value.success);
+    EXPECT_EQ(value.value, 101);
+    EXPECT_EQ(vm.getSwapDevice()->getStats().prefetch_hits - hits_before, 4u);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(60));
+
+    uint64_t faults = vm.getStats().page_faults;
+    for (Address page = 0; page < 4; page++) {
+        EXPECT_EQ(vm.read(page * 256).value, page + 100);
+    }
+    EXPECT_EQ(vm.getStats().page_faults, faults);
+    ASSERT_TRUE(vm.setSwapDelay(0).success);
+    std::remove(path.c_str());
+}
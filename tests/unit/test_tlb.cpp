@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "virtual_memory/tlb.h"
+#include "virtual_memory/virtual_memory.h"
+#include "memory/physical_memory.h"
+
+using namespace memsim;
+
+TEST(TLBTest, ReplacesWithinSetByPolicy) {
+    TLB lru("dTLB", {2, 2, TLBPolicy::LRU, 0});
+    TLB fifo("dTLB", {2, 2, TLBPolicy::FIFO, 0});
+    EXPECT_EQ(lru.getNumEntries(), 4u);
+
+    // Pages 0, 2 and 4 share set 0; touching page 0 makes page 2 the LRU entry
+    for (TLB* tlb : {&lru, &fifo}) {
+        Address frame = 0;
+        tlb->insert(0, 10);
+        tlb->insert(2, 12);
+        tlb->insert(1, 11);                     // Set 1, no conflict
+        EXPECT_TRUE(tlb->lookup(0, frame));
+        EXPECT_EQ(frame, 10u);
+        tlb->insert(4, 14);
+        EXPECT_EQ(tlb->getStats().evictions, 1u);
+        EXPECT_TRUE(tlb->contains(1));
+        EXPECT_TRUE(tlb->contains(4));
+    }
+    EXPECT_TRUE(lru.contains(0));
+    EXPECT_FALSE(lru.contains(2));
+    EXPECT_FALSE(fifo.contains(0));             // Oldest insert, despite the recent hit
+    EXPECT_TRUE(fifo.contains(2));
+
+    EXPECT_TRUE(lru.invalidate(4));
+    EXPECT_FALSE(lru.invalidate(4));
+    EXPECT_EQ(lru.getStats().invalidations, 1u);
+    EXPECT_THROW(TLB("dTLB", {3, 2, TLBPolicy::LRU, 0}), std::invalid_argument);
+}
+
+TEST(TLBTest, STLBHitRefillsDTLB) {
+    TLBHierarchy tlb({1, 1, TLBPolicy::LRU, 1}, {2, 2, TLBPolicy::LRU, 7}, 30);
+    tlb.fill(1, 21);
+    tlb.fill(2, 22);                            // Displaces page 1 from the single-entry dTLB
+
+    Address frame = 0;
+    EXPECT_EQ(tlb.lookup(1, frame), TLBOutcome::STLB_HIT);
+    EXPECT_EQ(frame, 21u);
+    EXPECT_EQ(tlb.lookup(1, frame), TLBOutcome::DTLB_HIT);
+    EXPECT_EQ(tlb.lookup(5, frame), TLBOutcome::MISS);
+
+    EXPECT_EQ(tlb.getCycles(TLBOutcome::DTLB_HIT), 1u);
+    EXPECT_EQ(tlb.getCycles(TLBOutcome::STLB_HIT), 8u);
+    EXPECT_EQ(tlb.getCycles(TLBOutcome::MISS), 38u);
+
+    tlb.shootdown(1);
+    EXPECT_FALSE(tlb.getDTLB().contains(1));
+    EXPECT_FALSE(tlb.getSTLB().contains(1));
+    EXPECT_EQ(tlb.getShootdowns(), 1u);
+}
+
+TEST(TLBTest, VirtualMemoryShootsDownEvictedPages) {
+    PhysicalMemory memory(4096);
+    VirtualMemory vm(&memory, 10, 2, 256, PageReplacementPolicy::FIFO);
+    vm.setTLB(std::make_unique<TLBHierarchy>(TLBConfig{2, 2, TLBPolicy::LRU, 0},
+                                             TLBConfig{4, 2, TLBPolicy::LRU, 7}, 30));
+
+    vm.write(0, 42);                            // Walk + fault
+    EXPECT_EQ(vm.read(1).value, 1);             // dTLB hit, same page
+    vm.read(256);                               // Walk + fault
+    vm.read(512);                               // Walk + fault, evicts page 0
+    EXPECT_FALSE(vm.getTLB()->getSTLB().contains(0));
+
+    // The stale mapping must not be used: page 0 faults again
+    auto result = vm.read(0);
+    ASSERT_TRUE(result.success);
+    VirtualMemoryStats stats = vm.getStats();
+    EXPECT_EQ(stats.page_faults, 4u);
+    EXPECT_EQ(stats.page_walks, 4u);
+    EXPECT_EQ(stats.dtlb_hits, 1u);
+    EXPECT_EQ(stats.translation_cycles, 4u * 37);
+    EXPECT_EQ(vm.getTLB()->getShootdowns(), 2u);  // Pages 0 and 1 (FIFO)
+    EXPECT_TRUE(vm.peek(0).success);
+    EXPECT_FALSE(vm.peek(256).success);
+}
+
+TEST(TLBTest, HugePagesExtendReach) {
+    PhysicalMemory memory(4096);
+    VirtualMemory vm(&memory, 64, 16, 256, PageReplacementPolicy::LRU);
+    vm.setTLB(std::make_unique<TLBHierarchy>(TLBConfig{1, 1, TLBPolicy::LRU, 0},
+                                             TLBConfig{1, 1, TLBPolicy::LRU, 7}, 30));
+    vm.setTransparentHugePages(PageSize::HUGE_2M);
+
+    // One 2M entry covers all 8 pages of the region
+    for (size_t page = 0; page < 8; page++) {
+        vm.read(page * 256);
+    }
+    auto stats = vm.getStats();
+    EXPECT_EQ(stats.by_size[1].tlb_misses, 1u);
+    EXPECT_EQ(stats.by_size[1].tlb_hits, 7u);
+    EXPECT_EQ(stats.page_walks, 1u);
+
+    // Demoting shoots the huge entry down; base pages then miss one by one
+    ASSERT_TRUE(vm.demote(0).success);
+    vm.read(0);
+    vm.read(256);
+    stats = vm.getStats();
+    EXPECT_EQ(stats.by_size[0].tlb_misses, 2u);
+    EXPECT_EQ(vm.translate(256 + 3).value, 256u + 3);
+}
@@ -271,6 +271,133 @@ TEST_F(VirtualMemoryTest, LRU_UpdateOnAccess) {
     EXPECT_EQ(stats.page_hits, 4);
 }
 
+TEST(VirtualMemoryLRUTest, ListOrderOverLargeAddressSpace) {
+    PhysicalMemory memory(64 * 1024);
+
+    // A million virtual pages: victim selection must not scan them
+    VirtualMemory vm(&memory, 1 << 20, 16, 4096, PageReplacementPolicy::LRU, 4);
+    for (size_t i = 0; i < 16; i++) {
+        vm.read((i * 65537 % (1 << 20)) * 4096);
+    }
+    vm.read(0);                                   // Page 0 becomes most recently used
+    vm.read(5 * 65537 % (1 << 20) * 4096);
+    vm.read(123456ULL * 4096);                    // Evicts page 65537, the oldest untouched
+    EXPECT_TRUE(vm.peek(0).success);
+    EXPECT_FALSE(vm.peek(65537ULL * 4096).success);
+
+    // Cycling through one page more than fits faults every time under LRU
+    for (size_t i = 0; i < 17; i++) {
+        vm.read((i * 60001 % (1 << 20)) * 4096);
+    }
+    uint64_t faults_before = vm.getStats().page_faults;
+    for (size_t round = 0; round < 200; round++) {
+        for (size_t i = 0; i < 17; i++) {
+            vm.read((i * 60001 % (1 << 20)) * 4096);
+        }
+    }
+    auto stats = vm.getStats();
+    EXPECT_EQ(stats.page_faults - faults_before, 200u * 17);
+    EXPECT_EQ(stats.by_size[0].mappings, 16u);
+}
+
+// ===== Clock Variant Tests =====
+
+TEST(VirtualMemoryClockTest, HandSweepsFramesNotVirtualPages) {
+    PhysicalMemory memory(64 * 1024);
+
+    // Sixteen pages scattered over a million virtual pages fill the frames in order
+    VirtualMemory vm(&memory, 1 << 20, 16, 4096, PageReplacementPolicy::CLOCK, 4);
+    for (size_t i = 0; i < 16; i++) {
+        vm.read((i * 65537 % (1 << 20)) * 4096);
+    }
+
+    // Every page is referenced: one pass clears them all, then frame 0 goes
+    vm.read(999999ULL * 4096);
+    EXPECT_EQ(vm.getStats().clock_scans, 17u);
+    EXPECT_FALSE(vm.peek(0).success);
+    vm.read(888888ULL * 4096);                    // Frame 1 was cleared by the first pass
+    EXPECT_EQ(vm.getStats().clock_scans, 18u);
+    EXPECT_FALSE(vm.peek(65537ULL * 4096).success);
+    EXPECT_TRUE(vm.peek(2 * 65537ULL * 4096).success);
+}
+
+TEST_F(VirtualMemoryTest, TwoHandedClockEvictsPagesUnusedBetweenHands) {
+    vm = std::make_unique<VirtualMemory>(memory.get(), 32, 8, 256, PageReplacementPolicy::TWO_HANDED_CLOCK);
+    EXPECT_EQ(vm->getClockHandSpread(), 4u);
+    EXPECT_FALSE(vm->setClockHandSpread(8).success);
+    ASSERT_TRUE(vm->setClockHandSpread(2).success);
+    for (size_t page = 0; page < 8; page++) {
+        vm->read(page * 256);
+    }
+
+    // The front hand clears pages 2-4 while the back hand passes 0-2: page 2 goes
+    vm->read(8 * 256);
+    EXPECT_FALSE(vm->peek(2 * 256).success);
+    EXPECT_EQ(vm->getStats().clock_scans, 3u);
+
+    // Page 3 is used again before the back hand arrives, page 4 is not
+    vm->read(3 * 256);
+    vm->read(9 * 256);
+    EXPECT_TRUE(vm->peek(3 * 256).success);
+    EXPECT_FALSE(vm->peek(4 * 256).success);
+}
+
+TEST_F(VirtualMemoryTest, WSClockCleansOldDirtyPages) {
+    vm = std::make_unique<VirtualMemory>(memory.get(), 32, 4, 256, PageReplacementPolicy::WSCLOCK);
+    EXPECT_EQ(vm->getWorkingSetWindow(), 4u);
+    vm->setWorkingSetWindow(2);
+    vm->write(0, 7);                              // Page 0 dirty
+    for (size_t page = 1; page < 4; page++) {
+        vm->read(page * 256);
+    }
+    for (size_t i = 0; i < 5; i++) {
+        vm->read(3 * 256);
+    }
+
+    // First pass clears the bits; the second cleans page 0 and evicts page 1
+    vm->read(4 * 256);
+    auto stats = vm->getStats();
+    EXPECT_EQ(stats.page_cleanings, 1u);
+    EXPECT_EQ(stats.page_writebacks, 1u);
+    EXPECT_TRUE(vm->peek(0).success);
+    EXPECT_FALSE(vm->peek(256).success);
+
+    // Once clean, page 0 is evicted without another writeback
+    vm->read(5 * 256);
+    vm->read(6 * 256);
+    vm->read(7 * 256);
+    EXPECT_FALSE(vm->peek(0).success);
+    EXPECT_EQ(vm->getStats().page_writebacks, 1u);
+}
+
+TEST_F(VirtualMemoryTest, ClockProKeepsHotPagesThroughScans) {
+    vm = std::make_unique<VirtualMemory>(memory.get(), 256, 8, 16, PageReplacementPolicy::CLOCK_PRO);
+    ASSERT_NE(vm->getClockPro(), nullptr);
+
+    // Pages 0 and 1 are reused every round while a scan streams through
+    for (size_t round = 0; round < 100; round++) {
+        vm->read(0);
+        vm->read(16);
+        vm->read((2 + round) * 16);
+    }
+    uint64_t faults_before = vm->getStats().page_faults;
+    for (size_t round = 100; round < 200; round++) {
+        vm->read(0);
+        vm->read(16);
+        vm->read((2 + round) * 16);
+    }
+    EXPECT_EQ(vm->getStats().page_faults - faults_before, 100u);
+    const ClockPro& clock = *vm->getClockPro();
+    EXPECT_GE(clock.getHotPages(), 2u);
+    EXPECT_EQ(clock.getHotPages() + clock.getColdPages(), 8u);
+    EXPECT_LE(clock.getTestPages(), 8u);
+
+    vm->flush();
+    EXPECT_EQ(clock.getHotPages() + clock.getColdPages() + clock.getTestPages(), 0u);
+    EXPECT_THROW(VirtualMemory(memory.get(), 32, 1, 256, PageReplacementPolicy::CLOCK_PRO),
+                 std::invalid_argument);
+}
+
 // ===== Flush Tests =====
 
 TEST_F(VirtualMemoryTest, Flush) {
@@ -476,6 +603,252 @@ TEST(VirtualMemoryLargeTest, LargeAddressSpace) {
     EXPECT_GT(stats.total_accesses, 0);
 }
 
+TEST_F(VirtualMemoryTest, DiskLatencyChargesFaultsAndWritebacks) {
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 10, 2, 256, PageReplacementPolicy::FIFO
+    );
+    vm->setDiskLatency(1000, 500);
+
+    vm->write(0, 1);       // Fault
+    vm->read(256);         // Fault
+    EXPECT_EQ(vm->getStats().disk_cycles, 2000u);
+
+    vm->read(512);         // Fault, evicts dirty page 0
+    EXPECT_EQ(vm->getStats().page_writebacks, 1u);
+    EXPECT_EQ(vm->getStats().disk_cycles, 3500u);
+
+    vm->read(0);           // Fault, evicts clean page 1
+    EXPECT_EQ(vm->getStats().page_writebacks, 1u);
+    EXPECT_EQ(vm->getStats().disk_cycles, 4500u);
+}
+
+// ===== Prefetching =====
+
+TEST_F(VirtualMemoryTest, ReadaheadFollowsSequentialScan) {
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 16, 256, PageReplacementPolicy::LRU
+    );
+    PhysicalMemory plain_memory(4096);
+    VirtualMemory plain(&plain_memory, 64, 16, 256, PageReplacementPolicy::LRU);
+    vm->setReadahead(4);
+
+    for (Address page = 0; page < 64; page++) {
+        ASSERT_EQ(vm->read(page * 256 + 3).value, plain.read(page * 256 + 3).value);
+    }
+    // Page 0 opens a stream, page 1 continues it; every later page was read ahead
+    auto stats = vm->getStats();
+    EXPECT_EQ(stats.page_faults, 2u);
+    EXPECT_EQ(plain.getStats().page_faults, 64u);
+    EXPECT_EQ(stats.readahead_pages, 62u);
+    EXPECT_EQ(stats.prefetch_hits, 62u);
+    EXPECT_EQ(stats.prefetch_wasted, 0u);
+    EXPECT_EQ(vm->getReadaheadLimit(), 4u);
+}
+
+TEST_F(VirtualMemoryTest, UnusedReadaheadIsEvictedBeforeOlderDemandPages) {
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 8, 256, PageReplacementPolicy::LRU
+    );
+    vm->setReadahead(4);
+
+    for (Address page : {20, 30, 40, 50, 0, 1}) {     // Page 1 reads ahead pages 2-5
+        vm->read(page * 256);
+    }
+    EXPECT_EQ(vm->getStats().readahead_pages, 4u);
+    EXPECT_FALSE(vm->peek(30 * 256).success);        // Made room for the window
+
+    // The window entered at the LRU tail: new faults take it, not page 40
+    vm->read(60 * 256);
+    vm->read(62 * 256);
+    EXPECT_TRUE(vm->peek(40 * 256).success);
+    EXPECT_FALSE(vm->peek(5 * 256).success);
+    EXPECT_FALSE(vm->peek(4 * 256).success);
+    EXPECT_EQ(vm->getStats().prefetch_wasted, 2u);
+
+    // A used prefetched page moves to the head like any other
+    vm->read(2 * 256);
+    vm->read(10 * 256);
+    EXPECT_TRUE(vm->peek(2 * 256).success);
+    EXPECT_FALSE(vm->peek(3 * 256).success);
+    EXPECT_TRUE(vm->peek(40 * 256).success);
+    EXPECT_EQ(vm->getStats().prefetch_wasted, 3u);
+}
+
+TEST_F(VirtualMemoryTest, ReadaheadEvictionsLeaveNoStaleFifoEntries) {
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 3, 256, PageReplacementPolicy::FIFO
+    );
+    vm->setReadahead(4);
+
+    vm->read(10 * 256);
+    vm->read(11 * 256);                           // Reading ahead evicts page 10 past the window
+    ASSERT_FALSE(vm->peek(10 * 256).success);
+
+    // Page 10 faults back in after page 11, so page 11 goes first
+    vm->read(10 * 256);
+    vm->read(40 * 256);
+    vm->read(50 * 256);
+    EXPECT_TRUE(vm->peek(10 * 256).success);
+    EXPECT_FALSE(vm->peek(11 * 256).success);
+}
+
+TEST_F(VirtualMemoryTest, ClocksPrefetchIntoFreeFramesOnly) {
+    for (auto policy : {PageReplacementPolicy::CLOCK, PageReplacementPolicy::WSCLOCK,
+                        PageReplacementPolicy::TWO_HANDED_CLOCK}) {
+        VirtualMemory plain(memory.get(), 64, 4, 256, policy);
+        VirtualMemory ahead(memory.get(), 64, 4, 256, policy);
+        ahead.setReadahead(4);
+
+        // Memory is full before the stream starts, so no sweep runs on its behalf
+        for (Address page : {20, 30, 40, 50, 20, 0, 1, 2, 30, 3}) {
+            plain.read(page * 256);
+            ahead.read(page * 256);
+        }
+        EXPECT_EQ(ahead.getStats().readahead_pages, 0u);
+        EXPECT_EQ(ahead.getStats().page_faults, plain.getStats().page_faults);
+        for (Address page = 0; page < 64; page++) {
+            EXPECT_EQ(ahead.peek(page * 256).success, plain.peek(page * 256).success) << "page " << page;
+        }
+    }
+}
+
+TEST_F(VirtualMemoryTest, FaultAroundMapsAlignedBlocks) {
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 16, 256, PageReplacementPolicy::FIFO
+    );
+    EXPECT_FALSE(vm->setFaultAround(3).success);
+    ASSERT_TRUE(vm->setFaultAround(4).success);
+
+    vm->write(5 * 256, 77);                       // Maps pages 4-7
+    vm->read(6 * 256);
+    EXPECT_EQ(vm->getStats().page_faults, 1u);
+    EXPECT_EQ(vm->getStats().fault_around_pages, 3u);
+    EXPECT_EQ(vm->getStats().prefetch_hits, 1u);
+
+    // A stride of one block uses one page in four: the rest are wasted once evicted
+    for (Address page = 8; page < 64; page += 4) {
+        vm->read(page * 256);
+    }
+    auto stats = vm->getStats();
+    EXPECT_EQ(stats.page_faults, 15u);
+    EXPECT_EQ(stats.fault_around_pages, 45u);
+    EXPECT_GT(stats.prefetch_wasted, 0u);
+    EXPECT_EQ(stats.prefetch_hits, 1u);
+}
+
+TEST_F(VirtualMemoryTest, ReadaheadLimitAdaptsToWaste) {
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 8, 256, PageReplacementPolicy::FIFO
+    );
+    vm->setReadahead(16);
+
+    // Pairs of sequential faults open windows that are never used
+    for (Address page = 0; page < 64; page += 16) {
+        vm->read(page * 256);
+        vm->read((page + 1) * 256);
+    }
+    auto stats = vm->getStats();
+    EXPECT_EQ(stats.readahead_windows, 4u);
+    EXPECT_EQ(stats.prefetch_hits, 0u);
+    EXPECT_GT(stats.prefetch_wasted, 0u);
+    EXPECT_EQ(vm->getReadaheadLimit(), 16u - stats.prefetch_wasted);
+
+    // A sequential scan faults twice to open its stream; its hits raise the limit again
+    size_t limit = vm->getReadaheadLimit();
+    for (Address page = 0; page < 12; page++) {
+        vm->read(page * 256);
+    }
+    EXPECT_EQ(vm->getStats().page_faults, stats.page_faults + 2);
+    EXPECT_GT(vm->getReadaheadLimit(), limit);
+
+    vm->flush();
+    EXPECT_EQ(vm->getReadaheadLimit(), 16u);
+}
+
+// ===== Huge Pages =====
+
+TEST_F(VirtualMemoryTest, TransparentHugePagesMapAlignedRuns) {
+    // 2-level table over 64 pages: 3 bits per level, so a 2M page covers 8 pages
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 16, 256, PageReplacementPolicy::LRU
+    );
+    EXPECT_FALSE(vm->setTransparentHugePages(PageSize::HUGE_1G).success);
+    ASSERT_TRUE(vm->setTransparentHugePages(PageSize::HUGE_2M).success);
+
+    vm->write(3 * 256, 9);                        // Huge fault: pages 0-7 in frames 0-7
+    EXPECT_EQ(vm->getPageSize(0).value, PageSize::HUGE_2M);
+    EXPECT_EQ(vm->translate(5 * 256 + 7).value, 5u * 256 + 7);
+    vm->read(16 * 256);                           // Pages 16-23 in frames 8-15
+    EXPECT_EQ(vm->getStats().page_faults, 2u);
+
+    // No aligned run is free: fall back to a base page, evicting the LRU huge page whole
+    vm->read(8 * 256);
+    auto stats = vm->getStats();
+    EXPECT_EQ(stats.huge_fallbacks, 1u);
+    EXPECT_EQ(stats.page_writebacks, 8u);        // Every base page of the dirty huge page
+    EXPECT_EQ(stats.by_size[0].faults, 1u);
+    EXPECT_EQ(stats.by_size[1].faults, 2u);
+    EXPECT_EQ(stats.by_size[0].mappings, 1u);
+    EXPECT_EQ(stats.by_size[1].mappings, 1u);
+    EXPECT_EQ(vm->getPageSize(8 * 256).value, PageSize::BASE);
+    EXPECT_FALSE(vm->peek(0).success);
+}
+
+TEST_F(VirtualMemoryTest, PromoteAndDemoteKeepData) {
+    // 3-level table over 64 pages: 2M pages cover 4 pages, 1G pages 16
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 16, 256, PageReplacementPolicy::FIFO, 3
+    );
+    vm->write(256 + 5, 42);                       // Page 1
+    vm->read(2 * 256);                            // Page 2
+    vm->read(40 * 256);                           // Outside the region
+
+    ASSERT_TRUE(vm->promote(0, PageSize::HUGE_2M).success);
+    EXPECT_EQ(vm->getPageSize(256).value, PageSize::HUGE_2M);
+    EXPECT_EQ(vm->read(256 + 5).value, 42);
+    EXPECT_EQ(vm->read(3 * 256 + 1).value, static_cast<uint8_t>(3 * 256 + 1));  // Loaded from disk
+    EXPECT_FALSE(vm->promote(256, PageSize::HUGE_2M).success);
+
+    // A 1G page needs all 16 frames: page 40 is evicted to make room
+    ASSERT_TRUE(vm->promote(0, PageSize::HUGE_1G).success);
+    EXPECT_FALSE(vm->peek(40 * 256).success);
+    EXPECT_EQ(vm->read(256 + 5).value, 42);
+
+    ASSERT_TRUE(vm->demote(0).success);
+    EXPECT_EQ(vm->getPageSize(8 * 256).value, PageSize::HUGE_2M);
+    ASSERT_TRUE(vm->demote(256).success);
+    EXPECT_EQ(vm->getPageSize(256).value, PageSize::BASE);
+    EXPECT_EQ(vm->read(256 + 5).value, 42);
+    EXPECT_FALSE(vm->demote(256).success);
+
+    auto stats = vm->getStats();
+    EXPECT_EQ(stats.promotions, 2u);
+    EXPECT_EQ(stats.demotions, 2u);
+    EXPECT_EQ(stats.by_size[0].mappings, 4u);
+    EXPECT_EQ(stats.by_size[1].mappings, 3u);
+    EXPECT_EQ(stats.by_size[2].mappings, 0u);
+}
+
+TEST_F(VirtualMemoryTest, PromoteEvictionsLeaveNoStaleFifoEntries) {
+    // 3-level table over 64 pages: 2M pages cover 4 pages
+    vm = std::make_unique<VirtualMemory>(
+        memory.get(), 64, 8, 256, PageReplacementPolicy::FIFO, 3
+    );
+    for (uint64_t page = 40; page < 52; page++) {
+        vm->read(page * 256);                     // Pages 44-51 stay resident
+    }
+    ASSERT_TRUE(vm->promote(0, PageSize::HUGE_2M).success);
+    ASSERT_FALSE(vm->peek(48 * 256).success);     // Evicted from the middle of the queue
+
+    // Page 48 faults back in after the huge page, so it must outlive it
+    vm->read(48 * 256);
+    for (uint64_t page = 56; page < 60; page++) {
+        vm->read(page * 256);
+    }
+    EXPECT_TRUE(vm->peek(48 * 256).success);
+    EXPECT_FALSE(vm->peek(0).success);
+}
+
 // ===== Edge Cases =====
 
 TEST_F(VirtualMemoryTest, InvalidVirtualAddress) {